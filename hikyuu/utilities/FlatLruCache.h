@@ -0,0 +1,427 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include "Log.h"
+#include "LruCache.h"
+
+namespace hku {
+
+/**
+ * @brief 扁平存储的 LRU 缓存
+ * @details
+ * 与 LruCache 接口一致，存储方式不同：
+ * - 所有条目存放在连续的节点数组中，以数组下标构成侵入式双向链表维护访问顺序；
+ * - 键索引为线性探测的开放寻址表，删除时后移填补，不使用墓碑；
+ * - 删除或淘汰的节点进入空闲链表复用，预热（或 reserve）后插入不再分配内存。
+ * 读操作只加共享锁并设置访问标记，淘汰时对带访问标记的尾部节点给予一次"第二次机会"
+ * 移至头部（CLOCK 近似），因此与 LruCache 一样为非严格 LRU。
+ * 节点下标为 32 位，条目数不能超过 2^32 - 1。
+ * @tparam KeyType 键的类型，必须支持哈希和相等比较
+ * @tparam ValueType 值的类型，必须支持默认构造、拷贝和移动操作
+ * @tparam Lock 锁类型，默认为 NullLock（非线程安全）
+ * @tparam Hash 键的哈希函数
+ */
+template <typename KeyType, typename ValueType, class Lock = NullLock,
+          class Hash = std::hash<KeyType>>
+class FlatLruCache final {
+public:
+    using key_type = KeyType;
+    using value_type = ValueType;
+    using size_type = size_t;
+    typedef Lock lock_type;
+    using UniqueGuard = std::unique_lock<lock_type>;
+    using SharedGuard = std::shared_lock<lock_type>;
+
+    /**
+     * @brief 构造函数
+     * @param capacity 缓存容量，默认为64，0表示无限制容量
+     * @param overflow 溢出容量，默认为8，允许缓存临时超出设定容量
+     *                 仅当缓存大小 > 容量+溢出容量时才触发淘汰机制
+     */
+    explicit FlatLruCache(size_type capacity = 64, size_type overflow = 8)
+    : m_capacity(capacity), m_overflow(overflow) {}
+
+    /**
+     * @brief 插入键值对
+     * @param key 键
+     * @param value 值
+     */
+    void insert(const key_type& key, const value_type& value) {
+        UniqueGuard lock(m_mutex);
+        _insert(key, value_type(value));
+    }
+
+    /**
+     * @brief 插入键值对（移动版本）
+     * @param key 键
+     * @param value 值（右值引用）
+     */
+    void insert(const key_type& key, value_type&& value) {
+        UniqueGuard lock(m_mutex);
+        _insert(key, std::move(value));
+    }
+
+    /**
+     * @brief 获取键对应的值
+     * @param key 键
+     * @return 存在则返回值，否则返回ValueType的默认构造值
+     */
+    value_type get(const key_type& key) {
+        SharedGuard lock(m_mutex);
+        size_t pos = _find(key, _hash(key));
+        if (pos == NPOS) {
+            return value_type{};
+        }
+        Node& node = m_nodes[m_buckets[pos].node];
+        node.referenced.store(true, std::memory_order_relaxed);
+        return node.value;
+    }
+
+    /**
+     * @brief 尝试获取键对应的值
+     * @param key 键
+     * @param value 用于接收值的引用参数
+     * @return 如果键存在返回true，否则返回false
+     */
+    bool tryGet(const key_type& key, value_type& value) {
+        SharedGuard lock(m_mutex);
+        size_t pos = _find(key, _hash(key));
+        if (pos == NPOS) {
+            return false;
+        }
+        Node& node = m_nodes[m_buckets[pos].node];
+        node.referenced.store(true, std::memory_order_relaxed);
+        value = node.value;
+        return true;
+    }
+
+    /**
+     * @brief 检查是否包含指定键
+     * @param key 键
+     * @return 存在返回true，否则返回false
+     */
+    bool contains(const key_type& key) {
+        SharedGuard lock(m_mutex);
+        return _find(key, _hash(key)) != NPOS;
+    }
+
+    /**
+     * @brief 删除指定键
+     * @param key 要删除的键
+     * @return 成功删除返回true，不存在返回false
+     */
+    bool remove(const key_type& key) {
+        UniqueGuard lock(m_mutex);
+        size_t pos = _find(key, _hash(key));
+        if (pos == NPOS) {
+            return false;
+        }
+        _erase(pos);
+        return true;
+    }
+
+    /**
+     * @brief 清空缓存，已分配的存储空间保留以供复用
+     */
+    void clear() {
+        UniqueGuard lock(m_mutex);
+        m_nodes.clear();
+        for (auto& bucket : m_buckets) {
+            bucket.node = NPOS;
+        }
+        m_head = m_tail = m_free = NPOS;
+        m_size = 0;
+    }
+
+    /**
+     * @brief 预分配可容纳 n 个条目的存储空间
+     * @details 缓存内条目数不会超过容量+溢出容量，n 不小于该值时之后的插入不再分配内存
+     * @param n 条目数量
+     */
+    void reserve(size_type n) {
+        UniqueGuard lock(m_mutex);
+        m_nodes.reserve(n);
+        if (_bucketsFor(n) > m_buckets.size()) {
+            _rehash(_bucketsFor(n));
+        }
+    }
+
+    /**
+     * @brief 获取缓存当前大小
+     * @return 当前缓存元素数量
+     */
+    size_type size() const {
+        SharedGuard lock(m_mutex);
+        return m_size;
+    }
+
+    /**
+     * @brief 检查缓存是否为空
+     * @return 空返回true，否则返回false
+     */
+    bool empty() const {
+        SharedGuard lock(m_mutex);
+        return m_size == 0;
+    }
+
+    /**
+     * @brief 获取缓存容量
+     * @return 缓存容量
+     */
+    size_type capacity() const {
+        SharedGuard lock(m_mutex);
+        return m_capacity;
+    }
+
+    /**
+     * @brief 获取缓存溢出容量
+     * @return 缓存溢出容量
+     */
+    size_type overflow() const {
+        SharedGuard lock(m_mutex);
+        return m_overflow;
+    }
+
+    /**
+     * @brief 当前节点数组与索引表占用的内存字节数（不含键值自身在堆上分配的内存）
+     */
+    size_type memoryUsage() const {
+        SharedGuard lock(m_mutex);
+        return m_nodes.capacity() * sizeof(Node) + m_buckets.capacity() * sizeof(Bucket);
+    }
+
+    /**
+     * @brief 设置缓存容量
+     * @param capacity 新的容量，0表示不限制容量
+     */
+    void resize(size_type capacity) {
+        UniqueGuard lock(m_mutex);
+        m_capacity = capacity;
+        _prune_if_needed();
+    }
+
+    /**
+     * @brief 设置缓存溢出容量
+     * @param overflow 新的溢出容量
+     */
+    void setOverflow(size_type overflow) {
+        UniqueGuard lock(m_mutex);
+        m_overflow = overflow;
+        _prune_if_needed();
+    }
+
+private:
+    static constexpr uint32_t NPOS = 0xFFFFFFFF;
+
+    struct Node {
+        key_type key;
+        value_type value;
+        uint32_t prev = NPOS;
+        uint32_t next = NPOS;
+        std::atomic<bool> referenced{false};  // 读取时设置，淘汰时给予第二次机会
+
+        Node(const key_type& k, value_type&& v) : key(k), value(std::move(v)) {}
+
+        // 仅在持有独占锁时随节点数组扩容调用
+        Node(Node&& other) noexcept(std::is_nothrow_move_constructible<key_type>::value &&
+                                    std::is_nothrow_move_constructible<value_type>::value)
+        : key(std::move(other.key)),
+          value(std::move(other.value)),
+          prev(other.prev),
+          next(other.next),
+          referenced(other.referenced.load(std::memory_order_relaxed)) {}
+    };
+
+    struct Bucket {
+        uint32_t node = NPOS;  // 节点下标，NPOS 表示空槽
+        uint32_t hash = 0;     // 键的哈希值，用于定位理想槽位与快速比较
+    };
+
+    uint32_t _hash(const key_type& key) const {
+        // std::hash 对整数通常为恒等映射，乘法散列后取高位，避免线性探测时聚集
+        uint64_t h = uint64_t(m_hash(key)) * 0x9E3779B97F4A7C15ULL;
+        return uint32_t(h >> 32);
+    }
+
+    static size_t _bucketsFor(size_t n) {
+        // 负载因子不超过 3/4
+        size_t buckets = 16;
+        while (buckets * 3 < n * 4) {
+            buckets <<= 1;
+        }
+        return buckets;
+    }
+
+    size_t _find(const key_type& key, uint32_t hash) const {
+        if (m_size == 0) {
+            return NPOS;
+        }
+        size_t mask = m_buckets.size() - 1;
+        for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+            const Bucket& bucket = m_buckets[pos];
+            if (bucket.node == NPOS) {
+                return NPOS;
+            }
+            if (bucket.hash == hash && m_nodes[bucket.node].key == key) {
+                return pos;
+            }
+        }
+    }
+
+    void _place(uint32_t node, uint32_t hash) {
+        size_t mask = m_buckets.size() - 1;
+        size_t pos = hash & mask;
+        while (m_buckets[pos].node != NPOS) {
+            pos = (pos + 1) & mask;
+        }
+        m_buckets[pos].node = node;
+        m_buckets[pos].hash = hash;
+    }
+
+    void _rehash(size_t bucket_count) {
+        std::vector<Bucket> buckets(bucket_count);
+        m_buckets.swap(buckets);
+        for (const auto& bucket : buckets) {
+            if (bucket.node != NPOS) {
+                _place(bucket.node, bucket.hash);
+            }
+        }
+    }
+
+    void _insert(const key_type& key, value_type&& value) {
+        uint32_t hash = _hash(key);
+        size_t pos = _find(key, hash);
+        if (pos != NPOS) {
+            uint32_t idx = m_buckets[pos].node;
+            Node& node = m_nodes[idx];
+            node.value = std::move(value);
+            node.referenced.store(false, std::memory_order_relaxed);
+            _moveToFront(idx);
+            return;
+        }
+
+        // 先淘汰再插入，使节点数不超过容量+溢出容量，已分配的空间足以容纳
+        if (m_capacity != 0 && m_size + 1 > m_capacity + m_overflow) {
+            _evict_to(m_capacity - 1);
+        }
+        if ((m_size + 1) * 4 > m_buckets.size() * 3) {
+            _rehash(_bucketsFor(m_size + 1));
+        }
+
+        uint32_t idx;
+        if (m_free != NPOS) {
+            idx = m_free;
+            m_free = m_nodes[idx].next;
+            m_nodes[idx].key = key;
+            m_nodes[idx].value = std::move(value);
+        } else {
+            HKU_CHECK(m_nodes.size() < NPOS, "FlatLruCache too many entries!");
+            idx = uint32_t(m_nodes.size());
+            m_nodes.emplace_back(key, std::move(value));
+        }
+        m_nodes[idx].referenced.store(false, std::memory_order_relaxed);
+        _place(idx, hash);
+        _pushFront(idx);
+        m_size++;
+    }
+
+    // 删除索引表中 pos 处的条目，后续探测链上的条目后移填补空位
+    void _erase(size_t pos) {
+        uint32_t idx = m_buckets[pos].node;
+        size_t mask = m_buckets.size() - 1;
+        size_t hole = pos;
+        for (size_t i = (pos + 1) & mask; m_buckets[i].node != NPOS; i = (i + 1) & mask) {
+            size_t ideal = m_buckets[i].hash & mask;
+            if (((i - ideal) & mask) >= ((i - hole) & mask)) {
+                m_buckets[hole] = m_buckets[i];
+                hole = i;
+            }
+        }
+        m_buckets[hole].node = NPOS;
+
+        _unlink(idx);
+        Node& node = m_nodes[idx];
+        node.value = value_type{};
+        node.next = m_free;
+        m_free = idx;
+        m_size--;
+    }
+
+    // 如果缓存已满，移除最久未使用的项
+    void _prune_if_needed() {
+        if (m_capacity != 0 && m_size > m_capacity + m_overflow) {
+            _evict_to(m_capacity);
+        }
+    }
+
+    // 淘汰至 size 个元素，带访问标记的尾部节点清除标记后移至头部
+    void _evict_to(size_type size) {
+        while (m_size > size) {
+            uint32_t idx = m_tail;
+            while (m_nodes[idx].referenced.load(std::memory_order_relaxed)) {
+                m_nodes[idx].referenced.store(false, std::memory_order_relaxed);
+                _moveToFront(idx);
+                idx = m_tail;
+            }
+            _erase(_find(m_nodes[idx].key, _hash(m_nodes[idx].key)));
+        }
+    }
+
+    void _pushFront(uint32_t idx) {
+        Node& node = m_nodes[idx];
+        node.prev = NPOS;
+        node.next = m_head;
+        if (m_head != NPOS) {
+            m_nodes[m_head].prev = idx;
+        } else {
+            m_tail = idx;
+        }
+        m_head = idx;
+    }
+
+    void _unlink(uint32_t idx) {
+        Node& node = m_nodes[idx];
+        if (node.prev != NPOS) {
+            m_nodes[node.prev].next = node.next;
+        } else {
+            m_head = node.next;
+        }
+        if (node.next != NPOS) {
+            m_nodes[node.next].prev = node.prev;
+        } else {
+            m_tail = node.prev;
+        }
+    }
+
+    void _moveToFront(uint32_t idx) {
+        if (m_head != idx) {
+            _unlink(idx);
+            _pushFront(idx);
+        }
+    }
+
+private:
+    size_type m_capacity;
+    size_type m_overflow;
+    size_type m_size = 0;
+    uint32_t m_head = NPOS;  // 最近使用
+    uint32_t m_tail = NPOS;  // 最久未使用
+    uint32_t m_free = NPOS;  // 空闲节点链表
+    std::vector<Node> m_nodes;
+    std::vector<Bucket> m_buckets;
+    Hash m_hash;
+    mutable lock_type m_mutex;
+};
+
+}  // namespace hku
@@ -0,0 +1,394 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "Log.h"
+#include "LruCache.h"
+#include "thread/AwaitableFuture.h"
+
+namespace hku {
+
+/**
+ * @brief 自动加载缓存，合并对同一键的并发加载请求
+ * @details
+ * 基于 LruCache，未命中时调用加载函数获取值并放入缓存：
+ * - 请求合并：多个线程同时未命中同一键时，只有一个线程执行加载，其余线程共享其结果
+ *   （std::shared_future），加载函数抛出的异常同样传递给所有等待者；
+ * - 存活时间：setTTL 设置值的存活时间，过期后重新加载；
+ * - 提前刷新：setRefreshAhead 设置提前量，命中距过期不足该时长的值时触发一次后台刷新，
+ *   刷新期间仍返回旧值，刷新失败时保留旧值直至过期；
+ * - 失败缓存：setNegativeTTL 设置加载失败的缓存时长，期间对该键的请求直接抛出上次的异常，
+ *   不再重复加载。
+ * 异步加载与提前刷新通过 setExecutor 设置的执行器运行（如提交至线程池），
+ * 未设置执行器时在调用线程中同步执行。get_or_load_async 返回 AwaitableFuture，
+ * 协程中可使用 await_future 等待，加载完成时直接唤醒协程，无需轮询。
+ * @tparam KeyType 键的类型，必须支持哈希和相等比较
+ * @tparam ValueType 值的类型，必须支持拷贝和移动操作
+ */
+template <typename KeyType, typename ValueType>
+class LoadingCache final {
+public:
+    using key_type = KeyType;
+    using value_type = ValueType;
+    using size_type = size_t;
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+    using duration = std::chrono::milliseconds;
+
+    /** 加载函数，失败时抛出异常 */
+    using Loader = std::function<value_type(const key_type&)>;
+
+    /** 执行器，负责运行异步加载任务 */
+    using Executor = std::function<void(std::function<void()>)>;
+
+    /**
+     * @brief 构造函数
+     * @param capacity 缓存容量，默认为64，0表示无限制容量
+     * @param overflow 溢出容量，默认为8
+     */
+    explicit LoadingCache(size_type capacity = 64, size_type overflow = 8)
+    : m_cache(capacity, overflow), m_failures(capacity, overflow) {}
+
+    LoadingCache(const LoadingCache&) = delete;
+    LoadingCache& operator=(const LoadingCache&) = delete;
+
+    /** 析构时等待所有进行中的加载完成 */
+    ~LoadingCache() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this] { return m_pending == 0; });
+    }
+
+    /**
+     * @brief 获取键对应的值，未命中时加载
+     * @details 同一键的并发未命中只会调用一次加载函数，加载在调用线程中执行
+     * @param key 键
+     * @param loader 加载函数
+     * @return 键对应的值
+     * @exception 加载函数抛出的异常，或失败缓存中保存的异常
+     */
+    value_type get_or_load(const key_type& key, const Loader& loader) {
+        Entry entry;
+        if (m_cache.tryGet(key, entry)) {
+            _refresh_if_needed(key, entry, loader);
+            return entry.value;
+        }
+        std::exception_ptr failure;
+        if (m_failures.tryGet(key, failure)) {
+            std::rethrow_exception(failure);
+        }
+        return _load(key, loader, false, false).get();
+    }
+
+    /**
+     * @brief 异步获取键对应的值，未命中时通过执行器加载
+     * @details 每次调用返回独立的 future，同一键的并发请求仍只加载一次
+     * @param key 键
+     * @param loader 加载函数
+     * @return 值的 AwaitableFuture，命中时已就绪
+     */
+    AwaitableFuture<value_type> get_or_load_async(const key_type& key, const Loader& loader) {
+        auto waiter = std::make_shared<AwaitablePromise<value_type>>();
+        AwaitableFuture<value_type> future = waiter->get_future();
+        Entry entry;
+        if (m_cache.tryGet(key, entry)) {
+            _refresh_if_needed(key, entry, loader);
+            waiter->set_value(std::move(entry.value));
+            return future;
+        }
+        std::exception_ptr failure;
+        if (m_failures.tryGet(key, failure)) {
+            waiter->set_exception(failure);
+            return future;
+        }
+        _load(key, loader, false, true, waiter);
+        return future;
+    }
+
+    /**
+     * @brief 仅从缓存中获取，不触发加载
+     * @param key 键
+     * @param value 用于接收值的引用参数
+     * @return 命中返回true，否则返回false
+     */
+    bool tryGet(const key_type& key, value_type& value) {
+        Entry entry;
+        if (m_cache.tryGet(key, entry)) {
+            value = std::move(entry.value);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 直接放入缓存，并清除该键的失败记录
+     * @param key 键
+     * @param value 值
+     */
+    void insert(const key_type& key, const value_type& value) {
+        m_cache.insert(key, Entry{value, clock_type::now()});
+        m_failures.remove(key);
+    }
+
+    /**
+     * @brief 使指定键失效（包括失败记录），进行中的加载不受影响
+     * @param key 键
+     */
+    void invalidate(const key_type& key) {
+        m_cache.remove(key);
+        m_failures.remove(key);
+    }
+
+    /** 清空缓存及失败记录 */
+    void clear() {
+        m_cache.clear();
+        m_failures.clear();
+    }
+
+    /** 缓存中的元素数量（可能包含尚未清理的过期元素） */
+    size_type size() const {
+        return m_cache.size();
+    }
+
+    /** 缓存容量 */
+    size_type capacity() const {
+        return m_cache.capacity();
+    }
+
+    /**
+     * @brief 设置缓存容量
+     * @param capacity 新的容量，0表示不限制容量
+     */
+    void resize(size_type capacity) {
+        m_cache.resize(capacity);
+        m_failures.resize(capacity);
+    }
+
+    /**
+     * @brief 设置值的存活时间，对之后加载的值生效
+     * @param ttl 存活时间，小于等于0表示永不过期（默认）
+     */
+    void setTTL(duration ttl) {
+        m_ttl_ms.store(ttl.count(), std::memory_order_relaxed);
+        m_cache.setDefaultTTL(ttl);
+    }
+
+    /** 值的存活时间 */
+    duration ttl() const {
+        return duration(m_ttl_ms.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief 设置提前刷新的时长，需同时设置存活时间且小于存活时间才生效
+     * @param ahead 提前量，小于等于0表示不提前刷新（默认）
+     */
+    void setRefreshAhead(duration ahead) {
+        m_refresh_ahead_ms.store(ahead.count(), std::memory_order_relaxed);
+    }
+
+    /** 提前刷新的时长 */
+    duration refreshAhead() const {
+        return duration(m_refresh_ahead_ms.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief 设置加载失败的缓存时长
+     * @param ttl 失败缓存时长，小于等于0表示不缓存失败（默认）
+     */
+    void setNegativeTTL(duration ttl) {
+        m_negative_ttl_ms.store(ttl.count(), std::memory_order_relaxed);
+        m_failures.setDefaultTTL(ttl);
+    }
+
+    /** 加载失败的缓存时长 */
+    duration negativeTTL() const {
+        return duration(m_negative_ttl_ms.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief 设置运行异步加载与提前刷新的执行器
+     * @param executor 执行器，为空时在调用线程中同步执行
+     */
+    void setExecutor(Executor executor) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_executor = std::move(executor);
+    }
+
+    /** 加载函数的累计调用次数（含提前刷新） */
+    uint64_t loadCount() const {
+        return m_load_count.load(std::memory_order_relaxed);
+    }
+
+    /** 因合并至进行中的加载而未调用加载函数的请求次数 */
+    uint64_t coalescedCount() const {
+        return m_coalesced_count.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Entry {
+        value_type value{};
+        time_point loaded_at;
+    };
+
+    using Waiter = std::shared_ptr<AwaitablePromise<value_type>>;
+
+    // 进行中的加载，waiters 为 get_or_load_async 合并至该加载的请求
+    struct Inflight {
+        std::shared_future<value_type> future;
+        std::vector<Waiter> waiters;
+    };
+
+    void _refresh_if_needed(const key_type& key, const Entry& entry, const Loader& loader) {
+        int64_t ttl = m_ttl_ms.load(std::memory_order_relaxed);
+        int64_t ahead = m_refresh_ahead_ms.load(std::memory_order_relaxed);
+        if (ttl <= 0 || ahead <= 0 || ahead >= ttl) {
+            return;
+        }
+        if (clock_type::now() >= entry.loaded_at + duration(ttl - ahead)) {
+            _load(key, loader, true, true);
+        }
+    }
+
+    // 发起加载，同一键已有进行中的加载时直接返回其 future，waiter 非空时在加载完成后设置其结果
+    std::shared_future<value_type> _load(const key_type& key, const Loader& loader, bool refresh,
+                                         bool async, const Waiter& waiter = Waiter()) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto iter = m_inflight.find(key);
+        if (iter != m_inflight.end()) {
+            if (!refresh) {
+                m_coalesced_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (waiter) {
+                iter->second.waiters.push_back(waiter);
+            }
+            return iter->second.future;
+        }
+
+        // 加载完成时先写入缓存再移出进行中列表，此处复查可避免刚完成的加载被重复执行
+        auto promise = std::make_shared<std::promise<value_type>>();
+        if (!refresh) {
+            Entry entry;
+            if (m_cache.tryGet(key, entry)) {
+                lock.unlock();
+                if (waiter) {
+                    waiter->set_value(entry.value);
+                }
+                promise->set_value(std::move(entry.value));
+                return promise->get_future().share();
+            }
+            std::exception_ptr failure;
+            if (m_failures.tryGet(key, failure)) {
+                lock.unlock();
+                if (waiter) {
+                    waiter->set_exception(failure);
+                }
+                promise->set_exception(failure);
+                return promise->get_future().share();
+            }
+        }
+
+        std::shared_future<value_type> future = promise->get_future().share();
+        Inflight& inflight = m_inflight[key];
+        inflight.future = future;
+        if (waiter) {
+            inflight.waiters.push_back(waiter);
+        }
+        m_pending++;
+        m_load_count.fetch_add(1, std::memory_order_relaxed);
+        Executor executor = async ? m_executor : Executor();
+        lock.unlock();
+
+        auto task = [this, key, loader, promise, refresh]() {
+            _run_load(key, loader, *promise, refresh);
+        };
+        if (executor) {
+            try {
+                executor(task);
+            } catch (...) {
+                // 执行器拒绝任务时在当前线程中执行，保证进行中的加载总能完成
+                task();
+            }
+        } else {
+            task();
+        }
+        return future;
+    }
+
+    void _run_load(const key_type& key, const Loader& loader, std::promise<value_type>& promise,
+                   bool refresh) {
+        std::optional<value_type> value;
+        std::exception_ptr e;
+        try {
+            value.emplace(loader(key));
+            m_cache.insert(key, Entry{*value, clock_type::now()});
+            m_failures.remove(key);
+        } catch (...) {
+            e = std::current_exception();
+            if (refresh) {
+                HKU_WARN("LoadingCache refresh failed, keep the old value until it expires!");
+            } else if (m_negative_ttl_ms.load(std::memory_order_relaxed) > 0) {
+                m_failures.insert(key, e);
+            }
+        }
+
+        std::vector<Waiter> waiters;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto iter = m_inflight.find(key);
+            waiters.swap(iter->second.waiters);
+            m_inflight.erase(iter);
+        }
+
+        // 此时已不会再有请求合并至本次加载，在锁外设置结果，等待者的回调不会阻塞其他请求
+        for (auto& waiter : waiters) {
+            if (e) {
+                waiter->set_exception(e);
+            } else {
+                waiter->set_value(*value);
+            }
+        }
+        if (e) {
+            promise.set_exception(e);
+        } else {
+            promise.set_value(std::move(*value));
+        }
+
+        // 持锁通知，否则析构函数可能在 m_pending 归零后先行返回，销毁 m_cond 后才被通知
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending--;
+        m_cond.notify_all();
+    }
+
+private:
+    LruCache<key_type, Entry, std::shared_mutex> m_cache;
+    LruCache<key_type, std::exception_ptr, std::shared_mutex> m_failures;  // 失败缓存
+
+    std::atomic<int64_t> m_ttl_ms{0};
+    std::atomic<int64_t> m_refresh_ahead_ms{0};
+    std::atomic<int64_t> m_negative_ttl_ms{0};
+    std::atomic<uint64_t> m_load_count{0};
+    std::atomic<uint64_t> m_coalesced_count{0};
+
+    std::mutex m_mutex;  // 保护以下成员
+    std::condition_variable m_cond;
+    std::unordered_map<key_type, Inflight> m_inflight;  // 进行中的加载
+    size_t m_pending = 0;                               // 进行中的任务数
+    Executor m_executor;
+};
+
+}  // namespace hku
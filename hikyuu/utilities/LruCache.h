@@ -8,9 +8,12 @@
 #pragma once
 #include <unordered_map>
 #include <list>
+#include <map>
 #include <mutex>
 #include <shared_mutex>
 #include <atomic>
+#include <chrono>
+#include <functional>
 #include <optional>
 
 namespace hku {
@@ -32,6 +35,11 @@ public:
 /**
  * @brief LRU (Least Recently Used)
  * 缓存实现(非严格意义LRU以便提升并发读取性能)
+ * @details
+ * - 可设置权重函数（setWeigher），此时容量与溢出容量以权重之和计量（如字节数），
+ *   未设置时每个元素权重为1，即按元素个数计量；
+ * - 可设置默认存活时间（setDefaultTTL）或在插入时指定单个元素的存活时间，
+ *   过期元素在访问时视为不存在，并在插入、调整容量或调用 removeExpired 时批量清理。
  * @tparam KeyType 键的类型，必须支持哈希和相等比较
  * @tparam ValueType 值的类型，必须支持拷贝和移动操作
  */
@@ -45,9 +53,36 @@ public:
     using UniqueGuard = std::unique_lock<lock_type>;
     using SharedGuard = std::shared_lock<lock_type>;
 
-    // 存储结构：值 + 原子脏标记（标记是否被get访问过，需要更新LRU顺序）
-    using CacheValue = std::pair<value_type, std::atomic<bool>>;
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+    using duration = std::chrono::milliseconds;
+
+    /** 权重函数，返回元素的权重（如占用的字节数） */
+    using Weigher = std::function<size_type(const key_type&, const value_type&)>;
+
     using LruList = std::list<key_type>;
+    using ExpireMap = std::multimap<time_point, key_type>;
+
+    // 存储结构：值 + 原子脏标记（标记是否被get访问过，需要更新LRU顺序）+ 权重 + 过期时间
+    struct CacheValue {
+        value_type value;
+        std::atomic<bool> dirty;
+        size_type weight;
+        time_point expire_at;                      // time_point::max() 表示永不过期
+        typename ExpireMap::iterator expire_iter;  // 过期索引中的位置，仅在会过期时有效
+
+        explicit CacheValue(value_type&& v)
+        : value(std::move(v)), dirty(false), weight(0), expire_at(time_point::max()) {}
+
+        // 仅在持有独占锁时插入容器时调用
+        CacheValue(CacheValue&& other)
+        : value(std::move(other.value)),
+          dirty(other.dirty.load(std::memory_order_relaxed)),
+          weight(other.weight),
+          expire_at(other.expire_at),
+          expire_iter(other.expire_iter) {}
+    };
+
     using CacheMap =
       std::unordered_map<key_type, std::pair<typename LruList::iterator, CacheValue>>;
 
@@ -64,49 +99,49 @@ public:
         UniqueGuard lock(m_mutex);
         m_cache.clear();
         m_lru_list.clear();
+        m_expires.clear();
     }
 
     /**
-     * @brief 插入键值对
+     * @brief 插入键值对，使用默认存活时间
      * @param key 键
      * @param value 值
      */
     void insert(const key_type& key, const value_type& value) {
         UniqueGuard lock(m_mutex);
-        _batch_update_dirty_nodes();
-        auto it = m_cache.find(key);
-        if (it != m_cache.end()) {
-            it->second.second.first = value;
-            it->second.second.second.store(false, std::memory_order_relaxed);
-            m_lru_list.splice(m_lru_list.begin(), m_lru_list, it->second.first);
-        } else {
-            m_lru_list.emplace_front(key);
-            m_cache.emplace(key, std::make_pair(m_lru_list.begin(),
-                                                std::make_pair(value, false)  // 初始脏标记为false
-                                                ));
-            _prune_if_needed();
-        }
+        _insert(key, value_type(value), _expire_at(m_default_ttl));
     }
 
     /**
-     * @brief 插入键值对（移动版本）
+     * @brief 插入键值对（移动版本），使用默认存活时间
      * @param key 键
      * @param value 值（右值引用）
      */
     void insert(const key_type& key, value_type&& value) {
         UniqueGuard lock(m_mutex);
-        _batch_update_dirty_nodes();
-        auto it = m_cache.find(key);
-        if (it != m_cache.end()) {
-            it->second.second.first = std::move(value);
-            it->second.second.second.store(false, std::memory_order_relaxed);
-            m_lru_list.splice(m_lru_list.begin(), m_lru_list, it->second.first);
-        } else {
-            m_lru_list.emplace_front(key);
-            m_cache.emplace(
-              key, std::make_pair(m_lru_list.begin(), std::make_pair(std::move(value), false)));
-            _prune_if_needed();
-        }
+        _insert(key, std::move(value), _expire_at(m_default_ttl));
+    }
+
+    /**
+     * @brief 插入键值对，并指定该元素的存活时间
+     * @param key 键
+     * @param value 值
+     * @param ttl 存活时间，小于等于0表示永不过期
+     */
+    void insert(const key_type& key, const value_type& value, duration ttl) {
+        UniqueGuard lock(m_mutex);
+        _insert(key, value_type(value), _expire_at(ttl));
+    }
+
+    /**
+     * @brief 插入键值对（移动版本），并指定该元素的存活时间
+     * @param key 键
+     * @param value 值（右值引用）
+     * @param ttl 存活时间，小于等于0表示永不过期
+     */
+    void insert(const key_type& key, value_type&& value, duration ttl) {
+        UniqueGuard lock(m_mutex);
+        _insert(key, std::move(value), _expire_at(ttl));
     }
 
     /**
@@ -117,9 +152,9 @@ public:
     value_type get(const key_type& key) {
         SharedGuard lock(m_mutex);
         auto it = m_cache.find(key);
-        if (it != m_cache.end()) {
-            it->second.second.second.store(true, std::memory_order_relaxed);
-            return it->second.second.first;
+        if (it != m_cache.end() && !_expired(it->second.second)) {
+            it->second.second.dirty.store(true, std::memory_order_relaxed);
+            return it->second.second.value;
         }
         return value_type{};
     }
@@ -133,9 +168,9 @@ public:
     bool tryGet(const key_type& key, value_type& value) {
         SharedGuard lock(m_mutex);
         auto it = m_cache.find(key);
-        if (it != m_cache.end()) {
-            it->second.second.second.store(true, std::memory_order_relaxed);
-            value = it->second.second.first;
+        if (it != m_cache.end() && !_expired(it->second.second)) {
+            it->second.second.dirty.store(true, std::memory_order_relaxed);
+            value = it->second.second.value;
             return true;
         }
         return false;
@@ -144,11 +179,12 @@ public:
     /**
      * @brief 检查是否包含指定键
      * @param key 键
-     * @return 存在返回true，否则返回false
+     * @return 存在且未过期返回true，否则返回false
      */
     bool contains(const key_type& key) {
         SharedGuard lock(m_mutex);
-        return m_cache.find(key) != m_cache.end();
+        auto it = m_cache.find(key);
+        return it != m_cache.end() && !_expired(it->second.second);
     }
 
     /**
@@ -160,8 +196,7 @@ public:
         UniqueGuard lock(m_mutex);
         auto it = m_cache.find(key);
         if (it != m_cache.end()) {
-            m_lru_list.erase(it->second.first);
-            m_cache.erase(it);
+            _erase(it);
             return true;
         }
         return false;
@@ -174,11 +209,22 @@ public:
         UniqueGuard lock(m_mutex);
         m_cache.clear();
         m_lru_list.clear();
+        m_expires.clear();
+        m_weight = 0;
+    }
+
+    /**
+     * @brief 立即清理所有已过期的元素
+     * @return 清理的元素数量
+     */
+    size_type removeExpired() {
+        UniqueGuard lock(m_mutex);
+        return _remove_expired();
     }
 
     /**
      * @brief 获取缓存当前大小
-     * @return 当前缓存元素数量
+     * @return 当前缓存元素数量（可能包含尚未清理的过期元素）
      */
     size_type size() const {
         SharedGuard lock(m_mutex);
@@ -203,6 +249,15 @@ public:
         return m_capacity;
     }
 
+    /**
+     * @brief 获取当前所有元素的权重之和，未设置权重函数时等于元素数量
+     * @return 总权重
+     */
+    size_type weight() const {
+        SharedGuard lock(m_mutex);
+        return m_weight;
+    }
+
     /**
      * @brief 获取缓存溢出容量
      * @return 缓存溢出容量
@@ -232,17 +287,117 @@ public:
         _prune_if_needed();
     }
 
+    /**
+     * @brief 设置权重函数，已有元素的权重随之重新计算
+     * @details 设置后容量与溢出容量均以权重之和计量；权重超过容量的单个元素插入后会被立即淘汰
+     * @param weigher 权重函数，为空时恢复按元素个数计量
+     */
+    void setWeigher(Weigher weigher) {
+        UniqueGuard lock(m_mutex);
+        m_weigher = std::move(weigher);
+        m_weight = 0;
+        for (auto& item : m_cache) {
+            CacheValue& entry = item.second.second;
+            entry.weight = _weigh(item.first, entry.value);
+            m_weight += entry.weight;
+        }
+        _prune_if_needed();
+    }
+
+    /**
+     * @brief 设置默认存活时间，仅对之后未指定存活时间插入的元素生效
+     * @param ttl 存活时间，小于等于0表示永不过期（默认）
+     */
+    void setDefaultTTL(duration ttl) {
+        UniqueGuard lock(m_mutex);
+        m_default_ttl = ttl;
+    }
+
+    /**
+     * @brief 获取默认存活时间
+     * @return 默认存活时间，小于等于0表示永不过期
+     */
+    duration defaultTTL() const {
+        SharedGuard lock(m_mutex);
+        return m_default_ttl;
+    }
+
 private:
-    // 如果缓存已满，移除最久未使用的项
-    size_t _prune_if_needed() {
-        size_t maxAllowed = m_capacity + m_overflow;
-        if (m_capacity == 0 || m_cache.size() <= maxAllowed) {
+    void _insert(const key_type& key, value_type&& value, time_point expire_at) {
+        _batch_update_dirty_nodes();
+        auto it = m_cache.find(key);
+        if (it != m_cache.end()) {
+            CacheValue& entry = it->second.second;
+            entry.value = std::move(value);
+            entry.dirty.store(false, std::memory_order_relaxed);
+            m_lru_list.splice(m_lru_list.begin(), m_lru_list, it->second.first);
+        } else {
+            m_lru_list.emplace_front(key);
+            it = m_cache
+                   .emplace(key, std::make_pair(m_lru_list.begin(), CacheValue(std::move(value))))
+                   .first;
+        }
+
+        CacheValue& entry = it->second.second;
+        m_weight -= entry.weight;
+        entry.weight = _weigh(key, entry.value);
+        m_weight += entry.weight;
+
+        if (entry.expire_at != time_point::max()) {
+            m_expires.erase(entry.expire_iter);
+        }
+        entry.expire_at = expire_at;
+        if (expire_at != time_point::max()) {
+            entry.expire_iter = m_expires.emplace(expire_at, key);
+        }
+        _prune_if_needed();
+    }
+
+    size_type _weigh(const key_type& key, const value_type& value) const {
+        return m_weigher ? m_weigher(key, value) : 1;
+    }
+
+    static time_point _expire_at(duration ttl) {
+        return ttl.count() > 0 ? clock_type::now() + ttl : time_point::max();
+    }
+
+    static bool _expired(const CacheValue& entry) {
+        return entry.expire_at != time_point::max() && entry.expire_at <= clock_type::now();
+    }
+
+    void _erase(typename CacheMap::iterator it) {
+        CacheValue& entry = it->second.second;
+        if (entry.expire_at != time_point::max()) {
+            m_expires.erase(entry.expire_iter);
+        }
+        m_weight -= entry.weight;
+        m_lru_list.erase(it->second.first);
+        m_cache.erase(it);
+    }
+
+    // 按过期时间顺序批量清理已过期的项
+    size_t _remove_expired() {
+        if (m_expires.empty()) {
             return 0;
         }
         size_t count = 0;
-        while (m_cache.size() > m_capacity) {
-            m_cache.erase(m_lru_list.back());
-            m_lru_list.pop_back();
+        time_point now = clock_type::now();
+        while (!m_expires.empty() && m_expires.begin()->first <= now) {
+            _erase(m_cache.find(m_expires.begin()->second));
+            ++count;
+        }
+        return count;
+    }
+
+    // 先清理过期项，如果缓存仍已满，移除最久未使用的项
+    size_t _prune_if_needed() {
+        size_t count = _remove_expired();
+        size_t maxAllowed = m_capacity + m_overflow;
+        if (m_capacity == 0 || m_weight <= maxAllowed) {
+            return count;
+        }
+        while (m_weight > m_capacity && !m_lru_list.empty()) {
+            _erase(m_cache.find(m_lru_list.back()));
             ++count;
         }
         return count;
@@ -262,7 +417,7 @@ private:
                 continue;
             }
 
-            auto& dirty_flag = cache_it->second.second.second;
+            auto& dirty_flag = cache_it->second.second.dirty;
             // 修复点2：原子加载判断，避免未初始化访问
             if (dirty_flag.load(std::memory_order_relaxed)) {
                 latest_dirty_it = it;
@@ -281,7 +436,7 @@ private:
             auto cache_it = m_cache.find(key);
             if (cache_it != m_cache.end()) {
                 // 清除脏标记
-                cache_it->second.second.second.store(false, std::memory_order_relaxed);
+                cache_it->second.second.dirty.store(false, std::memory_order_relaxed);
                 // 移动节点到链表头部（splice仅支持正向迭代器）
                 m_lru_list.splice(m_lru_list.begin(), m_lru_list, forward_it);
             }
@@ -291,8 +446,12 @@ private:
 private:
     size_type m_capacity;
     size_type m_overflow;
+    size_type m_weight = 0;     // 当前总权重
+    duration m_default_ttl{0};  // 默认存活时间，0表示永不过期
+    Weigher m_weigher;
     LruList m_lru_list;
     CacheMap m_cache;
+    ExpireMap m_expires;  // 按过期时间排序的索引，仅包含会过期的项
     mutable lock_type m_mutex;
 };
 
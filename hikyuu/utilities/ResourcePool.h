@@ -14,10 +14,14 @@
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include <deque>
 #include <chrono>
+#include <functional>
+#include <type_traits>
 #include <unordered_set>
 #include "Parameter.h"
 #include "Log.h"
+#include "thread/ThreadPoolStats.h"
 
 namespace hku {
 
@@ -49,8 +53,39 @@ public:
     virtual ~CreateResourceException() {}
 };
 
+/**
+ * 资源池运行统计快照
+ */
+struct ResourcePoolStats {
+    size_t count = 0;                ///< 当前活动的资源数
+    size_t idle = 0;                 ///< 当前空闲的资源数
+    uint64_t created = 0;            ///< 累计创建的资源数（含预热）
+    uint64_t create_failed = 0;      ///< 累计创建失败次数
+    uint64_t timeouts = 0;           ///< 累计等待超时次数
+    uint64_t evicted = 0;            ///< 累计因空闲超时被释放的资源数
+    uint64_t validation_failed = 0;  ///< 累计健康检查失败被释放的资源数
+    LatencyHistogram wait_time;      ///< 成功获取资源的等待时间（含新建资源耗时）
+};
+
+namespace detail {
+
+template <typename T, typename = void>
+struct has_ping : std::false_type {};
+
+template <typename T>
+struct has_ping<T, std::void_t<decltype(std::declval<T &>().ping())>> : std::true_type {};
+
+}  // namespace detail
+
 /**
  * 通用共享资源池
+ * @details
+ * 可选的后台维护任务（startMaintenance）定期执行 maintain：
+ * - 预热：空闲资源不足 minIdleSize 时预先创建，避免启动后首批请求承担资源创建开销；
+ * - 空闲淘汰：释放空闲时间超过 maxIdleTime 的资源，但保留至少 minIdleSize 个；
+ * - 健康检查：对超过 validateInterval 未检查的空闲资源调用检查函数，释放检查失败的资源。
+ *   资源类型具有 ping() 方法（如 DBConnectBase）时默认以 ping() 作为检查函数。
+ * 空闲资源按后进先出复用，使长期用不到的资源能够因空闲超时被释放。
  * @ingroup Utilities
  */
 template <typename ResourceType>
@@ -60,6 +95,11 @@ public:
     ResourcePool(const ResourcePool &) = delete;
     ResourcePool &operator=(const ResourcePool &) = delete;
 
+    typedef std::chrono::steady_clock clock_type;
+
+    /** 资源健康检查函数，返回 false 表示资源已失效 */
+    typedef std::function<bool(ResourceType &)> Validator;
+
     /**
      * 构造函数
      * @param param 连接参数
@@ -67,12 +107,16 @@ public:
      * @param maxIdleNum 运行的最大空闲资源数，为 0 表示用完即刻释放，无缓存
      */
     explicit ResourcePool(const Parameter &param, size_t maxPoolSize = 0, size_t maxIdleNum = 100)
-    : m_maxPoolSize(maxPoolSize), m_maxIdelSize(maxIdleNum), m_count(0), m_param(param) {}
+    : m_maxPoolSize(maxPoolSize), m_maxIdelSize(maxIdleNum), m_count(0), m_param(param) {
+        m_validator = _defaultValidator(detail::has_ping<ResourceType>());
+    }
 
     /**
      * 析构函数，释放所有缓存的资源
      */
     virtual ~ResourcePool() {
+        stopMaintenance();
+
         std::unique_lock<std::mutex> lock(m_mutex);
 
         // 将所有已分配资源的 closer 和 pool 解绑
@@ -82,8 +126,8 @@ public:
 
         // 删除所有空闲资源
         while (!m_resourceList.empty()) {
-            ResourceType *p = m_resourceList.front();
-            m_resourceList.pop();
+            ResourceType *p = m_resourceList.back().resource;
+            m_resourceList.pop_back();
             if (p) {
                 delete p;
             }
@@ -112,6 +156,168 @@ public:
         m_maxIdelSize = num;
     }
 
+    /** 获取维护任务保持的最小空闲资源数 */
+    size_t minIdleSize() const {
+        return m_minIdleSize;
+    }
+
+    /** 设置维护任务保持的最小空闲资源数（预热数量），不超过最大空闲资源数 */
+    void minIdleSize(size_t num) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_minIdleSize = num;
+    }
+
+    /** 获取空闲资源的最大空闲时间 */
+    std::chrono::milliseconds maxIdleTime() const {
+        return m_maxIdleTime;
+    }
+
+    /** 设置空闲资源的最大空闲时间，超时后由维护任务释放，为 0 表示不释放 */
+    void maxIdleTime(std::chrono::milliseconds ms) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_maxIdleTime = ms;
+    }
+
+    /** 获取空闲资源的健康检查间隔 */
+    std::chrono::milliseconds validateInterval() const {
+        return m_validateInterval;
+    }
+
+    /** 设置空闲资源的健康检查间隔，为 0 表示不检查 */
+    void validateInterval(std::chrono::milliseconds ms) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_validateInterval = ms;
+    }
+
+    /** 设置健康检查函数，为空时不检查 */
+    void setValidator(Validator validator) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_validator = std::move(validator);
+    }
+
+    /**
+     * 启动后台维护任务，启动时立即执行一次 maintain（即预热）
+     * @param interval 维护间隔
+     */
+    void startMaintenance(std::chrono::milliseconds interval = std::chrono::milliseconds(1000)) {
+        stopMaintenance();
+        std::lock_guard<std::mutex> lock(m_maintainMutex);
+        m_maintainStop = false;
+        m_maintainThread = std::thread([this, interval] {
+            std::unique_lock<std::mutex> lock(m_maintainMutex);
+            while (!m_maintainStop) {
+                lock.unlock();
+                try {
+                    maintain();
+                } catch (const std::exception &e) {
+                    HKU_ERROR("ResourcePool maintenance failed! {}", e.what());
+                } catch (...) {
+                    HKU_ERROR("ResourcePool maintenance failed! Unknown error!");
+                }
+                lock.lock();
+                m_maintainCond.wait_for(lock, interval, [this] { return m_maintainStop; });
+            }
+        });
+    }
+
+    /** 停止后台维护任务 */
+    void stopMaintenance() {
+        {
+            std::lock_guard<std::mutex> lock(m_maintainMutex);
+            m_maintainStop = true;
+        }
+        m_maintainCond.notify_all();
+        if (m_maintainThread.joinable()) {
+            m_maintainThread.join();
+        }
+    }
+
+    /**
+     * 执行一次维护：释放空闲超时的资源，检查空闲资源的健康状态，补足最小空闲资源
+     * @note 通常由后台维护任务调用，也可在未启动维护任务时手工调用
+     */
+    void maintain() {
+        auto now = clock_type::now();
+        std::vector<ResourceType *> evicted;
+        std::vector<IdleResource> checking;
+        Validator validator;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // 队首为空闲最久的资源
+            if (m_maxIdleTime.count() > 0) {
+                while (m_resourceList.size() > m_minIdleSize &&
+                       now - m_resourceList.front().idle_since >= m_maxIdleTime) {
+                    evicted.push_back(m_resourceList.front().resource);
+                    m_resourceList.pop_front();
+                }
+                m_count -= evicted.size();
+                m_stats.evicted += evicted.size();
+            }
+
+            // 待检查的资源暂时移出空闲列表，以免检查期间持有锁
+            if (m_validator && m_validateInterval.count() > 0) {
+                validator = m_validator;
+                auto iter = m_resourceList.begin();
+                while (iter != m_resourceList.end()) {
+                    if (now - iter->last_check >= m_validateInterval) {
+                        checking.push_back(*iter);
+                        iter = m_resourceList.erase(iter);
+                    } else {
+                        ++iter;
+                    }
+                }
+            }
+        }
+
+        for (ResourceType *p : evicted) {
+            delete p;
+        }
+
+        if (!checking.empty()) {
+            std::vector<IdleResource> valid;
+            size_t failed = 0;
+            for (auto &item : checking) {
+                bool ok = false;
+                try {
+                    ok = validator(*item.resource);
+                } catch (...) {
+                    ok = false;
+                }
+                if (ok) {
+                    item.last_check = clock_type::now();
+                    valid.push_back(item);
+                } else {
+                    delete item.resource;
+                    failed++;
+                }
+            }
+
+            std::vector<ResourceType *> extra;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_count -= failed;
+                m_stats.validation_failed += failed;
+                // 检查前已空闲较久，放回队首；检查期间已有其他资源归还时，超出最大空闲数的部分释放
+                for (auto iter = valid.rbegin(); iter != valid.rend(); ++iter) {
+                    if (m_resourceList.size() < m_maxIdelSize) {
+                        m_resourceList.push_front(*iter);
+                    } else {
+                        extra.push_back(iter->resource);
+                        m_count--;
+                    }
+                }
+                if (extra.size() < valid.size()) {
+                    m_cond.notify_all();
+                }
+            }
+            for (ResourceType *p : extra) {
+                delete p;
+            }
+        }
+
+        _fillMinIdle();
+    }
+
     /** 资源实例指针类型 */
     typedef std::shared_ptr<ResourceType> ResourcePtr;
 
@@ -120,6 +326,7 @@ public:
      * @exception CreateResourceException 新资源创建可能抛出异常
      */
     ResourcePtr get() {
+        auto start = clock_type::now();
         std::lock_guard<std::mutex> lock(m_mutex);
         ResourcePtr result;
         ResourceType *p = nullptr;
@@ -127,24 +334,18 @@ public:
             if (m_maxPoolSize > 0 && m_count >= m_maxPoolSize) {
                 return result;
             }
-            try {
-                p = new ResourceType(m_param);
-            } catch (const std::exception &e) {
-                HKU_THROW_EXCEPTION(CreateResourceException, "Failed create a new Resource! {}",
-                                    e.what());
-            } catch (...) {
-                HKU_THROW_EXCEPTION(CreateResourceException,
-                                    "Failed create a new Resource! Unknown error!");
-            }
+            p = _createNoLock();
             m_count++;
             result = ResourcePtr(p, ResourceCloser(this));
             m_closer_set.insert(std::get_deleter<ResourceCloser>(result));
+            _recordWaitNoLock(start);
             return result;
         }
-        p = m_resourceList.front();
-        m_resourceList.pop();
+        p = m_resourceList.back().resource;
+        m_resourceList.pop_back();
         result = ResourcePtr(p, ResourceCloser(this));
         m_closer_set.insert(std::get_deleter<ResourceCloser>(result));
+        _recordWaitNoLock(start);
         return result;
     }
 
@@ -154,6 +355,7 @@ public:
      * @exception GetResourceTimeoutException, CreateResourceException
      */
     ResourcePtr getWaitFor(uint64_t ms_timeout) {  // NOSONAR
+        auto start = clock_type::now();
         std::unique_lock<std::mutex> lock(m_mutex);
         ResourcePtr result;
         ResourceType *p = nullptr;
@@ -161,37 +363,29 @@ public:
             if (m_maxPoolSize > 0 && m_count >= m_maxPoolSize) {
                 // HKU_TRACE("超出最大资源数，等待空闲资源");
                 if (ms_timeout > 0) {
-                    if (m_cond.wait_for(lock,
-                                        std::chrono::duration<uint64_t, std::milli>(ms_timeout),
-                                        [&] { return !m_resourceList.empty(); })) {
-                        HKU_CHECK_THROW(!m_resourceList.empty(), GetResourceTimeoutException,
-                                        "Failed get resource!");
-                    } else {
+                    if (!m_cond.wait_for(lock,
+                                         std::chrono::duration<uint64_t, std::milli>(ms_timeout),
+                                         [&] { return !m_resourceList.empty(); })) {
+                        m_stats.timeouts++;
                         HKU_THROW_EXCEPTION(GetResourceTimeoutException, "Failed get resource!");
                     }
                 } else {
                     m_cond.wait(lock, [this] { return !m_resourceList.empty(); });
                 }
             } else {
-                try {
-                    p = new ResourceType(m_param);
-                } catch (const std::exception &e) {
-                    HKU_THROW_EXCEPTION(CreateResourceException, "Failed create a new Resource! {}",
-                                        e.what());
-                } catch (...) {
-                    HKU_THROW_EXCEPTION(CreateResourceException,
-                                        "Failed create a new Resource! Unknown error!");
-                }
+                p = _createNoLock();
                 m_count++;
                 result = ResourcePtr(p, ResourceCloser(this));
                 m_closer_set.insert(std::get_deleter<ResourceCloser>(result));
+                _recordWaitNoLock(start);
                 return result;
             }
         }
-        p = m_resourceList.front();
-        m_resourceList.pop();
+        p = m_resourceList.back().resource;
+        m_resourceList.pop_back();
         result = ResourcePtr(p, ResourceCloser(this));
         m_closer_set.insert(std::get_deleter<ResourceCloser>(result));
+        _recordWaitNoLock(start);
         return result;
     }
 
@@ -219,11 +413,91 @@ public:
         _releaseIdleResourceNoLock();
     }
 
+    /** 获取运行统计快照 */
+    ResourcePoolStats stats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ResourcePoolStats ret = m_stats;
+        ret.count = m_count;
+        ret.idle = m_resourceList.size();
+        return ret;
+    }
+
 private:
+    struct IdleResource {
+        ResourceType *resource;
+        clock_type::time_point idle_since;  // 开始空闲的时间
+        clock_type::time_point last_check;  // 最近一次健康检查（或归还）的时间
+    };
+
+    static Validator _defaultValidator(std::true_type) {
+        return [](ResourceType &r) { return static_cast<bool>(r.ping()); };
+    }
+
+    static Validator _defaultValidator(std::false_type) {
+        return Validator();
+    }
+
+    ResourceType *_createNoLock() {
+        ResourceType *p = nullptr;
+        try {
+            p = new ResourceType(m_param);
+        } catch (const std::exception &e) {
+            m_stats.create_failed++;
+            HKU_THROW_EXCEPTION(CreateResourceException, "Failed create a new Resource! {}",
+                                e.what());
+        } catch (...) {
+            m_stats.create_failed++;
+            HKU_THROW_EXCEPTION(CreateResourceException,
+                                "Failed create a new Resource! Unknown error!");
+        }
+        m_stats.created++;
+        return p;
+    }
+
+    void _recordWaitNoLock(clock_type::time_point start) {
+        m_stats.wait_time.record(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count());
+    }
+
+    // 补足最小空闲资源，资源在锁外创建
+    void _fillMinIdle() {
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                size_t min_idle = std::min(m_minIdleSize, m_maxIdelSize);
+                if (m_resourceList.size() >= min_idle ||
+                    (m_maxPoolSize > 0 && m_count >= m_maxPoolSize)) {
+                    return;
+                }
+                m_count++;
+            }
+
+            ResourceType *p = nullptr;
+            try {
+                p = new ResourceType(m_param);
+            } catch (const std::exception &e) {
+                HKU_WARN("Failed create a new Resource for warm-up! {}", e.what());
+            } catch (...) {
+                HKU_WARN("Failed create a new Resource for warm-up! Unknown error!");
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!p) {
+                m_count--;
+                m_stats.create_failed++;
+                return;
+            }
+            m_stats.created++;
+            auto now = clock_type::now();
+            m_resourceList.push_back(IdleResource{p, now, now});
+            m_cond.notify_all();
+        }
+    }
+
     void _releaseIdleResourceNoLock() {
         while (!m_resourceList.empty()) {
-            ResourceType *p = m_resourceList.front();
-            m_resourceList.pop();
+            ResourceType *p = m_resourceList.back().resource;
+            m_resourceList.pop_back();
             m_count--;
             if (p) {
                 delete p;
@@ -236,9 +510,20 @@ private:
     size_t m_maxIdelSize;  // 允许的最大空闲资源数
     size_t m_count;        // 当前活动的资源数
     Parameter m_param;
-    std::mutex m_mutex;
+    mutable std::mutex m_mutex;
     std::condition_variable m_cond;
-    std::queue<ResourceType *> m_resourceList;
+    std::deque<IdleResource> m_resourceList;  // 空闲资源，队尾为最近归还的资源
+
+    size_t m_minIdleSize = 0;                             // 维护任务保持的最小空闲资源数
+    std::chrono::milliseconds m_maxIdleTime{0};           // 最大空闲时间
+    std::chrono::milliseconds m_validateInterval{30000};  // 健康检查间隔
+    Validator m_validator;                                // 健康检查函数
+    ResourcePoolStats m_stats;
+
+    std::thread m_maintainThread;  // 后台维护线程
+    std::mutex m_maintainMutex;
+    std::condition_variable m_maintainCond;
+    bool m_maintainStop = false;
 
     class ResourceCloser {
     public:
@@ -272,7 +557,8 @@ private:
         std::unique_lock<std::mutex> lock(m_mutex);
         if (p) {
             if (m_resourceList.size() < m_maxIdelSize) {
-                m_resourceList.push(p);
+                auto now = clock_type::now();
+                m_resourceList.push_back(IdleResource{p, now, now});
                 m_cond.notify_all();
             } else {
                 delete p;
@@ -0,0 +1,328 @@
+/*
+ * ResourceShardedPool.h
+ *
+ *  Copyright (c) 2026, hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+#pragma once
+#ifndef HKU_UTILS_RESOURCE_SHARDED_POOL_H
+#define HKU_UTILS_RESOURCE_SHARDED_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ResourcePool.h"
+
+namespace hku {
+
+/**
+ * 分片的通用共享资源池，接口与 ResourcePool 一致，适用于高频获取/归还资源的场景
+ * @details
+ * - 空闲资源分散存放在多个分片的栈中，线程优先从所属分片获取和归还，分片为空时再依次
+ *   查找其他分片，不同线程的获取与归还通常落在不同的锁上；
+ * - 资源数与空闲数使用原子计数，仅在达到最大资源数需要等待时才使用全局锁与条件变量；
+ * - 已分配资源的 closer 持有资源池共享状态的 shared_ptr，不再记录至集合中，
+ *   资源池先于资源析构时，资源归还时直接删除。
+ * @ingroup Utilities
+ */
+template <typename ResourceType>
+class ResourceShardedPool {
+public:
+    ResourceShardedPool() = delete;
+    ResourceShardedPool(const ResourceShardedPool &) = delete;
+    ResourceShardedPool &operator=(const ResourceShardedPool &) = delete;
+
+    /**
+     * 构造函数
+     * @param param 连接参数
+     * @param maxPoolSize 允许的最大共享资源数，为 0 表示不限制
+     * @param maxIdleNum 运行的最大空闲资源数，为 0 表示用完即刻释放，无缓存
+     * @param shardNum 分片数，为 0 时按硬件线程数自动设置
+     */
+    explicit ResourceShardedPool(const Parameter &param, size_t maxPoolSize = 0,
+                                 size_t maxIdleNum = 100, size_t shardNum = 0)
+    : m_core(std::make_shared<Core>(param, maxPoolSize, maxIdleNum, shardNum)) {}
+
+    /**
+     * 析构函数，释放所有缓存的资源，尚在使用中的资源在归还时删除
+     */
+    virtual ~ResourceShardedPool() {
+        m_core->close();
+    }
+
+    /** 获取当前允许的最大资源数 */
+    size_t maxPoolSize() const {
+        return m_core->m_maxPoolSize.load(std::memory_order_relaxed);
+    }
+
+    /** 获取当前允许的最大空闲资源数 */
+    size_t maxIdleSize() const {
+        return m_core->m_maxIdleSize.load(std::memory_order_relaxed);
+    }
+
+    /** 设置最大资源数 */
+    void maxPoolSize(size_t num) {
+        m_core->m_maxPoolSize.store(num);
+        m_core->notifyWaiters();
+    }
+
+    /** 设置允许的最大空闲资源数 */
+    void maxIdleSize(size_t num) {
+        m_core->m_maxIdleSize.store(num, std::memory_order_relaxed);
+    }
+
+    /** 分片数 */
+    size_t shardNum() const {
+        return m_core->m_shardNum;
+    }
+
+    /** 资源实例指针类型 */
+    typedef std::shared_ptr<ResourceType> ResourcePtr;
+
+    /**
+     * 获取可用资源，如超出允许的最大资源数将返回空指针
+     * @exception CreateResourceException 新资源创建可能抛出异常
+     */
+    ResourcePtr get() {
+        ResourceType *p = m_core->popIdle();
+        if (!p) {
+            HKU_IF_RETURN(!m_core->reserve(), ResourcePtr());
+            p = m_core->create();
+        }
+        return ResourcePtr(p, ResourceCloser(m_core));
+    }
+
+    /**
+     * 在指定的超时时间内获取可用资源
+     * @param ms_timeout 超时时间，单位毫秒，为 0 时一直等待
+     * @exception GetResourceTimeoutException, CreateResourceException
+     */
+    ResourcePtr getWaitFor(uint64_t ms_timeout) {
+        ResourcePtr result = get();
+        if (result) {
+            return result;
+        }
+
+        Core &core = *m_core;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms_timeout);
+        std::unique_lock<std::mutex> lock(core.m_waitMutex);
+        core.m_waiters.fetch_add(1);
+        ResourceType *p = nullptr;
+        bool create = false;
+        auto acquired = [&] {
+            p = core.popIdle();
+            if (!p) {
+                create = core.reserve();
+            }
+            return p != nullptr || create;
+        };
+        bool ok = true;
+        if (ms_timeout > 0) {
+            ok = core.m_cond.wait_until(lock, deadline, acquired);
+        } else {
+            core.m_cond.wait(lock, acquired);
+        }
+        core.m_waiters.fetch_sub(1);
+        lock.unlock();
+
+        HKU_CHECK_THROW(ok, GetResourceTimeoutException, "Failed get resource!");
+        if (create) {
+            p = core.create();
+        }
+        return ResourcePtr(p, ResourceCloser(m_core));
+    }
+
+    /**
+     * 获取可用资源，如超出允许的最大资源数，将阻塞等待直到获得空闲资源
+     * @exception CreateResourceException 新资源创建可能抛出异常
+     */
+    ResourcePtr getAndWait() {
+        return getWaitFor(0);
+    }
+
+    /** 当前活动的资源数, 即全部资源数（含空闲及被使用的资源） */
+    size_t count() const {
+        return m_core->m_count.load(std::memory_order_relaxed);
+    }
+
+    /** 当前空闲的资源数 */
+    size_t idleCount() const {
+        return m_core->m_idle.load(std::memory_order_relaxed);
+    }
+
+    /** 释放当前所有的空闲资源 */
+    void releaseIdleResource() {
+        m_core->releaseIdle();
+    }
+
+private:
+    // 资源池共享状态，由资源池及所有已分配资源的 closer 共同持有
+    struct Core {
+        // 独占缓存行，避免相邻分片的锁伪共享
+        struct alignas(64) Shard {
+            std::mutex mutex;
+            std::vector<ResourceType *> idle;  // 空闲资源栈，后进先出以复用较"热"的资源
+        };
+
+        Core(const Parameter &param, size_t maxPoolSize, size_t maxIdleSize, size_t shardNum)
+        : m_param(param), m_maxPoolSize(maxPoolSize), m_maxIdleSize(maxIdleSize) {
+            if (shardNum == 0) {
+                shardNum = std::thread::hardware_concurrency();
+            }
+            m_shardNum = 1;
+            while (m_shardNum < shardNum && m_shardNum < 64) {
+                m_shardNum <<= 1;
+            }
+            m_shards.reset(new Shard[m_shardNum]);
+        }
+
+        ~Core() {
+            releaseIdle();
+        }
+
+        // 线程首次使用时按顺序分配所属分片，使各线程均匀分布
+        Shard &homeShard() {
+            static std::atomic<size_t> s_next{0};
+            static thread_local size_t home = s_next.fetch_add(1, std::memory_order_relaxed);
+            return m_shards[home & (m_shardNum - 1)];
+        }
+
+        ResourceType *popIdle() {
+            if (m_idle.load() == 0) {
+                return nullptr;
+            }
+            size_t start = &homeShard() - m_shards.get();
+            for (size_t i = 0; i < m_shardNum; i++) {
+                Shard &shard = m_shards[(start + i) & (m_shardNum - 1)];
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                if (!shard.idle.empty()) {
+                    ResourceType *p = shard.idle.back();
+                    shard.idle.pop_back();
+                    m_idle.fetch_sub(1);
+                    return p;
+                }
+            }
+            return nullptr;
+        }
+
+        // 占用一个新资源名额，超出最大资源数时返回 false
+        bool reserve() {
+            size_t count = m_count.load(std::memory_order_relaxed);
+            do {
+                size_t max_size = m_maxPoolSize.load(std::memory_order_relaxed);
+                if (max_size > 0 && count >= max_size) {
+                    return false;
+                }
+            } while (!m_count.compare_exchange_weak(count, count + 1));
+            return true;
+        }
+
+        // 创建新资源，调用前须已通过 reserve 占用名额
+        ResourceType *create() {
+            try {
+                return new ResourceType(m_param);
+            } catch (const std::exception &e) {
+                giveUp();
+                HKU_THROW_EXCEPTION(CreateResourceException, "Failed create a new Resource! {}",
+                                    e.what());
+            } catch (...) {
+                giveUp();
+                HKU_THROW_EXCEPTION(CreateResourceException,
+                                    "Failed create a new Resource! Unknown error!");
+            }
+        }
+
+        // 归还资源，超出最大空闲数或资源池已关闭时删除
+        void giveBack(ResourceType *p) {
+            if (!m_closed.load()) {
+                if (m_idle.fetch_add(1) < m_maxIdleSize.load(std::memory_order_relaxed)) {
+                    Shard &shard = homeShard();
+                    {
+                        std::lock_guard<std::mutex> lock(shard.mutex);
+                        shard.idle.push_back(p);
+                    }
+                    notifyWaiters();
+                    return;
+                }
+                m_idle.fetch_sub(1);
+            }
+            delete p;
+            giveUp();
+        }
+
+        // 释放一个资源名额
+        void giveUp() {
+            m_count.fetch_sub(1);
+            notifyWaiters();
+        }
+
+        void notifyWaiters() {
+            if (m_waiters.load() > 0) {
+                // 加锁保证等待者不会在检查条件后、进入等待前错过通知
+                { std::lock_guard<std::mutex> lock(m_waitMutex); }
+                m_cond.notify_all();
+            }
+        }
+
+        void releaseIdle() {
+            for (size_t i = 0; i < m_shardNum; i++) {
+                std::vector<ResourceType *> idle;
+                {
+                    std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+                    idle.swap(m_shards[i].idle);
+                }
+                m_idle.fetch_sub(idle.size());
+                m_count.fetch_sub(idle.size());
+                for (ResourceType *p : idle) {
+                    delete p;
+                }
+            }
+            notifyWaiters();
+        }
+
+        void close() {
+            m_closed.store(true);
+            releaseIdle();
+        }
+
+        const Parameter m_param;
+        std::atomic<size_t> m_maxPoolSize;  // 允许的最大共享资源数
+        std::atomic<size_t> m_maxIdleSize;  // 允许的最大空闲资源数
+        std::atomic<size_t> m_count{0};     // 当前活动的资源数
+        std::atomic<size_t> m_idle{0};      // 当前空闲的资源数（含正在归还中的资源）
+        std::atomic<size_t> m_waiters{0};   // 等待空闲资源的线程数
+        std::atomic<bool> m_closed{false};  // 资源池是否已析构
+        size_t m_shardNum;
+        std::unique_ptr<Shard[]> m_shards;
+        std::mutex m_waitMutex;
+        std::condition_variable m_cond;
+    };
+
+    class ResourceCloser {
+    public:
+        explicit ResourceCloser(const std::shared_ptr<Core> &core) : m_core(core) {}
+
+        void operator()(ResourceType *conn) {  // NOSONAR
+            if (conn) {
+                m_core->giveBack(conn);
+            }
+        }
+
+    private:
+        std::shared_ptr<Core> m_core;
+    };
+
+private:
+    std::shared_ptr<Core> m_core;
+};
+
+}  // namespace hku
+
+#endif /* HKU_UTILS_RESOURCE_SHARDED_POOL_H */
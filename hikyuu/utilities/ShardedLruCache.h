@@ -0,0 +1,298 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <vector>
+#include "LruCache.h"
+
+namespace hku {
+
+/**
+ * @brief 缓存运行统计
+ */
+struct LruCacheStats {
+    size_t size = 0;       ///< 当前缓存元素数量
+    size_t capacity = 0;   ///< 容量，0表示无限制
+    uint64_t hits = 0;     ///< 命中次数
+    uint64_t misses = 0;   ///< 未命中次数
+    uint64_t inserts = 0;  ///< 插入（含更新）次数
+
+    /** 命中率，无访问时返回 0 */
+    double hitRate() const {
+        uint64_t total = hits + misses;
+        return total == 0 ? 0.0 : double(hits) / double(total);
+    }
+};
+
+/**
+ * @brief 分片并发 LRU 缓存
+ * @details
+ * 按键的哈希值将元素分散到 Shards 个相互独立的 LruCache 分片中，每个分片各自加锁，
+ * 不同分片上的读写互不阻塞。总容量按分片均分，淘汰在分片内按 LRU 进行，
+ * 因此为近似的全局 LRU。
+ * @tparam KeyType 键的类型，必须支持哈希和相等比较
+ * @tparam ValueType 值的类型，必须支持拷贝和移动操作
+ * @tparam Lock 分片锁类型，默认为 std::shared_mutex
+ * @tparam Shards 分片数量
+ * @tparam Hash 键的哈希函数
+ */
+template <typename KeyType, typename ValueType, class Lock = std::shared_mutex,
+          size_t Shards = 16, class Hash = std::hash<KeyType>>
+class ShardedLruCache final {
+    static_assert(Shards > 0, "Shards must be greater than 0!");
+
+public:
+    using key_type = KeyType;
+    using value_type = ValueType;
+    using size_type = size_t;
+    using shard_type = LruCache<KeyType, ValueType, Lock>;
+
+    /**
+     * @brief 构造函数
+     * @param capacity 全部分片的总容量，默认为1024，0表示无限制容量
+     * @param overflow 全部分片的总溢出容量，默认为64，按分片向上取整均分
+     * @param enable_stats 是否统计命中次数等运行信息
+     */
+    explicit ShardedLruCache(size_type capacity = 1024, size_type overflow = 64,
+                             bool enable_stats = false)
+    : m_capacity(capacity), m_overflow(overflow), m_enable_stats(enable_stats) {
+        _distribute();
+    }
+
+    /** 分片数量 */
+    static constexpr size_type shardCount() {
+        return Shards;
+    }
+
+    /**
+     * @brief 插入键值对
+     * @param key 键
+     * @param value 值
+     */
+    void insert(const key_type& key, const value_type& value) {
+        Shard& shard = _shard(key);
+        shard.cache.insert(key, value);
+        _count(shard.inserts);
+    }
+
+    /**
+     * @brief 插入键值对（移动版本）
+     * @param key 键
+     * @param value 值（右值引用）
+     */
+    void insert(const key_type& key, value_type&& value) {
+        Shard& shard = _shard(key);
+        shard.cache.insert(key, std::move(value));
+        _count(shard.inserts);
+    }
+
+    /**
+     * @brief 获取键对应的值
+     * @param key 键
+     * @return 存在则返回值，否则返回ValueType的默认构造值
+     */
+    value_type get(const key_type& key) {
+        value_type value{};
+        tryGet(key, value);
+        return value;
+    }
+
+    /**
+     * @brief 尝试获取键对应的值
+     * @param key 键
+     * @param value 用于接收值的引用参数
+     * @return 如果键存在返回true，否则返回false
+     */
+    bool tryGet(const key_type& key, value_type& value) {
+        Shard& shard = _shard(key);
+        bool found = shard.cache.tryGet(key, value);
+        _count(found ? shard.hits : shard.misses);
+        return found;
+    }
+
+    /**
+     * @brief 检查是否包含指定键
+     * @param key 键
+     * @return 存在返回true，否则返回false
+     */
+    bool contains(const key_type& key) {
+        return _shard(key).cache.contains(key);
+    }
+
+    /**
+     * @brief 删除指定键
+     * @param key 要删除的键
+     * @return 成功删除返回true，不存在返回false
+     */
+    bool remove(const key_type& key) {
+        return _shard(key).cache.remove(key);
+    }
+
+    /**
+     * @brief 清空缓存，不清除统计信息
+     */
+    void clear() {
+        for (auto& shard : m_shards) {
+            shard.cache.clear();
+        }
+    }
+
+    /**
+     * @brief 获取缓存当前大小（各分片大小之和，并发修改时为近似值）
+     * @return 当前缓存元素数量
+     */
+    size_type size() const {
+        size_type total = 0;
+        for (const auto& shard : m_shards) {
+            total += shard.cache.size();
+        }
+        return total;
+    }
+
+    /**
+     * @brief 检查缓存是否为空
+     * @return 空返回true，否则返回false
+     */
+    bool empty() const {
+        for (const auto& shard : m_shards) {
+            if (!shard.cache.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 获取缓存总容量
+     * @return 缓存容量
+     */
+    size_type capacity() const {
+        return m_capacity.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 获取缓存总溢出容量
+     * @return 缓存溢出容量
+     */
+    size_type overflow() const {
+        return m_overflow.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 设置缓存总容量，并重新分配至各分片
+     * @param capacity 新的容量，0表示不限制容量
+     */
+    void resize(size_type capacity) {
+        m_capacity.store(capacity, std::memory_order_relaxed);
+        _distribute();
+    }
+
+    /**
+     * @brief 设置缓存总溢出容量，并重新分配至各分片
+     * @param overflow 新的溢出容量
+     */
+    void setOverflow(size_type overflow) {
+        m_overflow.store(overflow, std::memory_order_relaxed);
+        _distribute();
+    }
+
+    /** 是否开启了运行统计 */
+    bool statsEnabled() const {
+        return m_enable_stats;
+    }
+
+    /**
+     * @brief 获取各分片的运行统计，未开启统计时计数均为0
+     */
+    std::vector<LruCacheStats> shardStats() const {
+        std::vector<LruCacheStats> ret(Shards);
+        for (size_t i = 0; i < Shards; i++) {
+            const Shard& shard = m_shards[i];
+            ret[i].size = shard.cache.size();
+            ret[i].capacity = shard.cache.capacity();
+            ret[i].hits = shard.hits.load(std::memory_order_relaxed);
+            ret[i].misses = shard.misses.load(std::memory_order_relaxed);
+            ret[i].inserts = shard.inserts.load(std::memory_order_relaxed);
+        }
+        return ret;
+    }
+
+    /**
+     * @brief 获取全部分片汇总的运行统计
+     */
+    LruCacheStats stats() const {
+        LruCacheStats ret;
+        for (const auto& one : shardStats()) {
+            ret.size += one.size;
+            ret.hits += one.hits;
+            ret.misses += one.misses;
+            ret.inserts += one.inserts;
+        }
+        ret.capacity = capacity();
+        return ret;
+    }
+
+    /** 清除运行统计 */
+    void resetStats() {
+        for (auto& shard : m_shards) {
+            shard.hits.store(0, std::memory_order_relaxed);
+            shard.misses.store(0, std::memory_order_relaxed);
+            shard.inserts.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    // 独占缓存行，避免不同分片的锁与计数器伪共享
+    struct alignas(64) Shard {
+        shard_type cache;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> inserts{0};
+    };
+
+    Shard& _shard(const key_type& key) {
+        // std::hash 对整数通常为恒等映射，先做乘法散列再取高位，避免连续键集中于少数分片
+        uint64_t h = uint64_t(m_hash(key)) * 0x9E3779B97F4A7C15ULL;
+        return m_shards[size_t(h >> 32) % Shards];
+    }
+
+    void _count(std::atomic<uint64_t>& counter) {
+        if (m_enable_stats) {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // 将总容量与溢出容量均分至各分片，余数分配给前面的分片
+    void _distribute() {
+        size_type capacity = m_capacity.load(std::memory_order_relaxed);
+        size_type overflow = m_overflow.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < Shards; i++) {
+            size_type shard_capacity = capacity / Shards + (i < capacity % Shards ? 1 : 0);
+            if (capacity != 0 && shard_capacity == 0) {
+                // 总容量小于分片数时，每个分片至少保留一个元素
+                shard_capacity = 1;
+            }
+            size_type shard_overflow = (overflow + Shards - 1) / Shards;
+            m_shards[i].cache.setOverflow(shard_overflow);
+            m_shards[i].cache.resize(shard_capacity);
+        }
+    }
+
+private:
+    std::atomic<size_type> m_capacity;  // 总容量
+    std::atomic<size_type> m_overflow;  // 总溢出容量
+    bool m_enable_stats;                // 是否统计运行信息
+    Hash m_hash;
+    std::array<Shard, Shards> m_shards;
+};
+
+}  // namespace hku
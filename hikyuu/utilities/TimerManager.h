@@ -13,6 +13,8 @@
 #include "hikyuu/utilities/datetime/Datetime.h"
 #include "hikyuu/utilities/Log.h"
 #include "thread/ThreadPool.h"
+#include "thread/ElasticThreadPool.h"
+#include "TimingWheel.h"
 #include "cppdef.h"
 
 namespace hku {
@@ -30,16 +32,24 @@ public:
     TimerManager& operator=(TimerManager&) = delete;
     TimerManager& operator=(TimerManager&&) = delete;
 
+    /** 定时任务调度方式 */
+    enum SchedulerType {
+        PRIORITY_QUEUE = 0,  ///< 优先队列，适合少量定时任务
+        TIMING_WHEEL = 1,    ///< 分层时间轮，插入/取消为 O(1)，精度 1 毫秒，适合大量定时任务
+    };
+
     /**
      * 构造函数
      * @param work_num 定时任务执行线程池线程数量
+     * @param scheduler 调度方式
      */
-    explicit TimerManager(size_t work_num = 1)
+    explicit TimerManager(size_t work_num = 1, SchedulerType scheduler = PRIORITY_QUEUE)
     : m_stop(true),
       m_current_timer_id(-1),
       m_work_num(work_num),
       m_tg(nullptr),
-      m_use_extend_tg(false) {
+      m_use_extend_tg(false),
+      m_scheduler(scheduler) {
         HKU_ASSERT(work_num >= 1);
         start();
     }
@@ -48,13 +58,36 @@ public:
      * 指定线程池方式构造，以便共享其他线程池
      * @note 请自行保证 tg 的生命周期在 TimerManager 存活期间始终有效
      * @param tg 指定任务组线程池
+     * @param scheduler 调度方式
      */
-    explicit TimerManager(ThreadPool* tg)
-    : m_stop(true), m_current_timer_id(-1), m_work_num(1), m_tg(tg), m_use_extend_tg(true) {
+    explicit TimerManager(ThreadPool* tg, SchedulerType scheduler = PRIORITY_QUEUE)
+    : m_stop(true),
+      m_current_timer_id(-1),
+      m_work_num(1),
+      m_tg(tg),
+      m_use_extend_tg(true),
+      m_scheduler(scheduler) {
         HKU_ASSERT(m_tg);
         start();
     }
 
+    /**
+     * 指定弹性线程池方式构造，执行线程数随定时任务负载伸缩
+     * @note 请自行保证 tg 的生命周期在 TimerManager 存活期间始终有效
+     * @param tg 指定弹性线程池
+     * @param scheduler 调度方式
+     */
+    explicit TimerManager(ElasticThreadPool* tg, SchedulerType scheduler = PRIORITY_QUEUE)
+    : m_stop(true),
+      m_current_timer_id(-1),
+      m_work_num(1),
+      m_elastic_tg(tg),
+      m_use_extend_tg(true),
+      m_scheduler(scheduler) {
+        HKU_ASSERT(m_elastic_tg);
+        start();
+    }
+
     /** 析构函数 */
     ~TimerManager() {
         stop();
@@ -75,7 +108,8 @@ public:
 
         std::priority_queue<IntervalS> new_queue;
         m_queue.swap(new_queue);
-        if (!m_tg) {
+        resetWheel();
+        if (!m_tg && !m_elastic_tg) {
             m_tg = new ThreadPool(m_work_num);
         }
 
@@ -135,7 +169,7 @@ public:
                 }
             }
 
-            m_queue.push(s);
+            pushInterval(s, now);
         }
 
         // 清除已无效的 timer
@@ -155,6 +189,7 @@ public:
             std::unique_lock<std::mutex> lock(m_mutex);
             std::priority_queue<IntervalS> queue;
             m_queue.swap(queue);
+            resetWheel();
             m_stop = true;
             lock.unlock();
             m_cond.notify_all();
@@ -182,6 +217,11 @@ public:
         return size() == 0;
     }
 
+    /** 调度方式 */
+    SchedulerType scheduler() const {
+        return m_scheduler;
+    }
+
     /** 返回当前停止状态 */
     bool stopped() const {
         return m_stop;
@@ -323,18 +363,62 @@ public:
     void removeTimer(int timerid) {
         std::unique_lock<std::mutex> lock(m_mutex);
         auto iter = m_timers.find(timerid);
-        if (iter != m_timers.end()) {
+        if (iter == m_timers.end()) {
+            return;
+        }
+
+        if (m_scheduler == TIMING_WHEEL) {
+            // 时间轮可直接取消，无需等到触发时再删除
+            if (iter->second->m_wheel_node) {
+                m_wheel.cancel(iter->second->m_wheel_node);
+            }
+            delete iter->second;
+            m_timers.erase(iter);
+        } else {
             iter->second->m_repeat_num = 0;
         }
     }
 
 private:
+    struct IntervalS {
+        Datetime m_time_point;  // 执行的精确时间点
+        int m_timer_id = -1;    // 对应的 Timer, 负数无效
+        bool operator<(const IntervalS& other) const {
+            return m_time_point > other.m_time_point;
+        }
+    };
+
+    class Timer {
+    public:
+        void operator()() {
+            m_func();
+        }
+
+        Datetime m_start_date = Datetime::min().startOfDay();  // 允许执行的起始日期（包含该日期）
+        Datetime m_end_date = Datetime::max().startOfDay();  // 允许执行的终止日期（包含该日期）
+        /*
+         * 注：如果 m_start_time < TimeDelta(0), 则 m_end_time 代表每日指定的运行时刻，此时忽略
+         * m_duration
+         */
+        TimeDelta m_start_time;  // 允许执行的当日起始时间（包含该时间）
+        TimeDelta m_end_time;    // 允许执行的当日结束时间（包含该时间）
+        TimeDelta m_duration;    // 延迟时长或间隔时长
+        int m_repeat_num = 1;    // 重复执行次数，max标识无限循环
+        std::function<void()> m_func;
+        TimingWheel<IntervalS>::handle_type m_wheel_node = nullptr;  // 在时间轮中的位置
+    };
+
     void _removeTimer(int id) {
         delete m_timers[id];
         m_timers.erase(id);
     }
 
     void detectThread() {
+        if (m_scheduler == TIMING_WHEEL) {
+            detectWheelThread();
+            return;
+        }
+
         while (!m_stop) {
             Datetime now = Datetime::now();
             std::unique_lock<std::mutex> lock(m_mutex);
@@ -365,47 +449,145 @@ private:
             }
 
             auto timer = timer_iter->second;
-            m_tg->submit(timer->m_func);
+            if (m_elastic_tg) {
+                m_elastic_tg->submit(timer->m_func);
+            } else {
+                m_tg->submit(timer->m_func);
+            }
 
-            if (timer->m_repeat_num != std::numeric_limits<int>::max()) {
-                timer->m_repeat_num--;
+            // 将下一运行时间推入队列
+            if (nextInterval(s, timer, now)) {
+                m_queue.push(s);
             }
+        }
+    }
 
-            if (timer->m_repeat_num <= 0) {
-                _removeTimer(s.m_timer_id);
+    /**
+     * 时间轮调度：按单调时钟推进时间轮，同一轮到期的任务批量提交至线程池
+     */
+    void detectWheelThread() {
+        std::vector<IntervalS> expired;
+        std::vector<std::function<void()>> tasks;
+        while (!m_stop) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto next = m_wheel.nextExpiration();
+            if (!next) {
+                m_cond.wait(lock);
                 continue;
             }
 
-            // 计算下一次执行的时间点
-            Datetime today = now.startOfDay();
-            if (timer->m_start_time >= TimeDelta()) {
-                // 非指定时刻执行的定时器
-                s.m_time_point = s.m_time_point + timer->m_duration;
-                if (s.m_time_point < now) {
-                    // 系统时间发生向前调整
-                    s.m_time_point = now;
+            uint64_t now_tick = currentTick();
+            if (*next > now_tick) {
+                m_cond.wait_for(lock, std::chrono::milliseconds(*next - now_tick));
+                continue;
+            }
+
+            m_wheel.advance(now_tick, [&expired](IntervalS& s) { expired.push_back(s); });
+            if (expired.empty()) {
+                // 仅高层槽位下沉，无到期任务
+                continue;
+            }
+
+            Datetime now = Datetime::now();
+            for (auto& s : expired) {
+                auto timer_iter = m_timers.find(s.m_timer_id);
+                if (timer_iter == m_timers.end()) {
+                    continue;
                 }
 
-                // 如果限定了当日可执行的时间段，且下一执行时刻超出了当日的限定时间
-                if (timer->m_start_time != timer->m_end_time &&
-                    s.m_time_point > today + timer->m_end_time) {
-                    s.m_time_point = today + timer->m_start_time + TimeDelta(1);
+                Timer* timer = timer_iter->second;
+                timer->m_wheel_node = nullptr;
+                tasks.emplace_back(timer->m_func);
+                if (nextInterval(s, timer, now)) {
+                    pushInterval(s, now);
                 }
+            }
+            expired.clear();
+            lock.unlock();
 
+            if (m_elastic_tg) {
+                m_elastic_tg->submit_bulk(tasks.begin(), tasks.end());
             } else {
-                // 指定了每日运行时刻的定时器
-                s.m_time_point =
-                  s.m_time_point + (today - s.m_time_point.startOfDay() + TimeDelta(1));
+                m_tg->submit_bulk(tasks.begin(), tasks.end());
             }
+            tasks.clear();
+        }
+    }
 
-            if (timer->m_end_date != Datetime::max() &&
-                s.m_time_point > timer->m_end_date + timer->m_end_time) {
-                _removeTimer(s.m_timer_id);
-                continue;
+    /**
+     * 计算已触发定时器的下一次执行时间点，需持有 m_mutex
+     * @return 定时器已无需再执行并被删除时返回 false
+     */
+    bool nextInterval(IntervalS& s, Timer* timer, const Datetime& now) {
+        if (timer->m_repeat_num != std::numeric_limits<int>::max()) {
+            timer->m_repeat_num--;
+        }
+
+        if (timer->m_repeat_num <= 0) {
+            _removeTimer(s.m_timer_id);
+            return false;
+        }
+
+        // 计算下一次执行的时间点
+        Datetime today = now.startOfDay();
+        if (timer->m_start_time >= TimeDelta()) {
+            // 非指定时刻执行的定时器
+            s.m_time_point = s.m_time_point + timer->m_duration;
+            if (s.m_time_point < now) {
+                // 系统时间发生向前调整
+                s.m_time_point = now;
             }
 
-            // 将下一运行时间推入队列
+            // 如果限定了当日可执行的时间段，且下一执行时刻超出了当日的限定时间
+            if (timer->m_start_time != timer->m_end_time &&
+                s.m_time_point > today + timer->m_end_time) {
+                s.m_time_point = today + timer->m_start_time + TimeDelta(1);
+            }
+
+        } else {
+            // 指定了每日运行时刻的定时器
+            s.m_time_point =
+              s.m_time_point + (today - s.m_time_point.startOfDay() + TimeDelta(1));
+        }
+
+        if (timer->m_end_date != Datetime::max() &&
+            s.m_time_point > timer->m_end_date + timer->m_end_time) {
+            _removeTimer(s.m_timer_id);
+            return false;
+        }
+
+        return true;
+    }
+
+    /** 将执行时间点加入调度队列，需持有 m_mutex */
+    void pushInterval(const IntervalS& s, const Datetime& now) {
+        if (m_scheduler != TIMING_WHEEL) {
             m_queue.push(s);
+            return;
+        }
+
+        // 将墙上时间换算为单调时钟 tick，向上取整以保证不提前触发
+        int64_t delay = (s.m_time_point - now).ticks();
+        uint64_t tick = currentTick();
+        if (delay > 0) {
+            tick += uint64_t((delay + WHEEL_TICK_US - 1) / WHEEL_TICK_US);
+        }
+        m_timers[s.m_timer_id]->m_wheel_node = m_wheel.insert(tick, s);
+    }
+
+    /** 时间轮当前 tick（自 m_wheel_base 起的毫秒数） */
+    uint64_t currentTick() const {
+        return uint64_t(std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - m_wheel_base)
+                          .count());
+    }
+
+    /** 清空时间轮并重置时间基准，需持有 m_mutex */
+    void resetWheel() {
+        m_wheel.reset();
+        m_wheel_base = std::chrono::steady_clock::now();
+        for (auto& item : m_timers) {
+            item.second->m_wheel_node = nullptr;
         }
     }
 
@@ -435,33 +617,6 @@ private:
     }
 
 private:
-    class Timer {
-    public:
-        void operator()() {
-            m_func();
-        }
-
-        Datetime m_start_date = Datetime::min().startOfDay();  // 允许执行的起始日期（包含该日期）
-        Datetime m_end_date = Datetime::max().startOfDay();  // 允许执行的终止日期（包含该日期）
-        /*
-         * 注：如果 m_start_time < TimeDelta(0), 则 m_end_time 代表每日指定的运行时刻，此时忽略
-         * m_duration
-         */
-        TimeDelta m_start_time;  // 允许执行的当日起始时间（包含该时间）
-        TimeDelta m_end_time;    // 允许执行的当日结束时间（包含该时间）
-        TimeDelta m_duration;    // 延迟时长或间隔时长
-        int m_repeat_num = 1;    // 重复执行次数，max标识无限循环
-        std::function<void()> m_func;
-    };
-
-    struct IntervalS {
-        Datetime m_time_point;  // 执行的精确时间点
-        int m_timer_id = -1;    // 对应的 Timer, 负数无效
-        bool operator<(const IntervalS& other) const {
-            return m_time_point > other.m_time_point;
-        }
-    };
-
     template <typename F, typename... Args>
     int _addFunc(Datetime start_date, Datetime end_date, TimeDelta start_time, TimeDelta end_time,
                  int repeat_num, TimeDelta duration, F&& f, Args&&... args) {
@@ -529,7 +684,7 @@ private:
         m_timers[id] = timer;
         s.m_timer_id = id;
         // HKU_TRACE("s.m_time_point: {}", s.m_time_point.repr());
-        m_queue.push(s);
+        pushInterval(s, now);
         lock.unlock();
         m_cond.notify_all();
         return id;
@@ -546,7 +701,13 @@ private:
     int m_current_timer_id;
     size_t m_work_num;  // 任务执行线程池线程数量
     ThreadPool* m_tg{nullptr};
+    ElasticThreadPool* m_elastic_tg{nullptr};
     bool m_use_extend_tg{false};
+
+    static constexpr int64_t WHEEL_TICK_US = 1000;  // 时间轮 tick 时长（微秒）
+    SchedulerType m_scheduler{PRIORITY_QUEUE};
+    TimingWheel<IntervalS> m_wheel;
+    std::chrono::steady_clock::time_point m_wheel_base;  // 时间轮 tick 0 对应的时刻
 };
 
 }  // namespace hku
\ No newline at end of file
@@ -0,0 +1,340 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HKU_UTILS_TIMING_WHEEL_H_
+#define HKU_UTILS_TIMING_WHEEL_H_
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace hku {
+
+/**
+ * 分层时间轮
+ * @details
+ * 共 6 层，每层 64 个槽位，第 n 层每个槽位跨度为 64^n 个 tick，可覆盖 2^36 个 tick，
+ * 超出范围的条目先放入最高层，到期时重新计算层级。插入、取消均为 O(1)，
+ * 推进时间时按槽位批量取出到期条目，高层槽位到期时其中的条目逐级下沉。
+ * tick 的时间单位由使用者决定，时间轮本身只处理单调递增的 tick 计数。
+ * @note 非线程安全，由使用者加锁保护
+ * @ingroup Utilities
+ */
+template <typename T>
+class TimingWheel {
+    struct Node;
+
+public:
+    typedef uint64_t tick_type;
+    typedef Node* handle_type;  ///< 条目句柄，条目到期或取消后失效
+
+    static constexpr size_t LEVEL_BITS = 6;
+    static constexpr size_t SLOT_NUM = size_t(1) << LEVEL_BITS;
+    static constexpr size_t LEVEL_NUM = 6;
+    static constexpr tick_type MAX_RANGE = tick_type(1) << (LEVEL_BITS * LEVEL_NUM);
+
+    /**
+     * 构造函数
+     * @param start 起始 tick
+     */
+    explicit TimingWheel(tick_type start = 0) : m_elapsed(start) {
+        for (size_t i = 0; i < LEVEL_NUM; i++) {
+            m_occupied[i] = 0;
+            for (size_t j = 0; j < SLOT_NUM; j++) {
+                m_slots[i][j] = nullptr;
+            }
+        }
+    }
+
+    ~TimingWheel() {
+        clear();
+        for (auto* node : m_free_nodes) {
+            delete node;
+        }
+    }
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    /** 当前 tick */
+    tick_type elapsed() const {
+        return m_elapsed;
+    }
+
+    /** 条目数量 */
+    size_t size() const {
+        return m_size;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    /**
+     * 插入条目
+     * @param deadline 到期 tick，不大于当前 tick 时在下次 advance 时立即到期
+     * @param value 条目值
+     * @return 条目句柄，可用于 cancel
+     */
+    handle_type insert(tick_type deadline, T value) {
+        Node* node = allocNode();
+        node->deadline = deadline;
+        node->value = std::move(value);
+        link(node);
+        m_size++;
+        return node;
+    }
+
+    /**
+     * 取消尚未到期的条目
+     * @param handle insert 返回的句柄，条目到期或取消后不可再使用
+     */
+    void cancel(handle_type handle) {
+        unlink(handle);
+        freeNode(handle);
+        m_size--;
+    }
+
+    /**
+     * 下一个需处理的 tick，时间轮为空时返回空
+     * @note 对于高层槽位，返回的是槽位起始 tick，到该时刻时其中条目下沉而不一定到期，
+     *       使用者应在该时刻调用 advance 后重新获取
+     */
+    std::optional<tick_type> nextExpiration() const {
+        if (m_pending) {
+            return m_elapsed;
+        }
+        for (size_t level = 0; level < LEVEL_NUM; level++) {
+            if (m_occupied[level]) {
+                return slotDeadline(level, nextSlot(level));
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * 推进时间至 now，依到期先后对每个到期条目调用 f(T&)
+     * @note f 中不可操作本时间轮
+     * @param now 当前 tick，小于当前 tick 时不推进
+     * @param f 到期处理函数
+     */
+    template <typename F>
+    void advance(tick_type now, F&& f) {
+        expirePending(f);
+        while (true) {
+            size_t level = 0;
+            while (level < LEVEL_NUM && !m_occupied[level]) {
+                level++;
+            }
+            if (level == LEVEL_NUM) {
+                break;
+            }
+
+            size_t slot = nextSlot(level);
+            tick_type deadline = slotDeadline(level, slot);
+            if (deadline > now) {
+                break;
+            }
+
+            // 取出整个槽位，到期的条目直接处理，未到期的按新的当前 tick 重新放入低层
+            m_elapsed = deadline;
+            Node* node = m_slots[level][slot];
+            m_slots[level][slot] = nullptr;
+            m_occupied[level] &= ~(uint64_t(1) << slot);
+            while (node) {
+                Node* next = node->next;
+                if (node->deadline <= m_elapsed) {
+                    expire(node, f);
+                } else {
+                    link(node);
+                }
+                node = next;
+            }
+            expirePending(f);
+        }
+
+        if (now > m_elapsed) {
+            m_elapsed = now;
+        }
+    }
+
+    /** 清除所有条目，已有句柄全部失效 */
+    void clear() {
+        for (size_t i = 0; i < LEVEL_NUM; i++) {
+            for (size_t j = 0; j < SLOT_NUM; j++) {
+                releaseList(m_slots[i][j]);
+                m_slots[i][j] = nullptr;
+            }
+            m_occupied[i] = 0;
+        }
+        releaseList(m_pending);
+        m_pending = nullptr;
+        m_size = 0;
+    }
+
+    /**
+     * 清除所有条目并重置当前 tick
+     * @param start 起始 tick
+     */
+    void reset(tick_type start = 0) {
+        clear();
+        m_elapsed = start;
+    }
+
+private:
+    struct Node {
+        tick_type deadline = 0;
+        Node* prev = nullptr;
+        Node* next = nullptr;
+        Node** head = nullptr;  // 所在链表头，用于 O(1) 取消
+        size_t level = 0;
+        size_t slot = 0;
+        T value;
+    };
+
+    static size_t countTrailingZero(uint64_t x) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return index;
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+
+    // 从当前 tick 所在槽位的下一个槽位开始，环形查找第一个非空槽位，调用前需确保该层非空
+    // 当前槽位只可能在最高层因回绕而非空，其到期时间为下一圈，故最后查找
+    size_t nextSlot(size_t level) const {
+        size_t start = ((m_elapsed >> (level * LEVEL_BITS)) + 1) & (SLOT_NUM - 1);
+        uint64_t occupied = m_occupied[level];
+        uint64_t rotated =
+          start == 0 ? occupied : (occupied >> start) | (occupied << (SLOT_NUM - start));
+        return (countTrailingZero(rotated) + start) & (SLOT_NUM - 1);
+    }
+
+    tick_type slotDeadline(size_t level, size_t slot) const {
+        tick_type slot_range = tick_type(1) << (level * LEVEL_BITS);
+        tick_type level_range = slot_range << LEVEL_BITS;
+        tick_type deadline = (m_elapsed & ~(level_range - 1)) + slot * slot_range;
+        if (deadline < m_elapsed) {
+            // 环形回绕至下一圈，仅出现在最高层
+            deadline += level_range;
+        }
+        return deadline;
+    }
+
+    void link(Node* node) {
+        if (node->deadline <= m_elapsed) {
+            pushFront(&m_pending, node);
+            return;
+        }
+
+        // 按到期 tick 与当前 tick 最高的不同位确定层级
+        tick_type when = node->deadline;
+        if (when - m_elapsed >= MAX_RANGE) {
+            // 超出范围，暂放入最高层，到时再重新计算
+            when = m_elapsed + MAX_RANGE - 1;
+        }
+        tick_type masked = (m_elapsed ^ when) | (SLOT_NUM - 1);
+        if (masked >= MAX_RANGE) {
+            // 跨越最高层的整圈边界时，放入最高层中的回绕槽位
+            masked = MAX_RANGE - 1;
+        }
+        size_t level = 0;
+        while (level < LEVEL_NUM - 1 && masked >= (tick_type(1) << ((level + 1) * LEVEL_BITS))) {
+            level++;
+        }
+        size_t slot = (when >> (level * LEVEL_BITS)) & (SLOT_NUM - 1);
+        node->level = level;
+        node->slot = slot;
+        pushFront(&m_slots[level][slot], node);
+        m_occupied[level] |= uint64_t(1) << slot;
+    }
+
+    void unlink(Node* node) {
+        if (node->prev) {
+            node->prev->next = node->next;
+        } else {
+            *node->head = node->next;
+        }
+        if (node->next) {
+            node->next->prev = node->prev;
+        }
+        if (node->head != &m_pending && *node->head == nullptr) {
+            m_occupied[node->level] &= ~(uint64_t(1) << node->slot);
+        }
+    }
+
+    static void pushFront(Node** head, Node* node) {
+        node->head = head;
+        node->prev = nullptr;
+        node->next = *head;
+        if (*head) {
+            (*head)->prev = node;
+        }
+        *head = node;
+    }
+
+    template <typename F>
+    void expire(Node* node, F& f) {
+        m_size--;
+        T value = std::move(node->value);
+        freeNode(node);
+        f(value);
+    }
+
+    template <typename F>
+    void expirePending(F& f) {
+        Node* node = m_pending;
+        m_pending = nullptr;
+        while (node) {
+            Node* next = node->next;
+            expire(node, f);
+            node = next;
+        }
+    }
+
+    Node* allocNode() {
+        if (m_free_nodes.empty()) {
+            return new Node;
+        }
+        Node* node = m_free_nodes.back();
+        m_free_nodes.pop_back();
+        return node;
+    }
+
+    void freeNode(Node* node) {
+        node->value = T();
+        m_free_nodes.push_back(node);
+    }
+
+    void releaseList(Node* node) {
+        while (node) {
+            Node* next = node->next;
+            freeNode(node);
+            node = next;
+        }
+    }
+
+private:
+    tick_type m_elapsed;                 // 当前 tick
+    size_t m_size = 0;                   // 条目数量
+    Node* m_slots[LEVEL_NUM][SLOT_NUM];  // 各层槽位链表
+    uint64_t m_occupied[LEVEL_NUM];      // 各层非空槽位位图
+    Node* m_pending = nullptr;           // 已到期待处理的条目
+    std::vector<Node*> m_free_nodes;     // 可复用的节点
+};
+
+}  // namespace hku
+
+#endif /* HKU_UTILS_TIMING_WHEEL_H_ */
@@ -0,0 +1,412 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "LruCache.h"
+
+namespace hku {
+
+/**
+ * @brief 频率估计草图（Count-Min Sketch），用于 TinyLfuCache 的准入判断
+ * @details
+ * 每个 64 位字包含 16 个 4 位计数器，每个键对应 4 个计数器，取其最小值作为频率估计，
+ * 计数上限为 15。累计增加次数达到采样周期（容量的 10 倍）时所有计数器减半，
+ * 以使历史热点随时间衰减。
+ */
+class FrequencySketch {
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity 预期的缓存容量
+     */
+    explicit FrequencySketch(size_t capacity = 64) {
+        resize(capacity);
+    }
+
+    /**
+     * @brief 按容量重建计数表，已有计数清零
+     * @param capacity 预期的缓存容量
+     */
+    void resize(size_t capacity) {
+        size_t n = 1;
+        while (n < capacity) {
+            n <<= 1;
+        }
+        m_table.assign(n, 0);
+        m_mask = n - 1;
+        m_sample_size = capacity == 0 ? 10 : 10 * capacity;
+        m_additions = 0;
+    }
+
+    /** 键的频率估计值（0~15） */
+    uint32_t frequency(uint64_t hash) const {
+        hash = spread(hash);
+        uint32_t start = uint32_t(hash & 3) << 2;
+        uint32_t freq = 15;
+        for (uint32_t i = 0; i < 4; i++) {
+            uint32_t shift = (start + i) << 2;
+            uint32_t count = uint32_t((m_table[indexOf(hash, i)] >> shift) & 0xF);
+            if (count < freq) {
+                freq = count;
+            }
+        }
+        return freq;
+    }
+
+    /** 增加键的频率计数 */
+    void increment(uint64_t hash) {
+        hash = spread(hash);
+        uint32_t start = uint32_t(hash & 3) << 2;
+        bool added = false;
+        for (uint32_t i = 0; i < 4; i++) {
+            uint32_t shift = (start + i) << 2;
+            uint64_t mask = uint64_t(0xF) << shift;
+            uint64_t& word = m_table[indexOf(hash, i)];
+            if ((word & mask) != mask) {
+                word += uint64_t(1) << shift;
+                added = true;
+            }
+        }
+        if (added && ++m_additions >= m_sample_size) {
+            reset();
+        }
+    }
+
+    /** 所有计数减半 */
+    void reset() {
+        for (auto& word : m_table) {
+            word = (word >> 1) & 0x7777777777777777ULL;
+        }
+        m_additions /= 2;
+    }
+
+private:
+    static uint64_t spread(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    size_t indexOf(uint64_t hash, uint32_t i) const {
+        static const uint64_t seeds[4] = {0xC3A5C85C97CB3127ULL, 0xB492B66FBE98F273ULL,
+                                          0x9AE16A3B2F90404FULL, 0xCBF29CE484222325ULL};
+        uint64_t h = (hash + seeds[i]) * seeds[i];
+        h += h >> 32;
+        return size_t(h) & m_mask;
+    }
+
+private:
+    std::vector<uint64_t> m_table;  // 计数表
+    size_t m_mask = 0;              // 计数表下标掩码
+    size_t m_sample_size = 0;       // 采样周期
+    size_t m_additions = 0;         // 当前周期内的累计增加次数
+};
+
+/**
+ * @brief W-TinyLFU 缓存，抗扫描的 LRU 缓存替代实现
+ * @details
+ * 缓存分为窗口区（约 1% 容量，LRU）与主区（SLRU，试用段 20%、保护段 80%）。
+ * 新元素先进入窗口区，从窗口区淘汰的候选元素与主区试用段最久未使用的元素比较
+ * FrequencySketch 中的访问频率，频率更高者留下。一次性的顺序扫描因频率低而难以进入主区，
+ * 从而不会冲掉热点数据。
+ * 接口与 LruCache 一致，访问时需更新频率与访问顺序，因此读操作同样加独占锁。
+ * @tparam KeyType 键的类型，必须支持哈希和相等比较
+ * @tparam ValueType 值的类型，必须支持拷贝和移动操作
+ * @tparam Lock 锁类型，默认为 NullLock（非线程安全）
+ * @tparam Hash 键的哈希函数
+ */
+template <typename KeyType, typename ValueType, class Lock = NullLock,
+          class Hash = std::hash<KeyType>>
+class TinyLfuCache final {
+public:
+    using key_type = KeyType;
+    using value_type = ValueType;
+    using size_type = size_t;
+    typedef Lock lock_type;
+    using Guard = std::unique_lock<lock_type>;
+
+    /**
+     * @brief 构造函数
+     * @param capacity 缓存容量，默认为64，0表示无限制容量（此时不淘汰）
+     */
+    explicit TinyLfuCache(size_type capacity = 64) {
+        _setCapacity(capacity);
+    }
+
+    /**
+     * @brief 插入键值对
+     * @param key 键
+     * @param value 值
+     */
+    void insert(const key_type& key, const value_type& value) {
+        Guard lock(m_mutex);
+        _insert(key, value_type(value));
+    }
+
+    /**
+     * @brief 插入键值对（移动版本）
+     * @param key 键
+     * @param value 值（右值引用）
+     */
+    void insert(const key_type& key, value_type&& value) {
+        Guard lock(m_mutex);
+        _insert(key, std::move(value));
+    }
+
+    /**
+     * @brief 获取键对应的值
+     * @param key 键
+     * @return 存在则返回值，否则返回ValueType的默认构造值
+     */
+    value_type get(const key_type& key) {
+        value_type value{};
+        tryGet(key, value);
+        return value;
+    }
+
+    /**
+     * @brief 尝试获取键对应的值
+     * @param key 键
+     * @param value 用于接收值的引用参数
+     * @return 如果键存在返回true，否则返回false
+     */
+    bool tryGet(const key_type& key, value_type& value) {
+        Guard lock(m_mutex);
+        size_t hash = m_hash(key);
+        m_sketch.increment(hash);
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            return false;
+        }
+        _onHit(it->second);
+        value = it->second.iter->value;
+        return true;
+    }
+
+    /**
+     * @brief 检查是否包含指定键，不影响访问频率与顺序
+     * @param key 键
+     * @return 存在返回true，否则返回false
+     */
+    bool contains(const key_type& key) {
+        Guard lock(m_mutex);
+        return m_index.find(key) != m_index.end();
+    }
+
+    /**
+     * @brief 删除指定键
+     * @param key 要删除的键
+     * @return 成功删除返回true，不存在返回false
+     */
+    bool remove(const key_type& key) {
+        Guard lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            return false;
+        }
+        _list(it->second.segment).erase(it->second.iter);
+        m_index.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief 清空缓存，保留频率统计
+     */
+    void clear() {
+        Guard lock(m_mutex);
+        m_index.clear();
+        m_window.clear();
+        m_probation.clear();
+        m_protected.clear();
+    }
+
+    /**
+     * @brief 获取缓存当前大小
+     * @return 当前缓存元素数量
+     */
+    size_type size() const {
+        Guard lock(m_mutex);
+        return m_index.size();
+    }
+
+    /**
+     * @brief 检查缓存是否为空
+     * @return 空返回true，否则返回false
+     */
+    bool empty() const {
+        Guard lock(m_mutex);
+        return m_index.empty();
+    }
+
+    /**
+     * @brief 获取缓存容量
+     * @return 缓存容量
+     */
+    size_type capacity() const {
+        Guard lock(m_mutex);
+        return m_capacity;
+    }
+
+    /**
+     * @brief 设置缓存容量，频率统计将被重置
+     * @param capacity 新的容量，0表示不限制容量
+     */
+    void resize(size_type capacity) {
+        Guard lock(m_mutex);
+        _setCapacity(capacity);
+        while (m_capacity != 0 && m_index.size() > m_capacity) {
+            _evictOne();
+        }
+        while (m_protected.size() > m_protected_capacity) {
+            _demoteProtected();
+        }
+    }
+
+private:
+    enum Segment { WINDOW, PROBATION, PROTECTED };
+
+    struct Entry {
+        key_type key;
+        value_type value;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    struct Node {
+        typename EntryList::iterator iter;
+        Segment segment;
+    };
+
+    EntryList& _list(Segment segment) {
+        return segment == WINDOW ? m_window : (segment == PROBATION ? m_probation : m_protected);
+    }
+
+    void _setCapacity(size_type capacity) {
+        m_capacity = capacity;
+        if (capacity == 0) {
+            m_window_capacity = 0;
+            m_protected_capacity = 0;
+        } else {
+            m_window_capacity = capacity / 100 > 0 ? capacity / 100 : 1;
+            size_type main_capacity = capacity - m_window_capacity;
+            m_protected_capacity = main_capacity * 4 / 5;
+        }
+        m_sketch.resize(capacity);
+    }
+
+    void _insert(const key_type& key, value_type&& value) {
+        m_sketch.increment(m_hash(key));
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            it->second.iter->value = std::move(value);
+            _onHit(it->second);
+            return;
+        }
+
+        m_window.push_front(Entry{key, std::move(value)});
+        m_index.emplace(key, Node{m_window.begin(), WINDOW});
+        if (m_capacity == 0) {
+            return;
+        }
+
+        // 窗口区溢出时，窗口区最久未使用的元素作为候选进入主区试用段
+        if (m_window.size() > m_window_capacity) {
+            Node& candidate = m_index[m_window.back().key];
+            m_probation.splice(m_probation.begin(), m_window, candidate.iter);
+            candidate.segment = PROBATION;
+        }
+        if (m_index.size() > m_capacity) {
+            _evictOne();
+        }
+    }
+
+    // 主区已满，在刚进入试用段的候选元素与试用段最久未使用的元素中淘汰频率较低者
+    void _evictOne() {
+        if (m_probation.empty()) {
+            if (!m_protected.empty()) {
+                _demoteProtected();
+            } else {
+                _evict(m_window, std::prev(m_window.end()));
+                return;
+            }
+        }
+
+        auto candidate = m_probation.begin();
+        auto victim = std::prev(m_probation.end());
+        if (candidate == victim) {
+            if (m_protected.empty()) {
+                _evict(m_probation, candidate);
+                return;
+            }
+            // 试用段只有候选元素，与保护段最久未使用的元素比较
+            victim = std::prev(m_protected.end());
+            if (m_sketch.frequency(m_hash(candidate->key)) >
+                m_sketch.frequency(m_hash(victim->key))) {
+                _evict(m_protected, victim);
+            } else {
+                _evict(m_probation, candidate);
+            }
+            return;
+        }
+
+        if (m_sketch.frequency(m_hash(candidate->key)) > m_sketch.frequency(m_hash(victim->key))) {
+            _evict(m_probation, victim);
+        } else {
+            _evict(m_probation, candidate);
+        }
+    }
+
+    void _evict(EntryList& list, typename EntryList::iterator iter) {
+        m_index.erase(iter->key);
+        list.erase(iter);
+    }
+
+    void _demoteProtected() {
+        auto last = std::prev(m_protected.end());
+        m_index[last->key].segment = PROBATION;
+        m_probation.splice(m_probation.begin(), m_protected, last);
+    }
+
+    void _onHit(Node& node) {
+        switch (node.segment) {
+            case WINDOW:
+                m_window.splice(m_window.begin(), m_window, node.iter);
+                break;
+            case PROBATION:
+                // 试用段元素再次被访问，晋升至保护段
+                m_protected.splice(m_protected.begin(), m_probation, node.iter);
+                node.segment = PROTECTED;
+                if (m_capacity != 0 && m_protected.size() > m_protected_capacity) {
+                    _demoteProtected();
+                }
+                break;
+            case PROTECTED:
+                m_protected.splice(m_protected.begin(), m_protected, node.iter);
+                break;
+        }
+    }
+
+private:
+    size_type m_capacity = 0;            // 总容量
+    size_type m_window_capacity = 0;     // 窗口区容量
+    size_type m_protected_capacity = 0;  // 主区保护段容量
+    EntryList m_window;                  // 窗口区
+    EntryList m_probation;               // 主区试用段
+    EntryList m_protected;               // 主区保护段
+    std::unordered_map<key_type, Node, Hash> m_index;
+    FrequencySketch m_sketch;
+    Hash m_hash;
+    mutable lock_type m_mutex;
+};
+
+}  // namespace hku
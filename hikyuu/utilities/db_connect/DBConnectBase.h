@@ -10,10 +10,16 @@
 #ifndef HIKYUU_DB_CONNECT_DBCONNECTBASE_H
 #define HIKYUU_DB_CONNECT_DBCONNECTBASE_H
 
+#include <cctype>
+#include <exception>
+#include <thread>
 #include "../../utilities/Parameter.h"
 #include "../Null.h"
+#include "../LruCache.h"
 #include "DBCondition.h"
 #include "SQLStatementBase.h"
+#include "SQLBatchInsert.h"
+#include "SQLRowCursor.h"
 #include "SQLException.h"
 
 namespace hku {
@@ -23,6 +29,12 @@ class SQLResultSet;
 
 /**
  * 数据库连接基类
+ * @details 每个连接带有按 SQL 文本索引的预编译语句 LRU 缓存，getStatement 对相同的 SQL
+ * 复用已预编译的语句，容量由连接参数 statement_cache_size 指定（默认 32，为 0 时关闭）。
+ * 缓存的语句在使用者释放后被重置并清除已绑定的参数；同一语句仍在使用中时另行创建不缓存的语句。
+ * 执行变更表结构的 SQL（CREATE/DROP/ALTER）时清空缓存。
+ * batchSave 可按连接参数 batch_insert_rows（默认 1，即逐条插入）将多条记录合并为
+ * 多行 INSERT 语句执行。
  * @ingroup DBConnect
  */
 class HKU_UTILS_API DBConnectBase : public std::enable_shared_from_this<DBConnectBase> {
@@ -114,6 +126,12 @@ class HKU_UTILS_API DBConnectBase : public std::enable_shared_from_this<DBConnec
 
     /**
      * 批量保存，迭代器中的数据必须是通过 TABLE_BIND 绑定的表模型
+     * @details batchInsertRows() 大于 1 时，每 batchInsertRows() 条记录合并为一条多行 INSERT
+     * 语句（同时受单条语句参数个数上限的约束），并按插入顺序回填各记录的 rowid。
+     * 插入语句带有冲突处理（如 INSERT OR IGNORE、REPLACE、ON CONFLICT）时无法确定各记录的 rowid，
+     * 仍逐条插入。
+     * @note SQLite 与 MySQL 按自增 id 连续分配推算各记录 id，要求 id 由数据库自动分配；
+     * MySQL 另要求自增步长为 1 且 innodb_autoinc_lock_mode 为 0 或 1，否则请勿开启合并插入
      * @param first 迭代器起始点
      * @param last 迭代器终止点
      * @param autotrans 启动事务
@@ -171,6 +189,49 @@ class HKU_UTILS_API DBConnectBase : public std::enable_shared_from_this<DBConnec
     template <typename Container>
     void batchLoadView(Container &container, const std::string &sql);
 
+    /**
+     * 流式查询，返回逐行读取的游标，不将全部结果加载至内存
+     * @param where 查询条件
+     * @param reuse 是否复用同一行对象 @see SQLRowCursor
+     */
+    template <typename TableT>
+    SQLRowCursor<TableT> cursor(const std::string &where = "", bool reuse = false);
+
+    /**
+     * 流式查询，返回逐行读取的游标，不将全部结果加载至内存
+     * @param sql select 的查询语句
+     * @param reuse 是否复用同一行对象 @see SQLRowCursor
+     */
+    template <typename TableT>
+    SQLRowCursor<TableT> cursorView(const std::string &sql, bool reuse = false);
+
+    /**
+     * 逐行处理查询结果
+     * @param where 查询条件
+     * @param func 处理函数，形如 void(TableT &row)，可将 row 移出
+     * @param reuse 是否复用同一行对象 @see SQLRowCursor
+     * @return 处理的行数
+     */
+    template <typename TableT, typename Func>
+    size_t forEachRow(const std::string &where, Func &&func, bool reuse = false);
+
+    /**
+     * 并行处理查询结果
+     * @details 当前线程读取数据，每 batch_rows 行为一批放入有界队列，由 worker_num 个线程取出
+     * 并调用 func 处理，队列满时暂停读取。
+     * @note func 在多个线程中并发调用，需自行保证线程安全，处理顺序与查询结果的顺序无关
+     * @param where 查询条件
+     * @param func 处理函数，形如 void(TableT &row)，可将 row 移出
+     * @param worker_num 处理线程数
+     * @param queue_capacity 队列中最多缓存的批数
+     * @param batch_rows 每批的行数
+     * @return 读取的行数
+     * @exception func 抛出的第一个异常，此时停止读取并丢弃尚未处理的数据
+     */
+    template <typename TableT, typename Func>
+    size_t forEachRowParallel(const std::string &where, Func &&func, size_t worker_num,
+                              size_t queue_capacity = 16, size_t batch_rows = 256);
+
     /**
      * 批量更新
      * @param container 拥有迭代器的容器
@@ -292,8 +353,83 @@ class HKU_UTILS_API DBConnectBase : public std::enable_shared_from_this<DBConnec
     template <typename TableT, size_t page_size = 50>
     SQLResultSet<TableT, page_size> query(const DBCondition &cond);
 
+    //-------------------------------------------------------------------------
+    // 预编译语句缓存
+    //-------------------------------------------------------------------------
+
+    /** 预编译语句缓存容量，为 0 表示不缓存 */
+    size_t statementCacheCapacity() const noexcept {
+        return m_stmt_cache_capacity;
+    }
+
+    /** 设置预编译语句缓存容量，为 0 时关闭缓存 */
+    void statementCacheCapacity(size_t capacity);
+
+    /** 当前缓存的预编译语句数 */
+    size_t statementCacheSize() const {
+        return m_stmt_cache.size();
+    }
+
+    /** 预编译语句缓存命中次数 */
+    uint64_t statementCacheHits() const noexcept {
+        return m_stmt_cache_hits;
+    }
+
+    /** 预编译语句缓存未命中次数（即实际预编译的次数） */
+    uint64_t statementCacheMisses() const noexcept {
+        return m_stmt_cache_misses;
+    }
+
+    /** 清空预编译语句缓存，使用中的语句不受影响 */
+    void clearStatementCache() {
+        m_stmt_cache.clear();
+    }
+
+    /** batchSave 时单条 INSERT 语句合并插入的最大记录数，小于等于 1 表示逐条插入（默认） */
+    size_t batchInsertRows() const noexcept {
+        return m_batch_insert_rows;
+    }
+
+    /** 设置 batchSave 时单条 INSERT 语句合并插入的最大记录数 */
+    void batchInsertRows(size_t rows) noexcept {
+        m_batch_insert_rows = rows;
+    }
+
+protected:
+    /**
+     * 从缓存中获取预编译语句，未命中时创建并放入缓存，供子类 getStatement 使用
+     * @tparam StatementType 子类对应的 SQLStatementBase 实现，构造参数为 (driver, sql)
+     */
+    template <class StatementType>
+    SQLStatementPtr getCachedStatement(const std::string &sql_statement);
+
+    /** 如 SQL 会变更表结构，清空预编译语句缓存，子类在执行 SQL 前调用 */
+    void invalidateStatementCache(const std::string &sql_string) {
+        if (!m_stmt_cache.empty() && isSchemaChange(sql_string)) {
+            m_stmt_cache.clear();
+        }
+    }
+
 private:
     DBConnectBase() = delete;
+
+    static bool isSchemaChange(const std::string &sql_string);
+
+private:
+    struct CachedStatement {
+        SQLStatementPtr statement;
+        bool in_use = false;
+        bool valid = true;  // 重置失败时置为 false，不再复用
+    };
+
+    LruCache<std::string, std::shared_ptr<CachedStatement>> m_stmt_cache;
+    size_t m_stmt_cache_capacity;
+    uint64_t m_stmt_cache_hits = 0;
+    uint64_t m_stmt_cache_misses = 0;
+    size_t m_batch_insert_rows;
+
+    // 单条 SQL 语句允许的参数个数上限（取各驱动中的最小值，SQLite 3.32 之前为 999）
+    static constexpr size_t MAX_SQL_PARAMS = 999;
 };
 
 /** @ingroup DBConnect */
@@ -303,7 +439,91 @@ typedef std::shared_ptr<DBConnectBase> DBConnectPtr;
 // inline方法实现
 //-------------------------------------------------------------------------
 
-inline DBConnectBase::DBConnectBase(const Parameter &param) : m_params(param) {}
+inline DBConnectBase::DBConnectBase(const Parameter &param)
+: m_params(param), m_stmt_cache(0, 0), m_stmt_cache_capacity(0) {
+    int capacity = tryGetParam<int>("statement_cache_size", 32);
+    statementCacheCapacity(capacity > 0 ? capacity : 0);
+    int rows = tryGetParam<int>("batch_insert_rows", 1);
+    m_batch_insert_rows = rows > 0 ? rows : 0;
+}
+
+inline void DBConnectBase::statementCacheCapacity(size_t capacity) {
+    m_stmt_cache_capacity = capacity;
+    if (capacity == 0) {
+        m_stmt_cache.clear();
+    }
+    m_stmt_cache.resize(capacity);
+}
+
+inline bool DBConnectBase::isSchemaChange(const std::string &sql_string) {
+    static const char *keywords[] = {"CREATE", "DROP", "ALTER"};
+    size_t total = sql_string.size();
+    for (size_t i = 0; i < total; i++) {
+        if (i > 0 && (std::isalnum((unsigned char)sql_string[i - 1]) || sql_string[i - 1] == '_')) {
+            continue;
+        }
+        for (const char *keyword : keywords) {
+            size_t j = 0;
+            while (keyword[j] && i + j < total &&
+                   std::toupper((unsigned char)sql_string[i + j]) == keyword[j]) {
+                j++;
+            }
+            if (!keyword[j] && (i + j == total || std::isspace((unsigned char)sql_string[i + j]))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <class StatementType>
+SQLStatementPtr DBConnectBase::getCachedStatement(const std::string &sql_statement) {
+    if (m_stmt_cache_capacity == 0) {
+        m_stmt_cache_misses++;
+        return std::make_shared<StatementType>(this, sql_statement);
+    }
+
+    std::shared_ptr<CachedStatement> entry;
+    if (m_stmt_cache.tryGet(sql_statement, entry)) {
+        if (entry->in_use) {
+            // 同一语句仍在使用中（如嵌套查询），另行创建不缓存的语句
+            m_stmt_cache_misses++;
+            return std::make_shared<StatementType>(this, sql_statement);
+        }
+        if (entry->valid) {
+            m_stmt_cache_hits++;
+        } else {
+            entry.reset();
+        }
+    }
+
+    if (!entry) {
+        m_stmt_cache_misses++;
+        SQLStatementPtr st = std::make_shared<StatementType>(this, sql_statement);
+        if (isSchemaChange(sql_statement)) {
+            m_stmt_cache.clear();
+            return st;
+        }
+        entry = std::make_shared<CachedStatement>();
+        entry->statement = st;
+        m_stmt_cache.insert(sql_statement, entry);
+    }
+
+    // 使用者释放时重置语句，缓存被清空或连接析构后仍由 entry 保持语句本身的生命周期
+    entry->in_use = true;
+    return SQLStatementPtr(entry->statement.get(), [entry](SQLStatementBase *st) {
+        try {
+            st->reset();
+        } catch (const std::exception &e) {
+            entry->valid = false;
+            HKU_WARN("Failed reset cached statement! {}", e.what());
+        } catch (...) {
+            entry->valid = false;
+            HKU_WARN("Failed reset cached statement! Unknown error!");
+        }
+        entry->in_use = false;
+    });
+}
 
 inline int DBConnectBase::queryInt(const std::string &query, int default_val) {
     return queryNumber<int>(query, default_val);
@@ -394,16 +614,49 @@ void DBConnectBase::batchSave(InputIterator first, InputIterator last, bool auto
     size_t count = std::distance(first, last);
     HKU_IF_RETURN(count == 0, void());
 
-    SQLStatementPtr st = getStatement(InputIterator::value_type::getInsertSQL());
+    std::string sql(InputIterator::value_type::getInsertSQL());
+    SQLInsertTemplate insert;
+    size_t chunk_rows = 1;
+    if (count > 1 && m_batch_insert_rows > 1 && insert.parse(sql) && insert.simple()) {
+        chunk_rows = std::min(count, m_batch_insert_rows);
+        chunk_rows = std::min(chunk_rows, std::max<size_t>(1, MAX_SQL_PARAMS / insert.params));
+    }
+
     if (autotrans) {
         transaction();
     }
 
     try {
-        for (InputIterator iter = first; iter != last; ++iter) {
-            iter->save(st);
-            st->exec();
-            iter->rowid(st->getLastRowid());
+        if (chunk_rows <= 1) {
+            SQLStatementPtr st = getStatement(sql);
+            for (InputIterator iter = first; iter != last; ++iter) {
+                iter->save(st);
+                st->exec();
+                iter->rowid(st->getLastRowid());
+            }
+        } else {
+            std::vector<uint64_t> rowids;
+            InputIterator iter = first;
+            size_t remain = count;
+            while (remain > 0) {
+                size_t rows = std::min(remain, chunk_rows);
+                SQLStatementPtr st = getStatement(insert.build(rows));
+                auto adapter = std::make_shared<SQLOffsetBindStatement>(st);
+                SQLStatementPtr adapter_st = adapter;
+                InputIterator chunk_first = iter;
+                for (size_t i = 0; i < rows; i++, ++iter) {
+                    adapter->offset(int(i * insert.params));
+                    iter->save(adapter_st);
+                }
+                st->exec();
+                st->getInsertedRowids(rows, rowids);
+                HKU_CHECK(rowids.size() == rows, "The number of returned rowids ({}) != {}!",
+                          rowids.size(), rows);
+                for (size_t i = 0; i < rows; i++, ++chunk_first) {
+                    chunk_first->rowid(rowids[i]);
+                }
+                remain -= rows;
+            }
         }
 
         if (autotrans) {
@@ -413,17 +666,17 @@ void DBConnectBase::batchSave(InputIterator first, InputIterator last, bool auto
         if (autotrans) {
             rollback();
         }
-        SQL_THROW(e.errcode(), "failed batch save! sql: {}! {}", st->getSqlString(), e.what());
+        SQL_THROW(e.errcode(), "failed batch save! sql: {}! {}", sql, e.what());
     } catch (std::exception &e) {
         if (autotrans) {
             rollback();
         }
-        HKU_THROW("failed batch save! sql: {}! {}", st->getSqlString(), e.what());
+        HKU_THROW("failed batch save! sql: {}! {}", sql, e.what());
     } catch (...) {
         if (autotrans) {
             rollback();
         }
-        HKU_THROW("failed batch save! sql: {}! Unknown error!", st->getSqlString());
+        HKU_THROW("failed batch save! sql: {}! Unknown error!", sql);
     }
 }
 
@@ -460,7 +713,7 @@ void DBConnectBase::batchLoad(Container &container, const std::string &where) {
     while (st->moveNext()) {
         typename Container::value_type tmp;
         tmp.load(st);
-        container.push_back(tmp);
+        container.push_back(std::move(tmp));
     }
 }
 
@@ -485,8 +738,103 @@ void DBConnectBase::batchLoadView(Container &container, const std::string &sql)
     while (st->moveNext()) {
         typename Container::value_type tmp;
         tmp.load(st);
-        container.push_back(tmp);
+        container.push_back(std::move(tmp));
+    }
+}
+
+template <typename TableT>
+SQLRowCursor<TableT> DBConnectBase::cursor(const std::string &where, bool reuse) {
+    std::ostringstream sql;
+    if (where != "") {
+        sql << TableT::getSelectSQL() << " where " << where;
+    } else {
+        sql << TableT::getSelectSQL();
+    }
+    return SQLRowCursor<TableT>(getStatement(sql.str()), reuse);
+}
+
+template <typename TableT>
+SQLRowCursor<TableT> DBConnectBase::cursorView(const std::string &sql, bool reuse) {
+    return SQLRowCursor<TableT>(getStatement(sql), reuse);
+}
+
+template <typename TableT, typename Func>
+size_t DBConnectBase::forEachRow(const std::string &where, Func &&func, bool reuse) {
+    auto rows = cursor<TableT>(where, reuse);
+    for (auto &row : rows) {
+        func(row);
+    }
+    return rows.count();
+}
+
+template <typename TableT, typename Func>
+size_t DBConnectBase::forEachRowParallel(const std::string &where, Func &&func,
+                                         size_t worker_num, size_t queue_capacity,
+                                         size_t batch_rows) {
+    worker_num = worker_num > 0 ? worker_num : 1;
+    batch_rows = batch_rows > 0 ? batch_rows : 1;
+
+    SQLRowQueue<std::vector<TableT>> queue(queue_capacity);
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto set_error = [&](std::exception_ptr e) {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = e;
+            }
+        }
+        queue.abort();
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(worker_num);
+    for (size_t i = 0; i < worker_num; i++) {
+        workers.emplace_back([&]() {
+            try {
+                std::vector<TableT> batch;
+                while (queue.pop(batch)) {
+                    for (auto &row : batch) {
+                        func(row);
+                    }
+                }
+            } catch (...) {
+                set_error(std::current_exception());
+            }
+        });
+    }
+
+    size_t count = 0;
+    try {
+        auto rows = cursor<TableT>(where);
+        std::vector<TableT> batch;
+        batch.reserve(batch_rows);
+        for (auto &row : rows) {
+            batch.push_back(std::move(row));
+            if (batch.size() >= batch_rows) {
+                if (!queue.push(std::move(batch))) {
+                    break;
+                }
+                batch = std::vector<TableT>();
+                batch.reserve(batch_rows);
+            }
+        }
+        if (!batch.empty()) {
+            queue.push(std::move(batch));
+        }
+        count = rows.count();
+    } catch (...) {
+        set_error(std::current_exception());
+    }
+
+    queue.close();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
     }
+    return count;
 }
 
 template <class Container>
@@ -0,0 +1,276 @@
+/*
+ * SQLBatchInsert.h
+ *
+ *  Copyright (c) 2026, hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+#pragma once
+#ifndef HIKYUU_DB_CONNECT_SQLBATCHINSERT_H
+#define HIKYUU_DB_CONNECT_SQLBATCHINSERT_H
+
+#include <cctype>
+#include "SQLStatementBase.h"
+
+namespace hku {
+
+/**
+ * 带参数序号偏移的语句适配器，用于多行 INSERT
+ * @details 将绑定至第 idx 个参数的值转发至目标语句的第 idx + offset 个参数，
+ * 使表模型的 save(st) 可将各记录依次绑定至多行 VALUES 语句中的不同行。仅支持参数绑定。
+ * @ingroup DBConnect
+ */
+class SQLOffsetBindStatement : public SQLStatementBase {
+public:
+    /**
+     * 构造函数
+     * @param target 实际执行的语句
+     */
+    explicit SQLOffsetBindStatement(const SQLStatementPtr &target)
+    : SQLStatementBase(target->getConnect(), target->getSqlString()), m_target(target) {}
+
+    virtual ~SQLOffsetBindStatement() = default;
+
+    /** 设置参数序号偏移量 */
+    void offset(int offset) {
+        m_offset = offset;
+    }
+
+    /** 获取参数序号偏移量 */
+    int offset() const {
+        return m_offset;
+    }
+
+protected:
+    virtual void sub_exec() override {
+        _unsupported();
+    }
+
+    virtual bool sub_moveNext() override {
+        _unsupported();
+        return false;
+    }
+
+    virtual uint64_t sub_getLastRowid() override {
+        _unsupported();
+        return 0;
+    }
+
+    virtual void sub_reset() override {
+        _unsupported();
+    }
+
+    virtual void sub_getInsertedRowids(size_t, std::vector<uint64_t> &) override {
+        _unsupported();
+    }
+
+    virtual void sub_bindNull(int idx) override {
+        m_target->bind(idx + m_offset);
+    }
+
+    virtual void sub_bindInt(int idx, int64_t value) override {
+        m_target->bind(idx + m_offset, value);
+    }
+
+    virtual void sub_bindDouble(int idx, double item) override {
+        m_target->bind(idx + m_offset, item);
+    }
+
+    virtual void sub_bindDatetime(int idx, const Datetime &item) override {
+        m_target->bind(idx + m_offset, item);
+    }
+
+    virtual void sub_bindText(int idx, const std::string &item) override {
+        m_target->bind(idx + m_offset, item);
+    }
+
+    virtual void sub_bindText(int idx, const char *item, size_t len) override {
+        m_target->bind(idx + m_offset, item, len);
+    }
+
+    virtual void sub_bindBlob(int idx, const std::string &item) override {
+        m_target->bindBlob(idx + m_offset, item);
+    }
+
+    virtual void sub_bindBlob(int idx, const std::vector<char> &item) override {
+        m_target->bindBlob(idx + m_offset, item);
+    }
+
+    virtual int sub_getNumColumns() const override {
+        _unsupported();
+        return 0;
+    }
+
+    virtual void sub_getColumnAsInt64(int, int64_t &) override {
+        _unsupported();
+    }
+
+    virtual void sub_getColumnAsDouble(int, double &) override {
+        _unsupported();
+    }
+
+    virtual void sub_getColumnAsDatetime(int, Datetime &) override {
+        _unsupported();
+    }
+
+    virtual void sub_getColumnAsText(int, std::string &) override {
+        _unsupported();
+    }
+
+    virtual void sub_getColumnAsBlob(int, std::string &) override {
+        _unsupported();
+    }
+
+    virtual void sub_getColumnAsBlob(int, std::vector<char> &) override {
+        _unsupported();
+    }
+
+private:
+    void _unsupported() const {
+        HKU_THROW("SQLOffsetBindStatement only supports bind! sql: {}", m_sql_string);
+    }
+
+private:
+    SQLStatementPtr m_target;
+    int m_offset = 0;
+};
+
+/**
+ * 单行 INSERT 语句的拆分结果，用于拼接多行 INSERT
+ * @details 如 "insert into t (a, b) values (?,?)" 拆分为 prefix "insert into t (a, b) values "、
+ * row "(?,?)"、suffix ""，params 为 2。
+ * @ingroup DBConnect
+ */
+struct SQLInsertTemplate {
+    std::string prefix;  ///< VALUES 关键字及之前的部分
+    std::string row;     ///< 单行参数组，如 "(?,?)"
+    std::string suffix;  ///< 参数组之后的部分（已去除末尾的分号）
+    size_t params = 0;   ///< 单行参数个数
+
+    /**
+     * 拆分单行 INSERT 语句
+     * @param sql 单行 INSERT 语句
+     * @return 语句中无 VALUES 参数组或无参数时返回 false
+     */
+    bool parse(const std::string &sql) {
+        params = 0;
+        size_t pos = _findValues(sql);
+        if (pos == std::string::npos) {
+            return false;
+        }
+
+        size_t start = sql.find('(', pos + 6);
+        if (start == std::string::npos) {
+            return false;
+        }
+        for (size_t i = pos + 6; i < start; i++) {
+            if (!std::isspace((unsigned char)sql[i])) {
+                return false;
+            }
+        }
+
+        int depth = 0;
+        size_t end = std::string::npos;
+        for (size_t i = start; i < sql.size(); i++) {
+            char c = sql[i];
+            if (c == '\'' || c == '"' || c == '`') {
+                // 参数组中含字面字符串时不做处理，退回单行插入
+                return false;
+            } else if (c == '(') {
+                depth++;
+            } else if (c == ')') {
+                if (--depth == 0) {
+                    end = i;
+                    break;
+                }
+            } else if (c == '?') {
+                params++;
+            }
+        }
+        if (end == std::string::npos || params == 0) {
+            params = 0;
+            return false;
+        }
+
+        prefix = sql.substr(0, start);
+        row = sql.substr(start, end - start + 1);
+        suffix = sql.substr(end + 1);
+        while (!suffix.empty() &&
+               (suffix.back() == ';' || std::isspace((unsigned char)suffix.back()))) {
+            suffix.pop_back();
+        }
+        return true;
+    }
+
+    /**
+     * 生成插入 rows 行记录的 INSERT 语句
+     * @param rows 行数
+     */
+    std::string build(size_t rows) const {
+        std::string sql;
+        sql.reserve(prefix.size() + (row.size() + 1) * rows + suffix.size());
+        sql.append(prefix);
+        for (size_t i = 0; i < rows; i++) {
+            if (i > 0) {
+                sql.push_back(',');
+            }
+            sql.append(row);
+        }
+        sql.append(suffix);
+        return sql;
+    }
+
+    /**
+     * 是否为不带冲突处理的普通 INSERT INTO 语句
+     * @details INSERT OR IGNORE、INSERT IGNORE、REPLACE INTO、ON CONFLICT、ON DUPLICATE KEY 等
+     * 会跳过或替换部分记录，此时插入记录的 id 不连续，无法合并插入后逐一回填
+     */
+    bool simple() const {
+        HKU_IF_RETURN(params == 0 || !suffix.empty(), false);
+        size_t pos = 0;
+        for (const char *keyword : {"INSERT", "INTO"}) {
+            while (pos < prefix.size() && std::isspace((unsigned char)prefix[pos])) {
+                pos++;
+            }
+            for (const char *c = keyword; *c; c++, pos++) {
+                if (pos >= prefix.size() || std::toupper((unsigned char)prefix[pos]) != *c) {
+                    return false;
+                }
+            }
+            if (pos >= prefix.size() || !std::isspace((unsigned char)prefix[pos])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    // 查找最后一个独立的 VALUES 关键字（忽略大小写）
+    static size_t _findValues(const std::string &sql) {
+        static const char *keyword = "VALUES";
+        if (sql.size() < 6) {
+            return std::string::npos;
+        }
+        for (size_t i = sql.size() - 6 + 1; i-- > 0;) {
+            size_t j = 0;
+            while (j < 6 && std::toupper((unsigned char)sql[i + j]) == keyword[j]) {
+                j++;
+            }
+            if (j < 6) {
+                continue;
+            }
+            bool left = i == 0 || !(std::isalnum((unsigned char)sql[i - 1]) || sql[i - 1] == '_');
+            bool right = i + 6 == sql.size() ||
+                         !(std::isalnum((unsigned char)sql[i + 6]) || sql[i + 6] == '_');
+            if (left && right) {
+                return i;
+            }
+        }
+        return std::string::npos;
+    }
+};
+
+}  // namespace hku
+
+#endif /* HIKYUU_DB_CONNECT_SQLBATCHINSERT_H */
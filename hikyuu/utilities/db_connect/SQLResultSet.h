@@ -7,7 +7,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <future>
 #include <iterator>
+#include <memory>
+#include <sstream>
 #include "hikyuu/utilities/arithmetic.h"
 #include "hikyuu/utilities/Log.h"
 #include "hikyuu/utilities/osdef.h"
@@ -20,6 +24,16 @@ class SQLResultSetIterator;
 
 /**
  * SQL查询结果集
+ * @details 默认使用 LIMIT/OFFSET 分页，OFFSET 的开销随页号线性增长。开启 keysetPagination 后，
+ * 顺序访问下一页时以上一页最后一条记录定位下一页（绑定其 id），开销与页号无关；随机访问其他页时
+ * 仍使用 OFFSET。键集分页要求排序条件为空（按 id 排序）或仅含单个非空列（如 "ORDER BY time DESC"），
+ * 定位条件为：
+ * - 按 id 排序时为 "id > ?"，DESC 时为 "id < ?"
+ * - 按列 key 排序时为 "key >= k AND (key > k OR id > ?)"，k 为上一页最后记录的 key 值，由其 id
+ *   子查询获得；DESC 时 key 的比较改为 "<=" 与 "<"，同值记录仍按 id 升序（排序条件会附加 id ASC）
+ * 加载一页时记录最后一条记录的 key 值，定位前若该记录已被删除或 key 值已改变，该页改用 OFFSET 读取；
+ * 定位结果少于 OFFSET 可读取的记录数时同样改用 OFFSET 重新读取。
+ * 通过 readAhead 指定独立的数据库连接后，键集分页加载一页后即在后台线程中预读下一页。
  * @tparam TableT 数据结构
  * @tparam page_size 每页包含的数据数量
  * @ingroup DBConnect
@@ -50,6 +64,7 @@ public:
         if (m_where.empty()) {
             m_where = "1=1";
             m_orderby_inner = "ORDER BY id";
+            _parseSeekKey(m_orderby_inner);
             // m_orderby_outer = "";
             return;
         }
@@ -60,9 +75,11 @@ public:
         if (pos != std::string::npos) {
             m_orderby_inner = fmt::format("{}, id ASC", m_where.substr(pos));
             m_orderby_outer = m_orderby_inner;
+            _parseSeekKey(m_where.substr(pos));
             m_where = m_where.erase(pos, std::string::npos);
         } else {
             m_orderby_inner = "ORDER BY id";
+            _parseSeekKey(m_orderby_inner);
         }
     }
 
@@ -71,6 +88,35 @@ public:
         return m_connect;
     }
 
+    /** 是否开启键集分页 */
+    bool keysetPagination() const {
+        return m_keyset;
+    }
+
+    /**
+     * 开启或关闭键集分页
+     * @note 排序条件不满足键集分页的要求时，仍使用 LIMIT/OFFSET 分页
+     */
+    void keysetPagination(bool enable) {
+        HKU_WARN_IF(enable && m_seek_params == 0,
+                    "Keyset pagination requires ordering by a single column, use OFFSET instead!");
+        m_keyset = enable;
+    }
+
+    /** 获取用于预读的数据库连接 */
+    const DBConnectPtr& readAhead() const {
+        return m_prefetch_connect;
+    }
+
+    /**
+     * 设置用于后台预读下一页的数据库连接，仅在键集分页时生效
+     * @param connect 独立的数据库连接，预读期间不可在其他线程中使用，为空时关闭预读
+     */
+    void readAhead(const DBConnectPtr& connect) {
+        m_prefetch.reset();
+        m_prefetch_connect = connect;
+    }
+
     using const_iterator = SQLResultSetIterator<TableT, page_size>;
     using iterator = SQLResultSetIterator<TableT, page_size>;
 
@@ -128,11 +174,7 @@ public:
      * @return std::vector<TableT> 该页包含的所有有效数据集
      */
     std::vector<TableT> getPage(size_t page) {
-        std::vector<TableT> result;
-        m_connect->batchLoad(
-          result, fmt::format(m_sql_template, TableT::getTableName(), m_where, m_orderby_inner,
-                              page_size, page * page_size, m_orderby_outer));
-        return result;
+        return _loadPage(page);
     }
 
     TableT operator[](size_t index) {
@@ -152,10 +194,7 @@ private:
 
         size_t page = index / page_size;
         if (m_connect && page != m_current_page) {
-            m_buffer.clear();
-            m_connect->batchLoad(
-              m_buffer, fmt::format(fmt::runtime(m_sql_template), TableT::getTableName(), m_where,
-                                    m_orderby_inner, page_size, page * page_size, m_orderby_outer));
+            m_buffer = _loadPage(page);
             m_current_page = page;
         }
 
@@ -168,7 +207,147 @@ private:
         return result;
     }
 
+    // 解析排序条件中的键集分页列，仅支持单个列，如 "ORDER BY time DESC"
+    void _parseSeekKey(const std::string& orderby) {
+        m_seek_params = 0;
+        std::istringstream in(orderby);
+        std::string order, by, key, direction, rest;
+        in >> order >> by >> key >> direction >> rest;
+        to_upper(by);
+        to_upper(direction);
+        HKU_IF_RETURN(by != "BY" || key.empty() || !rest.empty(), void());
+        HKU_IF_RETURN(key.find_first_of(",()") != std::string::npos, void());
+        HKU_IF_RETURN(!direction.empty() && direction != "ASC" && direction != "DESC", void());
+
+        const char* op = direction == "DESC" ? "<" : ">";
+        std::string name(key);
+        name.erase(std::remove_if(name.begin(), name.end(),
+                                  [](char c) { return c == '`' || c == '"'; }),
+                   name.end());
+        to_upper(name);
+        if (name == "ID") {
+            m_seek_cond = fmt::format("id {} ?", op);
+            m_seek_params = 1;
+        } else {
+            m_seek_key_sql = fmt::format("SELECT {} FROM {} WHERE id=?", key,
+                                         TableT::getTableName());
+            // 冗余的 >=（<=）条件使数据库可利用该列上的索引直接定位
+            m_seek_cond = fmt::format("{} {}= ({}) AND ({} {} ({}) OR id > ?)", key, op,
+                                      m_seek_key_sql, key, op, m_seek_key_sql);
+            m_seek_params = 3;
+        }
+    }
+
+    std::vector<TableT> _loadPage(size_t page) {
+        std::vector<TableT> result;
+        HKU_IF_RETURN(!m_connect, result);
+
+        bool keyset = m_keyset && m_seek_params > 0;
+        bool seek = keyset && m_seek_page != Null<size_t>() && page == m_seek_page + 1;
+        if (seek && !m_seek_key_sql.empty()) {
+            // 上一页最后记录已被删除或其排序列的值已改变时，无法据此定位
+            std::string key;
+            seek = _readSeekKey(m_seek_last_id, key) && key == m_seek_last_key;
+        }
+        if (keyset && (page == 0 || seek)) {
+            if (m_prefetch && m_prefetch->page == page && m_prefetch->future.valid()) {
+                try {
+                    result = m_prefetch->future.get();
+                } catch (const std::exception& e) {
+                    HKU_WARN("Failed read ahead page {}! {}", page, e.what());
+                    result = _seek(m_connect, _seekSQL(seek), seek ? m_seek_params : 0,
+                                   m_seek_last_id);
+                }
+            } else {
+                m_prefetch.reset();
+                result =
+                  _seek(m_connect, _seekSQL(seek), seek ? m_seek_params : 0, m_seek_last_id);
+            }
+            // 定位期间上一页最后记录被删除等情况下结果不完整，以 OFFSET 重新读取
+            if (seek && result.size() < page_size && result.size() + page * page_size < size()) {
+                result = _loadPageByOffset(page);
+            }
+        } else {
+            m_prefetch.reset();
+            result = _loadPageByOffset(page);
+        }
+        m_prefetch.reset();
+
+        if (keyset && !result.empty()) {
+            m_seek_page = page;
+            m_seek_last_id = result.back().id();
+            if (!m_seek_key_sql.empty() && !_readSeekKey(m_seek_last_id, m_seek_last_key)) {
+                m_seek_page = Null<size_t>();
+            }
+            if (m_seek_page != Null<size_t>() && m_prefetch_connect &&
+                result.size() == page_size) {
+                _startPrefetch(page + 1);
+            }
+        }
+        return result;
+    }
+
+    std::vector<TableT> _loadPageByOffset(size_t page) {
+        std::vector<TableT> result;
+        m_connect->batchLoad(result, fmt::format(fmt::runtime(m_sql_template),
+                                                 TableT::getTableName(), m_where, m_orderby_inner,
+                                                 page_size, page * page_size, m_orderby_outer));
+        return result;
+    }
+
+    // 读取记录 id 的排序列的值，以文本比较是否改变，记录不存在时返回 false
+    bool _readSeekKey(uint64_t id, std::string& key) const {
+        SQLStatementPtr st = m_connect->getStatement(m_seek_key_sql);
+        st->bind(0, id);
+        st->exec();
+        HKU_IF_RETURN(!st->moveNext(), false);
+        st->getColumn(0, key);
+        return true;
+    }
+
+    // 键集分页查询语句，seek 为 false 时查询第一页
+    std::string _seekSQL(bool seek) const {
+        if (seek) {
+            return fmt::format("{} where ({}) AND {} {} LIMIT {}", TableT::getSelectSQL(), m_where,
+                               m_seek_cond, m_orderby_inner, page_size);
+        }
+        return fmt::format("{} where {} {} LIMIT {}", TableT::getSelectSQL(), m_where,
+                           m_orderby_inner, page_size);
+    }
+
+    static std::vector<TableT> _seek(const DBConnectPtr& connect, const std::string& sql,
+                                     int params, uint64_t last_id) {
+        std::vector<TableT> result;
+        result.reserve(page_size);
+        SQLStatementPtr st = connect->getStatement(sql);
+        for (int i = 0; i < params; i++) {
+            st->bind(i, last_id);
+        }
+        st->exec();
+        while (st->moveNext()) {
+            TableT tmp;
+            tmp.load(st);
+            result.push_back(std::move(tmp));
+        }
+        return result;
+    }
+
+    void _startPrefetch(size_t page) {
+        auto prefetch = std::make_shared<Prefetch>();
+        prefetch->page = page;
+        prefetch->future =
+          std::async(std::launch::async, &SQLResultSet::_seek, m_prefetch_connect, _seekSQL(true),
+                     m_seek_params, m_seek_last_id);
+        m_prefetch = prefetch;
+    }
+
 private:
+    // 后台预读的页，future 析构时等待预读完成
+    struct Prefetch {
+        size_t page = Null<size_t>();
+        std::future<std::vector<TableT>> future;
+    };
+
     DBConnectPtr m_connect;
     std::vector<TableT> m_buffer;
     std::string m_where;
@@ -176,6 +355,16 @@ private:
     std::string m_orderby_inner;
     std::string m_orderby_outer;
     size_t m_current_page = Null<size_t>();
+
+    bool m_keyset = false;                 // 是否开启键集分页
+    std::string m_seek_cond;               // 键集分页定位条件
+    std::string m_seek_key_sql;            // 按 id 查询排序列的值，按 id 排序时为空
+    int m_seek_params = 0;                 // 定位条件的参数个数，为 0 时不支持键集分页
+    size_t m_seek_page = Null<size_t>();   // 最近加载的页
+    uint64_t m_seek_last_id = 0;           // 最近加载页中最后一条记录的 id
+    std::string m_seek_last_key;           // 最后一条记录加载时排序列的值
+    DBConnectPtr m_prefetch_connect;       // 预读使用的数据库连接
+    std::shared_ptr<Prefetch> m_prefetch;  // 进行中的预读
 };
 
 template <class TableT, size_t page_size>
@@ -0,0 +1,207 @@
+/*
+ * SQLRowCursor.h
+ *
+ *  Copyright (c) 2026, hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+#pragma once
+#ifndef HIKYUU_DB_CONNECT_SQLROWCURSOR_H
+#define HIKYUU_DB_CONNECT_SQLROWCURSOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <vector>
+#include "SQLStatementBase.h"
+
+namespace hku {
+
+/**
+ * 查询结果的流式游标，逐行读取而不将全部结果加载至容器
+ * @details 游标持有一个行对象，每次前进时从语句中加载下一行至该对象，迭代器解引用返回其引用，
+ * 调用者可将其移出（std::move）。reuse 为 true 时复用同一对象（字符串等成员的内存得以复用），
+ * 但 TABLE_BIND 的序列化成员遇到 NULL 时不会被覆盖，会保留上一行的值；reuse 为 false 时，
+ * 每行加载前重置为默认构造的对象。游标在析构前持有语句，同一连接上的其他查询不受影响。
+ * @code
+ *  for (auto &row : driver->cursor<TTT>("age > 10")) {
+ *      process(std::move(row));
+ *  }
+ * @endcode
+ * @tparam TableT 通过 TABLE_BIND 绑定的表模型
+ * @ingroup DBConnect
+ */
+template <typename TableT>
+class SQLRowCursor {
+public:
+    /** 游标的输入迭代器 */
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = TableT;
+        using difference_type = std::ptrdiff_t;
+        using pointer = TableT *;
+        using reference = TableT &;
+
+        iterator() = default;
+        explicit iterator(SQLRowCursor *cursor) : m_cursor(cursor) {}
+
+        reference operator*() const {
+            return m_cursor->m_row;
+        }
+
+        pointer operator->() const {
+            return &m_cursor->m_row;
+        }
+
+        iterator &operator++() {
+            if (!m_cursor->next()) {
+                m_cursor = nullptr;
+            }
+            return *this;
+        }
+
+        bool operator==(const iterator &other) const {
+            return m_cursor == other.m_cursor;
+        }
+
+        bool operator!=(const iterator &other) const {
+            return m_cursor != other.m_cursor;
+        }
+
+    private:
+        SQLRowCursor *m_cursor = nullptr;
+    };
+
+    /**
+     * 构造函数
+     * @param st 未执行的查询语句
+     * @param reuse 是否复用同一行对象
+     */
+    explicit SQLRowCursor(const SQLStatementPtr &st, bool reuse = false)
+    : m_st(st), m_reuse(reuse) {}
+
+    SQLRowCursor(SQLRowCursor &&) = default;
+    SQLRowCursor &operator=(SQLRowCursor &&) = default;
+    SQLRowCursor(const SQLRowCursor &) = delete;
+    SQLRowCursor &operator=(const SQLRowCursor &) = delete;
+
+    /** 执行查询并返回指向第一行的迭代器，仅可调用一次 */
+    iterator begin() {
+        return next() ? iterator(this) : iterator();
+    }
+
+    /** 结束迭代器 */
+    iterator end() {
+        return iterator();
+    }
+
+    /**
+     * 前进至下一行，首次调用时执行查询
+     * @return 无更多数据时返回 false
+     */
+    bool next() {
+        if (!m_executed) {
+            m_st->exec();
+            m_executed = true;
+        }
+        HKU_IF_RETURN(!m_st->moveNext(), false);
+        if (!m_reuse) {
+            m_row = TableT();
+        }
+        m_row.load(m_st);
+        m_count++;
+        return true;
+    }
+
+    /** 当前行 */
+    TableT &row() {
+        return m_row;
+    }
+
+    /** 已读取的行数 */
+    size_t count() const {
+        return m_count;
+    }
+
+private:
+    SQLStatementPtr m_st;
+    TableT m_row;
+    size_t m_count = 0;
+    bool m_reuse;
+    bool m_executed = false;
+};
+
+/**
+ * 有界的生产者/消费者队列，用于查询结果的并行处理
+ * @details 队列满时生产者阻塞，限制读取速度超过处理速度时的内存占用。close 后 pop 在队列
+ * 取空时返回 false；abort 后 push 与 pop 均立即返回 false。
+ * @ingroup DBConnect
+ */
+template <typename T>
+class SQLRowQueue {
+public:
+    /**
+     * 构造函数
+     * @param capacity 队列容量，最小为 1
+     */
+    explicit SQLRowQueue(size_t capacity) : m_capacity(capacity > 0 ? capacity : 1) {}
+
+    /** 放入元素，队列满时等待，队列已中止时返回 false */
+    bool push(T &&item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_full.wait(lock, [this] { return m_aborted || m_queue.size() < m_capacity; });
+        HKU_IF_RETURN(m_aborted, false);
+        m_queue.push_back(std::move(item));
+        lock.unlock();
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    /** 取出元素，队列为空时等待，队列已关闭且取空或已中止时返回 false */
+    bool pop(T &item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_empty.wait(lock, [this] { return m_aborted || m_closed || !m_queue.empty(); });
+        HKU_IF_RETURN(m_aborted || m_queue.empty(), false);
+        item = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+        m_not_full.notify_one();
+        return true;
+    }
+
+    /** 关闭队列，不再放入新元素，消费者取完剩余元素后退出 */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_not_empty.notify_all();
+    }
+
+    /** 中止队列，丢弃剩余元素，生产者和消费者均立即退出 */
+    void abort() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_aborted = true;
+            m_queue.clear();
+        }
+        m_not_empty.notify_all();
+        m_not_full.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+    std::deque<T> m_queue;
+    size_t m_capacity;
+    bool m_closed = false;
+    bool m_aborted = false;
+};
+
+}  // namespace hku
+
+#endif /* HIKYUU_DB_CONNECT_SQLROWCURSOR_H */
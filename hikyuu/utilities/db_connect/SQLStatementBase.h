@@ -59,6 +59,9 @@ public:
     /** 移动至下一结果 */
     bool moveNext();
 
+    /** 重置语句至未执行状态，并清除已绑定的参数，以便复用已预编译的语句 */
+    void reset();
+
     /** 将 null 绑定至 idx 指定的 SQL 参数中 */
     void bind(int idx);  // bind_null
 
@@ -102,6 +105,13 @@ public:
     /** 获取执行INSERT时最后插入记录的 rowid，非线程安全 */
     uint64_t getLastRowid();
 
+    /**
+     * 获取执行多行 INSERT 时插入的各记录 rowid，非线程安全
+     * @param count 本次插入的记录数
+     * @param rowids 按插入顺序输出各记录的 rowid
+     */
+    void getInsertedRowids(size_t count, std::vector<uint64_t> &rowids);
+
     /** 获取表格列数 */
     int getNumColumns() const;
 
@@ -137,6 +147,9 @@ public:
     virtual void sub_exec() = 0;              ///< 子类接口 @see exec
     virtual bool sub_moveNext() = 0;          ///< 子类接口 @see moveNext
     virtual uint64_t sub_getLastRowid() = 0;  ///< 子类接口 @see getLastRowid();
+    virtual void sub_reset() = 0;             ///< 子类接口 @see reset
+    virtual void sub_getInsertedRowids(
+      size_t count, std::vector<uint64_t> &rowids) = 0;  ///< 子类接口 @see getInsertedRowids
 
     virtual void sub_bindNull(int idx) = 0;                            ///< 子类接口 @see bind
     virtual void sub_bindInt(int idx, int64_t value) = 0;              ///< 子类接口 @see bind
@@ -195,6 +208,10 @@ inline bool SQLStatementBase::moveNext() {
     return sub_moveNext();
 }
 
+inline void SQLStatementBase::reset() {
+    sub_reset();
+}
+
 inline void SQLStatementBase::bind(int idx) {
     sub_bindNull(idx);
 }
@@ -207,6 +224,10 @@ inline void SQLStatementBase::bind(int idx, double item) {
     sub_bindDouble(idx, item);
 }
 
+inline void SQLStatementBase::bind(int idx, const char *item, size_t len) {
+    sub_bindText(idx, item, len);
+}
+
 inline void SQLStatementBase::bind(int idx, const Datetime &item) {
     sub_bindDatetime(idx, item);
 }
@@ -223,6 +244,11 @@ inline uint64_t SQLStatementBase::getLastRowid() {
     return sub_getLastRowid();
 }
 
+inline void SQLStatementBase::getInsertedRowids(size_t count, std::vector<uint64_t> &rowids) {
+    rowids.clear();
+    sub_getInsertedRowids(count, rowids);
+}
+
 inline int SQLStatementBase::getNumColumns() const {
     return sub_getNumColumns();
 }
@@ -0,0 +1,581 @@
+/*
+ * DuckDBColumn.h
+ *
+ *  Copyright (c) 2026, hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+#pragma once
+#ifndef HIKYUU_DB_CONNECT_DUCKDB_DUCKDBCOLUMN_H
+#define HIKYUU_DB_CONNECT_DUCKDB_DUCKDBCOLUMN_H
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <duckdb.h>
+#include "hikyuu/utilities/datetime/Datetime.h"
+#include "../SQLException.h"
+
+namespace hku {
+
+/**
+ * DuckDB 结果列的类型信息
+ * @ingroup DuckDB
+ */
+struct DuckDBColumnType {
+    duckdb_type type = DUCKDB_TYPE_INVALID;      ///< 列类型
+    duckdb_type internal = DUCKDB_TYPE_INVALID;  ///< DECIMAL 与 ENUM 的存储类型
+    double scale = 1.0;                          ///< DECIMAL 的缩放因子，即 10^小数位数
+    uint8_t decimals = 0;                        ///< DECIMAL 的小数位数
+    std::vector<std::string> dictionary;         ///< ENUM 的取值
+
+    DuckDBColumnType() = default;
+
+    /** 从结果集的第 col 列获取类型信息 */
+    DuckDBColumnType(duckdb_result *result, idx_t col) {
+        duckdb_logical_type logical = duckdb_column_logical_type(result, col);
+        type = duckdb_get_type_id(logical);
+        if (type == DUCKDB_TYPE_DECIMAL) {
+            internal = duckdb_decimal_internal_type(logical);
+            decimals = duckdb_decimal_scale(logical);
+            scale = std::pow(10.0, decimals);
+        } else if (type == DUCKDB_TYPE_ENUM) {
+            internal = duckdb_enum_internal_type(logical);
+            uint32_t size = duckdb_enum_dictionary_size(logical);
+            dictionary.reserve(size);
+            for (uint32_t i = 0; i < size; i++) {
+                char *value = duckdb_enum_dictionary_value(logical, i);
+                dictionary.emplace_back(value);
+                duckdb_free(value);
+            }
+        }
+        duckdb_destroy_logical_type(&logical);
+    }
+};
+
+/**
+ * 直接读取 duckdb_data_chunk 中一列数据的只读视图
+ * @details 按列类型直接访问向量的原始数据并转换为所需的类型，数值及日期时间的读取不分配内存，
+ * 文本写入调用者提供的字符串，可复用其容量。视图在所属 data chunk 销毁前有效。
+ * @ingroup DuckDB
+ */
+class DuckDBVectorReader {
+public:
+    DuckDBVectorReader() = default;
+
+    /**
+     * 构造函数
+     * @param chunk 数据块
+     * @param col 列序号
+     * @param type 列类型信息
+     */
+    DuckDBVectorReader(duckdb_data_chunk chunk, idx_t col, const DuckDBColumnType &type)
+    : m_type(&type) {
+        duckdb_vector vec = duckdb_data_chunk_get_vector(chunk, col);
+        m_data = duckdb_vector_get_data(vec);
+        m_validity = duckdb_vector_get_validity(vec);
+    }
+
+    /** 指定行是否为 NULL */
+    bool isNull(idx_t row) const {
+        return m_validity && !duckdb_validity_row_is_valid(m_validity, row);
+    }
+
+    /** 读取为整数，超出 int64 范围时抛出异常 */
+    int64_t getInt64(idx_t row) const {
+        switch (m_type->type) {
+            case DUCKDB_TYPE_BOOLEAN:
+                return _at<bool>(row) ? 1 : 0;
+            case DUCKDB_TYPE_TINYINT:
+                return _at<int8_t>(row);
+            case DUCKDB_TYPE_SMALLINT:
+                return _at<int16_t>(row);
+            case DUCKDB_TYPE_INTEGER:
+                return _at<int32_t>(row);
+            case DUCKDB_TYPE_BIGINT:
+                return _at<int64_t>(row);
+            case DUCKDB_TYPE_UTINYINT:
+                return _at<uint8_t>(row);
+            case DUCKDB_TYPE_USMALLINT:
+                return _at<uint16_t>(row);
+            case DUCKDB_TYPE_UINTEGER:
+                return _at<uint32_t>(row);
+            case DUCKDB_TYPE_UBIGINT: {
+                uint64_t value = _at<uint64_t>(row);
+                if (value > uint64_t(std::numeric_limits<int64_t>::max())) {
+                    _outOfRange();
+                }
+                return static_cast<int64_t>(value);
+            }
+            case DUCKDB_TYPE_HUGEINT: {
+                const duckdb_hugeint &value = _at<duckdb_hugeint>(row);
+                // 高 64 位仅为低 64 位的符号扩展时才在 int64 范围内
+                if (value.upper != (static_cast<int64_t>(value.lower) < 0 ? -1 : 0)) {
+                    _outOfRange();
+                }
+                return static_cast<int64_t>(value.lower);
+            }
+            case DUCKDB_TYPE_UHUGEINT: {
+                const duckdb_uhugeint &value = _at<duckdb_uhugeint>(row);
+                if (value.upper != 0 ||
+                    value.lower > uint64_t(std::numeric_limits<int64_t>::max())) {
+                    _outOfRange();
+                }
+                return static_cast<int64_t>(value.lower);
+            }
+            case DUCKDB_TYPE_FLOAT:
+            case DUCKDB_TYPE_DOUBLE:
+            case DUCKDB_TYPE_DECIMAL:
+                return static_cast<int64_t>(getDouble(row));
+            case DUCKDB_TYPE_DATE:
+                return _at<duckdb_date>(row).days;
+            case DUCKDB_TYPE_TIMESTAMP:
+            case DUCKDB_TYPE_TIMESTAMP_S:
+            case DUCKDB_TYPE_TIMESTAMP_MS:
+            case DUCKDB_TYPE_TIMESTAMP_NS:
+            case DUCKDB_TYPE_TIMESTAMP_TZ:
+                return _micros(row);
+            case DUCKDB_TYPE_VARCHAR: {
+                std::string tmp;
+                getText(row, tmp);
+                return std::stoll(tmp);
+            }
+            default:
+                _unsupported("int64");
+        }
+        return 0;
+    }
+
+    /** 读取为浮点数 */
+    double getDouble(idx_t row) const {
+        switch (m_type->type) {
+            case DUCKDB_TYPE_FLOAT:
+                return _at<float>(row);
+            case DUCKDB_TYPE_DOUBLE:
+                return _at<double>(row);
+            case DUCKDB_TYPE_UBIGINT:
+                return static_cast<double>(_at<uint64_t>(row));
+            case DUCKDB_TYPE_HUGEINT:
+                return _hugeint(_at<duckdb_hugeint>(row));
+            case DUCKDB_TYPE_UHUGEINT: {
+                const duckdb_uhugeint &value = _at<duckdb_uhugeint>(row);
+                return static_cast<double>(value.upper) * 18446744073709551616.0 +
+                       static_cast<double>(value.lower);
+            }
+            case DUCKDB_TYPE_DECIMAL:
+                switch (m_type->internal) {
+                    case DUCKDB_TYPE_SMALLINT:
+                        return _at<int16_t>(row) / m_type->scale;
+                    case DUCKDB_TYPE_INTEGER:
+                        return _at<int32_t>(row) / m_type->scale;
+                    case DUCKDB_TYPE_BIGINT:
+                        return _at<int64_t>(row) / m_type->scale;
+                    case DUCKDB_TYPE_HUGEINT:
+                        return _hugeint(_at<duckdb_hugeint>(row)) / m_type->scale;
+                    default:
+                        _unsupported("double");
+                }
+                return 0.0;
+            case DUCKDB_TYPE_VARCHAR: {
+                std::string tmp;
+                getText(row, tmp);
+                return std::stod(tmp);
+            }
+            default:
+                return static_cast<double>(getInt64(row));
+        }
+    }
+
+    /**
+     * 读取为文本，除以下情况外与 DuckDB 转换为 VARCHAR 的结果一致：
+     * @details
+     * - VARCHAR 与 BLOB 返回原始内容，BLOB 不做转义
+     * - TIMESTAMP_TZ 固定按 UTC 输出并附加 "+00"，不受连接的 TimeZone 设置影响
+     * - FLOAT 总是输出最短可还原的表示，DuckDB 在少数情况下会多输出几位，如 "2710035.25"
+     *   而非 "2710035.2"，两者还原后为同一数值
+     * - LIST、STRUCT、MAP 等嵌套类型及 BIT 等其他类型不支持，抛出异常，需在 SQL 中转换为 VARCHAR
+     */
+    void getText(idx_t row, std::string &item) const {
+        switch (m_type->type) {
+            case DUCKDB_TYPE_VARCHAR:
+            case DUCKDB_TYPE_BLOB: {
+                const duckdb_string_t &str = _at<duckdb_string_t>(row);
+                uint32_t len = str.value.inlined.length;
+                item.assign(len <= 12 ? str.value.inlined.inlined : str.value.pointer.ptr, len);
+                break;
+            }
+            case DUCKDB_TYPE_BOOLEAN:
+                item = _at<bool>(row) ? "true" : "false";
+                break;
+            case DUCKDB_TYPE_TINYINT:
+            case DUCKDB_TYPE_SMALLINT:
+            case DUCKDB_TYPE_INTEGER:
+            case DUCKDB_TYPE_BIGINT:
+            case DUCKDB_TYPE_UTINYINT:
+            case DUCKDB_TYPE_USMALLINT:
+            case DUCKDB_TYPE_UINTEGER:
+                item = std::to_string(getInt64(row));
+                break;
+            case DUCKDB_TYPE_UBIGINT:
+                item = std::to_string(_at<uint64_t>(row));
+                break;
+            case DUCKDB_TYPE_HUGEINT:
+                item = _hugeintText(_at<duckdb_hugeint>(row));
+                break;
+            case DUCKDB_TYPE_UHUGEINT: {
+                const duckdb_uhugeint &value = _at<duckdb_uhugeint>(row);
+                item = _uint128Text(value.upper, value.lower);
+                break;
+            }
+            case DUCKDB_TYPE_FLOAT:
+                item = _floatText(_at<float>(row));
+                break;
+            case DUCKDB_TYPE_DOUBLE:
+                item = _floatText(_at<double>(row));
+                break;
+            case DUCKDB_TYPE_DECIMAL:
+                item = _decimalText(row);
+                break;
+            case DUCKDB_TYPE_DATE: {
+                int32_t days = _at<duckdb_date>(row).days;
+                if (days == std::numeric_limits<int32_t>::max()) {
+                    item = "infinity";
+                } else if (days == -std::numeric_limits<int32_t>::max()) {
+                    item = "-infinity";
+                } else {
+                    item = _dateText(duckdb_from_date(duckdb_date{days}));
+                }
+                break;
+            }
+            case DUCKDB_TYPE_TIME:
+                item = _timeText(duckdb_from_time(_at<duckdb_time>(row)));
+                break;
+            case DUCKDB_TYPE_TIME_TZ: {
+                duckdb_time_tz_struct t = duckdb_from_time_tz(_at<duckdb_time_tz>(row));
+                item = _timeText(t.time);
+                int32_t offset = std::abs(t.offset);
+                item.append(fmt::format("{}{:02d}", t.offset < 0 ? '-' : '+', offset / 3600));
+                if (offset % 3600 != 0) {
+                    item.append(fmt::format(":{:02d}", offset % 3600 / 60));
+                    if (offset % 60 != 0) {
+                        item.append(fmt::format(":{:02d}", offset % 60));
+                    }
+                }
+                break;
+            }
+            case DUCKDB_TYPE_TIMESTAMP:
+            case DUCKDB_TYPE_TIMESTAMP_S:
+            case DUCKDB_TYPE_TIMESTAMP_MS:
+            case DUCKDB_TYPE_TIMESTAMP_NS:
+            case DUCKDB_TYPE_TIMESTAMP_TZ:
+                item = _timestampText(row);
+                break;
+            case DUCKDB_TYPE_INTERVAL:
+                item = _intervalText(_at<duckdb_interval>(row));
+                break;
+            case DUCKDB_TYPE_UUID: {
+                // DuckDB 存储时翻转了最高位，以保证按有符号数比较时的顺序
+                const duckdb_hugeint &value = _at<duckdb_hugeint>(row);
+                uint64_t upper = static_cast<uint64_t>(value.upper) ^ (uint64_t(1) << 63);
+                item = fmt::format("{:08x}-{:04x}-{:04x}-{:04x}-{:012x}", upper >> 32,
+                                   (upper >> 16) & 0xffff, upper & 0xffff, value.lower >> 48,
+                                   value.lower & 0xffffffffffffULL);
+                break;
+            }
+            case DUCKDB_TYPE_ENUM:
+                item = m_type->dictionary.at(_enumIndex(row));
+                break;
+            default:
+                _unsupported("text");
+        }
+    }
+
+    /** 读取为日期时间 */
+    Datetime getDatetime(idx_t row) const {
+        switch (m_type->type) {
+            case DUCKDB_TYPE_DATE: {
+                duckdb_date_struct d = duckdb_from_date(_at<duckdb_date>(row));
+                return Datetime(d.year, d.month, d.day);
+            }
+            case DUCKDB_TYPE_TIMESTAMP:
+            case DUCKDB_TYPE_TIMESTAMP_S:
+            case DUCKDB_TYPE_TIMESTAMP_MS:
+            case DUCKDB_TYPE_TIMESTAMP_NS:
+            case DUCKDB_TYPE_TIMESTAMP_TZ: {
+                duckdb_timestamp_struct t = duckdb_from_timestamp(duckdb_timestamp{_micros(row)});
+                return Datetime(t.date.year, t.date.month, t.date.day, t.time.hour, t.time.min,
+                                t.time.sec, t.time.micros / 1000, t.time.micros % 1000);
+            }
+            case DUCKDB_TYPE_VARCHAR: {
+                std::string tmp;
+                getText(row, tmp);
+                return tmp.empty() ? Datetime() : Datetime(tmp);
+            }
+            default:
+                _unsupported("Datetime");
+        }
+        return Datetime();
+    }
+
+    /** 读取为 item 的类型，NULL 时为默认值 */
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type get(idx_t row, T &item) const {
+        if (isNull(row)) {
+            item = T();
+        } else if (std::is_floating_point<T>::value) {
+            item = static_cast<T>(getDouble(row));
+        } else {
+            item = static_cast<T>(getInt64(row));
+        }
+    }
+
+    /** 读取为文本，NULL 时为空字符串 */
+    void get(idx_t row, std::string &item) const {
+        if (isNull(row)) {
+            item.clear();
+        } else {
+            getText(row, item);
+        }
+    }
+
+    /** 读取为日期时间，NULL 时为 Null<Datetime>() */
+    void get(idx_t row, Datetime &item) const {
+        item = isNull(row) ? Datetime() : getDatetime(row);
+    }
+
+    /** 将前 count 行追加至 column */
+    template <typename T>
+    void append(idx_t count, std::vector<T> &column) const {
+        size_t start = column.size();
+        column.resize(start + count);
+        for (idx_t row = 0; row < count; row++) {
+            if constexpr (std::is_same<T, bool>::value) {
+                bool value;  // std::vector<bool> 的元素不可取引用
+                get(row, value);
+                column[start + row] = value;
+            } else {
+                get(row, column[start + row]);
+            }
+        }
+    }
+
+private:
+    template <typename T>
+    const T &_at(idx_t row) const {
+        return static_cast<const T *>(m_data)[row];
+    }
+
+    int64_t _micros(idx_t row) const {
+        int64_t value = _at<duckdb_timestamp>(row).micros;
+        switch (m_type->type) {
+            case DUCKDB_TYPE_TIMESTAMP_S:
+                return value * 1000000;
+            case DUCKDB_TYPE_TIMESTAMP_MS:
+                return value * 1000;
+            case DUCKDB_TYPE_TIMESTAMP_NS:
+                // 向下取整，1970 年前的时间不会进位到下一微秒
+                return value >= 0 ? value / 1000 : (value - 999) / 1000;
+            default:
+                return value;
+        }
+    }
+
+    /** 时间戳文本，如 "2024-01-02 03:04:05.5" */
+    std::string _timestampText(idx_t row) const {
+        int64_t value = _at<duckdb_timestamp>(row).micros;
+        if (value == std::numeric_limits<int64_t>::max()) {
+            return "infinity";
+        } else if (value == -std::numeric_limits<int64_t>::max()) {
+            return "-infinity";
+        }
+
+        int64_t micros = _micros(row);
+        duckdb_timestamp_struct t = duckdb_from_timestamp(duckdb_timestamp{micros});
+        std::string text = _dateText(t.date);
+        text.append(fmt::format(" {:02d}:{:02d}:{:02d}", t.time.hour, t.time.min, t.time.sec));
+        if (m_type->type == DUCKDB_TYPE_TIMESTAMP_NS) {
+            _appendFraction(text, t.time.micros * 1000 + (value - micros * 1000), 9);
+        } else {
+            _appendFraction(text, t.time.micros, 6);
+        }
+        if (m_type->type == DUCKDB_TYPE_TIMESTAMP_TZ) {
+            text.append("+00");
+        }
+        return text;
+    }
+
+    /** 日期文本，公元前的年份按 DuckDB 的格式附加 " (BC)" */
+    static std::string _dateText(const duckdb_date_struct &d) {
+        if (d.year > 0) {
+            return fmt::format("{:04d}-{:02d}-{:02d}", d.year, d.month, d.day);
+        }
+        return fmt::format("{:04d}-{:02d}-{:02d} (BC)", 1 - d.year, d.month, d.day);
+    }
+
+    static std::string _timeText(const duckdb_time_struct &t) {
+        std::string text = fmt::format("{:02d}:{:02d}:{:02d}", t.hour, t.min, t.sec);
+        _appendFraction(text, t.micros, 6);
+        return text;
+    }
+
+    /** 追加 digits 位的小数秒并去除末尾的 0，为 0 时不追加 */
+    static void _appendFraction(std::string &text, int64_t fraction, int digits) {
+        if (fraction != 0) {
+            std::string frac = fmt::format("{:0{}d}", fraction, digits);
+            frac.erase(frac.find_last_not_of('0') + 1);
+            text.append(1, '.').append(frac);
+        }
+    }
+
+    /** 如 "1 year 2 months 3 days 04:05:06.789"，全为 0 时为 "00:00:00" */
+    static std::string _intervalText(const duckdb_interval &value) {
+        std::string text;
+        auto append_part = [&text](int32_t count, const char *unit) {
+            if (count != 0) {
+                if (!text.empty()) {
+                    text.push_back(' ');
+                }
+                text.append(fmt::format("{} {}{}", count, unit, std::abs(count) != 1 ? "s" : ""));
+            }
+        };
+        append_part(value.months / 12, "year");
+        append_part(value.months % 12, "month");
+        append_part(value.days, "day");
+        if (value.micros != 0) {
+            if (!text.empty()) {
+                text.push_back(' ');
+            }
+            uint64_t micros = static_cast<uint64_t>(value.micros);
+            if (value.micros < 0) {
+                text.push_back('-');
+                micros = ~micros + 1;
+            }
+            uint64_t seconds = micros / 1000000;
+            text.append(fmt::format("{:02d}:{:02d}:{:02d}", seconds / 3600, seconds % 3600 / 60,
+                                    seconds % 60));
+            _appendFraction(text, static_cast<int64_t>(micros % 1000000), 6);
+        } else if (text.empty()) {
+            text = "00:00:00";
+        }
+        return text;
+    }
+
+    /** 最短可还原的十进制表示，整数值附加 ".0"，如 "1.0"、"0.1"、"1e+20" */
+    template <typename T>
+    static std::string _floatText(T value) {
+        std::string text = fmt::format("{}", value);
+        if (std::isfinite(value) && text.find_first_of(".e") == std::string::npos) {
+            text.append(".0");
+        }
+        return text;
+    }
+
+    /** 由缩放后的整数精确生成定点小数文本，保留全部小数位，如 DECIMAL(10,2) 的 "1.50" */
+    std::string _decimalText(idx_t row) const {
+        duckdb_hugeint value{0, 0};
+        switch (m_type->internal) {
+            case DUCKDB_TYPE_SMALLINT:
+                value = _toHugeint(_at<int16_t>(row));
+                break;
+            case DUCKDB_TYPE_INTEGER:
+                value = _toHugeint(_at<int32_t>(row));
+                break;
+            case DUCKDB_TYPE_BIGINT:
+                value = _toHugeint(_at<int64_t>(row));
+                break;
+            case DUCKDB_TYPE_HUGEINT:
+                value = _at<duckdb_hugeint>(row);
+                break;
+            default:
+                _unsupported("text");
+        }
+
+        bool negative = value.upper < 0;
+        std::string text = negative ? _hugeintText(value).substr(1) : _hugeintText(value);
+        size_t decimals = m_type->decimals;
+        if (decimals > 0) {
+            if (text.size() <= decimals) {
+                text.insert(0, decimals + 1 - text.size(), '0');
+            }
+            text.insert(text.size() - decimals, 1, '.');
+        }
+        return negative ? "-" + text : text;
+    }
+
+    size_t _enumIndex(idx_t row) const {
+        switch (m_type->internal) {
+            case DUCKDB_TYPE_UTINYINT:
+                return _at<uint8_t>(row);
+            case DUCKDB_TYPE_USMALLINT:
+                return _at<uint16_t>(row);
+            case DUCKDB_TYPE_UINTEGER:
+                return _at<uint32_t>(row);
+            default:
+                _unsupported("text");
+        }
+        return 0;
+    }
+
+    static duckdb_hugeint _toHugeint(int64_t value) {
+        return duckdb_hugeint{static_cast<uint64_t>(value), value < 0 ? -1 : 0};
+    }
+
+    static std::string _hugeintText(const duckdb_hugeint &value) {
+        if (value.upper >= 0) {
+            return _uint128Text(static_cast<uint64_t>(value.upper), value.lower);
+        }
+        // 按补码取绝对值，INT128 的最小值同样适用
+        uint64_t lower = ~value.lower + 1;
+        uint64_t upper = ~static_cast<uint64_t>(value.upper) + (lower == 0 ? 1 : 0);
+        return "-" + _uint128Text(upper, lower);
+    }
+
+    /** 无符号 128 位整数的十进制文本 */
+    static std::string _uint128Text(uint64_t upper, uint64_t lower) {
+        if (upper == 0) {
+            return std::to_string(lower);
+        }
+        // 每次按 32 位分段对 10 做长除法，取出最低的一位十进制数字
+        char buf[40];
+        size_t pos = sizeof(buf);
+        uint32_t parts[4] = {uint32_t(upper >> 32), uint32_t(upper), uint32_t(lower >> 32),
+                             uint32_t(lower)};
+        while (parts[0] != 0 || parts[1] != 0 || parts[2] != 0 || parts[3] != 0) {
+            uint64_t rem = 0;
+            for (uint32_t &part : parts) {
+                uint64_t cur = (rem << 32) | part;
+                part = uint32_t(cur / 10);
+                rem = cur % 10;
+            }
+            buf[--pos] = char('0' + rem);
+        }
+        return std::string(buf + pos, sizeof(buf) - pos);
+    }
+
+    static double _hugeint(const duckdb_hugeint &value) {
+        return static_cast<double>(value.upper) * 18446744073709551616.0 +
+               static_cast<double>(value.lower);
+    }
+
+    void _unsupported(const char *target) const {
+        SQL_THROW(-1, "Unsupported conversion from duckdb type {} to {}!", int(m_type->type),
+                  target);
+    }
+
+    void _outOfRange() const {
+        SQL_THROW(-1, "Value of duckdb type {} is out of int64 range!", int(m_type->type));
+    }
+
+private:
+    const DuckDBColumnType *m_type = nullptr;
+    void *m_data = nullptr;
+    uint64_t *m_validity = nullptr;
+};
+
+}  // namespace hku
+
+#endif /* HIKYUU_DB_CONNECT_DUCKDB_DUCKDBCOLUMN_H */
@@ -71,6 +71,8 @@ DuckDBConnect::~DuckDBConnect() {
 }
 
 void DuckDBConnect::close() {
+    // 缓存的语句须在断开连接前释放
+    clearStatementCache();
     if (m_connection) {
         duckdb_disconnect(&m_connection);
         m_connection = nullptr;
@@ -87,6 +89,7 @@ int64_t DuckDBConnect::exec(const std::string& sql_string) {
     HKU_DEBUG(sql_string);
 #endif
 
+    invalidateStatementCache(sql_string);
     duckdb_result result;
     duckdb_state state = duckdb_query(m_connection, sql_string.c_str(), &result);
 
@@ -128,7 +131,7 @@ void DuckDBConnect::rollback() noexcept {
 }
 
 SQLStatementPtr DuckDBConnect::getStatement(const std::string& sql_statement) {
-    return std::make_shared<DuckDBStatement>(this, sql_statement);
+    return getCachedStatement<DuckDBStatement>(sql_statement);
 }
 
 bool DuckDBConnect::tableExist(const std::string& tablename) {
@@ -10,7 +10,9 @@
 #ifndef HIKYUU_DB_CONNECT_DUCKDB_DUCKDBCONNECT_H
 #define HIKYUU_DB_CONNECT_DUCKDB_DUCKDBCONNECT_H
 
+#include <tuple>
 #include "../DBConnectBase.h"
+#include "DuckDBColumn.h"
 #include "DuckDBStatement.h"
 #include <duckdb.h>
 
@@ -71,6 +73,40 @@ public:
      */
     virtual void resetAutoIncrement(const std::string& tablename) override;
 
+    /**
+     * 列式查询，按数据块将结果各列直接填充至对应的 vector，无逐个值的函数调用及内存分配
+     * @code
+     *  std::vector<Datetime> dates;
+     *  std::vector<double> closes;
+     *  driver->queryColumns("select date, close from kdata", dates, closes);
+     * @endcode
+     * @note 列的元素类型可为算术类型、std::string 及 Datetime，NULL 值填充为默认值
+     * @param sql 查询语句
+     * @param columns 依次接收结果中前 sizeof...(columns) 列的容器，原有数据将被清除
+     * @return 结果的行数
+     */
+    template <typename... Ts>
+    size_t queryColumns(const std::string& sql, std::vector<Ts>&... columns);
+
+    /**
+     * 列式查询至用户定义的结构体数组（struct-of-arrays）
+     * @details soa 须提供 columns() 方法，以 std::tie 返回各列 vector 的引用，如：
+     * @code
+     *  struct KDataColumns {
+     *      std::vector<Datetime> date;
+     *      std::vector<double> close;
+     *      auto columns() {
+     *          return std::tie(date, close);
+     *      }
+     *  };
+     * @endcode
+     * @param sql 查询语句
+     * @param soa 接收结果的结构体
+     * @return 结果的行数
+     */
+    template <typename SoA>
+    auto queryColumns(const std::string& sql, SoA& soa) -> decltype(soa.columns(), size_t());
+
 private:
     void close();
 
@@ -83,6 +119,65 @@ private:
 
 typedef std::shared_ptr<DuckDBConnect> DuckDBConnectPtr;
 
+template <typename... Ts>
+size_t DuckDBConnect::queryColumns(const std::string& sql, std::vector<Ts>&... columns) {
+#if HKU_SQL_TRACE
+    HKU_DEBUG(sql);
+#endif
+    // 出错或异常时释放结果集及当前数据块
+    struct ResultGuard {
+        duckdb_result result{};
+        duckdb_data_chunk chunk = nullptr;
+        ~ResultGuard() {
+            if (chunk) {
+                duckdb_destroy_data_chunk(&chunk);
+            }
+            duckdb_destroy_result(&result);
+        }
+    } guard;
+
+    if (duckdb_query(m_connection, sql.c_str(), &guard.result) != DuckDBSuccess) {
+        const char* error_msg = duckdb_result_error(&guard.result);
+        std::string msg = error_msg ? std::string(error_msg) : "Unknown error";
+        SQL_THROW(-1, "SQL error: {}! ({})", msg, sql);
+    }
+
+    idx_t col_count = duckdb_column_count(&guard.result);
+    if (col_count < sizeof...(Ts)) {
+        SQL_THROW(-1, "The query returns {} columns, less than {}! ({})", col_count,
+                  sizeof...(Ts), sql);
+    }
+
+    std::vector<DuckDBColumnType> types;
+    types.reserve(sizeof...(Ts));
+    for (idx_t i = 0; i < sizeof...(Ts); i++) {
+        types.emplace_back(&guard.result, i);
+    }
+
+    (columns.clear(), ...);
+    size_t total = 0;
+    while ((guard.chunk = duckdb_fetch_chunk(guard.result)) != nullptr) {
+        idx_t rows = duckdb_data_chunk_get_size(guard.chunk);
+        idx_t col = 0;
+        auto fill = [&](auto& column) {
+            DuckDBVectorReader(guard.chunk, col, types[col]).append(rows, column);
+            col++;
+        };
+        (fill(columns), ...);
+        total += rows;
+        duckdb_destroy_data_chunk(&guard.chunk);
+        guard.chunk = nullptr;
+    }
+    return total;
+}
+
+template <typename SoA>
+auto DuckDBConnect::queryColumns(const std::string& sql, SoA& soa)
+  -> decltype(soa.columns(), size_t()) {
+    return std::apply([this, &sql](auto&... columns) { return queryColumns(sql, columns...); },
+                      soa.columns());
+}
+
 }  // namespace hku
 
 #endif /* HIKYUU_DB_CONNECT_DUCKDB_DUCKDBCONNECT_H */
\ No newline at end of file
@@ -16,13 +16,17 @@ DuckDBStatement::DuckDBStatement(DBConnectBase *driver, const std::string &sql_s
 : SQLStatementBase(driver, sql_statement),
   m_connection(dynamic_cast<DuckDBConnect *>(driver)->m_connection),
   m_has_result(false),
-  m_current_row(0),
-  m_row_count(0) {
+  m_chunk(nullptr),
+  m_chunk_size(0),
+  m_chunk_row(0) {
     memset(&m_result, 0, sizeof(duckdb_result));
     _prepare();
 }
 
 DuckDBStatement::~DuckDBStatement() {
+    if (m_chunk) {
+        duckdb_destroy_data_chunk(&m_chunk);
+    }
     if (m_stmt) {
         duckdb_destroy_prepare(&m_stmt);
     }
@@ -62,11 +66,54 @@ std::string DuckDBStatement::_prepareInsertWithReturning(const std::string &sql)
 }
 
 void DuckDBStatement::_reset() {
+    if (m_chunk) {
+        duckdb_destroy_data_chunk(&m_chunk);
+        m_chunk = nullptr;
+    }
+    m_readers.clear();
+    m_column_types.clear();
+    m_chunk_size = 0;
+    m_chunk_row = 0;
     duckdb_destroy_result(&m_result);
     memset(&m_result, 0, sizeof(duckdb_result));
     m_has_result = false;
-    m_current_row = 0;
-    m_row_count = 0;
+}
+
+bool DuckDBStatement::_fetchChunk() {
+    if (m_chunk) {
+        duckdb_destroy_data_chunk(&m_chunk);
+        m_chunk = nullptr;
+    }
+    m_readers.clear();
+    m_chunk_size = 0;
+    m_chunk_row = 0;
+
+    while ((m_chunk = duckdb_fetch_chunk(m_result)) != nullptr) {
+        m_chunk_size = duckdb_data_chunk_get_size(m_chunk);
+        if (m_chunk_size > 0) {
+            break;
+        }
+        duckdb_destroy_data_chunk(&m_chunk);
+        m_chunk = nullptr;
+    }
+    HKU_IF_RETURN(!m_chunk, false);
+
+    for (size_t i = 0, total = m_column_types.size(); i < total; i++) {
+        m_readers.emplace_back(m_chunk, i, m_column_types[i]);
+    }
+    return true;
+}
+
+const DuckDBVectorReader &DuckDBStatement::_reader(int idx) {
+    if (!m_chunk || idx < 0 || idx >= static_cast<int>(m_readers.size())) {
+        SQL_THROW(-1, "No valid result or invalid row position");
+    }
+    return m_readers[idx];
+}
+
+void DuckDBStatement::sub_reset() {
+    _reset();
+    duckdb_clear_bindings(m_stmt);
 }
 
 void DuckDBStatement::sub_exec() {
@@ -80,17 +127,23 @@ void DuckDBStatement::sub_exec() {
     }
 
     m_has_result = true;
-    m_row_count = duckdb_row_count(&m_result);
-    m_current_row = 0;
+    idx_t col_count = duckdb_column_count(&m_result);
+    m_column_types.reserve(col_count);
+    for (idx_t i = 0; i < col_count; i++) {
+        m_column_types.emplace_back(&m_result, i);
+    }
 }
 
 bool DuckDBStatement::sub_moveNext() {
-    if (!m_has_result || m_current_row >= m_row_count) {
+    if (!m_has_result) {
         return false;
     }
 
-    m_current_row++;
-    return m_current_row <= m_row_count;
+    if (m_chunk && m_chunk_row + 1 < m_chunk_size) {
+        m_chunk_row++;
+        return true;
+    }
+    return _fetchChunk();
 }
 
 int DuckDBStatement::sub_getNumColumns() const {
@@ -160,70 +213,31 @@ void DuckDBStatement::sub_bindBlob(int idx, const std::vector<char> &item) {
 }
 
 void DuckDBStatement::sub_getColumnAsInt64(int idx, int64_t &item) {
-    if (!m_has_result || m_current_row == 0 || m_current_row > m_row_count) {
-        SQL_THROW(-1, "No valid result or invalid row position");
-    }
-
-    if (duckdb_value_is_null(&m_result, static_cast<idx_t>(idx), m_current_row - 1)) {
-        item = 0;
-        return;
-    }
-
-    item = duckdb_value_int64(&m_result, static_cast<idx_t>(idx), m_current_row - 1);
+    const DuckDBVectorReader &reader = _reader(idx);
+    item = reader.isNull(m_chunk_row) ? 0 : reader.getInt64(m_chunk_row);
 }
 
 void DuckDBStatement::sub_getColumnAsDouble(int idx, double &item) {
-    if (!m_has_result || m_current_row == 0 || m_current_row > m_row_count) {
-        SQL_THROW(-1, "No valid result or invalid row position");
-    }
-
-    if (duckdb_value_is_null(&m_result, static_cast<idx_t>(idx), m_current_row - 1)) {
-        item = 0.0;
-        return;
-    }
-
-    item = duckdb_value_double(&m_result, static_cast<idx_t>(idx), m_current_row - 1);
+    const DuckDBVectorReader &reader = _reader(idx);
+    item = reader.isNull(m_chunk_row) ? 0.0 : reader.getDouble(m_chunk_row);
 }
 
 void DuckDBStatement::sub_getColumnAsDatetime(int idx, Datetime &item) {
-    std::string date_str;
-    sub_getColumnAsText(idx, date_str);
-    item = date_str.empty() ? Datetime() : Datetime(date_str);
+    _reader(idx).get(m_chunk_row, item);
 }
 
 void DuckDBStatement::sub_getColumnAsText(int idx, std::string &item) {
-    if (!m_has_result || m_current_row == 0 || m_current_row > m_row_count) {
-        SQL_THROW(-1, "No valid result or invalid row position");
-    }
-
-    if (duckdb_value_is_null(&m_result, static_cast<idx_t>(idx), m_current_row - 1)) {
-        item = "";
-        return;
-    }
-
-    char *value = duckdb_value_varchar(&m_result, static_cast<idx_t>(idx), m_current_row - 1);
-    if (value) {
-        item = std::string(value);
-        free(value);
-    } else {
-        item = "";
-    }
+    _reader(idx).get(m_chunk_row, item);
 }
 
 void DuckDBStatement::sub_getColumnAsBlob(int idx, std::string &item) {
-    if (!m_has_result || m_current_row == 0 || m_current_row > m_row_count) {
+    if (!m_chunk || idx < 0 || idx >= static_cast<int>(m_readers.size()) ||
+        m_readers[idx].isNull(m_chunk_row)) {
         throw null_blob_exception();
     }
 
-    if (duckdb_value_is_null(&m_result, static_cast<idx_t>(idx), m_current_row - 1)) {
-        throw null_blob_exception();
-    }
-
-    duckdb_blob blob = duckdb_value_blob(&m_result, static_cast<idx_t>(idx), m_current_row - 1);
-    if (blob.data && blob.size > 0) {
-        item = std::string(static_cast<char *>(blob.data), blob.size);
-        free(blob.data);
-    } else {
+    m_readers[idx].getText(m_chunk_row, item);
+    if (item.empty()) {
         throw null_blob_exception();
     }
 }
@@ -234,11 +248,7 @@ void DuckDBStatement::sub_getColumnAsBlob(int idx, std::vector<char> &item) {
     item.assign(blob_str.begin(), blob_str.end());
 }
 
-uint64_t DuckDBStatement::sub_getLastRowid() {
-    if (!m_has_result || m_row_count == 0) {
-        return 0;
-    }
-
+int DuckDBStatement::_idColumn() {
     int col_count = duckdb_column_count(&m_result);
     for (int i = 0; i < col_count; ++i) {
         const char *col_name = duckdb_column_name(&m_result, i);
@@ -246,17 +256,39 @@ uint64_t DuckDBStatement::sub_getLastRowid() {
             std::string col_name_str(col_name);
             std::transform(col_name_str.begin(), col_name_str.end(), col_name_str.begin(),
                            ::toupper);
-
             if (col_name_str == "ID" || col_name_str == "\"ID\"") {
-                if (duckdb_value_is_null(&m_result, i, 0)) {
-                    return 0;
-                }
-                return duckdb_value_int64(&m_result, i, 0);
+                return i;
             }
         }
     }
+    return -1;
+}
 
-    return 0;
+void DuckDBStatement::sub_getInsertedRowids(size_t count, std::vector<uint64_t> &rowids) {
+    // INSERT 语句附加了 RETURNING id，结果集中按插入顺序包含所有记录的 id
+    HKU_IF_RETURN(!m_has_result, void());
+    int col = _idColumn();
+    HKU_IF_RETURN(col < 0, void());
+    HKU_IF_RETURN(!m_chunk && !sub_moveNext(), void());
+    rowids.reserve(count);
+    do {
+        const DuckDBVectorReader &reader = m_readers[col];
+        rowids.push_back(
+          reader.isNull(m_chunk_row) ? 0 : static_cast<uint64_t>(reader.getInt64(m_chunk_row)));
+    } while (sub_moveNext());
+}
+
+uint64_t DuckDBStatement::sub_getLastRowid() {
+    if (!m_has_result) {
+        return 0;
+    }
+
+    int col = _idColumn();
+    if (col < 0 || (!m_chunk && !sub_moveNext())) {
+        return 0;
+    }
+    const DuckDBVectorReader &reader = m_readers[col];
+    return reader.isNull(m_chunk_row) ? 0 : reader.getInt64(m_chunk_row);
 }
 
 }  // namespace hku
\ No newline at end of file
@@ -11,6 +11,7 @@
 #define HIKYUU_DB_CONNECT_DUCKDB_DUCKDBSTATEMENT_H
 
 #include "../SQLStatementBase.h"
+#include "DuckDBColumn.h"
 #include <duckdb.h>
 
 namespace hku {
@@ -19,6 +20,7 @@ class DuckDBConnect;
 
 /**
  * DuckDB Statement
+ * @details 查询结果通过 duckdb_fetch_chunk 按数据块读取，getColumn 直接访问当前数据块中的列向量
  * @ingroup DBConnect
  */
 class HKU_UTILS_API DuckDBStatement : public SQLStatementBase {
@@ -38,6 +40,8 @@ public:
     virtual void sub_exec() override;
     virtual bool sub_moveNext() override;
     virtual uint64_t sub_getLastRowid() override;
+    virtual void sub_reset() override;
+    virtual void sub_getInsertedRowids(size_t count, std::vector<uint64_t> &rowids) override;
 
     virtual void sub_bindNull(int idx) override;
     virtual void sub_bindInt(int idx, int64_t value) override;
@@ -59,6 +63,9 @@ public:
 private:
     void _prepare();
     void _reset();
+    bool _fetchChunk();
+    const DuckDBVectorReader &_reader(int idx);
+    int _idColumn();  // RETURNING 结果中 id 列的序号，不存在时返回 -1
     std::string _prepareInsertWithReturning(const std::string &sql);
 
 private:
@@ -66,8 +73,11 @@ private:
     duckdb_prepared_statement m_stmt;
     duckdb_result m_result;
     bool m_has_result;
-    idx_t m_current_row;
-    idx_t m_row_count;
+    duckdb_data_chunk m_chunk;                     // 当前数据块
+    idx_t m_chunk_size;                            // 当前数据块的行数
+    idx_t m_chunk_row;                             // 当前行在数据块中的序号
+    std::vector<DuckDBColumnType> m_column_types;  // 结果集各列类型
+    std::vector<DuckDBVectorReader> m_readers;     // 当前数据块各列的读取视图
 };
 
 }  // namespace hku
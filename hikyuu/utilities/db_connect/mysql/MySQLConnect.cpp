@@ -95,6 +95,8 @@ void MySQLConnect::connect() {
 }
 
 void MySQLConnect::close() {
+    // 预编译语句随连接失效，须在关闭连接前释放
+    clearStatementCache();
     if (m_mysql) {
         mysql_close(m_mysql);
         delete m_mysql;
@@ -104,7 +106,12 @@ void MySQLConnect::close() {
 
 bool MySQLConnect::ping() {
     HKU_ERROR_IF_RETURN(!m_mysql && !tryConnect(), false, "Failed connect to mysql!");
+    auto thread_id = mysql_thread_id(m_mysql);
     auto ret = mysql_ping(m_mysql);
+    if (!ret && thread_id != mysql_thread_id(m_mysql)) {
+        // 已自动重连，原有的预编译语句在服务端失效
+        clearStatementCache();
+    }
     HKU_ERROR_IF_RETURN(ret && !tryConnect(), false, "mysql_ping error code: {}, msg: {}", ret,
                         mysql_error(m_mysql));
     return true;
@@ -118,6 +125,8 @@ int64_t MySQLConnect::exec(const std::string& sql_string) {
         HKU_CHECK(!tryConnect(), "Failed connect to mysql!");
     }
 
+    invalidateStatementCache(sql_string);
+
     int ret = mysql_query(m_mysql, sql_string.c_str());
     if (ret) {
         // 尝试重新连接
@@ -160,7 +169,7 @@ int64_t MySQLConnect::exec(const std::string& sql_string) {
 }
 
 SQLStatementPtr MySQLConnect::getStatement(const std::string& sql_statement) {
-    return std::make_shared<MySQLStatement>(this, sql_statement);
+    return getCachedStatement<MySQLStatement>(sql_statement);
 }
 
 bool MySQLConnect::tableExist(const std::string& tablename) {
@@ -108,6 +108,26 @@ void MySQLStatement::_reset() {
     }
 }
 
+void MySQLStatement::sub_reset() {
+    m_needs_reset = true;
+    _reset();
+    if (!m_param_bind.empty()) {
+        memset(m_param_bind.data(), 0, m_param_bind.size() * sizeof(MYSQL_BIND));
+    }
+    m_param_buffer.clear();
+}
+
+void MySQLStatement::sub_getInsertedRowids(size_t count, std::vector<uint64_t>& rowids) {
+    // 多行 INSERT 时 mysql_stmt_insert_id 返回第一条记录的自增 id，
+    // 要求自增步长为 1 且 innodb_autoinc_lock_mode 为 0 或 1（同一语句内分配连续的 id）
+    uint64_t first = mysql_stmt_insert_id(m_stmt);
+    HKU_IF_RETURN(count == 0 || first == 0, void());
+    rowids.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        rowids.push_back(first + i);
+    }
+}
+
 void MySQLStatement::sub_exec() {
     _reset();
     m_needs_reset = true;
@@ -41,6 +41,8 @@ public:
     virtual void sub_exec() override;
     virtual bool sub_moveNext() override;
     virtual uint64_t sub_getLastRowid() override;
+    virtual void sub_reset() override;
+    virtual void sub_getInsertedRowids(size_t count, std::vector<uint64_t> &rowids) override;
 
     virtual void sub_bindNull(int idx) override;
     virtual void sub_bindInt(int idx, int64_t value) override;
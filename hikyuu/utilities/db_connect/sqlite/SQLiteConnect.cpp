@@ -84,6 +84,8 @@ bool SQLiteConnect::ping() {
 }
 
 void SQLiteConnect::close() {
+    // 缓存的语句须在关闭连接前释放
+    clearStatementCache();
     if (m_db) {
         sqlite3_close(m_db);
         m_db = nullptr;
@@ -94,6 +96,7 @@ int64_t SQLiteConnect::exec(const std::string &sql_string) {
 #if HKU_SQL_TRACE
     HKU_DEBUG(sql_string);
 #endif
+    invalidateStatementCache(sql_string);
     int rc = sqlite3_exec(m_db, sql_string.c_str(), NULL, NULL, NULL);
     SQL_CHECK(rc == SQLITE_OK, rc, "SQL error: {}! ({})", sqlite3_errmsg(m_db), sql_string);
     int affect_rows = sqlite3_changes(m_db);
@@ -119,7 +122,7 @@ void SQLiteConnect::rollback() noexcept {
 }
 
 SQLStatementPtr SQLiteConnect::getStatement(const std::string &sql_statement) {
-    return std::make_shared<SQLiteStatement>(this, sql_statement);
+    return getCachedStatement<SQLiteStatement>(sql_statement);
 }
 
 bool SQLiteConnect::tableExist(const std::string &tablename) {
@@ -48,6 +48,15 @@ void SQLiteStatement::_reset() {
     }
 }
 
+void SQLiteStatement::sub_reset() {
+    // sqlite3_reset 返回的是上一次执行的结果，无论如何语句都已被重置
+    sqlite3_reset(m_stmt);
+    sqlite3_clear_bindings(m_stmt);
+    m_needs_reset = false;
+    m_step_status = SQLITE_DONE;
+    m_at_first_step = true;
+}
+
 void SQLiteStatement::sub_exec() {
     _reset();
     m_step_status = sqlite3_step(m_stmt);
@@ -178,4 +187,15 @@ uint64_t SQLiteStatement::sub_getLastRowid() {
     return sqlite3_last_insert_rowid(m_db);
 }
 
+void SQLiteStatement::sub_getInsertedRowids(size_t count, std::vector<uint64_t> &rowids) {
+    // 仅用于 batchSave 合并的普通 INSERT（无冲突处理，rowid 由数据库分配）：单条语句在写锁内执行，
+    // 各记录依次分配当前最大 rowid + 1，最后插入的为最大值。rowid 已达上限时改为随机分配，不再连续
+    uint64_t last = sqlite3_last_insert_rowid(m_db);
+    HKU_IF_RETURN(count == 0 || last < count, void());
+    rowids.reserve(count);
+    for (uint64_t id = last - count + 1; id <= last; id++) {
+        rowids.push_back(id);
+    }
+}
+
 }  // namespace hku
\ No newline at end of file
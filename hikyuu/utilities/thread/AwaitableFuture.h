@@ -0,0 +1,278 @@
+/*
+ * AwaitableFuture.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_THREAD_AWAITABLEFUTURE_H
+#define HIKYUU_UTILITIES_THREAD_AWAITABLEFUTURE_H
+
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include "FuncWrapper.h"
+#include "../Log.h"
+
+namespace hku {
+
+template <typename T>
+class AwaitablePromise;
+
+/**
+ * AwaitableFuture 与 AwaitablePromise 之间的共享状态
+ * @details 任务完成时由完成线程直接调用已注册的回调，无需轮询
+ */
+template <typename T>
+class AwaitableState {
+public:
+    typedef typename std::conditional<std::is_void<T>::value, bool, T>::type value_type;
+
+    AwaitableState() = default;
+    AwaitableState(const AwaitableState&) = delete;
+    AwaitableState& operator=(const AwaitableState&) = delete;
+
+    template <typename... Args>
+    void set_value(Args&&... args) {
+        FuncWrapper callback;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_ready) {
+                throw std::future_error(std::future_errc::promise_already_satisfied);
+            }
+            m_value.emplace(std::forward<Args>(args)...);
+            m_ready = true;
+            callback = std::move(m_callback);
+        }
+        m_cond.notify_all();
+        invoke(callback);
+    }
+
+    void set_exception(std::exception_ptr e) {
+        FuncWrapper callback;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_ready) {
+                throw std::future_error(std::future_errc::promise_already_satisfied);
+            }
+            m_exception = e;
+            m_ready = true;
+            callback = std::move(m_callback);
+        }
+        m_cond.notify_all();
+        invoke(callback);
+    }
+
+    /** 注册完成回调，如已完成则在当前线程立即执行。仅可注册一次 */
+    void on_ready(FuncWrapper&& callback) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_ready) {
+                m_callback = std::move(callback);
+                return;
+            }
+        }
+        invoke(callback);
+    }
+
+    bool ready() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_ready;
+    }
+
+    void wait() const {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this] { return m_ready; });
+    }
+
+    /** 获取结果，只能调用一次 */
+    T get() {
+        wait();
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+        if constexpr (std::is_void<T>::value) {
+            return;
+        } else {
+            return std::move(*m_value);
+        }
+    }
+
+private:
+    // 回调抛出的异常不能传出，否则设置结果的一方会将其视为任务失败而再次设置结果
+    static void invoke(FuncWrapper& callback) noexcept {
+        try {
+            callback();
+        } catch (const std::exception& e) {
+            HKU_ERROR("AwaitableFuture callback exception: {}", e.what());
+        } catch (...) {
+            HKU_ERROR("AwaitableFuture callback unknown exception!");
+        }
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_cond;
+    bool m_ready = false;
+    std::optional<value_type> m_value;
+    std::exception_ptr m_exception;
+    FuncWrapper m_callback;
+};
+
+/**
+ * 可在协程中直接等待的 future，由 AwaitablePromise 或线程池 submit_awaitable 获得
+ * @details
+ * 与 std::future 不同，AwaitableFuture 可以注册完成回调，任务完成时由执行任务的线程直接调用，
+ * 协程中配合 await_future 使用时不需要定时轮询。
+ * @note 非协程环境中亦可使用 wait/get 阻塞等待
+ */
+template <typename T>
+class AwaitableFuture {
+public:
+    AwaitableFuture() = default;
+    AwaitableFuture(const AwaitableFuture&) = delete;
+    AwaitableFuture& operator=(const AwaitableFuture&) = delete;
+    AwaitableFuture(AwaitableFuture&&) noexcept = default;
+    AwaitableFuture& operator=(AwaitableFuture&&) noexcept = default;
+
+    /** 是否关联了共享状态 */
+    bool valid() const noexcept {
+        return m_state != nullptr;
+    }
+
+    /** 结果是否已就绪 */
+    bool ready() const {
+        check_state();
+        return m_state->ready();
+    }
+
+    /** 阻塞等待结果就绪 */
+    void wait() const {
+        check_state();
+        m_state->wait();
+    }
+
+    /**
+     * 获取结果，如任务抛出异常则重新抛出该异常，调用后 future 失效
+     */
+    T get() {
+        check_state();
+        std::shared_ptr<AwaitableState<T>> state = std::move(m_state);
+        return state->get();
+    }
+
+    /**
+     * 注册完成回调，结果就绪时由完成任务的线程调用（如已就绪则在当前线程立即调用）
+     * @note 每个 future 只能注册一次，回调中不应执行耗时操作。回调抛出的异常仅记录日志，
+     * 不影响 future 的结果
+     */
+    template <typename Callback>
+    void on_ready(Callback&& callback) {
+        check_state();
+        m_state->on_ready(FuncWrapper(std::forward<Callback>(callback)));
+    }
+
+private:
+    friend class AwaitablePromise<T>;
+
+    explicit AwaitableFuture(std::shared_ptr<AwaitableState<T>> state)
+    : m_state(std::move(state)) {}
+
+    void check_state() const {
+        if (!m_state) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+    }
+
+private:
+    std::shared_ptr<AwaitableState<T>> m_state;
+};
+
+/**
+ * AwaitableFuture 对应的 promise，接口与 std::promise 一致
+ * @details 未设置结果即析构时，关联的 future 将得到 broken_promise 异常
+ */
+template <typename T>
+class AwaitablePromise {
+public:
+    AwaitablePromise() : m_state(std::make_shared<AwaitableState<T>>()) {}
+
+    /** 使用指定分配器分配共享状态 */
+    template <typename Alloc>
+    AwaitablePromise(std::allocator_arg_t, const Alloc& alloc)
+    : m_state(std::allocate_shared<AwaitableState<T>>(alloc)) {}
+
+    AwaitablePromise(const AwaitablePromise&) = delete;
+    AwaitablePromise& operator=(const AwaitablePromise&) = delete;
+    AwaitablePromise(AwaitablePromise&&) noexcept = default;
+
+    AwaitablePromise& operator=(AwaitablePromise&& other) noexcept {
+        if (this != &other) {
+            abandon();
+            m_state = std::move(other.m_state);
+            m_retrieved = other.m_retrieved;
+            m_satisfied = other.m_satisfied;
+        }
+        return *this;
+    }
+
+    ~AwaitablePromise() {
+        abandon();
+    }
+
+    /** 获取关联的 future，只能调用一次 */
+    AwaitableFuture<T> get_future() {
+        check_state();
+        if (m_retrieved) {
+            throw std::future_error(std::future_errc::future_already_retrieved);
+        }
+        m_retrieved = true;
+        return AwaitableFuture<T>(m_state);
+    }
+
+    template <typename... Args>
+    void set_value(Args&&... args) {
+        check_state();
+        m_state->set_value(std::forward<Args>(args)...);
+        m_satisfied = true;
+    }
+
+    void set_exception(std::exception_ptr e) {
+        check_state();
+        m_state->set_exception(e);
+        m_satisfied = true;
+    }
+
+private:
+    void check_state() const {
+        if (!m_state) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+    }
+
+    void abandon() noexcept {
+        if (m_state && !m_satisfied) {
+            try {
+                m_state->set_exception(
+                  std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+            } catch (...) {
+            }
+        }
+    }
+
+private:
+    std::shared_ptr<AwaitableState<T>> m_state;
+    bool m_retrieved = false;
+    bool m_satisfied = false;
+};
+
+}  // namespace hku
+
+#endif /* HIKYUU_UTILITIES_THREAD_AWAITABLEFUTURE_H */
@@ -0,0 +1,250 @@
+/*
+ * BulkFuture.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_THREAD_BULKFUTURE_H
+#define HIKYUU_UTILITIES_THREAD_BULKFUTURE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include "FuncWrapper.h"
+
+namespace hku {
+
+/**
+ * 批量任务共享状态，记录剩余未完成的任务数及首个任务异常
+ */
+class BulkState {
+public:
+    explicit BulkState(size_t count) : m_remaining(count), m_done(count == 0) {}
+    virtual ~BulkState() = default;
+
+    BulkState(const BulkState&) = delete;
+    BulkState& operator=(const BulkState&) = delete;
+
+    /** 记录任务异常，仅保留第一个异常 */
+    void set_exception(std::exception_ptr e) noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_exception) {
+            m_exception = e;
+        }
+    }
+
+    /** 完成一个任务，最后一个任务完成时唤醒等待线程 */
+    void finish_one() noexcept {
+        if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_done = true;
+            m_cond.notify_all();
+        }
+    }
+
+    bool ready() const noexcept {
+        return m_remaining.load(std::memory_order_acquire) == 0;
+    }
+
+    size_t remaining() const noexcept {
+        return m_remaining.load(std::memory_order_acquire);
+    }
+
+    void wait() const {
+        if (ready()) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this] { return m_done; });
+    }
+
+    template <class Rep, class Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+        if (ready()) {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_cond.wait_for(lock, timeout, [this] { return m_done; });
+    }
+
+    std::exception_ptr exception() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_exception;
+    }
+
+private:
+    std::atomic<size_t> m_remaining;
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_cond;
+    bool m_done;
+    std::exception_ptr m_exception;
+};
+
+/**
+ * 批量提交任务（submit_bulk/submit_n）后返回的聚合句柄
+ * @details
+ * 所有任务完成后就绪，任务中的异常不会中断其他任务，get() 时重新抛出第一个捕获的异常。
+ * 提供 wait_for 接口，可同 std::future 一样用于 wait_for_all_non_blocking 等函数。
+ */
+class BulkFuture {
+public:
+    BulkFuture() = default;
+    explicit BulkFuture(std::shared_ptr<BulkState> state) : m_state(std::move(state)) {}
+
+    /** 是否关联了批量任务 */
+    bool valid() const noexcept {
+        return m_state != nullptr;
+    }
+
+    /** 是否全部任务均已完成 */
+    bool ready() const {
+        check_state();
+        return m_state->ready();
+    }
+
+    /** 剩余未完成的任务数 */
+    size_t remaining() const {
+        check_state();
+        return m_state->remaining();
+    }
+
+    /** 阻塞等待全部任务完成 */
+    void wait() const {
+        check_state();
+        m_state->wait();
+    }
+
+    /** 等待全部任务完成，直至超时 */
+    template <class Rep, class Period>
+    std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+        check_state();
+        return m_state->wait_for(timeout) ? std::future_status::ready
+                                          : std::future_status::timeout;
+    }
+
+    /** 等待全部任务完成，如有任务抛出异常，则重新抛出第一个异常 */
+    void get() const {
+        wait();
+        std::exception_ptr e = m_state->exception();
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    void check_state() const {
+        if (!m_state) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+    }
+
+private:
+    std::shared_ptr<BulkState> m_state;
+};
+
+/** @cond internal */
+/** 批量任务中单个任务持有的完成令牌，任务未执行即被销毁时视为 broken_promise */
+class BulkTaskToken {
+public:
+    explicit BulkTaskToken(std::shared_ptr<BulkState> state) : m_state(std::move(state)) {}
+    BulkTaskToken(BulkTaskToken&&) noexcept = default;
+    BulkTaskToken(const BulkTaskToken&) = delete;
+    BulkTaskToken& operator=(const BulkTaskToken&) = delete;
+    BulkTaskToken& operator=(BulkTaskToken&&) = delete;
+
+    ~BulkTaskToken() {
+        if (m_state) {
+            m_state->set_exception(
+              std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+            m_state->finish_one();
+        }
+    }
+
+    BulkState* state() const noexcept {
+        return m_state.get();
+    }
+
+    /** 任务执行完毕 */
+    void finish() noexcept {
+        m_state->finish_one();
+        m_state.reset();
+    }
+
+private:
+    std::shared_ptr<BulkState> m_state;
+};
+
+template <typename FunctionType>
+class BulkFuncState : public BulkState {
+public:
+    BulkFuncState(size_t count, FunctionType&& f) : BulkState(count), func(std::move(f)) {}
+    FunctionType func;
+};
+/** @endcond */
+
+/**
+ * 将 [first, last) 中的函数对象包装为线程池任务
+ * @param first 起始迭代器，元素为无参数的可调用对象
+ * @param last 结束迭代器
+ * @param tasks [out] 包装后的任务
+ * @return 聚合句柄
+ */
+template <typename Iterator>
+BulkFuture package_bulk_tasks(Iterator first, Iterator last, std::vector<FuncWrapper>& tasks) {
+    typedef typename std::decay<decltype(*first)>::type func_type;
+    size_t count = std::distance(first, last);
+    auto state = std::make_shared<BulkState>(count);
+    tasks.reserve(tasks.size() + count);
+    for (; first != last; ++first) {
+        tasks.emplace_back([token = BulkTaskToken(state), func = func_type(*first)]() mutable {
+            try {
+                func();
+            } catch (...) {
+                token.state()->set_exception(std::current_exception());
+            }
+            token.finish();
+        });
+    }
+    return BulkFuture(std::move(state));
+}
+
+/**
+ * 将 f(0), f(1), ..., f(n-1) 包装为 n 个线程池任务，所有任务共享同一函数对象
+ * @param n 任务数
+ * @param f 以 size_t 为参数的可调用对象
+ * @param tasks [out] 包装后的任务
+ * @return 聚合句柄
+ */
+template <typename FunctionType>
+BulkFuture package_n_tasks(size_t n, FunctionType&& f, std::vector<FuncWrapper>& tasks) {
+    typedef typename std::decay<FunctionType>::type func_type;
+    typedef BulkFuncState<func_type> state_type;
+    auto state = std::make_shared<state_type>(n, func_type(std::forward<FunctionType>(f)));
+    tasks.reserve(tasks.size() + n);
+    for (size_t i = 0; i < n; i++) {
+        tasks.emplace_back([token = BulkTaskToken(state), i]() mutable {
+            try {
+                static_cast<state_type*>(token.state())->func(i);
+            } catch (...) {
+                token.state()->set_exception(std::current_exception());
+            }
+            token.finish();
+        });
+    }
+    return BulkFuture(std::move(state));
+}
+
+}  // namespace hku
+
+#endif /* HIKYUU_UTILITIES_THREAD_BULKFUTURE_H */
@@ -0,0 +1,273 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "../osdef.h"
+
+#if HKU_OS_WINDOWS
+#include <windows.h>
+#elif HKU_OS_LINUX || HKU_OS_ANDROID
+#include <pthread.h>
+#include <sched.h>
+#include <dirent.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include "CpuAffinity.h"
+
+namespace hku {
+
+std::vector<int> parse_cpu_list(const std::string& cpu_list) {
+    std::vector<int> ret;
+    size_t pos = 0;
+    while (pos < cpu_list.size()) {
+        size_t comma = cpu_list.find(',', pos);
+        if (comma == std::string::npos) {
+            comma = cpu_list.size();
+        }
+        std::string item = cpu_list.substr(pos, comma - pos);
+        pos = comma + 1;
+
+        char* end = nullptr;
+        long first = std::strtol(item.c_str(), &end, 10);
+        if (end == item.c_str() || first < 0) {
+            continue;
+        }
+        long last = first;
+        if (*end == '-') {
+            const char* second = end + 1;
+            last = std::strtol(second, &end, 10);
+            if (end == second || last < first) {
+                continue;
+            }
+        }
+        for (long cpu = first; cpu <= last; cpu++) {
+            ret.push_back(static_cast<int>(cpu));
+        }
+    }
+    return ret;
+}
+
+CpuTopology::CpuTopology() {
+    size_t n = std::thread::hardware_concurrency();
+    std::vector<int> cpus;
+    for (size_t i = 0; i < std::max<size_t>(n, 1); i++) {
+        cpus.push_back(static_cast<int>(i));
+    }
+    m_node_cpus.push_back(cpus);
+    m_cpus = std::move(cpus);
+}
+
+CpuTopology::CpuTopology(const std::vector<std::vector<int>>& node_cpus) {
+    for (const auto& cpus : node_cpus) {
+        if (!cpus.empty()) {
+            m_node_cpus.push_back(cpus);
+            m_cpus.insert(m_cpus.end(), cpus.begin(), cpus.end());
+        }
+    }
+    if (m_node_cpus.empty()) {
+        *this = CpuTopology();
+    }
+}
+
+const CpuTopology& CpuTopology::system() {
+    static CpuTopology s_topology = from_sysfs();
+    return s_topology;
+}
+
+static bool read_first_line(const std::string& filename, std::string& line) {
+    std::ifstream file(filename);
+    return file && std::getline(file, line);
+}
+
+CpuTopology CpuTopology::from_sysfs(const std::string& sys_root) {
+#if HKU_OS_LINUX || HKU_OS_ANDROID
+    std::string line;
+    std::vector<int> online;
+    if (read_first_line(sys_root + "/devices/system/cpu/online", line)) {
+        online = parse_cpu_list(line);
+        std::sort(online.begin(), online.end());
+        online.erase(std::unique(online.begin(), online.end()), online.end());
+    }
+    if (online.empty()) {
+        return CpuTopology();
+    }
+
+    // 节点目录名为 node<编号>，按编号排序
+    std::vector<int> node_ids;
+    std::string node_path = sys_root + "/devices/system/node";
+    DIR* dir = opendir(node_path.c_str());
+    if (dir) {
+        struct dirent* entry = nullptr;
+        while ((entry = readdir(dir)) != nullptr) {
+            std::string name(entry->d_name);
+            if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+                name.find_first_not_of("0123456789", 4) == std::string::npos) {
+                node_ids.push_back(std::atoi(name.c_str() + 4));
+            }
+        }
+        closedir(dir);
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+
+    std::vector<std::vector<int>> node_cpus;
+    std::vector<bool> assigned(*std::max_element(online.begin(), online.end()) + 1, false);
+    for (int id : node_ids) {
+        if (!read_first_line(node_path + "/node" + std::to_string(id) + "/cpulist", line)) {
+            continue;
+        }
+        std::vector<int> cpus;
+        for (int cpu : parse_cpu_list(line)) {
+            // 仅保留在线的 CPU
+            if (std::binary_search(online.begin(), online.end(), cpu) && !assigned[cpu]) {
+                assigned[cpu] = true;
+                cpus.push_back(cpu);
+            }
+        }
+        node_cpus.push_back(std::move(cpus));
+    }
+
+    // 未归属任何节点的在线 CPU（如未启用 NUMA 的内核）
+    std::vector<int> rest;
+    for (int cpu : online) {
+        if (!assigned[cpu]) {
+            rest.push_back(cpu);
+        }
+    }
+    if (!rest.empty()) {
+        if (node_cpus.empty()) {
+            node_cpus.push_back(std::move(rest));
+        } else {
+            node_cpus.front().insert(node_cpus.front().end(), rest.begin(), rest.end());
+        }
+    }
+    return CpuTopology(node_cpus);
+#else
+    return CpuTopology();
+#endif
+}
+
+int CpuTopology::node_of(int cpu) const noexcept {
+    for (size_t i = 0; i < m_node_cpus.size(); i++) {
+        const auto& cpus = m_node_cpus[i];
+        if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end()) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+std::vector<std::vector<int>> AffinityPolicy::assign(size_t worker_num,
+                                                     const CpuTopology& topo) const {
+    std::vector<std::vector<int>> ret(worker_num);
+    switch (m_type) {
+        case COMPACT: {
+            const auto& cpus = topo.cpus();
+            for (size_t i = 0; i < worker_num; i++) {
+                ret[i].push_back(cpus[i % cpus.size()]);
+            }
+            break;
+        }
+
+        case SCATTER: {
+            size_t node_num = topo.node_num();
+            for (size_t i = 0; i < worker_num; i++) {
+                const auto& cpus = topo.node_cpus(i % node_num);
+                ret[i].push_back(cpus[(i / node_num) % cpus.size()]);
+            }
+            break;
+        }
+
+        case EXPLICIT:
+            if (!m_cpus.empty()) {
+                for (size_t i = 0; i < worker_num; i++) {
+                    ret[i].push_back(m_cpus[i % m_cpus.size()]);
+                }
+            }
+            break;
+
+        case NUMA_NODE:
+            if (m_node < topo.node_num()) {
+                for (size_t i = 0; i < worker_num; i++) {
+                    ret[i] = topo.node_cpus(m_node);
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+    return ret;
+}
+
+bool bind_current_thread_to_cpus(const std::vector<int>& cpus) noexcept {
+    if (cpus.empty()) {
+        return false;
+    }
+#if HKU_OS_LINUX || HKU_OS_ANDROID
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif HKU_OS_WINDOWS
+    DWORD_PTR mask = 0;
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < int(sizeof(DWORD_PTR) * 8)) {
+            mask |= DWORD_PTR(1) << cpu;
+        }
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+    // macOS 等系统不支持将线程绑定到指定 CPU
+    return false;
+#endif
+}
+
+WorkerPlacement::WorkerPlacement(const AffinityPolicy& policy, size_t worker_num,
+                                 const CpuTopology& topo)
+: m_cpus(policy.assign(worker_num, topo)), m_nodes(worker_num, -1), m_steal_order(worker_num) {
+    for (size_t i = 0; i < worker_num; i++) {
+        // 绑定的 CPU 均位于同一节点时，才认为工作线程属于该节点
+        const auto& cpus = m_cpus[i];
+        if (!cpus.empty()) {
+            int node = topo.node_of(cpus.front());
+            for (int cpu : cpus) {
+                if (topo.node_of(cpu) != node) {
+                    node = -1;
+                    break;
+                }
+            }
+            m_nodes[i] = node;
+        }
+    }
+
+    for (size_t i = 0; i < worker_num; i++) {
+        auto& order = m_steal_order[i];
+        order.reserve(worker_num > 0 ? worker_num - 1 : 0);
+        for (size_t k = 1; k < worker_num; k++) {
+            order.push_back(static_cast<int>((i + k) % worker_num));
+        }
+        if (m_nodes[i] >= 0) {
+            std::stable_partition(order.begin(), order.end(),
+                                  [this, i](int victim) { return m_nodes[victim] == m_nodes[i]; });
+        }
+    }
+}
+
+void WorkerPlacement::bind(size_t index) const noexcept {
+    if (index < m_cpus.size() && !m_cpus[index].empty()) {
+        bind_current_thread_to_cpus(m_cpus[index]);
+    }
+}
+
+}  // namespace hku
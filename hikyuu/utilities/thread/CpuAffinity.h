@@ -0,0 +1,204 @@
+/*
+ * CpuAffinity.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_THREAD_CPUAFFINITY_H
+#define HIKYUU_UTILITIES_THREAD_CPUAFFINITY_H
+
+#include <string>
+#include <vector>
+
+#ifndef HKU_UTILS_API
+#define HKU_UTILS_API
+#endif
+
+namespace hku {
+
+/**
+ * 解析 Linux cpulist 格式的 CPU 列表，如 "0-3,8,10-11"
+ * @return CPU 编号列表，格式错误的部分被忽略
+ */
+std::vector<int> HKU_UTILS_API parse_cpu_list(const std::string& cpu_list);
+
+/**
+ * CPU 及 NUMA 节点拓扑
+ * @details Linux 下从 /sys/devices/system 读取，其他系统视为单个节点
+ */
+class HKU_UTILS_API CpuTopology {
+public:
+    /** 单节点，CPU 编号为 0 ~ hardware_concurrency - 1 */
+    CpuTopology();
+
+    /**
+     * 由各 NUMA 节点的 CPU 列表构造
+     * @param node_cpus 每个节点包含的 CPU 编号，空节点被忽略
+     */
+    explicit CpuTopology(const std::vector<std::vector<int>>& node_cpus);
+
+    /** 当前系统的拓扑，首次调用时读取并缓存 */
+    static const CpuTopology& system();
+
+    /**
+     * 从 sysfs 读取拓扑，读取失败时返回单节点拓扑
+     * @param sys_root sysfs 挂载点，测试时可指定为模拟的目录
+     */
+    static CpuTopology from_sysfs(const std::string& sys_root = "/sys");
+
+    /** 在线 CPU 数 */
+    size_t cpu_num() const noexcept {
+        return m_cpus.size();
+    }
+
+    /** NUMA 节点数 */
+    size_t node_num() const noexcept {
+        return m_node_cpus.size();
+    }
+
+    /** 全部在线 CPU，按节点顺序排列 */
+    const std::vector<int>& cpus() const noexcept {
+        return m_cpus;
+    }
+
+    /** 指定节点（按序号，非节点编号）包含的 CPU */
+    const std::vector<int>& node_cpus(size_t node) const {
+        return m_node_cpus.at(node);
+    }
+
+    /** CPU 所属节点序号，未知时返回 -1 */
+    int node_of(int cpu) const noexcept;
+
+private:
+    std::vector<std::vector<int>> m_node_cpus;
+    std::vector<int> m_cpus;
+};
+
+/**
+ * 工作线程 CPU 亲和性策略
+ * @details
+ * <pre>
+ * NONE     - 不绑定，由操作系统调度（默认）
+ * COMPACT  - 按节点顺序依次将工作线程绑定到单个 CPU，工作线程集中在尽量少的节点上
+ * SCATTER  - 工作线程轮流分布到各节点，每个工作线程绑定到单个 CPU
+ * EXPLICIT - 按给定的 CPU 列表依次绑定，工作线程数多于 CPU 数时循环使用
+ * NUMA_NODE - 全部工作线程绑定到指定节点的所有 CPU，用于每个 NUMA 节点各创建一个线程池
+ * </pre>
+ */
+class HKU_UTILS_API AffinityPolicy {
+public:
+    enum PolicyType { NONE, COMPACT, SCATTER, EXPLICIT, NUMA_NODE };
+
+    AffinityPolicy() = default;
+
+    PolicyType type() const noexcept {
+        return m_type;
+    }
+
+    /** EXPLICIT 策略下的 CPU 列表 */
+    const std::vector<int>& cpus() const noexcept {
+        return m_cpus;
+    }
+
+    /** NUMA_NODE 策略下的节点序号 */
+    size_t node() const noexcept {
+        return m_node;
+    }
+
+    /**
+     * 为各工作线程分配 CPU
+     * @param worker_num 工作线程数
+     * @param topo CPU 拓扑
+     * @return 每个工作线程可运行的 CPU 集合，为空表示不绑定
+     */
+    std::vector<std::vector<int>> assign(size_t worker_num, const CpuTopology& topo) const;
+
+    static AffinityPolicy none() {
+        return AffinityPolicy();
+    }
+
+    static AffinityPolicy compact() {
+        return AffinityPolicy(COMPACT);
+    }
+
+    static AffinityPolicy scatter() {
+        return AffinityPolicy(SCATTER);
+    }
+
+    static AffinityPolicy explicit_cpus(std::vector<int> cpus) {
+        AffinityPolicy ret(EXPLICIT);
+        ret.m_cpus = std::move(cpus);
+        return ret;
+    }
+
+    static AffinityPolicy numa_node(size_t node) {
+        AffinityPolicy ret(NUMA_NODE);
+        ret.m_node = node;
+        return ret;
+    }
+
+private:
+    explicit AffinityPolicy(PolicyType type) : m_type(type) {}
+
+private:
+    PolicyType m_type = NONE;
+    std::vector<int> m_cpus;
+    size_t m_node = 0;
+};
+
+/**
+ * 将当前线程绑定到指定的 CPU 集合
+ * @return 不支持或绑定失败时返回 false
+ */
+bool HKU_UTILS_API bind_current_thread_to_cpus(const std::vector<int>& cpus) noexcept;
+
+/**
+ * 线程池内部使用的工作线程布局：各工作线程绑定的 CPU 及窃取任务时的候选顺序
+ */
+class HKU_UTILS_API WorkerPlacement {
+public:
+    WorkerPlacement() = default;
+
+    /**
+     * 构造函数
+     * @param policy 亲和性策略
+     * @param worker_num 工作线程数
+     * @param topo CPU 拓扑
+     */
+    WorkerPlacement(const AffinityPolicy& policy, size_t worker_num,
+                    const CpuTopology& topo = CpuTopology::system());
+
+    /** 在序号为 index 的工作线程中调用，按策略绑定当前线程 */
+    void bind(size_t index) const noexcept;
+
+    /** 工作线程绑定的 CPU，为空表示未绑定 */
+    const std::vector<int>& cpus(size_t index) const {
+        return m_cpus.at(index);
+    }
+
+    /** 工作线程所在节点序号，未绑定或跨节点时返回 -1 */
+    int node(size_t index) const {
+        return m_nodes.at(index);
+    }
+
+    /**
+     * 工作线程窃取任务时依次尝试的其他工作线程序号
+     * @details 从 index + 1 开始环形排列，同一节点上的工作线程优先
+     */
+    const std::vector<int>& steal_order(size_t index) const {
+        return m_steal_order.at(index);
+    }
+
+private:
+    std::vector<std::vector<int>> m_cpus;
+    std::vector<int> m_nodes;
+    std::vector<std::vector<int>> m_steal_order;
+};
+
+}  // namespace hku
+
+#endif /* HIKYUU_UTILITIES_THREAD_CPUAFFINITY_H */
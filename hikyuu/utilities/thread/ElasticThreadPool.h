@@ -0,0 +1,455 @@
+/*
+ * ElasticThreadPool.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "FuncWrapper.h"
+#include "PackagedTask.h"
+#include "BulkFuture.h"
+#include "../cppdef.h"
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef HKU_UTILS_API
+#define HKU_UTILS_API
+#endif
+
+namespace hku {
+
+/**
+ * @brief 弹性线程池，工作线程数随负载在 [min_threads, max_threads] 之间伸缩，任务之间彼此独立
+ * @details
+ * <pre>
+ * - 提交任务时，如排队任务数多于空闲线程数且活动线程数未达上限，则创建新的工作线程
+ * - 任务中通过 BlockingScope 标记阻塞（如等待 IO）区间，阻塞中的线程不计入活动线程数，
+ *   必要时创建新线程以保持吞吐
+ * - 空闲超过 keep_alive 的工作线程自动退出，直至剩余 min_threads 个
+ * </pre>
+ * 接口与 ThreadPool 一致，可用于替换 ThreadPool，如用于 TimerManager。
+ * @ingroup ThreadPool
+ */
+#ifdef _MSC_VER
+class ElasticThreadPool {
+#else
+class HKU_UTILS_API ElasticThreadPool {
+#endif
+public:
+    /**
+     * 默认构造函数，最多创建和当前系统CPU数一致的线程数
+     */
+    ElasticThreadPool() : ElasticThreadPool(1, std::thread::hardware_concurrency()) {}
+
+    /**
+     * 构造函数
+     * @param min_threads 常驻工作线程数，构造时即创建
+     * @param max_threads 最大活动工作线程数（不含阻塞中的线程），至少为 1
+     * @param keep_alive 超出常驻数量的工作线程空闲该时长后退出
+     */
+    ElasticThreadPool(size_t min_threads, size_t max_threads,
+                      std::chrono::milliseconds keep_alive = std::chrono::milliseconds(60000))
+    : m_min_threads(min_threads),
+      m_max_threads(std::max<size_t>(max_threads, 1)),
+      m_keep_alive(keep_alive) {
+        if (m_min_threads > m_max_threads) {
+            m_min_threads = m_max_threads;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < m_min_threads; i++) {
+            spawn_worker();
+        }
+    }
+
+    /**
+     * 析构函数，等待并阻塞至线程池内所有任务完成
+     */
+    ~ElasticThreadPool() {
+        if (!m_done) {
+            join();
+        }
+    }
+
+    /** 当前工作线程数 */
+    size_t worker_num() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_worker_num;
+    }
+
+    /** 当前空闲等待任务的工作线程数 */
+    size_t idle_num() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_idle_num;
+    }
+
+    /** 常驻工作线程数 */
+    size_t min_threads() const {
+        return m_min_threads;
+    }
+
+    /** 最大活动工作线程数 */
+    size_t max_threads() const {
+        return m_max_threads;
+    }
+
+    /** 累计创建的工作线程数 */
+    size_t created_count() const {
+        return m_created_count;
+    }
+
+    /** 累计因空闲而退出的工作线程数 */
+    size_t retired_count() const {
+        return m_retired_count;
+    }
+
+    /** 工作线程数峰值 */
+    size_t peak_worker_num() const {
+        return m_peak_worker_num;
+    }
+
+    /** 剩余任务数 */
+    size_t remain_task_count() const {
+        return m_queue_size.load(std::memory_order_relaxed);
+    }
+
+    /** 先线程池提交任务后返回的对应 future 的类型 */
+    template <typename ResultType>
+    using task_handle = std::future<ResultType>;
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+
+    /** 向线程池提交任务 */
+    template <typename FunctionType>
+    auto submit(FunctionType&& f) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped ElasticThreadPool!");
+        }
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+        task_type task;
+        task_handle<result_type> res(package_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
+
+    /**
+     * 向线程池提交任务，返回可在协程中直接等待的 AwaitableFuture
+     * @details 任务完成时直接唤醒等待的协程，配合 await_future 使用时无需轮询
+     */
+    template <typename FunctionType>
+    auto submit_awaitable(FunctionType&& f) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped ElasticThreadPool!");
+        }
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+        task_type task;
+        AwaitableFuture<result_type> res(
+          package_awaitable_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
+
+    /**
+     * 批量提交任务，只加锁一次
+     * @param first 起始迭代器，元素为无参数的可调用对象
+     * @param last 结束迭代器
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename Iterator>
+    BulkFuture submit_bulk(Iterator first, Iterator last) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped ElasticThreadPool!");
+        }
+        std::vector<task_type> tasks;
+        BulkFuture res(package_bulk_tasks(first, last, tasks));
+        push_task_bulk(tasks);
+        return res;
+    }
+
+    /**
+     * 批量提交 f(0), f(1), ..., f(n-1) 共 n 个任务
+     * @param n 任务数
+     * @param f 以 size_t 为参数的可调用对象，所有任务共享同一函数对象
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename FunctionType>
+    BulkFuture submit_n(size_t n, FunctionType&& f) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped ElasticThreadPool!");
+        }
+        std::vector<task_type> tasks;
+        BulkFuture res(package_n_tasks(n, std::forward<FunctionType>(f), tasks));
+        push_task_bulk(tasks);
+        return res;
+    }
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+    /**
+     * 阻塞区间标记，在任务中进入可能长时间阻塞的操作（如等待 IO）前创建，离开作用域时结束
+     * @details 阻塞期间该线程不计入活动线程数，如有排队任务则创建新线程执行
+     * @note 仅可在本线程池的任务中使用
+     */
+    class BlockingScope {
+    public:
+        explicit BlockingScope(ElasticThreadPool& pool) : m_pool(pool) {
+            m_pool.enter_blocking();
+        }
+
+        ~BlockingScope() {
+            m_pool.leave_blocking();
+        }
+
+        BlockingScope(const BlockingScope&) = delete;
+        BlockingScope& operator=(const BlockingScope&) = delete;
+
+    private:
+        ElasticThreadPool& m_pool;
+    };
+
+    /** 返回线程池结束状态 */
+    bool done() const {
+        return m_done;
+    }
+
+    /**
+     * 等待各线程完成当前执行的任务后立即结束退出，未执行的任务被丢弃
+     */
+    void stop() {
+        if (m_done.exchange(true)) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        join_all_workers();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.clear();
+        m_queue_size.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * 等待并阻塞至线程池内所有任务完成
+     * @note 至此线程池能工作线程结束不可再使用
+     */
+    void join() {
+        if (m_done) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_joining = true;
+            // 确保剩余任务有线程执行
+            if (!m_queue.empty() && m_worker_num == m_blocking_num) {
+                spawn_worker();
+            }
+        }
+        join_all_workers();
+        m_done = true;
+    }
+
+    struct ExecutorWrapper {
+        ElasticThreadPool* pool;
+        template <typename Function>
+        void execute(Function f) {
+            pool->submit(std::move(f));
+        }
+    };
+
+    /** 协程执行器 */
+    ExecutorWrapper executor() {
+        return ExecutorWrapper{this};
+    }
+
+private:
+    typedef FuncWrapper task_type;
+    typedef std::list<std::thread>::iterator worker_iterator;
+
+    size_t m_min_threads;                    // 常驻工作线程数
+    size_t m_max_threads;                    // 最大活动工作线程数
+    std::chrono::milliseconds m_keep_alive;  // 空闲线程存活时间
+    std::atomic_bool m_done{false};          // 线程池全局需终止指示
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::deque<task_type> m_queue;               // 任务队列
+    std::atomic<size_t> m_queue_size{0};         // 任务队列大小，用于无锁读取
+    std::list<std::thread> m_threads;            // 工作线程
+    std::vector<std::thread> m_retired_threads;  // 已退出待回收的工作线程
+    size_t m_worker_num = 0;                     // 当前工作线程数
+    size_t m_idle_num = 0;                       // 空闲等待中的线程数
+    size_t m_blocking_num = 0;                   // 处于阻塞区间的线程数
+    bool m_joining = false;                      // 等待剩余任务完成后退出
+    bool m_stop = false;                         // 立即退出
+
+    std::atomic<size_t> m_created_count{0};    // 累计创建的线程数
+    std::atomic<size_t> m_retired_count{0};    // 累计退出的线程数
+    std::atomic<size_t> m_peak_worker_num{0};  // 线程数峰值
+
+    // 需持有 m_mutex
+    bool need_more_worker() const {
+        return !m_stop && m_queue.size() > m_idle_num &&
+               m_worker_num - m_blocking_num < m_max_threads;
+    }
+
+    // 需持有 m_mutex
+    void spawn_worker() {
+        // 顺带回收已退出的线程
+        for (auto& t : m_retired_threads) {
+            if (t.joinable()) {
+                t.join();
+            }
+        }
+        m_retired_threads.clear();
+
+        m_threads.emplace_back();
+        auto self = std::prev(m_threads.end());
+        try {
+            *self = std::thread(&ElasticThreadPool::worker_thread, this, self);
+        } catch (...) {
+            m_threads.erase(self);
+            throw;
+        }
+        m_worker_num++;
+        m_created_count++;
+        if (m_worker_num > m_peak_worker_num) {
+            m_peak_worker_num = m_worker_num;
+        }
+    }
+
+    void push_task(task_type&& task) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(task));
+        m_queue_size.store(m_queue.size(), std::memory_order_relaxed);
+        if (need_more_worker()) {
+            spawn_worker();
+        } else {
+            m_cond.notify_one();
+        }
+    }
+
+    void push_task_bulk(std::vector<task_type>& tasks) {
+        if (tasks.empty()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& task : tasks) {
+            m_queue.push_back(std::move(task));
+        }
+        m_queue_size.store(m_queue.size(), std::memory_order_relaxed);
+        while (need_more_worker()) {
+            spawn_worker();
+        }
+        m_cond.notify_all();
+    }
+
+    void enter_blocking() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blocking_num++;
+        if (need_more_worker()) {
+            spawn_worker();
+        }
+    }
+
+    void leave_blocking() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blocking_num--;
+    }
+
+    void join_all_workers() {
+        // 等待期间仍可能因阻塞区间创建新线程，循环直至没有需回收的线程
+        while (true) {
+            std::vector<std::thread> threads;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (auto& t : m_threads) {
+                    if (t.joinable()) {
+                        threads.push_back(std::move(t));
+                    }
+                }
+                for (auto& t : m_retired_threads) {
+                    threads.push_back(std::move(t));
+                }
+                m_retired_threads.clear();
+            }
+            if (threads.empty()) {
+                break;
+            }
+
+            m_cond.notify_all();
+            for (auto& t : threads) {
+                if (t.joinable()) {
+                    t.join();
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threads.clear();
+        m_worker_num = 0;
+    }
+
+    void worker_thread(worker_iterator self) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stop) {
+            if (!m_queue.empty()) {
+                task_type task(std::move(m_queue.front()));
+                m_queue.pop_front();
+                m_queue_size.store(m_queue.size(), std::memory_order_relaxed);
+                lock.unlock();
+                task();
+                lock.lock();
+                continue;
+            }
+
+            if (m_joining) {
+                break;
+            }
+
+            m_idle_num++;
+            bool has_task = m_cond.wait_for(lock, m_keep_alive, [this] {
+                return m_stop || m_joining || !m_queue.empty();
+            });
+            m_idle_num--;
+
+            if (!has_task && m_worker_num > m_min_threads) {
+                // 空闲超时，退出并由其他线程或 join 回收
+                m_retired_threads.push_back(std::move(*self));
+                m_threads.erase(self);
+                m_worker_num--;
+                m_retired_count++;
+                return;
+            }
+        }
+    }
+};
+
+} /* namespace hku */
+
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
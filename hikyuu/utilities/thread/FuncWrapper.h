@@ -11,8 +11,14 @@
 #ifndef HIKYUU_UTILITIES_THREAD_FUNCWRAPPER_H
 #define HIKYUU_UTILITIES_THREAD_FUNCWRAPPER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
 #include <memory>
+#include <new>
 #include <functional>
+#include <type_traits>
+#include "../config.h"
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -23,9 +29,17 @@ namespace hku {
 
 /**
  * 函数及函数对象等包装器实现移动语义，以便线程池支持不同类型的任务
+ * @details 小于 inline_size 的函数对象直接保存在包装器内部，不再额外分配堆内存
  */
 class FuncWrapper {
 public:
+    /** 内联存储空间大小（字节），整个包装器大小为 64 字节 */
+#if HKU_ENABLE_THREAD_POOL_STATS
+    static constexpr size_t inline_size = 64 - sizeof(void*) - sizeof(int64_t);
+#else
+    static constexpr size_t inline_size = 64 - sizeof(void*);
+#endif
+
     FuncWrapper() = default;
     FuncWrapper(const FuncWrapper&) = delete;
     FuncWrapper(FuncWrapper&) = delete;
@@ -34,46 +48,131 @@ public:
     /** 移动构造函数，实现对函数及函数对象等任务包装 */
     template <typename F>
     // cppcheck-suppress noExplicitConstructor ; 此处不能添加 explicit 修饰，需要使用转换复制
-    FuncWrapper(F&& f) : impl(new impl_type<F>(std::move(f))) {}
+    FuncWrapper(F&& f) {
+        typedef typename std::decay<F>::type func_type;
+        if constexpr (can_inline<func_type>()) {
+            ::new (static_cast<void*>(m_storage)) func_type(std::forward<F>(f));
+            m_ops = &inline_ops<func_type>::ops;
+        } else {
+            *reinterpret_cast<func_type**>(m_storage) = new func_type(std::forward<F>(f));
+            m_ops = &heap_ops<func_type>::ops;
+        }
+#if HKU_ENABLE_THREAD_POOL_STATS
+        m_create_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count();
+#endif
+    }
+
+    ~FuncWrapper() {
+        reset();
+    }
 
     /** 执行被包装的任务 */
     void operator()() {
-        if (impl) {
-            impl->call();
+        if (m_ops) {
+            m_ops->call(m_storage);
         }
     }
 
     /** 移动构造函数 */
-    FuncWrapper(FuncWrapper&& other) : impl(std::move(other.impl)) {}
+    FuncWrapper(FuncWrapper&& other) noexcept {
+        move_from(other);
+    }
 
     /** 移动复制函数 */
-    FuncWrapper& operator=(FuncWrapper&& other) {
-        impl = std::move(other.impl);
+    FuncWrapper& operator=(FuncWrapper&& other) noexcept {
+        if (this != &other) {
+            reset();
+            move_from(other);
+        }
         return *this;
     }
 
     /** 是否是空任务，用于线程池判断是否在所有任务完成后终止运行 */
     bool isNullTask() const {
-        return impl ? false : true;
+        return m_ops ? false : true;
     }
 
+    /** 被包装的函数对象是否保存在内联空间中（未分配堆内存） */
+    bool isInline() const {
+        return m_ops && m_ops->is_inline;
+    }
+
+#if HKU_ENABLE_THREAD_POOL_STATS
+    /** 任务创建时间（steady_clock 纳秒数），用于统计任务在队列中的等待时间 */
+    int64_t createTime() const {
+        return m_create_ns;
+    }
+#endif
+
 private:
-    struct impl_base {
-        virtual void call() = 0;
-        virtual ~impl_base() {}
+    struct ops_type {
+        void (*call)(void*);
+        void (*move)(void* dst, void* src);  // 移动至 dst，并析构 src
+        void (*destroy)(void*);
+        bool is_inline;
     };
 
-    std::unique_ptr<impl_base> impl;
+    template <typename F>
+    static constexpr bool can_inline() {
+        return sizeof(F) <= inline_size && alignof(F) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<F>::value;
+    }
+
+    template <typename F>
+    struct inline_ops {
+        static void call(void* p) {
+            (*static_cast<F*>(p))();
+        }
+        static void move(void* dst, void* src) {
+            ::new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        }
+        static void destroy(void* p) {
+            static_cast<F*>(p)->~F();
+        }
+        static constexpr ops_type ops{&call, &move, &destroy, true};
+    };
 
     template <typename F>
-    struct impl_type : impl_base {
-        F f;
-        // cppcheck-suppress noExplicitConstructor ; 此处不能添加 explicit 修饰，需要使用转换复制
-        impl_type(F&& f_) : f(std::move(f_)) {}
-        void call() override {
-            f();
+    struct heap_ops {
+        static void call(void* p) {
+            (**static_cast<F**>(p))();
         }
+        static void move(void* dst, void* src) {
+            *static_cast<F**>(dst) = *static_cast<F**>(src);
+        }
+        static void destroy(void* p) {
+            delete *static_cast<F**>(p);
+        }
+        static constexpr ops_type ops{&call, &move, &destroy, false};
     };
+
+    void reset() noexcept {
+        if (m_ops) {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+    void move_from(FuncWrapper& other) noexcept {
+        if (other.m_ops) {
+            other.m_ops->move(m_storage, other.m_storage);
+            m_ops = other.m_ops;
+            other.m_ops = nullptr;
+        }
+#if HKU_ENABLE_THREAD_POOL_STATS
+        m_create_ns = other.m_create_ns;
+#endif
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char m_storage[inline_size];
+    const ops_type* m_ops = nullptr;
+#if HKU_ENABLE_THREAD_POOL_STATS
+    int64_t m_create_ns = 0;
+#endif
 };
 
 } /* namespace hku */
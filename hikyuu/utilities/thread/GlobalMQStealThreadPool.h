@@ -14,8 +14,11 @@
 #include <chrono>
 #include <vector>
 #include "FuncWrapper.h"
+#include "PackagedTask.h"
+#include "BulkFuture.h"
 #include "MQStealQueue.h"
 #include "InterruptFlag.h"
+#include "ThreadPoolStats.h"
 #include "../cppdef.h"
 
 #ifdef __GNUC__
@@ -51,6 +54,7 @@ public:
     explicit GlobalMQStealThreadPool(size_t n, bool until_empty = true)
     : m_done(false), m_worker_num(n), m_runnging_until_empty(until_empty) {
         try {
+            m_stats = ThreadPoolStatsCollector(m_worker_num);
             m_interrupt_flags.resize(m_worker_num, nullptr);
             for (size_t i = 0; i < m_worker_num; i++) {
                 // 创建工作线程及其任务队列
@@ -93,6 +97,14 @@ public:
         return total;
     }
 
+    /**
+     * 运行统计快照，可在任意线程中调用
+     * @note 编译时开启 HKU_ENABLE_THREAD_POOL_STATS 才收集各工作线程的统计，否则仅包含剩余任务数
+     */
+    ThreadPoolStats stats() const {
+        return m_stats.snapshot(remain_task_count());
+    }
+
     /** 先线程池提交任务后返回的对应 future 的类型 */
     template <typename ResultType>
     using task_handle = std::future<ResultType>;
@@ -111,33 +123,66 @@ public:
         }
 
         typedef typename std::invoke_result<FunctionType>::type result_type;
-        std::packaged_task<result_type()> task(std::forward<FunctionType>(f));
-        task_handle<result_type> res(task.get_future());
+        task_type task;
+        task_handle<result_type> res(package_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
 
-        // 如果是本地线程且线程仍未终止，则加入自身队列
-        if (m_local_work_queue) {
-            // 本地线程任务从前部入队列（递归成栈）
-            m_local_work_queue->push_front(std::move(task));
-            return res;
+    /**
+     * 向线程池提交任务，返回可在协程中直接等待的 AwaitableFuture
+     * @details 任务完成时直接唤醒等待的协程，配合 await_future 使用时无需轮询
+     */
+    template <typename FunctionType>
+    auto submit_awaitable(FunctionType&& f) {
+        if (m_thread_need_stop.isSet() || m_done) {
+            throw std::logic_error(
+              "You can't submit a task to the stopped GlobalMQStealThreadPool!");
         }
 
-        // 选择任务最少的任务队列，将任务加入其尾部
-        size_t min_count = std::numeric_limits<size_t>::max();
-        int index = 0;
-        for (int i = 0; i < m_worker_num; ++i) {
-            size_t cur_count = m_queues[i]->size();
-            if (cur_count == 0) {
-                index = i;
-                break;
-            }
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+        task_type task;
+        AwaitableFuture<result_type> res(
+          package_awaitable_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
 
-            if (cur_count < min_count) {
-                min_count = cur_count;
-                index = i;
-            }
+    /**
+     * 批量提交任务，只加锁一次并仅唤醒所需数量的工作线程
+     * @param first 起始迭代器，元素为无参数的可调用对象
+     * @param last 结束迭代器
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename Iterator>
+    BulkFuture submit_bulk(Iterator first, Iterator last) {
+        if (m_thread_need_stop.isSet() || m_done) {
+            throw std::logic_error(
+              "You can't submit a task to the stopped GlobalMQStealThreadPool!");
         }
 
-        m_queues[index]->push(std::move(task));
+        std::vector<task_type> tasks;
+        BulkFuture res(package_bulk_tasks(first, last, tasks));
+        push_task_bulk(tasks);
+        return res;
+    }
+
+    /**
+     * 批量提交 f(0), f(1), ..., f(n-1) 共 n 个任务
+     * @param n 任务数
+     * @param f 以 size_t 为参数的可调用对象，所有任务共享同一函数对象
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename FunctionType>
+    BulkFuture submit_n(size_t n, FunctionType&& f) {
+        if (m_thread_need_stop.isSet() || m_done) {
+            throw std::logic_error(
+              "You can't submit a task to the stopped GlobalMQStealThreadPool!");
+        }
+
+        std::vector<task_type> tasks;
+        BulkFuture res(package_n_tasks(n, std::forward<FunctionType>(f), tasks));
+        push_task_bulk(tasks);
         return res;
     }
 
@@ -247,9 +292,10 @@ public:
 
 private:
     typedef FuncWrapper task_type;
-    std::atomic_bool m_done;      // 线程池全局需终止指示
-    size_t m_worker_num;          // 工作线程数量
-    bool m_runnging_until_empty;  // 运行直到队列空时停止
+    std::atomic_bool m_done;           // 线程池全局需终止指示
+    size_t m_worker_num;               // 工作线程数量
+    bool m_runnging_until_empty;       // 运行直到队列空时停止
+    ThreadPoolStatsCollector m_stats;  // 运行统计
 
     std::vector<std::unique_ptr<MQStealQueue<task_type>>> m_queues;  // 线程任务队列
     std::vector<InterruptFlag*> m_interrupt_flags;                   // 线程终止标志
@@ -267,6 +313,58 @@ private:
     static thread_local InterruptFlag m_thread_need_stop;             // 线程停止运行指示
 #endif
 
+    void push_task(task_type&& task) {
+        // 如果是本地线程且线程仍未终止，则加入自身队列
+        if (m_local_work_queue) {
+            // 本地线程任务从前部入队列（递归成栈）
+            m_local_work_queue->push_front(std::move(task));
+            return;
+        }
+
+        // 选择任务最少的任务队列，将任务加入其尾部
+        size_t min_count = std::numeric_limits<size_t>::max();
+        int index = 0;
+        for (int i = 0; i < m_worker_num; ++i) {
+            size_t cur_count = m_queues[i]->size();
+            if (cur_count == 0) {
+                index = i;
+                break;
+            }
+
+            if (cur_count < min_count) {
+                min_count = cur_count;
+                index = i;
+            }
+        }
+
+        m_queues[index]->push(std::move(task));
+    }
+
+    void push_task_bulk(std::vector<task_type>& tasks) {
+        if (tasks.empty()) {
+            return;
+        }
+
+        if (m_local_work_queue) {
+            for (auto& task : tasks) {
+                m_local_work_queue->push_front(std::move(task));
+            }
+            return;
+        }
+
+        // 将任务平均分段，每段只对相应工作线程队列加锁一次
+        size_t total = tasks.size();
+        size_t count = m_worker_num;
+        size_t per_num = total / count;
+        size_t extra = total % count;
+        auto first = tasks.begin();
+        for (size_t i = 0; i < count && first != tasks.end(); i++) {
+            size_t len = per_num + (i < extra ? 1 : 0);
+            m_queues[i]->push_bulk(first, first + len);
+            first += len;
+        }
+    }
+
     void worker_thread(int index) {
         m_index = index;
         m_interrupt_flags[index] = &m_thread_need_stop;
@@ -285,7 +383,7 @@ private:
             if (task.isNullTask()) {
                 m_thread_need_stop.set();
             } else {
-                task();
+                m_stats.run_task(m_index, task);
                 // std::this_thread::yield();
             }
             return;
@@ -293,7 +391,7 @@ private:
 
         // 尝试从其他任务队列偷取任务
         if (pop_task_from_other_thread_queue(task)) {
-            task();
+            m_stats.run_task(m_index, task);
             // std::this_thread::yield();
             return;
         }
@@ -301,11 +399,14 @@ private:
         // 阻塞并等待本地队列中有新的任务
         // 注：如果是递归情况，任务被优先加入本地队列且彼此依赖，如果任务被其他线程偷取到的话，将导致其他线程被阻塞并等待
         // 所以，此处等待本地队列而不是继续循环偷取
-        m_local_work_queue->wait_and_pop(task);
+        {
+            auto blocked = m_stats.blocked(m_index);
+            m_local_work_queue->wait_and_pop(task);
+        }
         if (task.isNullTask()) {
             m_thread_need_stop.set();
         } else {
-            task();
+            m_stats.run_task(m_index, task);
             // std::this_thread::yield();
         }
     }
@@ -314,6 +415,7 @@ private:
         for (size_t i = 0; i < m_worker_num; ++i) {
             size_t index = (m_index + i + 1) % m_worker_num;
             if (index != m_index && m_queues[index]->try_steal(task)) {
+                m_stats.task_stolen(m_index, index);
                 return true;
             }
         }
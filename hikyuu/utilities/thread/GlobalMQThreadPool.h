@@ -15,7 +15,10 @@
 #include <vector>
 #include "InterruptFlag.h"
 #include "FuncWrapper.h"
+#include "PackagedTask.h"
+#include "BulkFuture.h"
 #include "ThreadSafeQueue.h"
+#include "ThreadPoolStats.h"
 #include "../cppdef.h"
 
 #ifdef __GNUC__
@@ -53,6 +56,7 @@ public:
     explicit GlobalMQThreadPool(size_t n, bool until_empty = true)
     : m_done(false), m_worker_num(n), m_runnging_until_empty(until_empty) {
         try {
+            m_stats = ThreadPoolStatsCollector(m_worker_num);
             m_interrupt_flags.resize(m_worker_num, nullptr);
             for (int i = 0; i < m_worker_num; i++) {
                 // 创建工作线程及其任务队列
@@ -92,6 +96,14 @@ public:
         return total;
     }
 
+    /**
+     * 运行统计快照，可在任意线程中调用
+     * @note 编译时开启 HKU_ENABLE_THREAD_POOL_STATS 才收集各工作线程的统计，否则仅包含剩余任务数
+     */
+    ThreadPoolStats stats() const {
+        return m_stats.snapshot(remain_task_count());
+    }
+
     /** 先线程池提交任务后返回的对应 future 的类型 */
     template <typename ResultType>
     using task_handle = std::future<ResultType>;
@@ -109,26 +121,63 @@ public:
         }
 
         typedef typename std::invoke_result<FunctionType>::type result_type;
-        std::packaged_task<result_type()> task(std::forward<FunctionType>(f));
-        task_handle<result_type> res(task.get_future());
+        task_type task;
+        task_handle<result_type> res(package_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
 
-        // 向空队列或任务数最小的队列中加入任务
-        size_t min_count = std::numeric_limits<size_t>::max();
-        int index = 0;
-        for (int i = 0; i < m_worker_num; ++i) {
-            size_t cur_count = m_queues[i]->size();
-            if (cur_count == 0) {
-                index = i;
-                break;
-            }
+    /**
+     * 向线程池提交任务，返回可在协程中直接等待的 AwaitableFuture
+     * @details 任务完成时直接唤醒等待的协程，配合 await_future 使用时无需轮询
+     */
+    template <typename FunctionType>
+    auto submit_awaitable(FunctionType&& f) {
+        if (m_thread_need_stop.isSet() || m_done) {
+            throw std::logic_error("You can't submit a task to the stopped GlobalMQThreadPool!");
+        }
 
-            if (cur_count < min_count) {
-                min_count = cur_count;
-                index = i;
-            }
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+        task_type task;
+        AwaitableFuture<result_type> res(
+          package_awaitable_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
+
+    /**
+     * 批量提交任务，只加锁一次并仅唤醒所需数量的工作线程
+     * @param first 起始迭代器，元素为无参数的可调用对象
+     * @param last 结束迭代器
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename Iterator>
+    BulkFuture submit_bulk(Iterator first, Iterator last) {
+        if (m_thread_need_stop.isSet() || m_done) {
+            throw std::logic_error("You can't submit a task to the stopped GlobalMQThreadPool!");
         }
 
-        m_queues[index]->push(std::move(task));
+        std::vector<task_type> tasks;
+        BulkFuture res(package_bulk_tasks(first, last, tasks));
+        push_task_bulk(tasks);
+        return res;
+    }
+
+    /**
+     * 批量提交 f(0), f(1), ..., f(n-1) 共 n 个任务
+     * @param n 任务数
+     * @param f 以 size_t 为参数的可调用对象，所有任务共享同一函数对象
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename FunctionType>
+    BulkFuture submit_n(size_t n, FunctionType&& f) {
+        if (m_thread_need_stop.isSet() || m_done) {
+            throw std::logic_error("You can't submit a task to the stopped GlobalMQThreadPool!");
+        }
+
+        std::vector<task_type> tasks;
+        BulkFuture res(package_n_tasks(n, std::forward<FunctionType>(f), tasks));
+        push_task_bulk(tasks);
         return res;
     }
 
@@ -238,9 +287,10 @@ public:
 
 private:
     typedef FuncWrapper task_type;
-    std::atomic_bool m_done;      // 线程池全局需终止指示
-    size_t m_worker_num;          // 工作线程数量
-    bool m_runnging_until_empty;  // 运行直到队列空时停止
+    std::atomic_bool m_done;           // 线程池全局需终止指示
+    size_t m_worker_num;               // 工作线程数量
+    bool m_runnging_until_empty;       // 运行直到队列空时停止
+    ThreadPoolStatsCollector m_stats;  // 运行统计
 
     std::vector<std::unique_ptr<ThreadSafeQueue<task_type>>> m_queues;  // 线程任务队列
     std::vector<InterruptFlag*> m_interrupt_flags;                      // 线程终止标志
@@ -256,23 +306,64 @@ private:
     static thread_local InterruptFlag m_thread_need_stop;                // 线程停止运行指示
 #endif
 
+    void push_task(task_type&& task) {
+        // 向空队列或任务数最小的队列中加入任务
+        size_t min_count = std::numeric_limits<size_t>::max();
+        int index = 0;
+        for (int i = 0; i < m_worker_num; ++i) {
+            size_t cur_count = m_queues[i]->size();
+            if (cur_count == 0) {
+                index = i;
+                break;
+            }
+
+            if (cur_count < min_count) {
+                min_count = cur_count;
+                index = i;
+            }
+        }
+
+        m_queues[index]->push(std::move(task));
+    }
+
+    void push_task_bulk(std::vector<task_type>& tasks) {
+        if (tasks.empty()) {
+            return;
+        }
+
+        // 将任务平均分段，每段只对相应工作线程队列加锁一次
+        size_t total = tasks.size();
+        size_t count = m_worker_num;
+        size_t per_num = total / count;
+        size_t extra = total % count;
+        auto first = tasks.begin();
+        for (size_t i = 0; i < count && first != tasks.end(); i++) {
+            size_t len = per_num + (i < extra ? 1 : 0);
+            m_queues[i]->push_bulk(first, first + len);
+            first += len;
+        }
+    }
+
     void worker_thread(int index) {
         m_interrupt_flags[index] = &m_thread_need_stop;
         m_local_work_queue = m_queues[index].get();
         while (!m_thread_need_stop.isSet() || !m_done) {
-            run_pending_task();
+            run_pending_task(index);
         }
         m_local_work_queue = nullptr;
         m_interrupt_flags[index] = nullptr;
     }
 
-    static void run_pending_task() {
+    void run_pending_task(int index) {
         task_type task;
-        m_local_work_queue->wait_and_pop(task);
+        {
+            auto blocked = m_stats.blocked(index);
+            m_local_work_queue->wait_and_pop(task);
+        }
         if (task.isNullTask()) {
             m_thread_need_stop.set();
         } else {
-            task();
+            m_stats.run_task(index, task);
         }
     }
 };
@@ -13,8 +13,15 @@
 #include <thread>
 #include <vector>
 #include "ThreadSafeQueue.h"
+#include "PackagedTask.h"
+#include "BulkFuture.h"
+#include "TaskLatch.h"
 #include "WorkStealQueue.h"
+#include "LockFreeStealQueue.h"
 #include "InterruptFlag.h"
+#include "CpuAffinity.h"
+#include "ThreadPoolStats.h"
+#include "../config.h"
 #include "../Log.h"
 #include "../cppdef.h"
 
@@ -52,12 +59,23 @@ public:
      * @param until_empty 任务队列为空时，自动停止运行
      */
     explicit GlobalStealThreadPool(size_t n, bool until_empty = true)
+    : GlobalStealThreadPool(n, AffinityPolicy(), until_empty) {}
+
+    /**
+     * 构造函数，创建指定数量的线程，并按亲和性策略绑定工作线程
+     * @param n 指定的线程数
+     * @param affinity CPU 亲和性策略
+     * @param until_empty 任务队列为空时，自动停止运行
+     */
+    GlobalStealThreadPool(size_t n, const AffinityPolicy& affinity, bool until_empty = true)
     : m_done(false), m_worker_num(n), m_running_until_empty(until_empty), m_sleep_count(0) {
         try {
+            m_placement = WorkerPlacement(affinity, m_worker_num);
+            m_stats = ThreadPoolStatsCollector(m_worker_num);
             m_interrupt_flags.resize(m_worker_num, nullptr);
             for (int i = 0; i < m_worker_num; i++) {
                 // 创建工作线程及其任务队列
-                m_queues.emplace_back(new WorkStealQueue);
+                m_queues.emplace_back(new queue_type);
             }
             // 初始完毕所有线程资源后再启动线程
             for (int i = 0; i < m_worker_num; i++) {
@@ -142,6 +160,14 @@ public:
         return total;
     }
 
+    /**
+     * 运行统计快照，可在任意线程中调用
+     * @note 编译时开启 HKU_ENABLE_THREAD_POOL_STATS 才收集各工作线程的统计，否则仅包含剩余任务数
+     */
+    ThreadPoolStats stats() const {
+        return m_stats.snapshot(remain_task_count());
+    }
+
     /** 当前线程是否为工作线程 */
     static bool is_work_thread() {
         return m_local_work_queue != nullptr;
@@ -165,21 +191,110 @@ public:
         }
 
         typedef typename std::invoke_result<FunctionType>::type result_type;
-        std::packaged_task<result_type()> task(std::forward<FunctionType>(f));
-        task_handle<result_type> res(task.get_future());
+        task_type task;
+        task_handle<result_type> res(package_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
 
-        std::thread::id id = std::this_thread::get_id();
-        if (m_local_work_queue && id == m_thread_id) {
-            // 本地线程任务从前部入队列（递归成栈）
-            m_local_work_queue->push_front(std::move(task));
-        } else {
-            m_master_work_queue.push(std::move(task));
-            m_cv.notify_one();
+    /**
+     * 向线程池提交任务，返回可在协程中直接等待的 AwaitableFuture
+     * @details 任务完成时直接唤醒等待的协程，配合 await_future 使用时无需轮询
+     */
+    template <typename FunctionType>
+    auto submit_awaitable(FunctionType&& f) {
+        if (m_thread_need_stop.isSet() || m_done.load(std::memory_order_acquire)) {
+            throw std::logic_error(
+              "You can't submit a task to the stopped GlobalStealThreadPool!!");
         }
 
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+        task_type task;
+        AwaitableFuture<result_type> res(
+          package_awaitable_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
         return res;
     }
 
+    /**
+     * 批量提交任务，只加锁一次并仅唤醒所需数量的工作线程
+     * @param first 起始迭代器，元素为无参数的可调用对象
+     * @param last 结束迭代器
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename Iterator>
+    BulkFuture submit_bulk(Iterator first, Iterator last) {
+        if (m_thread_need_stop.isSet() || m_done.load(std::memory_order_acquire)) {
+            throw std::logic_error(
+              "You can't submit a task to the stopped GlobalStealThreadPool!!");
+        }
+
+        std::vector<task_type> tasks;
+        BulkFuture res(package_bulk_tasks(first, last, tasks));
+        push_task_bulk(tasks);
+        return res;
+    }
+
+    /**
+     * 批量提交 f(0), f(1), ..., f(n-1) 共 n 个任务
+     * @param n 任务数
+     * @param f 以 size_t 为参数的可调用对象，所有任务共享同一函数对象
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename FunctionType>
+    BulkFuture submit_n(size_t n, FunctionType&& f) {
+        if (m_thread_need_stop.isSet() || m_done.load(std::memory_order_acquire)) {
+            throw std::logic_error(
+              "You can't submit a task to the stopped GlobalStealThreadPool!!");
+        }
+
+        std::vector<task_type> tasks;
+        BulkFuture res(package_n_tasks(n, std::forward<FunctionType>(f), tasks));
+        push_task_bulk(tasks);
+        return res;
+    }
+
+    /**
+     * 提交由 latch 计数的子任务，不返回任务句柄，需配合 wait(latch) 等待完成
+     * @param latch 子任务完成计数器，须在子任务全部完成前保持有效
+     * @param f 无参数的可调用对象
+     */
+    template <typename FunctionType>
+    void spawn(TaskLatch& latch, FunctionType&& f) {
+        if (m_thread_need_stop.isSet() || m_done.load(std::memory_order_acquire)) {
+            throw std::logic_error(
+              "You can't submit a task to the stopped GlobalStealThreadPool!!");
+        }
+
+        latch.add(1);
+        push_task(task_type([token = TaskLatchToken(&latch),
+                             func = typename std::decay<FunctionType>::type(
+                               std::forward<FunctionType>(f))]() mutable { token.run(func); }));
+    }
+
+    /**
+     * 提交由 latch 计数的子任务 f(0), f(1), ..., f(n-1)
+     * @param latch 子任务完成计数器，须在子任务全部完成前保持有效
+     * @param n 任务数
+     * @param f 以 size_t 为参数的可调用对象，各任务通过引用共享，须在子任务全部完成前保持有效
+     */
+    template <typename FunctionType>
+    void spawn_n(TaskLatch& latch, size_t n, FunctionType& f) {
+        if (m_thread_need_stop.isSet() || m_done.load(std::memory_order_acquire)) {
+            throw std::logic_error(
+              "You can't submit a task to the stopped GlobalStealThreadPool!!");
+        }
+
+        std::vector<task_type> tasks;
+        tasks.reserve(n);
+        latch.add(n);
+        for (size_t i = 0; i < n; i++) {
+            tasks.emplace_back(
+              [token = TaskLatchToken(&latch), &f, i]() mutable { token.run(f, i); });
+        }
+        push_task_bulk(tasks);
+    }
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -205,7 +320,13 @@ public:
             if (m_interrupt_flags[i]) {
                 m_interrupt_flags[i]->set();
             }
+#if HKU_USE_LOCKFREE_STEAL_QUEUE
+            // 无锁队列的 push_front 只能由所属工作线程调用，空任务经外部队列加入。
+            // 中断标志已设置，工作线程结束当前任务后即退出，队列中剩余的任务同样不会执行
+            m_queues[i]->push_back(FuncWrapper());
+#else
             m_queues[i]->push_front(FuncWrapper());
+#endif
         }
 
         m_cv.notify_all();  // 唤醒所有工作线程
@@ -303,17 +424,17 @@ public:
         if (m_local_work_queue) {
             if (pop_task_from_local_queue(task)) {
                 if (!task.isNullTask()) {
-                    task();
+                    m_stats.run_task(m_index, task);
                     task_run = true;
                 } else {
                     m_thread_need_stop.set();
                 }
             } else if (pop_task_from_other_thread_queue(task)) {
-                task();
+                m_stats.run_task(m_index, task);
                 task_run = true;
             } else if (pop_task_from_master_queue(task)) {
                 if (!task.isNullTask()) {
-                    task();
+                    m_stats.run_task(m_index, task);
                     task_run = true;
                 } else {
                     m_thread_need_stop.set();
@@ -321,41 +442,115 @@ public:
             }
         } else if (pop_task_from_master_queue(task)) {
             if (!task.isNullTask()) {
-                task();
+                m_stats.run_task(m_index, task);
                 task_run = true;
             }
         }
         return task_run;
     }
 
+    /**
+     * 等待 latch 计数归零，当前线程在等待期间协助执行线程池中的任务
+     * @details
+     * 无任务可执行时，先短暂让出 CPU，之后在 latch 上休眠：子任务全部完成时立即被唤醒，
+     * 同时每隔 1ms 醒来检查是否有新产生的任务（如子任务派生的任务）可以协助执行。
+     * 子任务中如有异常，则在全部子任务完成后重新抛出第一个异常。
+     */
+    void wait(TaskLatch& latch) {
+        // 工作线程的子任务加入的是自身队列前端，其他线程需要被唤醒才能窃取
+        if (!latch.ready() && is_work_thread()) {
+            wake_up();
+        }
+
+        const int max_spin = 64;
+        int spin = 0;
+        while (!latch.ready()) {
+            if (run_available_task_once()) {
+                spin = 0;
+            } else if (m_done.load(std::memory_order_acquire) || m_thread_need_stop.isSet()) {
+                // 线程池已停止，未执行的子任务会随队列清理而完成计数
+                latch.wait();
+            } else if (spin < max_spin) {
+                spin++;
+                std::this_thread::yield();
+            } else {
+                latch.wait_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        latch.rethrow_if_exception();
+    }
+
 private:
     typedef FuncWrapper task_type;
-    std::atomic_bool m_done;         // 线程池全局需终止指示
-    size_t m_worker_num;             // 工作线程数量
-    bool m_running_until_empty;      // 任务队列为空时，自动停止运行
-    std::condition_variable m_cv;    // 信号量，无任务时阻塞线程并等待
-    std::mutex m_cv_mutex;           // 配合信号量的互斥量
-    std::atomic<int> m_sleep_count;  // 休眠计数
-
-    std::vector<InterruptFlag*> m_interrupt_flags;           // 工作线程状态
-    ThreadSafeQueue<task_type> m_master_work_queue;          // 主线程任务队列
-    std::vector<std::unique_ptr<WorkStealQueue> > m_queues;  // 任务队列（每个工作线程一个）
-    std::vector<std::thread> m_threads;                      // 工作线程
+#if HKU_USE_LOCKFREE_STEAL_QUEUE
+    typedef LockFreeStealQueue<task_type> queue_type;
+#else
+    typedef WorkStealQueue queue_type;
+#endif
+    std::atomic_bool m_done;           // 线程池全局需终止指示
+    size_t m_worker_num;               // 工作线程数量
+    bool m_running_until_empty;        // 任务队列为空时，自动停止运行
+    WorkerPlacement m_placement;       // 工作线程 CPU 绑定及窃取顺序
+    ThreadPoolStatsCollector m_stats;  // 运行统计
+    std::condition_variable m_cv;      // 信号量，无任务时阻塞线程并等待
+    std::mutex m_cv_mutex;             // 配合信号量的互斥量
+    std::atomic<int> m_sleep_count;    // 休眠计数
+
+    std::vector<InterruptFlag*> m_interrupt_flags;       // 工作线程状态
+    ThreadSafeQueue<task_type> m_master_work_queue;      // 主线程任务队列
+    std::vector<std::unique_ptr<queue_type> > m_queues;  // 任务队列（每个工作线程一个）
+    std::vector<std::thread> m_threads;                  // 工作线程
 
     // 线程本地变量
 #if CPP_STANDARD >= CPP_STANDARD_17 && !defined(__clang__)
-    inline static thread_local WorkStealQueue* m_local_work_queue = nullptr;  // 本地任务队列
-    inline static thread_local int m_index = -1;                              // 在线程池中的序号
-    inline static thread_local InterruptFlag m_thread_need_stop;              // 线程停止运行指示
+    inline static thread_local queue_type* m_local_work_queue = nullptr;  // 本地任务队列
+    inline static thread_local int m_index = -1;                          // 在线程池中的序号
+    inline static thread_local InterruptFlag m_thread_need_stop;          // 线程停止运行指示
     inline static thread_local std::thread::id m_thread_id;
 #else
-    static thread_local WorkStealQueue* m_local_work_queue;  // 本地任务队列
-    static thread_local int m_index;                         // 在线程池中的序号
-    static thread_local InterruptFlag m_thread_need_stop;    // 线程停止运行指示
+    static thread_local queue_type* m_local_work_queue;    // 本地任务队列
+    static thread_local int m_index;                       // 在线程池中的序号
+    static thread_local InterruptFlag m_thread_need_stop;  // 线程停止运行指示
     static thread_local std::thread::id m_thread_id;
 #endif
 
+    void push_task(task_type&& task) {
+        std::thread::id id = std::this_thread::get_id();
+        if (m_local_work_queue && id == m_thread_id) {
+            // 本地线程任务从前部入队列（递归成栈）
+            m_local_work_queue->push_front(std::move(task));
+        } else {
+            m_master_work_queue.push(std::move(task));
+            m_cv.notify_one();
+        }
+    }
+
+    void push_task_bulk(std::vector<task_type>& tasks) {
+        if (tasks.empty()) {
+            return;
+        }
+
+        std::thread::id id = std::this_thread::get_id();
+        if (m_local_work_queue && id == m_thread_id) {
+            for (auto& task : tasks) {
+                m_local_work_queue->push_front(std::move(task));
+            }
+            return;
+        }
+
+        m_master_work_queue.push_bulk(tasks.begin(), tasks.end());
+        if (tasks.size() >= m_worker_num) {
+            m_cv.notify_all();
+        } else {
+            for (size_t i = 0; i < tasks.size(); i++) {
+                m_cv.notify_one();
+            }
+        }
+    }
+
     void worker_thread(int index) {
+        m_placement.bind(index);
         m_thread_id = std::this_thread::get_id();
         m_interrupt_flags[index] = &m_thread_need_stop;
         m_index = index;
@@ -373,23 +568,24 @@ private:
         task_type task;
         if (pop_task_from_local_queue(task)) {
             if (!task.isNullTask()) {
-                task();
+                m_stats.run_task(m_index, task);
             } else {
                 m_thread_need_stop.set();
             }
         } else if (pop_task_from_master_queue(task)) {
             if (!task.isNullTask()) {
-                task();
+                m_stats.run_task(m_index, task);
             } else {
                 m_thread_need_stop.set();
             }
         } else if (pop_task_from_other_thread_queue(task)) {
-            task();
+            m_stats.run_task(m_index, task);
         } else {
             // 进入等待状态前增加休眠计数
             m_sleep_count.fetch_add(1, std::memory_order_acq_rel);
 
             // std::this_thread::yield();
+            auto blocked = m_stats.blocked(m_index);
             std::unique_lock<std::mutex> lk(m_cv_mutex);
             m_cv.wait(lk, [this] {
                 return this->m_done.load(std::memory_order_acquire) ||
@@ -413,9 +609,10 @@ private:
     }
 
     bool pop_task_from_other_thread_queue(task_type& task) {
-        for (int i = 0; i < m_worker_num; ++i) {
-            int index = (m_index + i + 1) % m_worker_num;
-            if (index != m_index && m_queues[index]->try_steal(task)) {
+        // 优先从同一 NUMA 节点上的工作线程窃取
+        for (int index : m_placement.steal_order(m_index)) {
+            if (m_queues[index]->try_steal(task)) {
+                m_stats.task_stolen(m_index, index);
                 return true;
             }
         }
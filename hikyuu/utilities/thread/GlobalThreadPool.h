@@ -14,8 +14,11 @@
 #include <thread>
 #include <vector>
 #include "FuncWrapper.h"
+#include "PackagedTask.h"
+#include "BulkFuture.h"
 #include "ThreadSafeQueue.h"
 #include "InterruptFlag.h"
+#include "ThreadPoolStats.h"
 #include "../cppdef.h"
 
 #ifdef __GNUC__
@@ -54,6 +57,7 @@ public:
     explicit GlobalThreadPool(size_t n, bool until_empty = true)
     : m_done(false), m_worker_num(n), m_running_until_empty(until_empty) {
         try {
+            m_stats = ThreadPoolStatsCollector(m_worker_num);
             m_interrupt_flags.resize(m_worker_num, nullptr);
             // 初始完毕所有线程资源后再启动线程
             for (int i = 0; i < m_worker_num; i++) {
@@ -96,9 +100,60 @@ public:
             throw std::logic_error("You can't submit a task to the stopped task group!");
         }
         typedef typename std::invoke_result<FunctionType>::type result_type;
-        std::packaged_task<result_type()> task(std::forward<FunctionType>(f));
-        task_handle<result_type> res(task.get_future());
-        m_master_work_queue.push(std::move(task));
+        task_type task;
+        task_handle<result_type> res(package_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
+
+    /**
+     * 向线程池提交任务，返回可在协程中直接等待的 AwaitableFuture
+     * @details 任务完成时直接唤醒等待的协程，配合 await_future 使用时无需轮询
+     */
+    template <typename FunctionType>
+    auto submit_awaitable(FunctionType&& f) {
+        if (m_thread_need_stop.isSet() || m_done) {
+            throw std::logic_error("You can't submit a task to the stopped task group!");
+        }
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+        task_type task;
+        AwaitableFuture<result_type> res(
+          package_awaitable_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
+
+    /**
+     * 批量提交任务，只加锁一次并仅唤醒所需数量的工作线程
+     * @param first 起始迭代器，元素为无参数的可调用对象
+     * @param last 结束迭代器
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename Iterator>
+    BulkFuture submit_bulk(Iterator first, Iterator last) {
+        if (m_thread_need_stop.isSet() || m_done) {
+            throw std::logic_error("You can't submit a task to the stopped task group!");
+        }
+        std::vector<task_type> tasks;
+        BulkFuture res(package_bulk_tasks(first, last, tasks));
+        push_task_bulk(tasks);
+        return res;
+    }
+
+    /**
+     * 批量提交 f(0), f(1), ..., f(n-1) 共 n 个任务
+     * @param n 任务数
+     * @param f 以 size_t 为参数的可调用对象，所有任务共享同一函数对象
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename FunctionType>
+    BulkFuture submit_n(size_t n, FunctionType&& f) {
+        if (m_thread_need_stop.isSet() || m_done) {
+            throw std::logic_error("You can't submit a task to the stopped task group!");
+        }
+        std::vector<task_type> tasks;
+        BulkFuture res(package_n_tasks(n, std::forward<FunctionType>(f), tasks));
+        push_task_bulk(tasks);
         return res;
     }
 
@@ -116,6 +171,14 @@ public:
         return m_master_work_queue.size();
     }
 
+    /**
+     * 运行统计快照，可在任意线程中调用
+     * @note 编译时开启 HKU_ENABLE_THREAD_POOL_STATS 才收集各工作线程的统计，否则仅包含剩余任务数
+     */
+    ThreadPoolStats stats() const {
+        return m_stats.snapshot(remain_task_count());
+    }
+
     /**
      * 等待各线程完成当前执行的任务后立即结束退出
      */
@@ -191,9 +254,10 @@ public:
 
 private:
     typedef FuncWrapper task_type;
-    std::atomic_bool m_done;     // 线程池全局需终止指示
-    size_t m_worker_num;         // 工作线程数量
-    bool m_running_until_empty;  // 任务队列为空时，自动停止运行
+    std::atomic_bool m_done;           // 线程池全局需终止指示
+    size_t m_worker_num;               // 工作线程数量
+    bool m_running_until_empty;        // 任务队列为空时，自动停止运行
+    ThreadPoolStatsCollector m_stats;  // 运行统计
 
     ThreadSafeQueue<task_type> m_master_work_queue;  // 主线程任务队列
     std::vector<std::thread> m_threads;              // 工作线程
@@ -206,22 +270,37 @@ private:
     static thread_local InterruptFlag m_thread_need_stop;  // 线程停止运行指示
 #endif
 
+    void push_task(task_type&& task) {
+        m_master_work_queue.push(std::move(task));
+    }
+
+    void push_task_bulk(std::vector<task_type>& tasks) {
+        if (tasks.empty()) {
+            return;
+        }
+
+        m_master_work_queue.push_bulk(tasks.begin(), tasks.end());
+    }
+
     void worker_thread(int index) {
         m_interrupt_flags[index] = &m_thread_need_stop;
         while (!m_thread_need_stop.isSet() && !m_done) {
-            run_pending_task();
+            run_pending_task(index);
             // std::this_thread::yield();
         }
         m_interrupt_flags[index] = nullptr;
     }
 
-    void run_pending_task() {
+    void run_pending_task(int index) {
         task_type task;
-        m_master_work_queue.wait_and_pop(task);
+        {
+            auto blocked = m_stats.blocked(index);
+            m_master_work_queue.wait_and_pop(task);
+        }
         if (task.isNullTask()) {
             m_thread_need_stop.set();
         } else {
-            task();
+            m_stats.run_task(index, task);
         }
     }
 };  // namespace hku
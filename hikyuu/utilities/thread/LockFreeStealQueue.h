@@ -0,0 +1,333 @@
+/*
+ * LockFreeStealQueue.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_THREAD_LOCKFREESTEALQUEUE_H
+#define HIKYUU_UTILITIES_THREAD_LOCKFREESTEALQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <condition_variable>
+
+namespace hku {
+
+/**
+ * 无锁任务偷取队列（Chase-Lev 双端队列）
+ * @details
+ * 可替代 WorkStealQueue/MQStealQueue 作为偷取式线程池的工作线程队列:
+ * <pre>
+ * - push_front/try_pop 只能由队列所属的工作线程调用，无锁（本地任务后进先出）
+ * - try_steal 可由任意线程调用，无锁（从另一端偷取最早的本地任务）
+ * - push/push_back 可由任意线程调用，进入带锁的外部队列，由所属工作线程在本地任务为空时取出
+ * </pre>
+ * 环形缓冲区满时自动扩容，旧缓冲区在队列析构时才释放，以保证偷取线程访问安全。
+ * 数据保存在可复用的节点中，预热后入队出队不再分配内存。
+ * @note 结束线程的空任务只能通过 push/push_back 加入，try_steal 不会偷取外部队列尾部的空任务
+ */
+template <typename T>
+class LockFreeStealQueue {
+public:
+    /**
+     * 构造函数
+     * @param capacity 初始环形缓冲区容量，会调整为 2 的幂
+     */
+    explicit LockFreeStealQueue(size_t capacity = 256)
+    : m_top(0), m_bottom(0), m_free_shared(nullptr), m_inbox_size(0) {
+        int64_t cap = 2;
+        while (cap < static_cast<int64_t>(capacity)) {
+            cap <<= 1;
+        }
+        m_buffers.emplace_back(new Buffer(cap));
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    ~LockFreeStealQueue() {
+        clear();
+        release_free_nodes(m_free_local);
+        release_free_nodes(m_free_shared.exchange(nullptr, std::memory_order_acquire));
+    }
+
+    // 禁用赋值构造和赋值重载
+    LockFreeStealQueue(const LockFreeStealQueue&) = delete;
+    LockFreeStealQueue& operator=(const LockFreeStealQueue&) = delete;
+
+    /** 将数据插入队列头部，仅限所属工作线程调用 */
+    void push_front(T&& data) {
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_acquire);
+        Buffer* buf = m_buffer.load(std::memory_order_relaxed);
+        if (b - t > buf->capacity - 1) {
+            buf = grow(buf, b, t);
+        }
+        buf->put(b, alloc_node(std::move(data)));
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /** 将数据插入队列尾部，可由任意线程调用 */
+    void push_back(T&& data) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_inbox.push_back(std::move(data));
+        m_inbox_size.store(m_inbox.size(), std::memory_order_relaxed);
+        m_cond.notify_one();
+    }
+
+    /** 将 [first, last) 中的元素批量移入外部队列，只加锁一次，可在任意线程调用 */
+    template <typename Iterator>
+    void push_bulk(Iterator first, Iterator last) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        for (; first != last; ++first) {
+            m_inbox.push_back(std::move(*first));
+        }
+        m_inbox_size.store(m_inbox.size(), std::memory_order_relaxed);
+        m_cond.notify_one();
+    }
+
+    /** 同 push_back，兼容 MQStealQueue 接口 */
+    void push(T&& data) {
+        push_back(std::move(data));
+    }
+
+    /**
+     * 尝试从队列头部弹出一条数据，仅限所属工作线程调用
+     * @param res 存储弹出的数据
+     * @return 如果原本队列为空返回 false，否则为 true
+     */
+    bool try_pop(T& res) {
+        Node* node = take();
+        if (node) {
+            res = std::move(node->value);
+            recycle_local(node);
+            return true;
+        }
+        return try_pop_inbox(res);
+    }
+
+    /**
+     * 等待直到从队列头部取出一条数据，仅限所属工作线程调用
+     * @note 所属线程自身阻塞时无法再向本地插入数据，故只需等待外部队列
+     */
+    void wait_and_pop(T& res) {
+        if (try_pop(res)) {
+            return;
+        }
+        std::unique_lock<std::mutex> lk(m_mutex);
+        m_cond.wait(lk, [this] { return !m_inbox.empty(); });
+        res = std::move(m_inbox.front());
+        m_inbox.pop_front();
+        m_inbox_size.store(m_inbox.size(), std::memory_order_relaxed);
+    }
+
+    /**
+     * 尝试从队列尾部偷取一条数据
+     * @param res 存储偷取的数据
+     * @return 如果原本队列为空返回 false，否则为 true
+     */
+    bool try_steal(T& res) {
+        Node* node = steal();
+        if (node) {
+            res = std::move(node->value);
+            recycle_shared(node);
+            return true;
+        }
+
+        if (m_inbox_size.load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_inbox.empty() || m_inbox.back().isNullTask()) {
+            return false;
+        }
+        res = std::move(m_inbox.back());
+        m_inbox.pop_back();
+        m_inbox_size.store(m_inbox.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    /** 队列是否为空 */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /** 队列大小（近似值） */
+    size_t size() const {
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+        size_t local = b > t ? static_cast<size_t>(b - t) : 0;
+        return local + m_inbox_size.load(std::memory_order_relaxed);
+    }
+
+    /** 清空队列，调用时不能有其他线程同时访问该队列 */
+    void clear() {
+        Node* node = nullptr;
+        while ((node = take()) != nullptr) {
+            node->value = T();
+            recycle_local(node);
+        }
+
+        std::lock_guard<std::mutex> lk(m_mutex);
+        auto tmp = std::deque<T>();
+        m_inbox.swap(tmp);
+        m_inbox_size.store(0, std::memory_order_relaxed);
+    }
+
+    /** 唤醒阻塞在 wait_and_pop 上的线程 */
+    void notify_all() {
+        m_cond.notify_all();
+    }
+
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+    struct Buffer {
+        explicit Buffer(int64_t cap)
+        : capacity(cap), mask(cap - 1), slots(new std::atomic<Node*>[cap]) {}
+
+        Node* get(int64_t i) const {
+            return slots[i & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t i, Node* node) {
+            slots[i & mask].store(node, std::memory_order_relaxed);
+        }
+
+        int64_t capacity;
+        int64_t mask;
+        std::unique_ptr<std::atomic<Node*>[]> slots;
+    };
+
+    // 仅由所属线程调用，从本地端取出
+    Node* take() {
+        int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buf = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+
+        Node* node = nullptr;
+        if (t <= b) {
+            node = buf->get(b);
+            if (t == b) {
+                // 最后一个元素，和偷取线程竞争
+                if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed)) {
+                    node = nullptr;
+                }
+                m_bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        } else {
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return node;
+    }
+
+    Node* steal() {
+        int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = m_bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+
+        Buffer* buf = m_buffer.load(std::memory_order_acquire);
+        Node* node = buf->get(t);
+        if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return node;
+    }
+
+    // 仅由所属线程调用，扩容后的旧缓冲区仍可能被偷取线程读取，延迟到析构时释放
+    Buffer* grow(Buffer* old, int64_t b, int64_t t) {
+        Buffer* buf = new Buffer(old->capacity * 2);
+        for (int64_t i = t; i < b; i++) {
+            buf->put(i, old->get(i));
+        }
+        m_buffers.emplace_back(buf);
+        m_buffer.store(buf, std::memory_order_release);
+        return buf;
+    }
+
+    bool try_pop_inbox(T& res) {
+        if (m_inbox_size.load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_inbox.empty()) {
+            return false;
+        }
+        res = std::move(m_inbox.front());
+        m_inbox.pop_front();
+        m_inbox_size.store(m_inbox.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    Node* alloc_node(T&& data) {
+        if (!m_free_local) {
+            m_free_local = m_free_shared.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (!m_free_local) {
+            return new Node{std::move(data), nullptr};
+        }
+        Node* node = m_free_local;
+        m_free_local = node->next;
+        node->value = std::move(data);
+        node->next = nullptr;
+        return node;
+    }
+
+    void recycle_local(Node* node) {
+        node->next = m_free_local;
+        m_free_local = node;
+    }
+
+    // 偷取线程归还节点，多生产者入栈，所属线程一次性全部取走，不存在 ABA 问题
+    void recycle_shared(Node* node) {
+        Node* head = m_free_shared.load(std::memory_order_relaxed);
+        do {
+            node->next = head;
+        } while (!m_free_shared.compare_exchange_weak(head, node, std::memory_order_release,
+                                                      std::memory_order_relaxed));
+    }
+
+    static void release_free_nodes(Node* node) {
+        while (node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> m_top;          // 偷取端
+    alignas(64) std::atomic<int64_t> m_bottom;       // 本地端
+    alignas(64) std::atomic<Buffer*> m_buffer;       // 当前环形缓冲区
+    std::vector<std::unique_ptr<Buffer>> m_buffers;  // 所有分配过的缓冲区，仅所属线程修改
+
+    Node* m_free_local = nullptr;      // 所属线程的空闲节点
+    std::atomic<Node*> m_free_shared;  // 偷取线程归还的空闲节点
+
+    mutable std::mutex m_mutex;        // 保护外部队列
+    std::deque<T> m_inbox;             // 外部线程插入的数据
+    std::atomic<size_t> m_inbox_size;  // 外部队列大小，用于无锁判断
+    std::condition_variable m_cond;    // 等待外部队列数据
+};
+
+} /* namespace hku */
+
+#endif /* HIKYUU_UTILITIES_THREAD_LOCKFREESTEALQUEUE_H */
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <queue>
 #include <thread>
 #include <condition_variable>
@@ -23,6 +24,18 @@ public:
     void push(T&& item) {
         std::lock_guard<std::mutex> lk(m_mutex);
         m_queue.push_back(std::move(item));
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
+        m_cond.notify_one();
+    }
+
+    /** 将 [first, last) 中的元素批量移入队列尾部，只加锁一次 */
+    template <typename Iterator>
+    void push_bulk(Iterator first, Iterator last) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        for (; first != last; ++first) {
+            m_queue.push_back(std::move(*first));
+        }
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         m_cond.notify_one();
     }
 
@@ -30,6 +43,7 @@ public:
     void push_front(T&& data) {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_queue.push_front(std::move(data));
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         m_cond.notify_one();
     }
 
@@ -38,6 +52,7 @@ public:
         m_cond.wait(lk, [this] { return !m_queue.empty(); });
         value = std::move(m_queue.front());
         m_queue.pop_front();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
     }
 
     std::shared_ptr<T> wait_and_pop() {
@@ -45,6 +60,7 @@ public:
         m_cond.wait(lk, [this] { return !m_queue.empty(); });
         std::shared_ptr<T> res(std::make_shared<T>(std::move(m_queue.front())));
         m_queue.pop_front();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         return res;
     }
 
@@ -55,6 +71,7 @@ public:
         }
         value = std::move(m_queue.front());
         m_queue.pop_front();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         return true;
     }
 
@@ -65,6 +82,7 @@ public:
         }
         std::shared_ptr<T> res(std::make_shared<T>(std::move(m_queue.front())));
         m_queue.pop();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         return res;
     }
 
@@ -84,6 +102,7 @@ public:
         }
         res = std::move(m_queue.back());
         m_queue.pop_back();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         return true;
     }
 
@@ -94,19 +113,21 @@ public:
 
     // 队列大小，无锁
     size_t size() const {
-        return m_queue.size();
+        return m_size.load(std::memory_order_relaxed);
     }
 
     void clear() {
         std::lock_guard<std::mutex> lock(m_mutex);
         auto tmp = std::deque<T>();
         m_queue.swap(tmp);
+        m_size.store(0, std::memory_order_relaxed);
     }
 
 private:
     mutable std::mutex m_mutex;
     std::deque<T> m_queue;
     std::condition_variable m_cond;
+    std::atomic<size_t> m_size{0};  // 队列大小，用于无锁读取
 };
 
 } /* namespace hku */
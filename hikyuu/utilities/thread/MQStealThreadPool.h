@@ -14,8 +14,13 @@
 #include <chrono>
 #include <vector>
 #include "FuncWrapper.h"
+#include "PackagedTask.h"
+#include "BulkFuture.h"
 #include "MQStealQueue.h"
+#include "LockFreeStealQueue.h"
 #include "InterruptFlag.h"
+#include "ThreadPoolStats.h"
+#include "../config.h"
 #include "../cppdef.h"
 
 #ifdef __GNUC__
@@ -51,10 +56,11 @@ public:
     explicit MQStealThreadPool(size_t n, bool until_empty = true)
     : m_done(false), m_worker_num(n), m_runnging_until_empty(until_empty) {
         try {
+            m_stats = ThreadPoolStatsCollector(m_worker_num);
             m_interrupt_flags.resize(m_worker_num);
             for (size_t i = 0; i < m_worker_num; i++) {
                 // 创建工作线程及其任务队列
-                m_queues.emplace_back(new MQStealQueue<task_type>);
+                m_queues.emplace_back(new queue_type);
             }
             // 初始完毕所有线程资源后再启动线程
             for (int i = 0; i < m_worker_num; i++) {
@@ -95,6 +101,14 @@ public:
         return total;
     }
 
+    /**
+     * 运行统计快照，可在任意线程中调用
+     * @note 编译时开启 HKU_ENABLE_THREAD_POOL_STATS 才收集各工作线程的统计，否则仅包含剩余任务数
+     */
+    ThreadPoolStats stats() const {
+        return m_stats.snapshot(remain_task_count());
+    }
+
     /** 先线程池提交任务后返回的对应 future 的类型 */
     template <typename ResultType>
     using task_handle = std::future<ResultType>;
@@ -111,28 +125,64 @@ public:
             throw std::logic_error("You can't submit a task to the stopped MQStealThreadPool!");
         }
 
-        int index = -1;
-        auto iter = m_thread_index.find(std::this_thread::get_id());
-        if (iter != m_thread_index.end()) {
-            index = iter->second;
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+        task_type task;
+        task_handle<result_type> res(package_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
+
+    /**
+     * 向线程池提交任务，返回可在协程中直接等待的 AwaitableFuture
+     * @details 任务完成时直接唤醒等待的协程，配合 await_future 使用时无需轮询
+     */
+    template <typename FunctionType>
+    auto submit_awaitable(FunctionType&& f) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped MQStealThreadPool!");
         }
 
         typedef typename std::invoke_result<FunctionType>::type result_type;
-        std::packaged_task<result_type()> task(std::forward<FunctionType>(f));
-        task_handle<result_type> res(task.get_future());
+        task_type task;
+        AwaitableFuture<result_type> res(
+          package_awaitable_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
 
-        // 如果是本地线程且线程仍未终止，则加入自身队列
-        if (index != -1 && m_interrupt_flags[index]) {
-            // 本地线程任务从前部入队列（递归成栈）
-            m_queues[index]->push_front(std::move(task));
-            return res;
+    /**
+     * 批量提交任务，只加锁一次并仅唤醒所需数量的工作线程
+     * @param first 起始迭代器，元素为无参数的可调用对象
+     * @param last 结束迭代器
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename Iterator>
+    BulkFuture submit_bulk(Iterator first, Iterator last) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped MQStealThreadPool!");
         }
 
-        m_queues[m_current_index]->push(std::move(task));
-        m_current_index++;
-        if (m_current_index >= m_worker_num) {
-            m_current_index = 0;
+        std::vector<task_type> tasks;
+        BulkFuture res(package_bulk_tasks(first, last, tasks));
+        push_task_bulk(tasks);
+        return res;
+    }
+
+    /**
+     * 批量提交 f(0), f(1), ..., f(n-1) 共 n 个任务
+     * @param n 任务数
+     * @param f 以 size_t 为参数的可调用对象，所有任务共享同一函数对象
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename FunctionType>
+    BulkFuture submit_n(size_t n, FunctionType&& f) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped MQStealThreadPool!");
         }
+
+        std::vector<task_type> tasks;
+        BulkFuture res(package_n_tasks(n, std::forward<FunctionType>(f), tasks));
+        push_task_bulk(tasks);
         return res;
     }
 
@@ -240,17 +290,75 @@ public:
 
 private:
     typedef FuncWrapper task_type;
-    std::atomic_bool m_done;      // 线程池全局需终止指示
-    size_t m_worker_num;          // 工作线程数量
-    bool m_runnging_until_empty;  // 运行直到队列空时停止
+#if HKU_USE_LOCKFREE_STEAL_QUEUE
+    typedef LockFreeStealQueue<task_type> queue_type;
+#else
+    typedef MQStealQueue<task_type> queue_type;
+#endif
+    std::atomic_bool m_done;           // 线程池全局需终止指示
+    size_t m_worker_num;               // 工作线程数量
+    bool m_runnging_until_empty;       // 运行直到队列空时停止
+    ThreadPoolStatsCollector m_stats;  // 运行统计
 
-    std::vector<std::unique_ptr<MQStealQueue<task_type>>> m_queues;  // 线程任务队列
-    std::vector<InterruptFlag> m_interrupt_flags;                    // 线程终止标志
-    std::vector<std::thread> m_threads;                              // 工作线程
+    std::vector<std::unique_ptr<queue_type>> m_queues;  // 线程任务队列
+    std::vector<InterruptFlag> m_interrupt_flags;       // 线程终止标志
+    std::vector<std::thread> m_threads;                 // 工作线程
 
     std::unordered_map<std::thread::id, int> m_thread_index;
     int m_current_index = 0;  // 当前放置新任务时的队列索引
 
+    void push_task(task_type&& task) {
+        int index = -1;
+        auto iter = m_thread_index.find(std::this_thread::get_id());
+        if (iter != m_thread_index.end()) {
+            index = iter->second;
+        }
+
+        // 如果是本地线程且线程仍未终止，则加入自身队列
+        if (index != -1 && m_interrupt_flags[index]) {
+            // 本地线程任务从前部入队列（递归成栈）
+            m_queues[index]->push_front(std::move(task));
+            return;
+        }
+
+        m_queues[m_current_index]->push(std::move(task));
+        m_current_index++;
+        if (m_current_index >= m_worker_num) {
+            m_current_index = 0;
+        }
+    }
+
+    void push_task_bulk(std::vector<task_type>& tasks) {
+        if (tasks.empty()) {
+            return;
+        }
+
+        int index = -1;
+        auto iter = m_thread_index.find(std::this_thread::get_id());
+        if (iter != m_thread_index.end()) {
+            index = iter->second;
+        }
+
+        if (index != -1 && m_interrupt_flags[index]) {
+            for (auto& task : tasks) {
+                m_queues[index]->push_front(std::move(task));
+            }
+            return;
+        }
+
+        // 将任务平均分段，每段只对相应工作线程队列加锁一次
+        size_t total = tasks.size();
+        size_t count = m_worker_num;
+        size_t per_num = total / count;
+        size_t extra = total % count;
+        auto first = tasks.begin();
+        for (size_t i = 0; i < count && first != tasks.end(); i++) {
+            size_t len = per_num + (i < extra ? 1 : 0);
+            m_queues[i]->push_bulk(first, first + len);
+            first += len;
+        }
+    }
+
     void worker_thread(int index) {
         while (!m_interrupt_flags[index].isSet() && !m_done) {
             run_pending_task(index);
@@ -264,19 +372,22 @@ private:
             if (task.isNullTask()) {
                 m_interrupt_flags[index].set();
             } else {
-                task();
+                m_stats.run_task(index, task);
             }
         } else if (pop_task_from_other_thread_queue(task, index)) {
-            task();
+            m_stats.run_task(index, task);
         } else {
             // 阻塞并等待本地队列中有新的任务
             // 注：如果是递归情况，任务被优先加入本地队列且彼此依赖，如果任务被其他线程偷取到的话，将导致其他线程被阻塞并等待
             // 所以，此处等待本地队列而不是继续循环偷取
-            m_queues[index]->wait_and_pop(task);
+            {
+                auto blocked = m_stats.blocked(index);
+                m_queues[index]->wait_and_pop(task);
+            }
             if (task.isNullTask()) {
                 m_interrupt_flags[index].set();
             } else {
-                task();
+                m_stats.run_task(index, task);
             }
         }
     }
@@ -285,6 +396,7 @@ private:
         for (size_t i = 0; i < m_worker_num; ++i) {
             size_t pos = (index + i + 1) % m_worker_num;
             if (pos != index && m_queues[pos]->try_steal(task)) {
+                m_stats.task_stolen(index, pos);
                 return true;
             }
         }
@@ -0,0 +1,296 @@
+/*
+ * PackagedTask.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_THREAD_PACKAGEDTASK_H
+#define HIKYUU_UTILITIES_THREAD_PACKAGEDTASK_H
+
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include "FuncWrapper.h"
+#include "AwaitableFuture.h"
+
+namespace hku {
+
+/**
+ * 任务共享状态内存池
+ * @details
+ * 按 64/128/256/512 字节分级缓存已释放的内存块，每个线程独立缓存，分配释放均无需加锁。
+ * 线程池中任务状态通常在提交线程分配、在工作线程释放，因此线程缓存超出上限时，
+ * 将其中一半成批转移至全局缓存，其他线程本地缓存为空时再从全局缓存整批取回。
+ */
+class TaskStatePool {
+public:
+    /** 每个级别每个线程最多缓存的内存块数量 */
+    static constexpr size_t max_cached_blocks = 1024;
+
+    /** 全局缓存中每个级别最多保存的批次数 */
+    static constexpr size_t max_central_batches = 64;
+
+    /** 分配内存 */
+    static void* allocate(size_t n) {
+        int level = get_level(n);
+        Cache* cache = level >= 0 ? local_cache() : nullptr;
+        if (cache) {
+            if (!cache->heads[level]) {
+                fetch_batch(cache, level);
+            }
+            if (cache->heads[level]) {
+                FreeBlock* block = cache->heads[level];
+                cache->heads[level] = block->next;
+                cache->counts[level]--;
+                return block;
+            }
+        }
+        return ::operator new(level >= 0 ? block_size(level) : n);
+    }
+
+    /** 释放内存，n 必须和分配时相同 */
+    static void deallocate(void* p, size_t n) noexcept {
+        int level = get_level(n);
+        Cache* cache = level >= 0 ? local_cache() : nullptr;
+        if (cache) {
+            if (cache->counts[level] >= max_cached_blocks) {
+                release_batch(cache, level);
+            }
+            FreeBlock* block = static_cast<FreeBlock*>(p);
+            block->next = cache->heads[level];
+            cache->heads[level] = block;
+            cache->counts[level]++;
+            return;
+        }
+        ::operator delete(p);
+    }
+
+private:
+    static constexpr int level_count = 4;
+
+    struct FreeBlock {
+        FreeBlock* next;
+        FreeBlock* next_batch;  // 仅在全局缓存中使用，链接各批次的首个内存块
+    };
+
+    static void free_list(FreeBlock* head) noexcept {
+        while (head) {
+            FreeBlock* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+
+    struct Cache {
+        explicit Cache(bool* destroyed) : destroyed(destroyed) {}
+        ~Cache() {
+            *destroyed = true;
+            for (int i = 0; i < level_count; i++) {
+                free_list(heads[i]);
+            }
+        }
+
+        FreeBlock* heads[level_count] = {nullptr, nullptr, nullptr, nullptr};
+        size_t counts[level_count] = {0, 0, 0, 0};
+        bool* destroyed;
+    };
+
+    struct Central {
+        explicit Central(bool* destroyed) : destroyed(destroyed) {}
+        ~Central() {
+            *destroyed = true;
+            for (int i = 0; i < level_count; i++) {
+                while (batches[i]) {
+                    FreeBlock* next = batches[i]->next_batch;
+                    free_list(batches[i]);
+                    batches[i] = next;
+                }
+            }
+        }
+
+        std::mutex mutex;
+        FreeBlock* batches[level_count] = {nullptr, nullptr, nullptr, nullptr};
+        size_t counts[level_count] = {0, 0, 0, 0};
+        bool* destroyed;
+    };
+
+    static constexpr size_t block_size(int level) {
+        return size_t(64) << level;
+    }
+
+    static int get_level(size_t n) {
+        for (int i = 0; i < level_count; i++) {
+            if (n <= block_size(i)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // 线程退出时缓存可能已先于其他 thread_local 对象析构，此时直接使用系统内存
+    static Cache* local_cache() {
+        static thread_local bool destroyed = false;
+        if (destroyed) {
+            return nullptr;
+        }
+        static thread_local Cache cache(&destroyed);
+        return &cache;
+    }
+
+    static Central* central() {
+        static bool destroyed = false;
+        if (destroyed) {
+            return nullptr;
+        }
+        static Central central(&destroyed);
+        return &central;
+    }
+
+    static void fetch_batch(Cache* cache, int level) {
+        Central* c = central();
+        if (!c) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(c->mutex);
+        FreeBlock* batch = c->batches[level];
+        if (batch) {
+            c->batches[level] = batch->next_batch;
+            c->counts[level]--;
+            cache->heads[level] = batch;
+            cache->counts[level] = max_cached_blocks / 2;
+        }
+    }
+
+    static void release_batch(Cache* cache, int level) noexcept {
+        FreeBlock* batch = cache->heads[level];
+        FreeBlock* tail = batch;
+        for (size_t i = 1; i < max_cached_blocks / 2; i++) {
+            tail = tail->next;
+        }
+        cache->heads[level] = tail->next;
+        cache->counts[level] -= max_cached_blocks / 2;
+        tail->next = nullptr;
+
+        Central* c = central();
+        if (c) {
+            std::lock_guard<std::mutex> lock(c->mutex);
+            if (c->counts[level] < max_central_batches) {
+                batch->next_batch = c->batches[level];
+                c->batches[level] = batch;
+                c->counts[level]++;
+                return;
+            }
+        }
+        free_list(batch);
+    }
+};
+
+/**
+ * 使用 TaskStatePool 的分配器，用于 std::promise 的共享状态
+ */
+template <typename T>
+class TaskStateAllocator {
+public:
+    typedef T value_type;
+
+    TaskStateAllocator() noexcept = default;
+
+    template <typename U>
+    TaskStateAllocator(const TaskStateAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (alignof(T) > alignof(std::max_align_t)) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+        return static_cast<T*>(TaskStatePool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (alignof(T) > alignof(std::max_align_t)) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+            return;
+        }
+        TaskStatePool::deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const TaskStateAllocator<U>&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const TaskStateAllocator<U>&) const noexcept {
+        return false;
+    }
+};
+
+/**
+ * 将函数包装为线程池任务，用于替代 std::packaged_task
+ * @details
+ * 返回的 std::future 共享状态由 TaskStateAllocator 分配，预热后不再分配堆内存；
+ * 包装后的函数对象不超过 FuncWrapper::inline_size 时，任务本身也不分配堆内存。
+ * @param f 待执行的函数
+ * @param task [out] 包装后的任务
+ * @return 任务对应的 future
+ */
+template <typename FunctionType>
+auto package_task(FunctionType&& f, FuncWrapper& task) {
+    typedef typename std::invoke_result<FunctionType>::type result_type;
+    std::promise<result_type> promise(std::allocator_arg, TaskStateAllocator<result_type>());
+    std::future<result_type> res = promise.get_future();
+    task = FuncWrapper([p = std::move(promise),
+                        func = typename std::decay<FunctionType>::type(
+                          std::forward<FunctionType>(f))]() mutable {
+        try {
+            if constexpr (std::is_void<result_type>::value) {
+                func();
+                p.set_value();
+            } else {
+                p.set_value(func());
+            }
+        } catch (...) {
+            p.set_exception(std::current_exception());
+        }
+    });
+    return res;
+}
+
+/**
+ * 将函数包装为线程池任务，返回可在协程中直接等待的 AwaitableFuture
+ * @details 共享状态同样由 TaskStateAllocator 分配
+ * @param f 待执行的函数
+ * @param task [out] 包装后的任务
+ * @return 任务对应的 AwaitableFuture
+ */
+template <typename FunctionType>
+auto package_awaitable_task(FunctionType&& f, FuncWrapper& task) {
+    typedef typename std::invoke_result<FunctionType>::type result_type;
+    AwaitablePromise<result_type> promise(std::allocator_arg,
+                                          TaskStateAllocator<AwaitableState<result_type>>());
+    AwaitableFuture<result_type> res = promise.get_future();
+    task = FuncWrapper([p = std::move(promise),
+                        func = typename std::decay<FunctionType>::type(
+                          std::forward<FunctionType>(f))]() mutable {
+        try {
+            if constexpr (std::is_void<result_type>::value) {
+                func();
+                p.set_value();
+            } else {
+                p.set_value(func());
+            }
+        } catch (...) {
+            p.set_exception(std::current_exception());
+        }
+    });
+    return res;
+}
+
+} /* namespace hku */
+
+#endif /* HIKYUU_UTILITIES_THREAD_PACKAGEDTASK_H */
@@ -0,0 +1,216 @@
+/*
+ * Partitioner.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_THREAD_PARTITIONER_H
+#define HIKYUU_UTILITIES_THREAD_PARTITIONER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace hku {
+
+/**
+ * 并行循环的任务划分策略
+ * @details
+ * <pre>
+ * STATIC  - 按工作线程数均分为等长的连续区间，余数分摊至前面的区间
+ * GUIDED  - 每次取剩余数量 / (2 * 工作线程数)，区间逐渐减小，但不小于 grain_size
+ * DYNAMIC - 工作线程通过原子计数器每次领取 grain_size 个索引，适合各索引耗时差异大的情况
+ * AUTO    - 同 DYNAMIC，但根据已执行区间测得的单次迭代耗时自动调整区间大小，
+ *           使每个区间耗时接近 target_time
+ * </pre>
+ */
+class Partitioner {
+public:
+    enum PartitionType { STATIC, GUIDED, DYNAMIC, AUTO };
+
+    /**
+     * 构造函数
+     * @param type 划分策略
+     * @param grain_size 区间最小长度（GUIDED）或固定长度（DYNAMIC），为 0 时视为 1
+     * @param target_time AUTO 模式下每个区间的期望耗时
+     */
+    explicit Partitioner(PartitionType type = AUTO, size_t grain_size = 1,
+                         std::chrono::nanoseconds target_time = std::chrono::microseconds(100))
+    : m_type(type), m_grain_size(grain_size == 0 ? 1 : grain_size), m_target_time(target_time) {}
+
+    PartitionType type() const noexcept {
+        return m_type;
+    }
+
+    size_t grain_size() const noexcept {
+        return m_grain_size;
+    }
+
+    std::chrono::nanoseconds target_time() const noexcept {
+        return m_target_time;
+    }
+
+private:
+    PartitionType m_type;
+    size_t m_grain_size;
+    std::chrono::nanoseconds m_target_time;
+};
+
+/** 静态均分 */
+inline Partitioner static_partitioner() {
+    return Partitioner(Partitioner::STATIC);
+}
+
+/** 递减区间划分 */
+inline Partitioner guided_partitioner(size_t min_grain_size = 1) {
+    return Partitioner(Partitioner::GUIDED, min_grain_size);
+}
+
+/** 固定区间长度的动态领取 */
+inline Partitioner dynamic_partitioner(size_t grain_size = 1) {
+    return Partitioner(Partitioner::DYNAMIC, grain_size);
+}
+
+/** 根据实测迭代耗时自动调整区间长度 */
+inline Partitioner auto_partitioner(
+  std::chrono::nanoseconds target_time = std::chrono::microseconds(100)) {
+    return Partitioner(Partitioner::AUTO, 1, target_time);
+}
+
+/**
+ * 按划分策略从 [start, end) 中依次领取区间，可由多个工作线程同时调用
+ */
+class PartitionRange {
+public:
+    PartitionRange(const Partitioner& partitioner, size_t start, size_t end, size_t worker_num)
+    : m_type(partitioner.type()),
+      m_start(start),
+      m_end(end),
+      m_worker_num(worker_num == 0 ? 1 : worker_num),
+      m_grain(partitioner.grain_size()),
+      m_target_ns(partitioner.target_time().count()),
+      m_next(start) {
+        size_t total = end > start ? end - start : 0;
+        if (m_type == Partitioner::STATIC) {
+            // 均分为 worker_num 段，m_next 记录已领取的段数
+            m_next = 0;
+            m_grain = total / m_worker_num;
+            m_extra = total % m_worker_num;
+        }
+    }
+
+    /** 工作线程数 */
+    size_t worker_num() const noexcept {
+        return m_worker_num;
+    }
+
+    /** 是否需要通过 report 反馈区间耗时 */
+    bool need_timing() const noexcept {
+        return m_type == Partitioner::AUTO;
+    }
+
+    /**
+     * 领取下一区间
+     * @param range [out] 领取到的区间 [first, second)
+     * @return 已无剩余区间时返回 false
+     */
+    bool next(std::pair<size_t, size_t>& range) {
+        switch (m_type) {
+            case Partitioner::STATIC:
+                return next_static(range);
+            case Partitioner::GUIDED:
+                return next_guided(range);
+            case Partitioner::DYNAMIC:
+                return next_fixed(range, m_grain);
+            default:
+                return next_fixed(range, auto_grain());
+        }
+    }
+
+    /** AUTO 模式下反馈已执行区间的耗时，用于调整后续区间长度 */
+    void report(const std::pair<size_t, size_t>& range, std::chrono::nanoseconds elapsed) {
+        size_t count = range.second - range.first;
+        int64_t ns = elapsed.count();
+        if (count == 0 || ns <= 0) {
+            // 耗时过短无法测量，加倍区间长度
+            size_t grain = m_grain_auto.load(std::memory_order_relaxed);
+            m_grain_auto.store(std::min(grain * 2, m_end - m_start), std::memory_order_relaxed);
+            return;
+        }
+        double per_iter = double(ns) / double(count);
+        size_t grain = static_cast<size_t>(double(m_target_ns) / per_iter);
+        m_grain_auto.store(std::max<size_t>(grain, 1), std::memory_order_relaxed);
+    }
+
+private:
+    bool next_static(std::pair<size_t, size_t>& range) {
+        size_t k = m_next.fetch_add(1, std::memory_order_relaxed);
+        while (k < m_worker_num) {
+            size_t first = m_start + k * m_grain + std::min(k, m_extra);
+            size_t len = m_grain + (k < m_extra ? 1 : 0);
+            if (len > 0) {
+                range.first = first;
+                range.second = first + len;
+                return true;
+            }
+            k = m_next.fetch_add(1, std::memory_order_relaxed);
+        }
+        return false;
+    }
+
+    bool next_guided(std::pair<size_t, size_t>& range) {
+        size_t cur = m_next.load(std::memory_order_relaxed);
+        while (cur < m_end) {
+            size_t len = std::max((m_end - cur) / (2 * m_worker_num), m_grain);
+            size_t last = std::min(cur + len, m_end);
+            if (m_next.compare_exchange_weak(cur, last, std::memory_order_relaxed)) {
+                range.first = cur;
+                range.second = last;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool next_fixed(std::pair<size_t, size_t>& range, size_t grain) {
+        if (m_next.load(std::memory_order_relaxed) >= m_end) {
+            return false;
+        }
+        size_t first = m_next.fetch_add(grain, std::memory_order_relaxed);
+        if (first >= m_end) {
+            return false;
+        }
+        range.first = first;
+        range.second = std::min(first + grain, m_end);
+        return true;
+    }
+
+    // 按实测耗时得到的区间长度，但保证剩余任务仍可在各工作线程间分配
+    size_t auto_grain() const {
+        size_t cur = m_next.load(std::memory_order_relaxed);
+        size_t remain = cur < m_end ? m_end - cur : 0;
+        size_t limit = std::max<size_t>(remain / (2 * m_worker_num), 1);
+        return std::min(m_grain_auto.load(std::memory_order_relaxed), limit);
+    }
+
+private:
+    Partitioner::PartitionType m_type;
+    size_t m_start;
+    size_t m_end;
+    size_t m_worker_num;
+    size_t m_grain;
+    size_t m_extra = 0;
+    int64_t m_target_ns;
+    std::atomic<size_t> m_grain_auto{1};
+    alignas(64) std::atomic<size_t> m_next;
+};
+
+}  // namespace hku
+
+#endif /* HIKYUU_UTILITIES_THREAD_PARTITIONER_H */
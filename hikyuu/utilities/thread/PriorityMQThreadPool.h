@@ -0,0 +1,425 @@
+/*
+ * PriorityMQThreadPool.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+
+#include <future>
+#include <thread>
+#include <chrono>
+#include <limits>
+#include <vector>
+#include "InterruptFlag.h"
+#include "FuncWrapper.h"
+#include "PackagedTask.h"
+#include "BulkFuture.h"
+#include "PriorityTaskQueue.h"
+#include "ThreadPoolStats.h"
+#include "../cppdef.h"
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef HKU_UTILS_API
+#define HKU_UTILS_API
+#endif
+
+namespace hku {
+
+/**
+ * @brief 支持任务优先级的多任务队列线程池，任务之间彼此独立不能互相等待
+ * @details
+ * 每个工作线程一个多优先级任务队列，优先级 0 最高。新任务加入任务数最少的队列，
+ * 工作线程优先执行本地队列中有效优先级最高的任务，本地队列为空时从其他队列偷取。
+ * 低优先级任务每等待 aging 时长提升一级优先级，避免在高优先级任务持续到达时被饿死。
+ * 适用于紧急任务与大量批量任务共用同一线程池的场景。
+ * @ingroup ThreadPool
+ */
+#ifdef _MSC_VER
+class PriorityMQThreadPool {
+#else
+class HKU_UTILS_API PriorityMQThreadPool {
+#endif
+public:
+    /**
+     * 默认构造函数，创建和当前系统CPU数一致的线程数
+     */
+    PriorityMQThreadPool() : PriorityMQThreadPool(std::thread::hardware_concurrency()) {}
+
+    /**
+     * 构造函数，创建指定数量的线程
+     * @param n 指定的线程数
+     * @param levels 优先级数量，优先级取值为 [0, levels)，0 为最高优先级
+     * @param aging 低优先级任务每等待该时长提升一级优先级，为 0 时表示严格按优先级执行
+     * @param until_empty 任务队列为空时，自动停止运行
+     */
+    explicit PriorityMQThreadPool(size_t n, size_t levels = 3,
+                                  std::chrono::milliseconds aging = std::chrono::milliseconds(100),
+                                  bool until_empty = true)
+    : m_done(false),
+      m_worker_num(n),
+      m_levels(levels > 0 ? levels : 1),
+      m_runnging_until_empty(until_empty) {
+        try {
+            m_stats = ThreadPoolStatsCollector(m_worker_num);
+            m_thread_need_stop.resize(m_worker_num);
+            for (size_t i = 0; i < m_worker_num; i++) {
+                // 创建工作线程及其任务队列
+                m_queues.emplace_back(new PriorityTaskQueue(m_levels, aging));
+            }
+            // 初始完毕所有线程资源后再启动线程
+            for (int i = 0; i < m_worker_num; i++) {
+                m_threads.emplace_back(&PriorityMQThreadPool::worker_thread, this, i);
+            }
+        } catch (...) {
+            m_done = true;
+            throw;
+        }
+    }
+
+    /**
+     * 析构函数，等待并阻塞至线程池内所有任务完成
+     */
+    ~PriorityMQThreadPool() {
+        if (!m_done) {
+            join();
+        }
+        m_threads.clear();
+    }
+
+    /** 获取工作线程数 */
+    size_t worker_num() const {
+        return m_worker_num;
+    }
+
+    /** 优先级数量 */
+    size_t priority_levels() const {
+        return m_levels;
+    }
+
+    /** 未指定优先级提交任务时使用的优先级，为中间一级 */
+    size_t default_priority() const {
+        return m_levels / 2;
+    }
+
+    /** 剩余任务数 */
+    size_t remain_task_count() const {
+        size_t total = 0;
+        for (size_t i = 0; i < m_worker_num; i++) {
+            total += m_queues[i]->size();
+        }
+        return total;
+    }
+
+    /**
+     * 运行统计快照，可在任意线程中调用
+     * @note 编译时开启 HKU_ENABLE_THREAD_POOL_STATS 才收集各工作线程的统计，否则仅包含剩余任务数
+     */
+    ThreadPoolStats stats() const {
+        return m_stats.snapshot(remain_task_count());
+    }
+
+    /** 先线程池提交任务后返回的对应 future 的类型 */
+    template <typename ResultType>
+    using task_handle = std::future<ResultType>;
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+
+    /** 以默认优先级向线程池提交任务 */
+    template <typename FunctionType>
+    auto submit(FunctionType &&f) {
+        return submit(default_priority(), std::forward<FunctionType>(f));
+    }
+
+    /**
+     * 按指定优先级向线程池提交任务
+     * @param priority 优先级，0 为最高，超出范围时视为最低优先级
+     * @param f 任务
+     */
+    template <typename FunctionType>
+    auto submit(size_t priority, FunctionType &&f) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped PriorityMQThreadPool!");
+        }
+
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+        task_type task;
+        task_handle<result_type> res(package_task(std::forward<FunctionType>(f), task));
+        push_task(priority, std::move(task));
+        return res;
+    }
+
+    /**
+     * 向线程池提交任务，返回可在协程中直接等待的 AwaitableFuture
+     * @param priority 优先级，0 为最高
+     * @param f 任务
+     */
+    template <typename FunctionType>
+    auto submit_awaitable(size_t priority, FunctionType &&f) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped PriorityMQThreadPool!");
+        }
+
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+        task_type task;
+        AwaitableFuture<result_type> res(
+          package_awaitable_task(std::forward<FunctionType>(f), task));
+        push_task(priority, std::move(task));
+        return res;
+    }
+
+    /** 以默认优先级提交任务，返回可在协程中直接等待的 AwaitableFuture */
+    template <typename FunctionType>
+    auto submit_awaitable(FunctionType &&f) {
+        return submit_awaitable(default_priority(), std::forward<FunctionType>(f));
+    }
+
+    /**
+     * 按同一优先级批量提交任务
+     * @param priority 优先级，0 为最高
+     * @param first 起始迭代器，元素为无参数的可调用对象
+     * @param last 结束迭代器
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename Iterator>
+    BulkFuture submit_bulk(size_t priority, Iterator first, Iterator last) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped PriorityMQThreadPool!");
+        }
+
+        std::vector<task_type> tasks;
+        BulkFuture res(package_bulk_tasks(first, last, tasks));
+        push_task_bulk(priority, tasks);
+        return res;
+    }
+
+    /** 以默认优先级批量提交任务 */
+    template <typename Iterator>
+    BulkFuture submit_bulk(Iterator first, Iterator last) {
+        return submit_bulk(default_priority(), first, last);
+    }
+
+    /**
+     * 按同一优先级批量提交 f(0), f(1), ..., f(n-1) 共 n 个任务
+     * @param priority 优先级，0 为最高
+     * @param n 任务数
+     * @param f 以 size_t 为参数的可调用对象，所有任务共享同一函数对象
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename FunctionType>
+    BulkFuture submit_n(size_t priority, size_t n, FunctionType &&f) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped PriorityMQThreadPool!");
+        }
+
+        std::vector<task_type> tasks;
+        BulkFuture res(package_n_tasks(n, std::forward<FunctionType>(f), tasks));
+        push_task_bulk(priority, tasks);
+        return res;
+    }
+
+    /** 以默认优先级批量提交 n 个任务 */
+    template <typename FunctionType>
+    BulkFuture submit_n(size_t n, FunctionType &&f) {
+        return submit_n(default_priority(), n, std::forward<FunctionType>(f));
+    }
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+    /** 返回线程池结束状态 */
+    bool done() const {
+        return m_done;
+    }
+
+    /**
+     * 等待各线程完成当前执行的任务后立即结束退出
+     */
+    void stop() {
+        if (m_done.exchange(true, std::memory_order_relaxed)) {
+            return;
+        }
+
+        for (size_t i = 0; i < m_worker_num; i++) {
+            m_thread_need_stop[i].set();
+            m_queues[i]->push(0, FuncWrapper());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex_join);
+            for (size_t i = 0; i < m_worker_num; i++) {
+                if (m_threads[i].joinable()) {
+                    m_threads[i].join();
+                }
+            }
+        }
+
+        for (size_t i = 0; i < m_worker_num; i++) {
+            m_queues[i]->clear();
+        }
+    }
+
+    /**
+     * 等待并阻塞至线程池内所有任务完成
+     * @note 至此线程池能工作线程结束不可再使用
+     */
+    void join() {
+        if (m_done) {
+            return;
+        }
+
+        // 指示各工作线程在未获取到工作任务时，停止运行
+        if (!m_runnging_until_empty) {
+            m_done = true;
+            for (size_t i = 0; i < m_worker_num; i++) {
+                m_thread_need_stop[i].set();
+            }
+        }
+
+        // 空任务仅在队列中没有其他任务时才会被取出
+        for (size_t i = 0; i < m_worker_num; i++) {
+            m_queues[i]->push(0, FuncWrapper());
+            m_queues[i]->notify_all();
+        }
+
+        {  // 等待线程结束
+            std::lock_guard<std::mutex> lock(m_mutex_join);
+            for (size_t i = 0; i < m_worker_num; i++) {
+                if (m_threads[i].joinable()) {
+                    m_threads[i].join();
+                }
+            }
+        }
+
+        m_done = true;
+    }
+
+    struct ExecutorWrapper {
+        PriorityMQThreadPool *pool;
+        size_t priority;
+        template <typename Function>
+        void execute(Function f) {
+            pool->submit(priority, std::move(f));
+        }
+    };
+
+    /** 协程执行器，以默认优先级提交任务 */
+    ExecutorWrapper executor() {
+        return ExecutorWrapper{this, default_priority()};
+    }
+
+    /** 以指定优先级提交任务的协程执行器 */
+    ExecutorWrapper executor(size_t priority) {
+        return ExecutorWrapper{this, priority};
+    }
+
+private:
+    typedef FuncWrapper task_type;
+    std::atomic_bool m_done;           // 线程池全局需终止指示
+    size_t m_worker_num;               // 工作线程数量
+    size_t m_levels;                   // 优先级数量
+    bool m_runnging_until_empty;       // 运行直到队列空时停止
+    ThreadPoolStatsCollector m_stats;  // 运行统计
+
+    std::vector<std::unique_ptr<PriorityTaskQueue>> m_queues;  // 线程任务队列
+    std::vector<InterruptFlag> m_thread_need_stop;             // 线程终止标志
+    std::vector<std::thread> m_threads;                        // 工作线程
+    std::mutex m_mutex_join;                                   // 用于保护 joinable
+
+    size_t select_queue() const {
+        // 选择空队列或任务数最小的队列
+        size_t min_count = std::numeric_limits<size_t>::max();
+        size_t index = 0;
+        for (size_t i = 0; i < m_worker_num; ++i) {
+            if (!m_thread_need_stop[i].isSet()) {
+                size_t cur_count = m_queues[i]->size();
+                if (cur_count == 0) {
+                    return i;
+                }
+
+                if (cur_count < min_count) {
+                    min_count = cur_count;
+                    index = i;
+                }
+            }
+        }
+        return index;
+    }
+
+    void push_task(size_t priority, task_type &&task) {
+        m_queues[select_queue()]->push(priority, std::move(task));
+    }
+
+    void push_task_bulk(size_t priority, std::vector<task_type> &tasks) {
+        if (tasks.empty()) {
+            return;
+        }
+
+        std::vector<size_t> indexes;
+        for (size_t i = 0; i < m_worker_num; ++i) {
+            if (!m_thread_need_stop[i].isSet()) {
+                indexes.push_back(i);
+            }
+        }
+        if (indexes.empty()) {
+            indexes.push_back(0);
+        }
+
+        // 将任务平均分段，每段只对相应工作线程队列加锁一次
+        size_t total = tasks.size();
+        size_t count = indexes.size();
+        size_t per_num = total / count;
+        size_t extra = total % count;
+        auto first = tasks.begin();
+        for (size_t i = 0; i < count && first != tasks.end(); i++) {
+            size_t len = per_num + (i < extra ? 1 : 0);
+            m_queues[indexes[i]]->push_bulk(priority, first, first + len);
+            first += len;
+        }
+    }
+
+    void worker_thread(int index) {
+        auto *local_queue = m_queues[index].get();
+        auto *local_stop_flag = &m_thread_need_stop[index];
+        while (!local_stop_flag->isSet() || !m_done) {
+            task_type task;
+            if (!local_queue->try_pop(task) && !pop_task_from_other_thread_queue(task, index)) {
+                auto blocked = m_stats.blocked(index);
+                local_queue->wait_and_pop(task);
+            }
+            if (task.isNullTask()) {
+                local_stop_flag->set();
+                break;
+            }
+            m_stats.run_task(index, task);
+        }
+    }
+
+    bool pop_task_from_other_thread_queue(task_type &task, size_t index) {
+        for (size_t i = 1; i < m_worker_num; ++i) {
+            size_t pos = (index + i) % m_worker_num;
+            if (m_queues[pos]->try_steal(task)) {
+                m_stats.task_stolen(index, pos);
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} /* namespace hku */
+
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
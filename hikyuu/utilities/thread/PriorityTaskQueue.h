@@ -0,0 +1,173 @@
+/*
+ * PriorityTaskQueue.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_THREAD_PRIORITYTASKQUEUE_H
+#define HIKYUU_UTILITIES_THREAD_PRIORITYTASKQUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <condition_variable>
+#include "FuncWrapper.h"
+
+namespace hku {
+
+/**
+ * 多优先级任务队列，用于 PriorityMQThreadPool
+ * @details
+ * 每个优先级一个先进先出队列，0 为最高优先级。出队时取有效优先级最高的任务，
+ * 有效优先级 = 优先级 - 等待时间 / aging，即低优先级任务每等待 aging 时长提升一级，
+ * 以防止在高优先级任务持续到达时被饿死。有效优先级相同时，先入队的任务优先。
+ * 空任务（线程池停止指示）单独计数，仅在队列中没有其他任务时才被取出。
+ */
+class PriorityTaskQueue {
+public:
+    typedef FuncWrapper task_type;
+    typedef std::chrono::steady_clock clock_type;
+
+    /**
+     * 构造函数
+     * @param levels 优先级数量，至少为 1
+     * @param aging 低优先级任务每等待该时长提升一级，为 0 时表示不提升
+     */
+    PriorityTaskQueue(size_t levels, clock_type::duration aging)
+    : m_levels(levels > 0 ? levels : 1), m_aging(aging) {}
+
+    /** 优先级数量 */
+    size_t levels() const {
+        return m_levels.size();
+    }
+
+    /** 按指定优先级插入任务，超出范围的优先级视为最低优先级 */
+    void push(size_t priority, task_type&& task) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        push_locked(priority, std::move(task), clock_type::now());
+        m_cond.notify_one();
+    }
+
+    /** 将 [first, last) 中的任务按同一优先级批量插入，只加锁一次 */
+    template <typename Iterator>
+    void push_bulk(size_t priority, Iterator first, Iterator last) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        auto now = clock_type::now();
+        for (; first != last; ++first) {
+            push_locked(priority, std::move(*first), now);
+        }
+        m_cond.notify_one();
+    }
+
+    /** 等待直到取出一个任务 */
+    void wait_and_pop(task_type& task) {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        m_cond.wait(lk, [this] { return m_size.load(std::memory_order_relaxed) > 0; });
+        pop_locked(task, true);
+    }
+
+    /** 尝试取出一个任务，队列为空时返回 false */
+    bool try_pop(task_type& task) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_size.load(std::memory_order_relaxed) > 0 && pop_locked(task, true);
+    }
+
+    /** 尝试偷取一个非空任务，同样按有效优先级选取 */
+    bool try_steal(task_type& task) {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_size.load(std::memory_order_relaxed) > 0 && pop_locked(task, false);
+    }
+
+    /** 队列大小（含空任务），无需加锁 */
+    size_t size() const {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        for (auto& level : m_levels) {
+            std::deque<Entry> tmp;
+            level.swap(tmp);
+        }
+        m_null_count = 0;
+        m_size.store(0, std::memory_order_relaxed);
+    }
+
+    void notify_all() {
+        m_cond.notify_all();
+    }
+
+private:
+    struct Entry {
+        task_type task;
+        clock_type::time_point time;  // 入队时间
+    };
+
+    void push_locked(size_t priority, task_type&& task, clock_type::time_point now) {
+        if (task.isNullTask()) {
+            m_null_count++;
+        } else {
+            if (priority >= m_levels.size()) {
+                priority = m_levels.size() - 1;
+            }
+            m_levels[priority].push_back(Entry{std::move(task), now});
+        }
+        m_size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool pop_locked(task_type& task, bool allow_null) {
+        size_t best = m_levels.size();
+        size_t best_effective = 0;
+        auto now = clock_type::now();
+        for (size_t i = 0; i < m_levels.size(); i++) {
+            if (m_levels[i].empty()) {
+                continue;
+            }
+            const Entry& head = m_levels[i].front();
+            size_t effective = i;
+            if (i > 0 && m_aging.count() > 0) {
+                size_t promoted = static_cast<size_t>((now - head.time) / m_aging);
+                effective = promoted >= i ? 0 : i - promoted;
+            }
+            if (best == m_levels.size() || effective < best_effective ||
+                (effective == best_effective && head.time < m_levels[best].front().time)) {
+                best = i;
+                best_effective = effective;
+            }
+        }
+
+        if (best < m_levels.size()) {
+            task = std::move(m_levels[best].front().task);
+            m_levels[best].pop_front();
+        } else if (allow_null && m_null_count > 0) {
+            task = task_type();
+            m_null_count--;
+        } else {
+            return false;
+        }
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<std::deque<Entry>> m_levels;  // 各优先级任务队列
+    clock_type::duration m_aging;             // 优先级提升间隔
+    size_t m_null_count = 0;                  // 空任务数量
+    std::atomic<size_t> m_size{0};            // 队列大小，用于无锁读取
+    std::condition_variable m_cond;
+};
+
+}  // namespace hku
+
+#endif /* HIKYUU_UTILITIES_THREAD_PRIORITYTASKQUEUE_H */
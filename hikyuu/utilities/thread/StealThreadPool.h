@@ -15,8 +15,14 @@
 #include <thread>
 #include <vector>
 #include "ThreadSafeQueue.h"
+#include "PackagedTask.h"
+#include "BulkFuture.h"
 #include "WorkStealQueue.h"
+#include "LockFreeStealQueue.h"
 #include "InterruptFlag.h"
+#include "CpuAffinity.h"
+#include "ThreadPoolStats.h"
+#include "../config.h"
 #include "../cppdef.h"
 
 #ifdef __GNUC__
@@ -53,12 +59,23 @@ public:
      * @param until_empty 任务队列为空时，自动停止运行
      */
     explicit StealThreadPool(size_t n, bool until_empty = true)
+    : StealThreadPool(n, AffinityPolicy(), until_empty) {}
+
+    /**
+     * 构造函数，创建指定数量的线程，并按亲和性策略绑定工作线程
+     * @param n 指定的线程数
+     * @param affinity CPU 亲和性策略
+     * @param until_empty 任务队列为空时，自动停止运行
+     */
+    StealThreadPool(size_t n, const AffinityPolicy& affinity, bool until_empty = true)
     : m_done(false), m_worker_num(n), m_running_until_empty(until_empty) {
         try {
+            m_placement = WorkerPlacement(affinity, m_worker_num);
+            m_stats = ThreadPoolStatsCollector(m_worker_num);
             m_interrupt_flags.resize(m_worker_num);
             for (int i = 0; i < m_worker_num; i++) {
                 // 创建工作线程及其任务队列
-                m_queues.emplace_back(new WorkStealQueue);
+                m_queues.emplace_back(new queue_type);
             }
             // 初始完毕所有线程资源后再启动线程
             for (int i = 0; i < m_worker_num; i++) {
@@ -98,6 +115,14 @@ public:
         return total;
     }
 
+    /**
+     * 运行统计快照，可在任意线程中调用
+     * @note 编译时开启 HKU_ENABLE_THREAD_POOL_STATS 才收集各工作线程的统计，否则仅包含剩余任务数
+     */
+    ThreadPoolStats stats() const {
+        return m_stats.snapshot(remain_task_count());
+    }
+
     /** 先线程池提交任务后返回的对应 future 的类型 */
     template <typename ResultType>
     using task_handle = std::future<ResultType>;
@@ -114,22 +139,64 @@ public:
             throw std::logic_error("You can't submit a task to the stopped StealThreadPool!!");
         }
 
-        int index = -1;
-        auto iter = m_thread_index.find(std::this_thread::get_id());
-        if (iter != m_thread_index.end()) {
-            index = iter->second;
+        typedef typename std::invoke_result<FunctionType>::type result_type;
+        task_type task;
+        task_handle<result_type> res(package_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
+
+    /**
+     * 向线程池提交任务，返回可在协程中直接等待的 AwaitableFuture
+     * @details 任务完成时直接唤醒等待的协程，配合 await_future 使用时无需轮询
+     */
+    template <typename FunctionType>
+    auto submit_awaitable(FunctionType&& f) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped StealThreadPool!!");
         }
 
         typedef typename std::invoke_result<FunctionType>::type result_type;
-        std::packaged_task<result_type()> task(std::forward<FunctionType>(f));
-        task_handle<result_type> res(task.get_future());
-        if (index != -1 && !m_interrupt_flags[index]) {
-            // 本地线程任务从前部入队列（递归成栈）
-            m_queues[index]->push_front(std::move(task));
-        } else {
-            m_master_work_queue.push(std::move(task));
-            m_cv.notify_one();
+        task_type task;
+        AwaitableFuture<result_type> res(
+          package_awaitable_task(std::forward<FunctionType>(f), task));
+        push_task(std::move(task));
+        return res;
+    }
+
+    /**
+     * 批量提交任务，只加锁一次并仅唤醒所需数量的工作线程
+     * @param first 起始迭代器，元素为无参数的可调用对象
+     * @param last 结束迭代器
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename Iterator>
+    BulkFuture submit_bulk(Iterator first, Iterator last) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped StealThreadPool!!");
+        }
+
+        std::vector<task_type> tasks;
+        BulkFuture res(package_bulk_tasks(first, last, tasks));
+        push_task_bulk(tasks);
+        return res;
+    }
+
+    /**
+     * 批量提交 f(0), f(1), ..., f(n-1) 共 n 个任务
+     * @param n 任务数
+     * @param f 以 size_t 为参数的可调用对象，所有任务共享同一函数对象
+     * @return 全部任务完成后就绪的聚合句柄
+     */
+    template <typename FunctionType>
+    BulkFuture submit_n(size_t n, FunctionType&& f) {
+        if (m_done) {
+            throw std::logic_error("You can't submit a task to the stopped StealThreadPool!!");
         }
+
+        std::vector<task_type> tasks;
+        BulkFuture res(package_n_tasks(n, std::forward<FunctionType>(f), tasks));
+        push_task_bulk(tasks);
         return res;
     }
 
@@ -155,7 +222,13 @@ public:
         // 同时加入结束任务指示，以便在dll退出时也能够终止
         for (size_t i = 0; i < m_worker_num; i++) {
             m_interrupt_flags[i].set();
+#if HKU_USE_LOCKFREE_STEAL_QUEUE
+            // 无锁队列的 push_front 只能由所属工作线程调用，空任务经外部队列加入。
+            // 中断标志已设置，工作线程结束当前任务后即退出，队列中剩余的任务同样不会执行
+            m_queues[i]->push_back(FuncWrapper());
+#else
             m_queues[i]->push_front(FuncWrapper());
+#endif
         }
 
         m_cv.notify_all();  // 唤醒所有工作线程
@@ -243,19 +316,71 @@ public:
 
 private:
     typedef FuncWrapper task_type;
-    std::atomic_bool m_done;       // 线程池全局需终止指示
-    size_t m_worker_num;           // 工作线程数量
-    bool m_running_until_empty;    // 任务队列为空时，自动停止运行
-    std::condition_variable m_cv;  // 信号量，无任务时阻塞线程并等待
-    std::mutex m_cv_mutex;         // 配合信号量的互斥量
-
-    std::vector<InterruptFlag> m_interrupt_flags;           // 工作线程状态
-    ThreadSafeQueue<task_type> m_master_work_queue;         // 主线程任务队列
-    std::vector<std::unique_ptr<WorkStealQueue>> m_queues;  // 任务队列（每个工作线程一个）
-    std::vector<std::thread> m_threads;                     // 工作线程
+#if HKU_USE_LOCKFREE_STEAL_QUEUE
+    typedef LockFreeStealQueue<task_type> queue_type;
+#else
+    typedef WorkStealQueue queue_type;
+#endif
+    std::atomic_bool m_done;           // 线程池全局需终止指示
+    size_t m_worker_num;               // 工作线程数量
+    bool m_running_until_empty;        // 任务队列为空时，自动停止运行
+    WorkerPlacement m_placement;       // 工作线程 CPU 绑定及窃取顺序
+    ThreadPoolStatsCollector m_stats;  // 运行统计
+    std::condition_variable m_cv;      // 信号量，无任务时阻塞线程并等待
+    std::mutex m_cv_mutex;             // 配合信号量的互斥量
+
+    std::vector<InterruptFlag> m_interrupt_flags;       // 工作线程状态
+    ThreadSafeQueue<task_type> m_master_work_queue;     // 主线程任务队列
+    std::vector<std::unique_ptr<queue_type>> m_queues;  // 任务队列（每个工作线程一个）
+    std::vector<std::thread> m_threads;                 // 工作线程
     std::unordered_map<std::thread::id, int> m_thread_index;
 
+    void push_task(task_type&& task) {
+        int index = -1;
+        auto iter = m_thread_index.find(std::this_thread::get_id());
+        if (iter != m_thread_index.end()) {
+            index = iter->second;
+        }
+
+        if (index != -1 && !m_interrupt_flags[index]) {
+            // 本地线程任务从前部入队列（递归成栈）
+            m_queues[index]->push_front(std::move(task));
+        } else {
+            m_master_work_queue.push(std::move(task));
+            m_cv.notify_one();
+        }
+    }
+
+    void push_task_bulk(std::vector<task_type>& tasks) {
+        if (tasks.empty()) {
+            return;
+        }
+
+        int index = -1;
+        auto iter = m_thread_index.find(std::this_thread::get_id());
+        if (iter != m_thread_index.end()) {
+            index = iter->second;
+        }
+
+        if (index != -1 && !m_interrupt_flags[index]) {
+            for (auto& task : tasks) {
+                m_queues[index]->push_front(std::move(task));
+            }
+            return;
+        }
+
+        m_master_work_queue.push_bulk(tasks.begin(), tasks.end());
+        if (tasks.size() >= m_worker_num) {
+            m_cv.notify_all();
+        } else {
+            for (size_t i = 0; i < tasks.size(); i++) {
+                m_cv.notify_one();
+            }
+        }
+    }
+
     void worker_thread(int index) {
+        m_placement.bind(index);
         while (!m_done && !m_interrupt_flags[index]) {
             run_pending_task(index);
         }
@@ -267,19 +392,20 @@ private:
         task_type task;
         if (pop_task_from_local_queue(task, index)) {
             if (!task.isNullTask()) {
-                task();
+                m_stats.run_task(index, task);
             } else {
                 m_interrupt_flags[index].set();
             }
         } else if (pop_task_from_master_queue(task)) {
             if (!task.isNullTask()) {
-                task();
+                m_stats.run_task(index, task);
             } else {
                 m_interrupt_flags[index].set();
             }
         } else if (pop_task_from_other_thread_queue(task, index)) {
-            task();
+            m_stats.run_task(index, task);
         } else {
+            auto blocked = m_stats.blocked(index);
             std::unique_lock<std::mutex> lk(m_cv_mutex);
             m_cv.wait(lk, [this] { return this->m_done || !this->m_master_work_queue.empty(); });
         }
@@ -295,9 +421,10 @@ private:
     }
 
     bool pop_task_from_other_thread_queue(task_type& task, int index) {
-        for (int i = 0; i < m_worker_num; ++i) {
-            int pos = (index + i + 1) % m_worker_num;
-            if (pos != index && !m_interrupt_flags[pos] && m_queues[pos]->try_steal(task)) {
+        // 优先从同一 NUMA 节点上的工作线程窃取
+        for (int pos : m_placement.steal_order(index)) {
+            if (!m_interrupt_flags[pos] && m_queues[pos]->try_steal(task)) {
+                m_stats.task_stolen(index, pos);
                 return true;
             }
         }
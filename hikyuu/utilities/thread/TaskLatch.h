@@ -0,0 +1,162 @@
+/*
+ * TaskLatch.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_THREAD_TASKLATCH_H
+#define HIKYUU_UTILITIES_THREAD_TASKLATCH_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <utility>
+
+namespace hku {
+
+/**
+ * 子任务完成计数器
+ * @details
+ * 提交子任务前通过 add 增加计数，子任务完成时 count_down，计数归零时唤醒等待线程。
+ * 子任务中的异常通过 set_exception 记录，仅保留第一个异常。
+ * 与 BulkFuture 不同，TaskLatch 由调用方持有（通常位于栈上），不需要分配共享状态，
+ * 调用方须保证在计数归零前 TaskLatch 有效。
+ */
+class TaskLatch {
+public:
+    explicit TaskLatch(size_t count = 0) : m_count(count) {}
+
+    /** 等待执行最后一次 count_down 的线程释放锁后再销毁 */
+    ~TaskLatch() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+
+    TaskLatch(const TaskLatch&) = delete;
+    TaskLatch& operator=(const TaskLatch&) = delete;
+
+    /** 增加未完成的子任务数 */
+    void add(size_t n = 1) noexcept {
+        m_count.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /** 完成一个子任务，计数归零时唤醒等待线程 */
+    void count_down() noexcept {
+        size_t cur = m_count.load(std::memory_order_relaxed);
+        while (cur > 1) {
+            if (m_count.compare_exchange_weak(cur, cur - 1, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+
+        // 可能是最后一个子任务，在锁内归零，避免等待线程在唤醒前销毁 latch
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            m_cond.notify_all();
+        }
+    }
+
+    /** 是否全部子任务均已完成 */
+    bool ready() const noexcept {
+        return m_count.load(std::memory_order_acquire) == 0;
+    }
+
+    /** 未完成的子任务数 */
+    size_t count() const noexcept {
+        return m_count.load(std::memory_order_acquire);
+    }
+
+    /** 阻塞等待计数归零 */
+    void wait() const {
+        if (ready()) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this] { return ready(); });
+    }
+
+    /** 等待计数归零，直至超时，返回是否已归零 */
+    template <class Rep, class Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+        if (ready()) {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_cond.wait_for(lock, timeout, [this] { return ready(); });
+    }
+
+    /** 记录子任务异常，仅保留第一个异常 */
+    void set_exception(std::exception_ptr e) noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_exception) {
+            m_exception = e;
+        }
+    }
+
+    /** 如有子任务抛出异常，则重新抛出第一个异常 */
+    void rethrow_if_exception() {
+        std::exception_ptr e;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            e = m_exception;
+            m_exception = nullptr;
+        }
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    std::atomic<size_t> m_count;
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_cond;
+    std::exception_ptr m_exception;
+};
+
+/** @cond internal */
+/** 子任务持有的完成令牌，任务未执行即被销毁（如线程池已停止）时视为 broken_promise */
+class TaskLatchToken {
+public:
+    explicit TaskLatchToken(TaskLatch* latch) noexcept : m_latch(latch) {}
+    TaskLatchToken(TaskLatchToken&& rv) noexcept : m_latch(rv.m_latch) {
+        rv.m_latch = nullptr;
+    }
+    TaskLatchToken(const TaskLatchToken&) = delete;
+    TaskLatchToken& operator=(const TaskLatchToken&) = delete;
+    TaskLatchToken& operator=(TaskLatchToken&&) = delete;
+
+    ~TaskLatchToken() {
+        if (m_latch) {
+            m_latch->set_exception(
+              std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+            m_latch->count_down();
+        }
+    }
+
+    /** 执行子任务，捕获异常并完成计数 */
+    template <typename FunctionType, typename... Args>
+    void run(FunctionType& f, Args&&... args) noexcept {
+        try {
+            f(std::forward<Args>(args)...);
+        } catch (...) {
+            m_latch->set_exception(std::current_exception());
+        }
+        TaskLatch* latch = m_latch;
+        m_latch = nullptr;
+        latch->count_down();
+    }
+
+private:
+    TaskLatch* m_latch;
+};
+/** @endcond */
+
+}  // namespace hku
+
+#endif /* HIKYUU_UTILITIES_THREAD_TASKLATCH_H */
@@ -0,0 +1,336 @@
+/*
+ * ThreadPoolStats.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_THREAD_THREADPOOLSTATS_H
+#define HIKYUU_UTILITIES_THREAD_THREADPOOLSTATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "FuncWrapper.h"
+#include "../config.h"
+
+namespace hku {
+
+/**
+ * 耗时直方图，按纳秒数的 2 的幂次分桶
+ * @details 第 0 个桶统计 0 纳秒，第 i 个桶统计 [2^(i-1), 2^i) 纳秒，最后一个桶包含所有更大的值
+ */
+struct LatencyHistogram {
+    static constexpr size_t bucket_num = 40;  // 2^39 纳秒约 9 分钟
+
+    std::array<uint64_t, bucket_num> buckets{};  ///< 各桶计数
+    uint64_t count = 0;                          ///< 总次数
+    uint64_t total_ns = 0;                       ///< 总耗时（纳秒）
+    uint64_t max_ns = 0;                         ///< 最大耗时（纳秒）
+
+    /** 耗时所在的桶序号 */
+    static size_t bucket_of(uint64_t ns) noexcept {
+        size_t i = 0;
+        while (ns && i < bucket_num - 1) {
+            ns >>= 1;
+            i++;
+        }
+        return i;
+    }
+
+    /** 桶的上界（纳秒） */
+    static uint64_t bucket_upper(size_t i) noexcept {
+        return i == 0 ? 0 : (uint64_t(1) << i) - 1;
+    }
+
+    void record(uint64_t ns) noexcept {
+        buckets[bucket_of(ns)]++;
+        count++;
+        total_ns += ns;
+        if (ns > max_ns) {
+            max_ns = ns;
+        }
+    }
+
+    void merge(const LatencyHistogram& other) noexcept {
+        for (size_t i = 0; i < bucket_num; i++) {
+            buckets[i] += other.buckets[i];
+        }
+        count += other.count;
+        total_ns += other.total_ns;
+        if (other.max_ns > max_ns) {
+            max_ns = other.max_ns;
+        }
+    }
+
+    /** 平均耗时（纳秒） */
+    double mean_ns() const noexcept {
+        return count ? double(total_ns) / double(count) : 0.0;
+    }
+
+    /**
+     * 估算百分位耗时
+     * @param p 百分位，取值 [0, 1]，如 0.99
+     * @return 所在桶的上界（纳秒），不超过最大耗时
+     */
+    uint64_t percentile(double p) const noexcept {
+        if (count == 0) {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(p * double(count));
+        if (target >= count) {
+            target = count - 1;
+        }
+        uint64_t seen = 0;
+        for (size_t i = 0; i < bucket_num; i++) {
+            seen += buckets[i];
+            if (seen > target) {
+                uint64_t upper = bucket_upper(i);
+                return upper < max_ns ? upper : max_ns;
+            }
+        }
+        return max_ns;
+    }
+};
+
+/** 单个工作线程的运行统计 */
+struct WorkerStats {
+    uint64_t tasks_executed = 0;     ///< 执行的任务数（含窃取的任务）
+    uint64_t tasks_stolen = 0;       ///< 从其他工作线程窃取的任务数
+    uint64_t tasks_stolen_from = 0;  ///< 被其他工作线程窃取走的任务数
+    uint64_t idle_ns = 0;            ///< 未执行任务的时间（纳秒），包含阻塞等待时间
+    uint64_t blocked_ns = 0;         ///< 阻塞等待新任务的时间（纳秒）
+    LatencyHistogram queue_latency;  ///< 任务从创建到开始执行的等待时间
+    LatencyHistogram run_time;       ///< 任务执行时间
+
+    void merge(const WorkerStats& other) noexcept {
+        tasks_executed += other.tasks_executed;
+        tasks_stolen += other.tasks_stolen;
+        tasks_stolen_from += other.tasks_stolen_from;
+        idle_ns += other.idle_ns;
+        blocked_ns += other.blocked_ns;
+        queue_latency.merge(other.queue_latency);
+        run_time.merge(other.run_time);
+    }
+};
+
+/**
+ * 线程池运行统计快照
+ * @note 仅在编译时开启 HKU_ENABLE_THREAD_POOL_STATS 时才收集各工作线程的统计信息，
+ *       否则 workers 为空，仅有剩余任务数
+ */
+struct ThreadPoolStats {
+    bool enabled = false;              ///< 是否收集了工作线程统计
+    size_t remain_tasks = 0;           ///< 快照时队列中的剩余任务数
+    std::vector<WorkerStats> workers;  ///< 各工作线程统计，按工作线程序号排列
+
+    /** 汇总所有工作线程 */
+    WorkerStats total() const noexcept {
+        WorkerStats ret;
+        for (const auto& w : workers) {
+            ret.merge(w);
+        }
+        return ret;
+    }
+};
+
+#if HKU_ENABLE_THREAD_POOL_STATS
+
+/**
+ * 线程池内部使用的统计收集器
+ * @details
+ * 每个工作线程一个独立的统计块（按缓存行对齐），仅由对应的工作线程写入，stats()
+ * 可在任意线程并发读取，读取结果为近似一致的快照。非工作线程（如协助执行任务的外部线程）
+ * 执行的任务不计入统计。
+ */
+class ThreadPoolStatsCollector {
+public:
+    ThreadPoolStatsCollector() = default;
+    explicit ThreadPoolStatsCollector(size_t worker_num)
+    : m_worker_num(worker_num), m_blocks(new Block[worker_num]) {
+        int64_t now = now_ns();
+        for (size_t i = 0; i < worker_num; i++) {
+            m_blocks[i].last_end_ns = now;
+        }
+    }
+
+    /** 在工作线程中执行任务，并记录等待及执行时间 */
+    void run_task(size_t index, FuncWrapper& task) {
+        if (index >= m_worker_num) {
+            task();
+            return;
+        }
+
+        Block& b = m_blocks[index];
+        int64_t start = now_ns();
+        if (b.depth == 0) {
+            add(b.idle_ns, elapsed(b.last_end_ns, start));
+        }
+        record(b.queue_latency, elapsed(task.createTime(), start));
+
+        // 任务内部等待子任务时可能嵌套执行其他任务，只在最外层统计空闲时间
+        b.depth++;
+        task();
+        b.depth--;
+
+        int64_t end = now_ns();
+        record(b.run_time, elapsed(start, end));
+        add(b.tasks_executed, 1);
+        if (b.depth == 0) {
+            b.last_end_ns = end;
+        }
+    }
+
+    /** 工作线程 thief 从工作线程 victim 窃取了一个任务 */
+    void task_stolen(size_t thief, size_t victim) noexcept {
+        if (thief < m_worker_num && victim < m_worker_num) {
+            add(m_blocks[thief].tasks_stolen, 1);
+            m_blocks[victim].tasks_stolen_from.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /** 阻塞等待计时，析构时累加至对应工作线程的阻塞时间 */
+    class BlockedScope {
+    public:
+        BlockedScope(ThreadPoolStatsCollector* stats, size_t index)
+        : m_stats(stats), m_index(index), m_start(now_ns()) {}
+
+        ~BlockedScope() {
+            if (m_index < m_stats->m_worker_num) {
+                add(m_stats->m_blocks[m_index].blocked_ns, elapsed(m_start, now_ns()));
+            }
+        }
+
+        BlockedScope(const BlockedScope&) = delete;
+        BlockedScope& operator=(const BlockedScope&) = delete;
+
+    private:
+        ThreadPoolStatsCollector* m_stats;
+        size_t m_index;
+        int64_t m_start;
+    };
+
+    BlockedScope blocked(size_t index) {
+        return BlockedScope(this, index);
+    }
+
+    ThreadPoolStats snapshot(size_t remain_tasks) const {
+        ThreadPoolStats ret;
+        ret.enabled = true;
+        ret.remain_tasks = remain_tasks;
+        ret.workers.resize(m_worker_num);
+        for (size_t i = 0; i < m_worker_num; i++) {
+            const Block& b = m_blocks[i];
+            WorkerStats& w = ret.workers[i];
+            w.tasks_executed = b.tasks_executed.load(std::memory_order_relaxed);
+            w.tasks_stolen = b.tasks_stolen.load(std::memory_order_relaxed);
+            w.tasks_stolen_from = b.tasks_stolen_from.load(std::memory_order_relaxed);
+            w.idle_ns = b.idle_ns.load(std::memory_order_relaxed);
+            w.blocked_ns = b.blocked_ns.load(std::memory_order_relaxed);
+            load(b.queue_latency, w.queue_latency);
+            load(b.run_time, w.run_time);
+        }
+        return ret;
+    }
+
+    static int64_t now_ns() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+    }
+
+private:
+    typedef std::atomic<uint64_t> counter_type;
+
+    struct AtomicHistogram {
+        std::array<counter_type, LatencyHistogram::bucket_num> buckets{};
+        counter_type count{0};
+        counter_type total_ns{0};
+        counter_type max_ns{0};
+    };
+
+    struct alignas(64) Block {
+        counter_type tasks_executed{0};
+        counter_type tasks_stolen{0};
+        counter_type tasks_stolen_from{0};  // 由其他线程写入
+        counter_type idle_ns{0};
+        counter_type blocked_ns{0};
+        AtomicHistogram queue_latency;
+        AtomicHistogram run_time;
+        int64_t last_end_ns = 0;  // 上一个任务结束时间，仅工作线程自身访问
+        int depth = 0;            // 嵌套执行深度，仅工作线程自身访问
+    };
+
+    static uint64_t elapsed(int64_t start, int64_t end) noexcept {
+        return end > start ? uint64_t(end - start) : 0;
+    }
+
+    // 单写者计数，无需原子读改写
+    static void add(counter_type& c, uint64_t v) noexcept {
+        c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+
+    static void record(AtomicHistogram& h, uint64_t ns) noexcept {
+        add(h.buckets[LatencyHistogram::bucket_of(ns)], 1);
+        add(h.count, 1);
+        add(h.total_ns, ns);
+        if (ns > h.max_ns.load(std::memory_order_relaxed)) {
+            h.max_ns.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    static void load(const AtomicHistogram& h, LatencyHistogram& out) noexcept {
+        for (size_t i = 0; i < LatencyHistogram::bucket_num; i++) {
+            out.buckets[i] = h.buckets[i].load(std::memory_order_relaxed);
+        }
+        out.count = h.count.load(std::memory_order_relaxed);
+        out.total_ns = h.total_ns.load(std::memory_order_relaxed);
+        out.max_ns = h.max_ns.load(std::memory_order_relaxed);
+    }
+
+private:
+    size_t m_worker_num = 0;
+    std::unique_ptr<Block[]> m_blocks;
+};
+
+#else
+
+/** 未开启 HKU_ENABLE_THREAD_POOL_STATS 时的空实现，调用均被编译器消除 */
+class ThreadPoolStatsCollector {
+public:
+    ThreadPoolStatsCollector() = default;
+    explicit ThreadPoolStatsCollector(size_t) {}
+
+    void run_task(size_t, FuncWrapper& task) {
+        task();
+    }
+
+    void task_stolen(size_t, size_t) noexcept {}
+
+    class BlockedScope {
+    public:
+        ~BlockedScope() {}
+    };
+
+    BlockedScope blocked(size_t) noexcept {
+        return BlockedScope();
+    }
+
+    ThreadPoolStats snapshot(size_t remain_tasks) const {
+        ThreadPoolStats ret;
+        ret.remain_tasks = remain_tasks;
+        return ret;
+    }
+};
+
+#endif /* HKU_ENABLE_THREAD_POOL_STATS */
+
+}  // namespace hku
+
+#endif /* HIKYUU_UTILITIES_THREAD_THREADPOOLSTATS_H */
@@ -11,6 +11,7 @@
 #ifndef HIKYUU_UTILITIES_THREAD_THREADSAFEQUEUE_H
 #define HIKYUU_UTILITIES_THREAD_THREADSAFEQUEUE_H
 
+#include <atomic>
 #include <queue>
 #include <thread>
 #include <condition_variable>
@@ -30,23 +31,51 @@ public:
     void push(T&& item) {
         std::lock_guard<std::mutex> lk(m_mutex);
         m_queue.push(std::move(item));
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         m_cond.notify_one();
     }
 
+    /**
+     * 将 [first, last) 中的元素批量移入队列尾部，只加锁一次
+     * @details 仅唤醒与插入元素数量相当的等待线程
+     */
+    template <typename Iterator>
+    void push_bulk(Iterator first, Iterator last) {
+        size_t count = 0;
+        size_t waiters = 0;
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            for (; first != last; ++first, ++count) {
+                m_queue.push(std::move(*first));
+            }
+            m_size.store(m_queue.size(), std::memory_order_relaxed);
+            waiters = m_waiters;
+        }
+        if (count >= waiters) {
+            m_cond.notify_all();
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                m_cond.notify_one();
+            }
+        }
+    }
+
     /** 等待直到从队列头部取出一个元素 */
     void wait_and_pop(T& value) {
         std::unique_lock<std::mutex> lk(m_mutex);
-        m_cond.wait(lk, [this] { return !m_queue.empty(); });
+        wait(lk);
         value = std::move(m_queue.front());
         m_queue.pop();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
     }
 
     /** 等待直到从队列头部取出一个元素 */
     std::shared_ptr<T> wait_and_pop() {
         std::unique_lock<std::mutex> lk(m_mutex);
-        m_cond.wait(lk, [this] { return !m_queue.empty(); });
+        wait(lk);
         std::shared_ptr<T> res(std::make_shared<T>(std::move(m_queue.front())));
         m_queue.pop();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         return res;
     }
 
@@ -58,6 +87,7 @@ public:
         }
         value = std::move(m_queue.front());
         m_queue.pop();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         return true;
     }
 
@@ -69,6 +99,7 @@ public:
         }
         std::shared_ptr<T> res(std::make_shared<T>(std::move(m_queue.front())));
         m_queue.pop();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         return res;
     }
 
@@ -78,9 +109,9 @@ public:
         return m_queue.empty();
     }
 
-    /** 队列大小，！未加锁，谨慎使用 */
+    /** 队列大小，无需加锁，仅为近似值，可用于监控及统计 */
     size_t size() const {
-        return m_queue.size();
+        return m_size.load(std::memory_order_relaxed);
     }
 
     /** 清空任务队列 */
@@ -88,16 +119,28 @@ public:
         std::lock_guard<std::mutex> lock(m_mutex);
         auto tmp = std::queue<T>();
         m_queue.swap(tmp);
+        m_size.store(0, std::memory_order_relaxed);
     }
 
     void notify_all() {
         m_cond.notify_all();
     }
 
+private:
+    void wait(std::unique_lock<std::mutex>& lk) {
+        if (m_queue.empty()) {
+            m_waiters++;
+            m_cond.wait(lk, [this] { return !m_queue.empty(); });
+            m_waiters--;
+        }
+    }
+
 private:
     mutable std::mutex m_mutex;
     std::queue<T> m_queue;
     std::condition_variable m_cond;
+    size_t m_waiters = 0;           // 阻塞等待中的线程数
+    std::atomic<size_t> m_size{0};  // 队列大小，用于无锁读取
 };
 
 } /* namespace hku */
@@ -11,13 +11,25 @@ namespace hku {
 
 std::unique_ptr<GlobalStealThreadPool> global_steal_thread_pool;
 
+static std::mutex g_default_parallel_mutex;
+static std::unique_ptr<MQThreadPool> g_default_parallel_task_group;
+
 void HKU_UTILS_API init_global_task_group(size_t work_num) {
-    size_t cpu_num = std::thread::hardware_concurrency();
+    init_global_task_group(work_num, AffinityPolicy());
+}
+
+void HKU_UTILS_API init_global_task_group(size_t work_num, const AffinityPolicy& affinity) {
     if (work_num == 0) {
-        work_num = cpu_num;
+        const auto& topo = CpuTopology::system();
+        if (affinity.type() == AffinityPolicy::NUMA_NODE && affinity.node() < topo.node_num()) {
+            work_num = topo.node_cpus(affinity.node()).size();
+        } else {
+            work_num = std::thread::hardware_concurrency();
+        }
     }
     if (!global_steal_thread_pool) {
-        global_steal_thread_pool = std::make_unique<GlobalStealThreadPool>(work_num, false);
+        global_steal_thread_pool =
+          std::make_unique<GlobalStealThreadPool>(work_num, affinity, false);
     }
 }
 
@@ -27,4 +39,18 @@ void HKU_UTILS_API release_global_task_group() {
     }
 }
 
+MQThreadPool* HKU_UTILS_API get_default_parallel_task_group() {
+    std::lock_guard<std::mutex> lock(g_default_parallel_mutex);
+    if (!g_default_parallel_task_group) {
+        g_default_parallel_task_group =
+          std::make_unique<MQThreadPool>(std::thread::hardware_concurrency());
+    }
+    return g_default_parallel_task_group.get();
+}
+
+void HKU_UTILS_API release_default_parallel_task_group() {
+    std::lock_guard<std::mutex> lock(g_default_parallel_mutex);
+    g_default_parallel_task_group.reset();
+}
+
 }  // namespace hku
\ No newline at end of file
@@ -7,19 +7,28 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <future>
 #include <functional>
+#include <iterator>
 #include <vector>
 #include <limits>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <type_traits>
 #include "ThreadPool.h"
 #include "MQThreadPool.h"
+#include "PriorityMQThreadPool.h"
+#include "ElasticThreadPool.h"
 #include "StealThreadPool.h"
 #include "MQStealThreadPool.h"
 #include "GlobalMQThreadPool.h"
 #include "GlobalStealThreadPool.h"
 #include "GlobalMQStealThreadPool.h"
 #include "GlobalThreadPool.h"
+#include "Partitioner.h"
 
 #if CPP_STANDARD >= CPP_STANDARD_20
 #include <boost/asio.hpp>
@@ -35,7 +44,8 @@
 // Note: 除 ThreadPool/MQThreadPool 外，其他线程池由于使用
 //       了 thread_local，本质为全局变量，只适合全局单例的方式使用,
 //       否则会出现不同线程池示例互相影响导致出错。
-//       每次会创建独立的线程池计算。
+//       未指定线程池时每次会创建独立的线程池计算，频繁调用时可使用
+//       指定线程池的重载版本。
 //       如果都是纯计算(IO较少)，
 //       建议创建全局线程池，并使用全局线程池进行计算。
 //----------------------------------------------------------------
@@ -82,13 +92,11 @@ void parallel_for_index_void(size_t start, size_t end, FunctionType f, int cpu_n
     }
 
     TaskGroup tg(cpu_num == 0 ? std::thread::hardware_concurrency() : cpu_num);
-    for (size_t i = 0, total = ranges.size(); i < total; i++) {
-        tg.submit([=, range = ranges[i]]() {
-            for (size_t ix = range.first; ix < range.second; ix++) {
-                f(ix);
-            }
-        });
-    }
+    tg.submit_n(ranges.size(), [f, &ranges](size_t i) {
+        for (size_t ix = ranges[i].first; ix < ranges[i].second; ix++) {
+            f(ix);
+        }
+    });
     tg.join();
     return;
 }
@@ -155,9 +163,7 @@ void parallel_for_index_void_single(size_t start, size_t end, FunctionType f, in
     }
 
     TaskGroup tg(cpu_num == 0 ? std::thread::hardware_concurrency() : cpu_num);
-    for (size_t i = start; i < end; i++) {
-        tg.submit([func = f, i]() { func(i); });
-    }
+    tg.submit_n(end - start, [func = f, start](size_t i) { func(start + i); });
     tg.join();
     return;
 }
@@ -182,15 +188,405 @@ auto parallel_for_index_single(size_t start, size_t end, FunctionType f, size_t
     return ret;
 }
 
+//----------------------------------------------------------------
+// 按划分策略（Partitioner）执行的 parallel_for 系列
+// 以工作线程数个任务并行执行，各任务按划分策略循环领取区间直至全部完成，
+// 适合各索引耗时不均匀的情况。
+//----------------------------------------------------------------
+
+/** @cond internal */
+template <typename RangeFunction>
+void run_partition_range(PartitionRange& pr, RangeFunction&& body) {
+    range_t range;
+    if (pr.need_timing()) {
+        while (pr.next(range)) {
+            auto start_time = std::chrono::steady_clock::now();
+            body(range);
+            pr.report(range, std::chrono::steady_clock::now() - start_time);
+        }
+    } else {
+        while (pr.next(range)) {
+            body(range);
+        }
+    }
+}
+
+// 结果可预先分配后由各工作线程直接写入对应位置（vector<bool> 按位存储，不可并发写入）
+template <typename T>
+struct can_write_in_place
+: std::integral_constant<bool, std::is_default_constructible<T>::value &&
+                                 std::is_move_assignable<T>::value &&
+                                 !std::is_same<T, bool>::value> {};
+
+// 将各工作线程按区间收集的结果，按区间起始位置顺序合并
+template <typename ResultType, typename PartType>
+void merge_partition_results(ResultType& ret, std::vector<std::vector<PartType>>& parts) {
+    std::vector<PartType*> all;
+    for (auto& one : parts) {
+        for (auto& part : one) {
+            all.push_back(&part);
+        }
+    }
+    std::sort(all.begin(), all.end(),
+              [](const PartType* a, const PartType* b) { return a->first < b->first; });
+    for (auto* part : all) {
+        for (auto&& value : part->second) {
+            ret.emplace_back(std::move(value));
+        }
+    }
+}
+/** @endcond */
+
+/**
+ * 按划分策略并行执行 f(i)，i 属于 [start, end)
+ * @param start 起始索引
+ * @param end 结束索引（不包含）
+ * @param f 以 size_t 为参数的函数
+ * @param partitioner 划分策略，如 static_partitioner()、guided_partitioner()、
+ *        dynamic_partitioner()、auto_partitioner()
+ * @param cpu_num 工作线程数，为 0 时使用 CPU 数
+ */
+template <typename FunctionType, class TaskGroup = MQThreadPool>
+void parallel_for_index_void(size_t start, size_t end, FunctionType f,
+                             const Partitioner& partitioner, int cpu_num = 0) {
+    if (start >= end) {
+        return;
+    }
+
+    size_t worker_num = cpu_num == 0 ? std::thread::hardware_concurrency() : cpu_num;
+    PartitionRange pr(partitioner, start, end, worker_num);
+    TaskGroup tg(worker_num);
+    auto task = tg.submit_n(worker_num, [&f, &pr](size_t) {
+        run_partition_range(pr, [&f](const range_t& range) {
+            for (size_t ix = range.first; ix < range.second; ix++) {
+                f(ix);
+            }
+        });
+    });
+    tg.join();
+    task.get();
+}
+
+/**
+ * 按划分策略并行执行 f(i)，i 属于 [start, end)，按索引顺序返回结果
+ * @see parallel_for_index_void
+ */
+template <typename FunctionType, class TaskGroup = MQThreadPool>
+auto parallel_for_index(size_t start, size_t end, FunctionType f, const Partitioner& partitioner,
+                        size_t cpu_num = 0) {
+    typedef typename std::invoke_result<FunctionType, size_t>::type value_type;
+    typedef std::pair<size_t, std::vector<value_type>> part_type;
+    std::vector<value_type> ret;
+    if (start >= end) {
+        return ret;
+    }
+
+    size_t worker_num = cpu_num == 0 ? std::thread::hardware_concurrency() : cpu_num;
+    PartitionRange pr(partitioner, start, end, worker_num);
+    std::vector<std::vector<part_type>> parts(worker_num);
+    TaskGroup tg(worker_num);
+    auto task = tg.submit_n(worker_num, [&f, &pr, &parts](size_t w) {
+        run_partition_range(pr, [&f, &parts, w](const range_t& range) {
+            std::vector<value_type> one_ret;
+            one_ret.reserve(range.second - range.first);
+            for (size_t ix = range.first; ix < range.second; ix++) {
+                one_ret.emplace_back(f(ix));
+            }
+            parts[w].emplace_back(range.first, std::move(one_ret));
+        });
+    });
+    tg.join();
+    task.get();
+
+    ret.reserve(end - start);
+    merge_partition_results(ret, parts);
+    return ret;
+}
+
+/**
+ * 按划分策略并行执行 f(range)，按区间顺序合并各区间返回的结果
+ * @see parallel_for_index_void
+ */
+template <typename FunctionType, class TaskGroup = MQThreadPool>
+auto parallel_for_range(size_t start, size_t end, FunctionType f, const Partitioner& partitioner,
+                        size_t cpu_num = 0) {
+    typedef typename std::invoke_result<FunctionType, range_t>::type result_type;
+    typedef std::pair<size_t, result_type> part_type;
+    result_type ret;
+    if (start >= end) {
+        return ret;
+    }
+
+    size_t worker_num = cpu_num == 0 ? std::thread::hardware_concurrency() : cpu_num;
+    PartitionRange pr(partitioner, start, end, worker_num);
+    std::vector<std::vector<part_type>> parts(worker_num);
+    TaskGroup tg(worker_num);
+    auto task = tg.submit_n(worker_num, [&f, &pr, &parts](size_t w) {
+        run_partition_range(pr, [&f, &parts, w](const range_t& range) {
+            parts[w].emplace_back(range.first, f(range));
+        });
+    });
+    tg.join();
+    task.get();
+
+    merge_partition_results(ret, parts);
+    return ret;
+}
+
+//----------------------------------------------------------------
+// 使用已有线程池执行的 parallel_for 系列
+// 不创建和销毁线程，适合频繁调用的小规模并行。线程池可为 ThreadPool、MQThreadPool、
+// PriorityMQThreadPool、ElasticThreadPool，或通过 get_default_parallel_task_group()
+// 获取的进程内默认线程池。
+// note: 调用期间当前线程阻塞等待，不可在同一线程池的任务中调用，否则可能死锁
+//----------------------------------------------------------------
+
+/**
+ * 获取进程内默认的 parallel_for 线程池，首次调用时创建，工作线程数为 CPU 数
+ * @note 返回的指针在 release_default_parallel_task_group 后失效
+ */
+MQThreadPool* HKU_UTILS_API get_default_parallel_task_group();
+
+/** 释放进程内默认的 parallel_for 线程池，等待其中的任务全部完成 */
+void HKU_UTILS_API release_default_parallel_task_group();
+
+/** @cond internal */
+template <class TaskGroup>
+size_t task_group_worker_num(const TaskGroup& tg) {
+    return std::max<size_t>(tg.worker_num(), 1);
+}
+
+// 弹性线程池的当前线程数随负载变化，按最大线程数划分任务
+inline size_t task_group_worker_num(const ElasticThreadPool& tg) {
+    return tg.max_threads();
+}
+/** @endcond */
+
+/**
+ * 使用指定线程池并行执行 f(i)，i 属于 [start, end)，按线程池工作线程数划分区间
+ * @note 调用线程阻塞至全部任务结束，不可在 tg 自身的工作线程中调用，否则该工作线程被占用，
+ * 线程池满载时将死锁。任务抛出异常时，等待其余任务结束后重新抛出第一个异常。
+ * @param tg 线程池，调用结束后仍可继续使用
+ * @param start 起始索引
+ * @param end 结束索引（不包含）
+ * @param f 以 size_t 为参数的函数
+ */
+template <class TaskGroup, typename FunctionType>
+void parallel_for_index_void(TaskGroup& tg, size_t start, size_t end, FunctionType f) {
+    auto ranges = parallelIndexRange(start, end, task_group_worker_num(tg));
+    if (ranges.empty()) {
+        return;
+    }
+
+    auto task = tg.submit_n(ranges.size(), [&f, &ranges](size_t i) {
+        for (size_t ix = ranges[i].first; ix < ranges[i].second; ix++) {
+            f(ix);
+        }
+    });
+    task.get();
+}
+
+/**
+ * 使用指定线程池并行执行 f(i)，i 属于 [start, end)，按索引顺序返回结果
+ * @note 不可在 tg 自身的工作线程中调用，否则可能死锁
+ * @see parallel_for_index_void(TaskGroup&, size_t, size_t, FunctionType)
+ */
+template <class TaskGroup, typename FunctionType>
+auto parallel_for_index(TaskGroup& tg, size_t start, size_t end, FunctionType f) {
+    typedef typename std::invoke_result<FunctionType, size_t>::type value_type;
+    std::vector<value_type> ret;
+    auto ranges = parallelIndexRange(start, end, task_group_worker_num(tg));
+    if (ranges.empty()) {
+        return ret;
+    }
+
+    // 各任务写入独立的位置，submit_n 在全部任务结束后才重新抛出异常，f 在任务执行期间始终有效
+    std::vector<std::vector<value_type>> parts(ranges.size());
+    auto task = tg.submit_n(ranges.size(), [&f, &ranges, &parts](size_t i) {
+        std::vector<value_type>& one_ret = parts[i];
+        one_ret.reserve(ranges[i].second - ranges[i].first);
+        for (size_t ix = ranges[i].first; ix < ranges[i].second; ix++) {
+            one_ret.emplace_back(f(ix));
+        }
+    });
+    task.get();
+
+    ret.reserve(end - start);
+    for (auto& one : parts) {
+        for (auto&& value : one) {
+            ret.emplace_back(std::move(value));
+        }
+    }
+    return ret;
+}
+
+/**
+ * 使用指定线程池并行执行 f(range)，按区间顺序合并各区间返回的结果
+ * @note 不可在 tg 自身的工作线程中调用，否则可能死锁
+ * @see parallel_for_index_void(TaskGroup&, size_t, size_t, FunctionType)
+ */
+template <class TaskGroup, typename FunctionType>
+auto parallel_for_range(TaskGroup& tg, size_t start, size_t end, FunctionType f) {
+    typedef typename std::invoke_result<FunctionType, range_t>::type result_type;
+    result_type ret;
+    auto ranges = parallelIndexRange(start, end, task_group_worker_num(tg));
+    if (ranges.empty()) {
+        return ret;
+    }
+
+    std::vector<result_type> parts(ranges.size());
+    auto task = tg.submit_n(ranges.size(),
+                            [&f, &ranges, &parts](size_t i) { parts[i] = f(ranges[i]); });
+    task.get();
+
+    for (auto& one : parts) {
+        for (auto&& value : one) {
+            ret.emplace_back(std::move(value));
+        }
+    }
+    return ret;
+}
+
+/**
+ * 使用指定线程池并行执行 f(i)，每个索引一个任务
+ * @see parallel_for_index_void(TaskGroup&, size_t, size_t, FunctionType)
+ */
+template <class TaskGroup, typename FunctionType>
+void parallel_for_index_void_single(TaskGroup& tg, size_t start, size_t end, FunctionType f) {
+    if (start >= end) {
+        return;
+    }
+    auto task = tg.submit_n(end - start, [&f, start](size_t i) { f(start + i); });
+    task.get();
+}
+
+/**
+ * 使用指定线程池并行执行 f(i)，每个索引一个任务，按索引顺序返回结果
+ * @note 不可在 tg 自身的工作线程中调用，否则可能死锁
+ * @see parallel_for_index_void(TaskGroup&, size_t, size_t, FunctionType)
+ */
+template <class TaskGroup, typename FunctionType>
+auto parallel_for_index_single(TaskGroup& tg, size_t start, size_t end, FunctionType f) {
+    typedef typename std::invoke_result<FunctionType, size_t>::type value_type;
+    std::vector<value_type> ret;
+    if (start >= end) {
+        return ret;
+    }
+
+    // 使用 optional 保存结果，value_type 无需默认构造，且避免 std::vector<bool> 的并发写入
+    std::vector<std::optional<value_type>> parts(end - start);
+    auto task =
+      tg.submit_n(end - start, [&f, &parts, start](size_t i) { parts[i] = f(start + i); });
+    task.get();
+
+    ret.reserve(end - start);
+    for (auto& value : parts) {
+        ret.push_back(std::move(*value));
+    }
+    return ret;
+}
+
+/**
+ * 使用指定线程池，按划分策略并行执行 f(i)，i 属于 [start, end)
+ * @see parallel_for_index_void(size_t, size_t, FunctionType, const Partitioner&, int)
+ */
+template <class TaskGroup, typename FunctionType>
+void parallel_for_index_void(TaskGroup& tg, size_t start, size_t end, FunctionType f,
+                             const Partitioner& partitioner) {
+    if (start >= end) {
+        return;
+    }
+
+    size_t worker_num = task_group_worker_num(tg);
+    PartitionRange pr(partitioner, start, end, worker_num);
+    auto task = tg.submit_n(worker_num, [&f, &pr](size_t) {
+        run_partition_range(pr, [&f](const range_t& range) {
+            for (size_t ix = range.first; ix < range.second; ix++) {
+                f(ix);
+            }
+        });
+    });
+    task.get();
+}
+
+/**
+ * 使用指定线程池，按划分策略并行执行 f(i)，i 属于 [start, end)，按索引顺序返回结果
+ * @see parallel_for_index_void(size_t, size_t, FunctionType, const Partitioner&, int)
+ */
+template <class TaskGroup, typename FunctionType>
+auto parallel_for_index(TaskGroup& tg, size_t start, size_t end, FunctionType f,
+                        const Partitioner& partitioner) {
+    typedef typename std::invoke_result<FunctionType, size_t>::type value_type;
+    typedef std::pair<size_t, std::vector<value_type>> part_type;
+    std::vector<value_type> ret;
+    if (start >= end) {
+        return ret;
+    }
+
+    size_t worker_num = task_group_worker_num(tg);
+    PartitionRange pr(partitioner, start, end, worker_num);
+    std::vector<std::vector<part_type>> parts(worker_num);
+    auto task = tg.submit_n(worker_num, [&f, &pr, &parts](size_t w) {
+        run_partition_range(pr, [&f, &parts, w](const range_t& range) {
+            std::vector<value_type> one_ret;
+            one_ret.reserve(range.second - range.first);
+            for (size_t ix = range.first; ix < range.second; ix++) {
+                one_ret.emplace_back(f(ix));
+            }
+            parts[w].emplace_back(range.first, std::move(one_ret));
+        });
+    });
+    task.get();
+
+    ret.reserve(end - start);
+    merge_partition_results(ret, parts);
+    return ret;
+}
+
+/**
+ * 使用指定线程池，按划分策略并行执行 f(range)，按区间顺序合并各区间返回的结果
+ * @see parallel_for_index_void(size_t, size_t, FunctionType, const Partitioner&, int)
+ */
+template <class TaskGroup, typename FunctionType>
+auto parallel_for_range(TaskGroup& tg, size_t start, size_t end, FunctionType f,
+                        const Partitioner& partitioner) {
+    typedef typename std::invoke_result<FunctionType, range_t>::type result_type;
+    typedef std::pair<size_t, result_type> part_type;
+    result_type ret;
+    if (start >= end) {
+        return ret;
+    }
+
+    size_t worker_num = task_group_worker_num(tg);
+    PartitionRange pr(partitioner, start, end, worker_num);
+    std::vector<std::vector<part_type>> parts(worker_num);
+    auto task = tg.submit_n(worker_num, [&f, &pr, &parts](size_t w) {
+        run_partition_range(pr, [&f, &parts, w](const range_t& range) {
+            parts[w].emplace_back(range.first, f(range));
+        });
+    });
+    task.get();
+
+    merge_partition_results(ret, parts);
+    return ret;
+}
+
 //----------------------------------------------------------------
 // 创建全局任务偷取线程池，主要目的用于计算密集或少量混合IO的并行，不适合纯IO的并行
-// 前面 parallel_for 系列每次都会创建独立线程池。
+// 前面未指定线程池的 parallel_for 系列每次都会创建独立线程池。
 // note: 程序内全局，初始化一次即可，重复初始化被忽略
 //----------------------------------------------------------------
 extern HKU_UTILS_API std::unique_ptr<GlobalStealThreadPool> global_steal_thread_pool;
 
 void HKU_UTILS_API init_global_task_group(size_t work_num = 0);
 
+/**
+ * 初始化全局任务组，并按亲和性策略绑定工作线程
+ * @param work_num 工作线程数，为 0 时使用 CPU 数（NUMA_NODE 策略时为该节点的 CPU 数）
+ * @param affinity CPU 亲和性策略
+ */
+void HKU_UTILS_API init_global_task_group(size_t work_num, const AffinityPolicy& affinity);
+
 void HKU_UTILS_API release_global_task_group();
 
 inline GlobalStealThreadPool* get_global_task_group() {
@@ -199,6 +595,53 @@ inline GlobalStealThreadPool* get_global_task_group() {
 
 size_t HKU_UTILS_API get_global_task_group_work_num();
 
+/**
+ * 全局线程池中的一组子任务
+ * @details
+ * 通过 run/run_n 提交子任务，子任务完成时递减组内计数器（TaskLatch），无需为每个子任务创建 future。
+ * wait 时当前线程协助执行线程池中的任务，无任务可执行时休眠直至子任务全部完成。
+ * 析构时如仍有未完成的子任务则等待其完成（忽略异常），以保证子任务引用的栈上对象有效。
+ */
+class GlobalTaskGroup {
+public:
+    explicit GlobalTaskGroup(GlobalStealThreadPool* pool = get_global_task_group()) : m_pool(pool) {
+        HKU_ASSERT(m_pool);
+    }
+
+    ~GlobalTaskGroup() {
+        if (!m_latch.ready()) {
+            try {
+                m_pool->wait(m_latch);
+            } catch (...) {
+            }
+        }
+    }
+
+    GlobalTaskGroup(const GlobalTaskGroup&) = delete;
+    GlobalTaskGroup& operator=(const GlobalTaskGroup&) = delete;
+
+    /** 提交无参数的子任务 */
+    template <typename FunctionType>
+    void run(FunctionType&& f) {
+        m_pool->spawn(m_latch, std::forward<FunctionType>(f));
+    }
+
+    /** 提交子任务 f(0), f(1), ..., f(n-1)，f 须在 wait 返回前保持有效 */
+    template <typename FunctionType>
+    void run_n(size_t n, FunctionType& f) {
+        m_pool->spawn_n(m_latch, n, f);
+    }
+
+    /** 等待全部子任务完成，如有子任务抛出异常，则重新抛出第一个异常 */
+    void wait() {
+        m_pool->wait(m_latch);
+    }
+
+private:
+    GlobalStealThreadPool* m_pool;
+    TaskLatch m_latch;
+};
+
 template <typename FutureContainer>
 void wait_for_all_non_blocking(GlobalStealThreadPool& pool, FutureContainer& futures) {
     // 如果当前线程是工作线程，其子任务加入的是自身队列前端，其他线程无法获取子任务，需要唤醒
@@ -208,36 +651,14 @@ void wait_for_all_non_blocking(GlobalStealThreadPool& pool, FutureContainer& fut
         pool.wake_up();
     }
 
-    bool all_ready = false;
-    auto init_delay = std::chrono::microseconds(1);
-    auto delay = init_delay;
-    const auto max_delay = std::chrono::microseconds(50000);
-
-    while (!all_ready && !pool.done()) {
-        all_ready = true;
-        for (auto& future : futures) {
-            if (future.wait_for(std::chrono::nanoseconds(0)) != std::future_status::ready) {
-                all_ready = false;
-                break;
-            }
-        }
-
-        // 如果不是所有任务都完成，尝试执行积累任务
-        if (!all_ready) {
+    for (auto& future : futures) {
+        // 等待期间协助执行任务，无任务可执行时在未完成的 future 上短暂阻塞，完成时立即返回
+        while (future.wait_for(std::chrono::nanoseconds(0)) != std::future_status::ready) {
             if (!pool.run_available_task_once()) {
-                return;
-            }
-            if (pool.run_available_task_once()) {
-                delay = init_delay;
-            } else if (pool.done()) {
-                // 非工作线程也要参与忙等，否则在内存不足时更容易发生内存交换
-                return;
-            } else {
-                // 工作线程休眠忙等
-                std::this_thread::sleep_for(delay);
-                if (delay < max_delay) {
-                    delay = std::min(delay * 2, max_delay);
+                if (pool.done()) {
+                    return;
                 }
+                future.wait_for(std::chrono::milliseconds(1));
             }
         }
     }
@@ -262,29 +683,14 @@ inline void global_wake_up() {
 template <typename FutureType>
 void global_wait_task(FutureType& future) {
     auto* tg = get_global_task_group();
-    bool ready = false;
-    auto init_delay = std::chrono::microseconds(1);
-    auto delay = init_delay;
-    const auto max_delay = std::chrono::microseconds(50000);
-
-    while (!ready && !tg->done()) {
-        ready = true;
-        if (future.wait_for(std::chrono::nanoseconds(0)) != std::future_status::ready) {
-            ready = false;
-        }
-
-        // 如果任务未完成，尝试执行本地任务
-        if (!ready) {
-            if (tg->run_available_task_once()) {
-                delay = init_delay;
-            } else if (tg->done()) {
+    while (!tg->done() &&
+           future.wait_for(std::chrono::nanoseconds(0)) != std::future_status::ready) {
+        // 如果任务未完成，尝试执行本地任务，无任务可执行时在 future 上短暂阻塞
+        if (!tg->run_available_task_once()) {
+            if (tg->done()) {
                 break;
-            } else {
-                std::this_thread::sleep_for(delay);
-                if (delay < max_delay) {
-                    delay = std::min(delay * 2, max_delay);
-                }
             }
+            future.wait_for(std::chrono::milliseconds(1));
         }
     }
 }
@@ -310,29 +716,21 @@ auto global_parallel_for_index_void(size_t start, size_t end, FunctionType&& f,
         return;
     }
 
-    std::vector<std::future<void>> tasks;
-    tasks.reserve(ranges.size());
-    for (size_t i = 0, total = ranges.size(); i < total; i++) {
-        tasks.emplace_back(tg->submit([func = f, range = ranges[i]]() {
-            for (size_t ix = range.first; ix < range.second; ix++) {
-                func(ix);
-            }
-        }));
-    }
-
-    wait_for_all_non_blocking(*tg, tasks);
-
-    for (auto& task : tasks) {
-        task.get();
-    }
-
-    return;
+    auto body = [&f, &ranges](size_t i) {
+        for (size_t ix = ranges[i].first; ix < ranges[i].second; ix++) {
+            f(ix);
+        }
+    };
+    GlobalTaskGroup group(tg);
+    group.run_n(ranges.size(), body);
+    group.wait();
 }
 
 template <typename FunctionType>
 auto global_parallel_for_index(size_t start, size_t end, FunctionType&& f, size_t threshold = 2,
                                bool enable_nested = true) {
-    std::vector<typename std::invoke_result<FunctionType, size_t>::type> ret;
+    typedef typename std::invoke_result<FunctionType, size_t>::type value_type;
+    std::vector<value_type> ret;
     HKU_IF_RETURN(start >= end, ret);
 
     ret.reserve(end - start);
@@ -353,26 +751,33 @@ auto global_parallel_for_index(size_t start, size_t end, FunctionType&& f, size_
         return ret;
     }
 
-    std::vector<std::future<std::vector<typename std::invoke_result<FunctionType, size_t>::type>>>
-      tasks;
-    tasks.reserve(ranges.size());
-    for (size_t i = 0, total = ranges.size(); i < total; i++) {
-        tasks.emplace_back(tg->submit([func = f, range = ranges[i]]() {
-            std::vector<typename std::invoke_result<FunctionType, size_t>::type> one_ret;
-            one_ret.reserve(range.second - range.first);
-            for (size_t ix = range.first; ix < range.second; ix++) {
-                one_ret.emplace_back(func(ix));
+    GlobalTaskGroup group(tg);
+    if constexpr (can_write_in_place<value_type>::value) {
+        // 预先分配结果，各任务直接写入对应位置，避免逐个拷贝各区间的结果
+        ret.resize(end - start);
+        auto body = [&f, &ranges, &ret, start](size_t i) {
+            for (size_t ix = ranges[i].first; ix < ranges[i].second; ix++) {
+                ret[ix - start] = f(ix);
             }
-            return one_ret;
-        }));
-    }
-
-    wait_for_all_non_blocking(*tg, tasks);
+        };
+        group.run_n(ranges.size(), body);
+        group.wait();
+    } else {
+        std::vector<std::vector<value_type>> parts(ranges.size());
+        auto body = [&f, &ranges, &parts](size_t i) {
+            auto& one_ret = parts[i];
+            one_ret.reserve(ranges[i].second - ranges[i].first);
+            for (size_t ix = ranges[i].first; ix < ranges[i].second; ix++) {
+                one_ret.emplace_back(f(ix));
+            }
+        };
+        group.run_n(ranges.size(), body);
+        group.wait();
 
-    for (auto& task : tasks) {
-        auto one = task.get();
-        for (auto&& value : one) {
-            ret.emplace_back(std::move(value));
+        for (auto& one : parts) {
+            for (auto&& value : one) {
+                ret.emplace_back(std::move(value));
+            }
         }
     }
 
@@ -395,24 +800,17 @@ void global_parallel_for_index_void_single(size_t start, size_t end, FunctionTyp
     auto* tg = get_global_task_group();
     HKU_ASSERT(tg);
 
-    std::vector<std::future<void>> tasks;
-    tasks.reserve(end - start);
-    for (size_t i = start; i < end; i++) {
-        tasks.push_back(tg->submit([func = f, i]() { func(i); }));
-    }
-
-    wait_for_all_non_blocking(*tg, tasks);
-
-    for (auto& task : tasks) {
-        task.get();
-    }
-    return;
+    auto body = [&f, start](size_t i) { f(start + i); };
+    GlobalTaskGroup group(tg);
+    group.run_n(end - start, body);
+    group.wait();
 }
 
 template <typename FunctionType>
 auto global_parallel_for_index_single(size_t start, size_t end, FunctionType&& f,
                                       size_t threshold = 1, bool enable_nested = true) {
-    std::vector<typename std::invoke_result<FunctionType, size_t>::type> ret;
+    typedef typename std::invoke_result<FunctionType, size_t>::type value_type;
+    std::vector<value_type> ret;
     HKU_IF_RETURN(start >= end, ret);
 
     ret.reserve(end - start);
@@ -428,23 +826,312 @@ auto global_parallel_for_index_single(size_t start, size_t end, FunctionType&& f
     auto* tg = get_global_task_group();
     HKU_ASSERT(tg);
 
-    std::vector<std::future<typename std::invoke_result<FunctionType, size_t>::type>> tasks;
-    tasks.reserve(end - start);
-    for (size_t i = start; i < end; i++) {
-        tasks.emplace_back(
-          tg->submit([func = f, i]() ->
-                     typename std::invoke_result<FunctionType, size_t>::type { return func(i); }));
+    GlobalTaskGroup group(tg);
+    if constexpr (can_write_in_place<value_type>::value) {
+        ret.resize(end - start);
+        auto body = [&f, &ret, start](size_t i) { ret[i] = f(start + i); };
+        group.run_n(end - start, body);
+        group.wait();
+    } else {
+        std::vector<std::optional<value_type>> values(end - start);
+        auto body = [&f, &values, start](size_t i) { values[i].emplace(f(start + i)); };
+        group.run_n(end - start, body);
+        group.wait();
+        for (auto& value : values) {
+            ret.push_back(std::move(*value));
+        }
     }
 
-    wait_for_all_non_blocking(*tg, tasks);
+    return ret;
+}
 
-    for (auto& task : tasks) {
-        ret.push_back(std::move(task.get()));
+/**
+ * 使用全局线程池，按划分策略并行执行 f(i)，i 属于 [start, end)
+ * @param start 起始索引
+ * @param end 结束索引（不包含）
+ * @param f 以 size_t 为参数的函数
+ * @param partitioner 划分策略
+ * @param threshold 任务数小于该阈值时直接在当前线程串行执行
+ * @param enable_nested 是否允许在工作线程中嵌套并行
+ */
+template <typename FunctionType>
+void global_parallel_for_index_void(size_t start, size_t end, FunctionType&& f,
+                                    const Partitioner& partitioner, size_t threshold = 2,
+                                    bool enable_nested = true) {
+    HKU_IF_RETURN(start >= end, void());
+
+    if ((end - start) < threshold || (!enable_nested && GlobalStealThreadPool::is_work_thread())) {
+        for (size_t i = start; i < end; i++) {
+            f(i);
+        }
+        return;
+    }
+
+    auto* tg = get_global_task_group();
+    HKU_ASSERT(tg);
+
+    size_t worker_num = tg->worker_num();
+    PartitionRange pr(partitioner, start, end, worker_num);
+    auto body = [&f, &pr](size_t) {
+        run_partition_range(pr, [&f](const range_t& range) {
+            for (size_t ix = range.first; ix < range.second; ix++) {
+                f(ix);
+            }
+        });
+    };
+    GlobalTaskGroup group(tg);
+    group.run_n(worker_num, body);
+    group.wait();
+}
+
+/**
+ * 使用全局线程池，按划分策略并行执行 f(i)，i 属于 [start, end)，按索引顺序返回结果
+ * @see global_parallel_for_index_void
+ */
+template <typename FunctionType>
+auto global_parallel_for_index(size_t start, size_t end, FunctionType&& f,
+                               const Partitioner& partitioner, size_t threshold = 2,
+                               bool enable_nested = true) {
+    typedef typename std::invoke_result<FunctionType, size_t>::type value_type;
+    typedef std::pair<size_t, std::vector<value_type>> part_type;
+    std::vector<value_type> ret;
+    HKU_IF_RETURN(start >= end, ret);
+
+    ret.reserve(end - start);
+    if ((end - start) < threshold || (!enable_nested && GlobalStealThreadPool::is_work_thread())) {
+        for (size_t i = start; i < end; i++) {
+            ret.emplace_back(f(i));
+        }
+        return ret;
+    }
+
+    auto* tg = get_global_task_group();
+    HKU_ASSERT(tg);
+
+    size_t worker_num = tg->worker_num();
+    PartitionRange pr(partitioner, start, end, worker_num);
+    GlobalTaskGroup group(tg);
+    if constexpr (can_write_in_place<value_type>::value) {
+        ret.resize(end - start);
+        auto body = [&f, &pr, &ret, start](size_t) {
+            run_partition_range(pr, [&f, &ret, start](const range_t& range) {
+                for (size_t ix = range.first; ix < range.second; ix++) {
+                    ret[ix - start] = f(ix);
+                }
+            });
+        };
+        group.run_n(worker_num, body);
+        group.wait();
+    } else {
+        std::vector<std::vector<part_type>> parts(worker_num);
+        auto body = [&f, &pr, &parts](size_t w) {
+            run_partition_range(pr, [&f, &parts, w](const range_t& range) {
+                std::vector<value_type> one_ret;
+                one_ret.reserve(range.second - range.first);
+                for (size_t ix = range.first; ix < range.second; ix++) {
+                    one_ret.emplace_back(f(ix));
+                }
+                parts[w].emplace_back(range.first, std::move(one_ret));
+            });
+        };
+        group.run_n(worker_num, body);
+        group.wait();
+        merge_partition_results(ret, parts);
     }
 
     return ret;
 }
 
+//----------------------------------------------------------------
+// 基于全局线程池的并行归约、扫描与排序
+// 各工作线程在本地累积结果，不生成中间结果数组；扫描结果直接写入调用方预分配的输出区间。
+// 迭代器均要求为随机访问迭代器。
+//----------------------------------------------------------------
+
+/** @cond internal */
+// 在全局线程池中执行 f(0), f(1), ..., f(n-1) 并等待全部完成，当前线程等待期间会协助执行任务
+template <typename FunctionType>
+void global_run_n(GlobalStealThreadPool& tg, size_t n, FunctionType&& f) {
+    GlobalTaskGroup group(&tg);
+    group.run_n(n, f);
+    group.wait();
+}
+/** @endcond */
+
+/**
+ * 使用全局线程池并行计算 reduce(init, transform(*first), ..., transform(*(last - 1)))
+ * @details
+ * 同 std::transform_reduce，合并顺序不确定，reduce 需满足结合律与交换律。
+ * 各工作线程按划分策略领取区间并在本地累积，最后由当前线程合并各工作线程的局部结果。
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param init 初始值
+ * @param reduce 二元归约操作
+ * @param transform 一元变换操作
+ * @param partitioner 划分策略
+ * @param threshold 元素数小于该阈值时直接在当前线程串行执行
+ * @return 归约结果
+ */
+template <typename Iterator, typename T, typename BinaryOp, typename UnaryOp>
+T global_parallel_transform_reduce(Iterator first, Iterator last, T init, BinaryOp reduce,
+                                   UnaryOp transform,
+                                   const Partitioner& partitioner = guided_partitioner(),
+                                   size_t threshold = 1024) {
+    HKU_IF_RETURN(first >= last, init);
+
+    size_t total = static_cast<size_t>(last - first);
+    if (total < threshold) {
+        for (; first != last; ++first) {
+            init = reduce(std::move(init), transform(*first));
+        }
+        return init;
+    }
+
+    auto* tg = get_global_task_group();
+    HKU_ASSERT(tg);
+
+    size_t worker_num = tg->worker_num();
+    PartitionRange pr(partitioner, 0, total, worker_num);
+    std::vector<std::optional<T>> partials(worker_num);
+    global_run_n(*tg, worker_num, [&](size_t w) {
+        // 在栈上累积，完成后再写回，避免相邻工作线程的局部结果伪共享
+        std::optional<T> local;
+        run_partition_range(pr, [&](const range_t& range) {
+            size_t i = range.first;
+            if (!local) {
+                local.emplace(transform(first[i++]));
+            }
+            for (; i < range.second; i++) {
+                *local = reduce(std::move(*local), transform(first[i]));
+            }
+        });
+        partials[w] = std::move(local);
+    });
+
+    for (auto& partial : partials) {
+        if (partial) {
+            init = reduce(std::move(init), std::move(*partial));
+        }
+    }
+    return init;
+}
+
+/**
+ * 使用全局线程池并行计算 op(init, *first, ..., *(last - 1))
+ * @details 同 std::reduce，合并顺序不确定，op 需满足结合律与交换律。
+ * @see global_parallel_transform_reduce
+ */
+template <typename Iterator, typename T, typename BinaryOp = std::plus<>>
+T global_parallel_reduce(Iterator first, Iterator last, T init, BinaryOp op = BinaryOp(),
+                         const Partitioner& partitioner = guided_partitioner(),
+                         size_t threshold = 1024) {
+    return global_parallel_transform_reduce(
+      first, last, std::move(init), op,
+      [](auto&& value) -> decltype(auto) { return std::forward<decltype(value)>(value); },
+      partitioner, threshold);
+}
+
+/**
+ * 使用全局线程池并行计算包含式前缀扫描，d_first[i] = op(*first, ..., *(first + i))
+ * @details
+ * 同 std::inclusive_scan，op 需满足结合律。输出区间由调用方预先分配，可与输入区间相同。
+ * 按工作线程数将输入均分为连续区间：第一遍各区间独立扫描并直接写入输出；
+ * 由当前线程依次求出各区间的前缀后，第二遍将前缀合并入除首区间外的各区间。
+ * @param first 输入起始迭代器
+ * @param last 输入结束迭代器
+ * @param d_first 输出起始迭代器
+ * @param op 二元操作
+ * @param threshold 元素数小于该阈值时直接在当前线程串行执行
+ * @return 输出区间的结束迭代器
+ */
+template <typename InputIt, typename OutputIt, typename BinaryOp = std::plus<>>
+OutputIt global_parallel_inclusive_scan(InputIt first, InputIt last, OutputIt d_first,
+                                        BinaryOp op = BinaryOp(), size_t threshold = 1024) {
+    typedef typename std::iterator_traits<InputIt>::value_type value_type;
+    HKU_IF_RETURN(first >= last, d_first);
+
+    size_t total = static_cast<size_t>(last - first);
+    if (total < threshold) {
+        return std::inclusive_scan(first, last, d_first, op);
+    }
+
+    auto* tg = get_global_task_group();
+    HKU_ASSERT(tg);
+
+    auto ranges = parallelIndexRange(0, total, tg->worker_num());
+    global_run_n(*tg, ranges.size(), [&](size_t k) {
+        std::inclusive_scan(first + ranges[k].first, first + ranges[k].second,
+                            d_first + ranges[k].first, op);
+    });
+
+    if (ranges.size() > 1) {
+        // carries[k] 为 ranges[k + 1] 之前全部元素的扫描结果
+        std::vector<value_type> carries;
+        carries.reserve(ranges.size() - 1);
+        carries.emplace_back(d_first[ranges[0].second - 1]);
+        for (size_t k = 1, count = ranges.size() - 1; k < count; k++) {
+            carries.emplace_back(op(carries.back(), d_first[ranges[k].second - 1]));
+        }
+
+        global_run_n(*tg, carries.size(), [&](size_t k) {
+            const value_type& carry = carries[k];
+            for (size_t i = ranges[k + 1].first; i < ranges[k + 1].second; i++) {
+                d_first[i] = op(carry, d_first[i]);
+            }
+        });
+    }
+
+    return d_first + total;
+}
+
+/**
+ * 使用全局线程池对 [first, last) 进行并行排序（不稳定）
+ * @details 按工作线程数将区间均分后各自排序，再逐轮并行归并相邻的有序区间。
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ * @param threshold 元素数小于该阈值时直接调用 std::sort
+ */
+template <typename Iterator, typename Compare = std::less<>>
+void global_parallel_sort(Iterator first, Iterator last, Compare comp = Compare(),
+                          size_t threshold = 4096) {
+    HKU_IF_RETURN(first >= last, void());
+
+    size_t total = static_cast<size_t>(last - first);
+    if (total < threshold) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    auto* tg = get_global_task_group();
+    HKU_ASSERT(tg);
+
+    auto ranges = parallelIndexRange(0, total, tg->worker_num());
+    global_run_n(*tg, ranges.size(), [&](size_t k) {
+        std::sort(first + ranges[k].first, first + ranges[k].second, comp);
+    });
+
+    while (ranges.size() > 1) {
+        size_t pairs = ranges.size() / 2;
+        global_run_n(*tg, pairs, [&](size_t k) {
+            const auto& left = ranges[2 * k];
+            const auto& right = ranges[2 * k + 1];
+            std::inplace_merge(first + left.first, first + right.first, first + right.second,
+                               comp);
+        });
+
+        std::vector<range_t> merged;
+        merged.reserve(pairs + 1);
+        for (size_t k = 0; k < pairs; k++) {
+            merged.emplace_back(ranges[2 * k].first, ranges[2 * k + 1].second);
+        }
+        if (ranges.size() % 2 == 1) {
+            merged.emplace_back(ranges.back());
+        }
+        ranges.swap(merged);
+    }
+}
+
 #if CPP_STANDARD >= CPP_STANDARD_20
 //----------------------------------------------------------------
 // 协程
@@ -689,6 +1376,42 @@ inline auto await_future<void>(std::shared_ptr<std::future<void>> fut_ptr)
     fut_ptr->get();  // 可能抛出异常
 }
 
+/**
+ * @brief AwaitableFuture 版本的 await_future（完成驱动，无轮询）
+ *
+ * 线程池 submit_awaitable 返回 AwaitableFuture，任务完成时由工作线程直接将协程的
+ * 恢复操作 post 至协程所属的 executor，相比 std::future 版本没有定时轮询带来的延迟和 CPU 开销。
+ *
+ * @code
+ *   asio::awaitable<void> example(ThreadPool& pool) {
+ *       int result = co_await await_future(pool.submit_awaitable([]() { return 42; }));
+ *   }
+ * @endcode
+ *
+ * @tparam T future 的返回值类型
+ * @param fut AwaitableFuture<T> 对象
+ * @return asio::awaitable<T> 可在协程中 co_await 的对象
+ */
+template <typename T>
+auto await_future(AwaitableFuture<T> fut) -> asio::awaitable<T> {
+    if (!fut.ready()) {
+        co_await asio::async_initiate<decltype(asio::use_awaitable), void()>(
+          [&fut](auto handler) {
+              auto io_exec = asio::get_associated_executor(handler);
+              fut.on_ready([handler = std::move(handler), io_exec]() mutable {
+                  asio::post(io_exec, std::move(handler));
+              });
+          },
+          asio::use_awaitable);
+    }
+
+    if constexpr (std::is_void_v<T>) {
+        fut.get();  // 可能抛出异常
+    } else {
+        co_return fut.get();  // 可能抛出异常
+    }
+}
+
 /**
  * @brief 在指定 executor 上异步执行函数，允许异常穿透（保留原始异常类型）
  *
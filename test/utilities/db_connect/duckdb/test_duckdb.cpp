@@ -13,6 +13,7 @@
 #include "hikyuu/utilities/os.h"
 #include "hikyuu/utilities/datetime/Datetime.h"
 #include "hikyuu/utilities/db_connect/TableMacro.h"
+#include "hikyuu/utilities/SpendTimer.h"
 #include <iostream>
 #include <chrono>
 
@@ -764,4 +765,281 @@ TEST_CASE("test_DuckDB_Datetime") {
     std::cout << "Datetime test completed successfully!" << std::endl;
 }
 
+namespace {
+struct QueryColumnsTestData {
+    std::vector<int64_t> id;
+    std::vector<double> price;
+    std::vector<std::string> name;
+
+    auto columns() {
+        return std::tie(id, price, name);
+    }
+};
+}  // namespace
+
+TEST_CASE("test_DuckDBConnect_queryColumns") {
+    Parameter param;
+    param.set<std::string>("db", ":memory:");
+    DuckDBConnectPtr driver = std::make_shared<DuckDBConnect>(param);
+    REQUIRE(driver);
+
+    driver->exec(
+      "CREATE TABLE columns_test (id INTEGER, price DECIMAL(10, 2), name VARCHAR, "
+      "created TIMESTAMP, day DATE, active BOOLEAN)");
+    driver->exec(
+      "INSERT INTO columns_test VALUES (1, 12.34, 'short', '2024-01-02 03:04:05', '2024-01-02', "
+      "true), (2, NULL, 'a string longer than twelve bytes', NULL, NULL, false), (3, 0.5, NULL, "
+      "'2024-06-15 08:15:30.123', '2024-06-15', NULL)");
+
+    /** @arg 多种类型及 NULL 值 */
+    std::vector<int> ids;
+    std::vector<double> prices;
+    std::vector<std::string> names;
+    std::vector<Datetime> created, days;
+    std::vector<bool> actives;
+    size_t rows = driver->queryColumns(
+      "SELECT id, price, name, created, day, active FROM columns_test ORDER BY id", ids, prices,
+      names, created, days, actives);
+    CHECK_EQ(rows, 3);
+    CHECK_EQ(ids, (std::vector<int>{1, 2, 3}));
+    CHECK_EQ(prices, (std::vector<double>{12.34, 0.0, 0.5}));
+    CHECK_EQ(names,
+             (std::vector<std::string>{"short", "a string longer than twelve bytes", ""}));
+    CHECK_EQ(created[0], Datetime(2024, 1, 2, 3, 4, 5));
+    CHECK_EQ(created[1], Null<Datetime>());
+    CHECK_EQ(created[2], Datetime(2024, 6, 15, 8, 15, 30, 123));
+    CHECK_EQ(days[0], Datetime(2024, 1, 2));
+    CHECK_EQ(days[1], Null<Datetime>());
+    CHECK_EQ(actives, (std::vector<bool>{true, false, false}));
+
+    /** @arg 再次查询时清除原有数据 */
+    rows = driver->queryColumns("SELECT id FROM columns_test WHERE id > 1", ids);
+    CHECK_EQ(rows, 2);
+    CHECK_EQ(ids, (std::vector<int>{2, 3}));
+
+    /** @arg 查询结果列数不足 */
+    CHECK_THROWS(driver->queryColumns("SELECT id FROM columns_test", ids, prices));
+    CHECK_THROWS(driver->queryColumns("SELECT id FROM nonexistent_table", ids));
+
+    /** @arg 跨多个数据块的结果集，结构体数组 */
+    QueryColumnsTestData soa;
+    rows = driver->queryColumns(
+      "SELECT i, i * 0.5, 'name_' || i::VARCHAR FROM range(5000) t(i) ORDER BY i", soa);
+    CHECK_EQ(rows, 5000);
+    REQUIRE_EQ(soa.id.size(), 5000);
+    REQUIRE_EQ(soa.name.size(), 5000);
+    for (int64_t i = 0; i < 5000; i++) {
+        CHECK_EQ(soa.id[i], i);
+        CHECK_EQ(soa.price[i], i * 0.5);
+        CHECK_EQ(soa.name[i], fmt::format("name_{}", i));
+    }
+
+    /** @arg 逐行读取跨越数据块边界 */
+    auto st =
+      driver->getStatement("SELECT i, 'name_' || i::VARCHAR FROM range(5000) t(i) ORDER BY i");
+    st->exec();
+    int64_t expect = 0;
+    while (st->moveNext()) {
+        int64_t id;
+        std::string name;
+        st->getColumn(0, id, name);
+        CHECK_EQ(id, expect);
+        CHECK_EQ(name, fmt::format("name_{}", expect));
+        expect++;
+    }
+    CHECK_EQ(expect, 5000);
+}
+
+/** @par 读取为文本时保持 DuckDB 自身的格式 */
+TEST_CASE("test_DuckDBStatement_getColumnAsText") {
+    Parameter param;
+    param.set<std::string>("db", ":memory:");
+    DuckDBConnectPtr driver = std::make_shared<DuckDBConnect>(param);
+    REQUIRE(driver);
+
+    auto st = driver->getStatement(
+      "SELECT TIMESTAMP '2024-01-02 03:04:05', TIMESTAMP '2024-06-15 08:15:30.5', "
+      "TIMESTAMP '2024-06-15 08:15:30.000123', '2024-06-15 08:15:30.123'::TIMESTAMP_MS, "
+      "'2024-06-15 08:15:30'::TIMESTAMP_S, '2024-06-15 08:15:30.123456789'::TIMESTAMP_NS, "
+      "'1969-12-31 23:59:59.999999999'::TIMESTAMP_NS, 'infinity'::TIMESTAMP, DATE '2024-01-02', "
+      "'abc', 42::UBIGINT, true");
+    st->exec();
+    REQUIRE(st->moveNext());
+
+    std::vector<std::string> expects{"2024-01-02 03:04:05",
+                                     "2024-06-15 08:15:30.5",
+                                     "2024-06-15 08:15:30.000123",
+                                     "2024-06-15 08:15:30.123",
+                                     "2024-06-15 08:15:30",
+                                     "2024-06-15 08:15:30.123456789",
+                                     "1969-12-31 23:59:59.999999999",
+                                     "infinity",
+                                     "2024-01-02",
+                                     "abc",
+                                     "42",
+                                     "true"};
+    REQUIRE_EQ(size_t(st->getNumColumns()), expects.size());
+    for (size_t i = 0; i < expects.size(); i++) {
+        std::string text;
+        st->getColumn(int(i), text);
+        CHECK_EQ(text, expects[i]);
+    }
+
+    /** @arg TIMESTAMP_TZ 按 UTC 输出 */
+    st = driver->getStatement("SELECT TIMESTAMPTZ '2024-01-02 03:04:05.25+00'");
+    st->exec();
+    REQUIRE(st->moveNext());
+    std::string text;
+    st->getColumn(0, text);
+    CHECK_EQ(text, "2024-01-02 03:04:05.25+00");
+
+    /** @arg 各数值及时间类型与 DuckDB 转换为 VARCHAR 的结果一致 */
+    driver->exec("CREATE TYPE mood AS ENUM ('sad', 'ok', 'happy')");
+    std::vector<std::string> values{
+      "-12::TINYINT",
+      "-1234::SMALLINT",
+      "123456::INTEGER",
+      "'-9223372036854775808'::BIGINT",
+      "255::UTINYINT",
+      "65535::USMALLINT",
+      "4294967295::UINTEGER",
+      "18446744073709551615::UBIGINT",
+      "-5::HUGEINT",
+      "170141183460469231731687303715884105727::HUGEINT",
+      "-170141183460469231731687303715884105727::HUGEINT - 1",
+      "(SELECT SUM(x) FROM (VALUES (9223372036854775807::BIGINT), (10::BIGINT)) t(x))",
+      "340282366920938463463374607431768211455::UHUGEINT",
+      "0.1::FLOAT",
+      "-1.5::FLOAT",
+      "1e7::FLOAT",
+      "3.4e38::FLOAT",
+      "1.0::DOUBLE",
+      "0.1::DOUBLE",
+      "123.456::DOUBLE",
+      "-0.0::DOUBLE",
+      "1e15::DOUBLE",
+      "1e16::DOUBLE",
+      "0.0001::DOUBLE",
+      "1e-5::DOUBLE",
+      "2.5e-10::DOUBLE",
+      "'inf'::DOUBLE",
+      "'-inf'::DOUBLE",
+      "'nan'::DOUBLE",
+      "1.50::DECIMAL(10, 2)",
+      "-0.05::DECIMAL(10, 2)",
+      "-1.5::DECIMAL(4, 1)",
+      "123::DECIMAL(5, 0)",
+      "1234567890123456.78::DECIMAL(18, 2)",
+      "12345678901234567890.123456::DECIMAL(38, 6)",
+      "-0.000001::DECIMAL(38, 6)",
+      "DATE '2024-01-02'",
+      "DATE '-0044-03-15'",
+      "DATE 'infinity'",
+      "DATE '-infinity'",
+      "TIME '12:34:56.789'",
+      "TIME '00:00:00'",
+      "TIMETZ '12:00:00+05:30'",
+      "TIMETZ '12:00:00-08'",
+      "TIMETZ '12:00:00.5+05:30:15'",
+      "TIMESTAMP '-0044-03-15 12:00:00'",
+      "TIMESTAMP '12345-01-01 00:00:00'",
+      "'-infinity'::TIMESTAMP",
+      "INTERVAL '1 year 2 months 3 days 04:05:06.789'",
+      "INTERVAL '0 seconds'",
+      "INTERVAL '-1 year'",
+      "INTERVAL '-3 days -01:00:00'",
+      "INTERVAL '1 month'",
+      "INTERVAL '100 hours'",
+      "INTERVAL '-00:00:00.5'",
+      "'a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11'::UUID",
+      "'00000000-0000-0000-0000-000000000000'::UUID",
+      "'ffffffff-ffff-ffff-ffff-ffffffffffff'::UUID",
+      "'happy'::mood"};
+    std::string sql = "SELECT ";
+    for (size_t i = 0; i < values.size(); i++) {
+        sql.append(fmt::format("{0}({1}), ({1})::VARCHAR", i > 0 ? ", " : "", values[i]));
+    }
+    st = driver->getStatement(sql);
+    st->exec();
+    REQUIRE(st->moveNext());
+    for (size_t i = 0; i < values.size(); i++) {
+        std::string expect;
+        st->getColumn(int(2 * i), text);
+        st->getColumn(int(2 * i + 1), expect);
+        CHECK_EQ(text, expect);
+    }
+
+    /** @arg 超出 int64 范围的整数读取为 int64 时抛出异常 */
+    st = driver->getStatement(
+      "SELECT 18446744073709551615::UBIGINT, 170141183460469231731687303715884105727::HUGEINT, "
+      "-9223372036854775808::HUGEINT, 9223372036854775807::UHUGEINT");
+    st->exec();
+    REQUIRE(st->moveNext());
+    int64_t x = 0;
+    CHECK_THROWS_AS(st->getColumn(0, x), SQLException);
+    CHECK_THROWS_AS(st->getColumn(1, x), SQLException);
+    st->getColumn(2, x);
+    CHECK_EQ(x, std::numeric_limits<int64_t>::min());
+    st->getColumn(3, x);
+    CHECK_EQ(x, std::numeric_limits<int64_t>::max());
+
+    /** @arg 嵌套类型不支持直接读取为文本，需在 SQL 中转换为 VARCHAR */
+    st = driver->getStatement("SELECT [1, 2], [1, 2]::VARCHAR");
+    st->exec();
+    REQUIRE(st->moveNext());
+    CHECK_THROWS_AS(st->getColumn(0, text), SQLException);
+    st->getColumn(1, text);
+    CHECK_EQ(text, "[1, 2]");
+
+    /** @arg 1970 年前的纳秒时间戳读取为 Datetime */
+    st = driver->getStatement("SELECT '1969-12-31 23:59:59.999999999'::TIMESTAMP_NS");
+    st->exec();
+    REQUIRE(st->moveNext());
+    Datetime date;
+    st->getColumn(0, date);
+    CHECK_EQ(date, Datetime(1969, 12, 31, 23, 59, 59, 999, 999));
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_DuckDBConnect_queryColumns_benchmark") {
+    Parameter param;
+    param.set<std::string>("db", ":memory:");
+    DuckDBConnectPtr driver = std::make_shared<DuckDBConnect>(param);
+    REQUIRE(driver);
+
+    size_t total = 1000000;
+    driver->exec(fmt::format(
+      "CREATE TABLE columns_bench AS SELECT i AS id, i * 0.01 AS price, "
+      "TIMESTAMP '2000-01-01' + INTERVAL (i) SECOND AS created FROM range({}) t(i)",
+      total));
+    std::string sql = "SELECT id, price, created FROM columns_bench";
+
+    std::vector<int64_t> ids;
+    std::vector<double> prices;
+    std::vector<Datetime> created;
+    {
+        BENCHMARK_TIME_MSG(test_DuckDBConnect_queryColumns_benchmark, 1,
+                           "read {} rows by getColumn", total);
+        auto st = driver->getStatement(sql);
+        st->exec();
+        while (st->moveNext()) {
+            int64_t id;
+            double price;
+            Datetime date;
+            st->getColumn(0, id, price, date);
+            ids.push_back(id);
+            prices.push_back(price);
+            created.push_back(date);
+        }
+    }
+    CHECK_EQ(ids.size(), total);
+
+    {
+        BENCHMARK_TIME_MSG(test_DuckDBConnect_queryColumns_benchmark, 1,
+                           "read {} rows by queryColumns", total);
+        CHECK_EQ(driver->queryColumns(sql, ids, prices, created), total);
+    }
+}
+#endif
+
 /** @} */
@@ -5,9 +5,10 @@
  *      Author: fasiondog
  */
 
-#include "doctest/doctest.h"
+#include "test_config.h"
 #include <hikyuu/utilities/arithmetic.h>
 #include <hikyuu/utilities/os.h>
+#include <hikyuu/utilities/SpendTimer.h>
 #include <hikyuu/utilities/db_connect/DBConnect.h>
 
 using namespace hku;
@@ -105,3 +106,143 @@ TEST_CASE("test_SQLResultSet") {
     CHECK_EQ(results[1].id(), 1447);
     CHECK_THROWS_AS(results.at(2), std::out_of_range);
 }
+
+namespace {
+struct KeysetTable {
+    TABLE_BIND2(KeysetTable, keyset_test, name, score)
+
+public:
+    KeysetTable(const std::string& name, int score) : name(name), score(score) {}
+
+    std::string name;
+    int score = 0;
+};
+
+std::shared_ptr<SQLiteConnect> createKeysetTable(const std::string& dbname, int total,
+                                                 int distinct) {
+    Parameter param;
+    param.set<std::string>("db", dbname);
+    param.set<int>("flags", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    auto con = std::make_shared<SQLiteConnect>(param);
+    if (con->tableExist("keyset_test")) {
+        con->exec("drop table keyset_test");
+    }
+    con->exec(
+      "create table keyset_test (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT, score "
+      "INTEGER NOT NULL)");
+    std::vector<KeysetTable> rows;
+    for (int i = 0; i < total; i++) {
+        rows.emplace_back(std::to_string(i), i % distinct);
+    }
+    con->batchSave(rows);
+    return con;
+}
+
+template <class ResultSet>
+std::vector<uint64_t> collectIds(ResultSet& results) {
+    std::vector<uint64_t> ids;
+    for (const auto& x : results) {
+        ids.push_back(x.id());
+    }
+    return ids;
+}
+}  // namespace
+
+TEST_CASE("test_SQLResultSet_keyset") {
+    std::string dbname = "sql_result_set_keyset.db";
+    // score 存在大量重复值，检验同值记录跨页时按 id 区分
+    auto con = createKeysetTable(dbname, 100, 7);
+
+    /** @arg 按 id 排序时与 OFFSET 分页结果一致 */
+    auto results = con->query<KeysetTable, 8>();
+    CHECK_UNARY_FALSE(results.keysetPagination());
+    std::vector<uint64_t> expect = collectIds(results);
+    CHECK_EQ(expect.size(), 100);
+    results.keysetPagination(true);
+    CHECK_UNARY(results.keysetPagination());
+    CHECK_EQ(collectIds(results), expect);
+
+    /** @arg 单列排序（含重复值及降序） */
+    for (const char* cond : {"score > 1 order by score", "1=1 order by `score` desc",
+                             "score < 5 ORDER BY id DESC"}) {
+        auto offset_results = con->query<KeysetTable, 8>(cond);
+        expect = collectIds(offset_results);
+        CHECK_UNARY_FALSE(expect.empty());
+        auto keyset_results = con->query<KeysetTable, 8>(cond);
+        keyset_results.keysetPagination(true);
+        CHECK_EQ(collectIds(keyset_results), expect);
+    }
+
+    /** @arg 随机访问时退回 OFFSET 分页 */
+    results = con->query<KeysetTable, 8>("1=1 order by score desc");
+    expect = collectIds(results);
+    results.keysetPagination(true);
+    CHECK_EQ(results[50].id(), expect[50]);
+    CHECK_EQ(results[10].id(), expect[10]);
+    CHECK_EQ(results[17].id(), expect[17]);
+    CHECK_EQ(results.getPage(3).front().id(), expect[24]);
+
+    /** @arg 多列排序不支持键集分页，仍使用 OFFSET */
+    results = con->query<KeysetTable, 8>("1=1 order by score, name");
+    expect = collectIds(results);
+    results.keysetPagination(true);
+    CHECK_EQ(collectIds(results), expect);
+
+    /** @arg 上一页最后记录在翻页前被删除或修改排序列时，改用 OFFSET 读取 */
+    results = con->query<KeysetTable, 8>("1=1 order by score");
+    results.keysetPagination(true);
+    auto page = results.getPage(0);
+    REQUIRE_EQ(page.size(), 8);
+    con->exec(fmt::format("delete from keyset_test where id={}", page.back().id()));
+    auto expect_page = con->query<KeysetTable, 8>("1=1 order by score").getPage(1);
+    page = results.getPage(1);
+    REQUIRE_EQ(page.size(), expect_page.size());
+    for (size_t i = 0; i < page.size(); i++) {
+        CHECK_EQ(page[i].id(), expect_page[i].id());
+    }
+    con->exec(fmt::format("update keyset_test set score=100 where id={}", page.back().id()));
+    expect_page = con->query<KeysetTable, 8>("1=1 order by score").getPage(2);
+    page = results.getPage(2);
+    REQUIRE_EQ(page.size(), expect_page.size());
+    for (size_t i = 0; i < page.size(); i++) {
+        CHECK_EQ(page[i].id(), expect_page[i].id());
+    }
+
+    /** @arg 使用独立连接后台预读下一页 */
+    Parameter param;
+    param.set<std::string>("db", dbname);
+    auto prefetch_con = std::make_shared<SQLiteConnect>(param);
+    results = con->query<KeysetTable, 8>("1=1 order by score desc");
+    expect = collectIds(results);
+    results.keysetPagination(true);
+    results.readAhead(prefetch_con);
+    CHECK_EQ(results.readAhead(), prefetch_con);
+    CHECK_EQ(collectIds(results), expect);
+    CHECK_EQ(collectIds(results), expect);
+    CHECK_UNARY(prefetch_con->statementCacheHits() > 0);
+
+    con->exec("drop table keyset_test");
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_SQLResultSet_keyset_benchmark") {
+    int total = 200000;
+    auto con = createKeysetTable("sql_result_set_keyset_benchmark.db", total, total / 2);
+    con->exec("create index keyset_test_score on keyset_test (score, id)");
+    for (const char* cond : {"1=1", "1=1 order by score desc"}) {
+        for (bool keyset : {false, true}) {
+            auto results = con->query<KeysetTable, 100>(cond);
+            results.keysetPagination(keyset);
+            BENCHMARK_TIME_MSG(test_SQLResultSet_keyset_benchmark, 1,
+                               "iterate {} rows ({}), page size 100, keyset: {}", total, cond,
+                               keyset);
+            size_t count = 0;
+            for (const auto& x : results) {
+                count += x.valid() ? 1 : 0;
+            }
+            CHECK_EQ(count, total);
+        }
+    }
+    con->exec("drop table keyset_test");
+}
+#endif
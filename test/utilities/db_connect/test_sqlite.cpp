@@ -5,12 +5,15 @@
  *      Author: fasiondog
  */
 
-#include "doctest/doctest.h"
+#include "test_config.h"
+#include <atomic>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <hikyuu/utilities/ResourcePool.h>
 #include <hikyuu/utilities/Null.h>
 #include <hikyuu/utilities/os.h>
+#include <hikyuu/utilities/SpendTimer.h>
 #include <hikyuu/utilities/db_connect/DBConnect.h>
 
 using namespace hku;
@@ -224,4 +227,337 @@ TEST_CASE("test_sqlite_backup") {
 
     CHECK(con->backup("test_data/tmp/backup_test.db.bak1", 5, 5));
     CHECK(con->backup("test_data/tmp/backup_test.db.bak2", -1));
-}
\ No newline at end of file
+}
+
+TEST_CASE("test_sqlite_statement_cache") {
+    createDir("测试");
+    Parameter param;
+    param.set<std::string>("db", "测试/statement_cache.db");
+    param.set<int>("flags", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    auto con = std::make_shared<SQLiteConnect>(param);
+    CHECK_EQ(con->statementCacheCapacity(), 32);
+
+    if (con->tableExist("stmt_cache")) {
+        con->exec("drop table stmt_cache");
+    }
+    con->exec("create table stmt_cache (id INTEGER, name TEXT)");
+    CHECK_EQ(con->statementCacheSize(), 0);
+    uint64_t hits = con->statementCacheHits();
+    uint64_t misses = con->statementCacheMisses();
+
+    // 相同的 SQL 复用已预编译的语句
+    std::string insert_sql("insert into stmt_cache (id, name) values (?, ?)");
+    for (int i = 0; i < 10; i++) {
+        SQLStatementPtr st = con->getStatement(insert_sql);
+        st->bind(0, i, std::to_string(i));
+        st->exec();
+    }
+    CHECK_EQ(con->statementCacheMisses() - misses, 1);
+    CHECK_EQ(con->statementCacheHits() - hits, 9);
+    CHECK_EQ(con->queryNumber<int>("select count(1) from stmt_cache"), 10);
+
+    // 复用时已清除上次绑定的参数
+    {
+        SQLStatementPtr st = con->getStatement(insert_sql);
+        st->exec();
+    }
+    CHECK_EQ(con->queryNumber<int>("select count(1) from stmt_cache where id is null"), 1);
+
+    // 未遍历完的查询语句在释放后被重置，复用时从头开始
+    std::string select_sql("select id from stmt_cache where id is not null order by id");
+    {
+        SQLStatementPtr st = con->getStatement(select_sql);
+        st->exec();
+        CHECK(st->moveNext());
+        CHECK(st->moveNext());
+    }
+    {
+        SQLStatementPtr st = con->getStatement(select_sql);
+        st->exec();
+        CHECK(st->moveNext());
+        int id = -1;
+        st->getColumn(0, id);
+        CHECK_EQ(id, 0);
+
+        // 仍在使用中的语句不会被重复使用
+        SQLStatementPtr st2 = con->getStatement(select_sql);
+        CHECK_NE(st.get(), st2.get());
+        st2->exec();
+        CHECK(st2->moveNext());
+        st2->getColumn(0, id);
+        CHECK_EQ(id, 0);
+        CHECK(st->moveNext());
+        st->getColumn(0, id);
+        CHECK_EQ(id, 1);
+    }
+
+    // 变更表结构时清空缓存
+    CHECK_UNARY(con->statementCacheSize() > 0);
+    con->exec("alter table stmt_cache add column age INTEGER");
+    CHECK_EQ(con->statementCacheSize(), 0);
+
+    // 关闭缓存
+    con->statementCacheCapacity(0);
+    misses = con->statementCacheMisses();
+    hits = con->statementCacheHits();
+    for (int i = 0; i < 3; i++) {
+        con->queryNumber<int>("select count(1) from stmt_cache");
+    }
+    CHECK_EQ(con->statementCacheMisses() - misses, 3);
+    CHECK_EQ(con->statementCacheHits() - hits, 0);
+    CHECK_EQ(con->statementCacheSize(), 0);
+
+    con->exec("drop table stmt_cache");
+}
+
+namespace {
+struct BatchInsertRow {
+    TABLE_BIND2(BatchInsertRow, batch_insert, name, value)
+
+public:
+    BatchInsertRow(const std::string& name, int64_t value) : name(name), value(value) {}
+
+    std::string name;
+    int64_t value = 0;
+};
+}  // namespace
+
+TEST_CASE("test_sqlite_batch_insert") {
+    /** @arg 单行 INSERT 语句的拆分与多行拼接 */
+    SQLInsertTemplate insert;
+    CHECK_UNARY(insert.parse("insert into `t` (`a`,`b`) VALUES (?,?);"));
+    CHECK_EQ(insert.params, 2);
+    CHECK_EQ(insert.build(3), "insert into `t` (`a`,`b`) VALUES (?,?),(?,?),(?,?)");
+    CHECK_UNARY(insert.simple());
+    CHECK_UNARY(insert.parse("insert into t (a) values(?) on conflict do nothing"));
+    CHECK_EQ(insert.build(2), "insert into t (a) values(?),(?) on conflict do nothing");
+    CHECK_UNARY_FALSE(insert.parse("insert into t (a) values ('x')"));
+    CHECK_UNARY_FALSE(insert.parse("insert into t (a) select a from t2"));
+
+    /** @arg 带冲突处理的语句无法推算各记录的 rowid，不合并插入 */
+    for (const char* sql : {"insert into t (a) values(?) on conflict do nothing",
+                            "INSERT OR IGNORE INTO t (a) VALUES (?)",
+                            "insert ignore into t (a) values (?)", "REPLACE INTO t (a) VALUES (?)",
+                            "insert into t (a) values (?) on duplicate key update a=values(a)"}) {
+        CHECK_UNARY_FALSE(insert.parse(sql) && insert.simple());
+    }
+
+    createDir("测试");
+    Parameter param;
+    param.set<std::string>("db", "测试/batch_insert.db");
+    param.set<int>("flags", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    /** @arg 默认逐条插入 */
+    CHECK_EQ(std::make_shared<SQLiteConnect>(param)->batchInsertRows(), 1);
+
+    param.set<int>("batch_insert_rows", 7);
+    auto con = std::make_shared<SQLiteConnect>(param);
+    CHECK_EQ(con->batchInsertRows(), 7);
+
+    if (con->tableExist("batch_insert")) {
+        con->exec("drop table batch_insert");
+    }
+    con->exec(
+      R"(CREATE TABLE "batch_insert" (
+            "id"	INTEGER UNIQUE,
+            "name"	TEXT,
+            "value"	INTEGER,
+            PRIMARY KEY("id" AUTOINCREMENT)
+        );)");
+
+    /** @arg 多行 INSERT 分块插入，rowid 与表中记录一致 */
+    std::vector<BatchInsertRow> rows;
+    for (int i = 0; i < 30; i++) {
+        rows.emplace_back(std::to_string(i), i);
+    }
+    con->batchSave(rows);
+    CHECK_EQ(con->queryNumber<int>("select count(1) from batch_insert"), 30);
+    for (const auto& row : rows) {
+        CHECK_EQ(con->queryNumber<int64_t>(
+                   fmt::format("select value from batch_insert where id={}", row.id())),
+                 row.value);
+    }
+
+    /** @arg 逐条插入时结果相同 */
+    con->batchInsertRows(1);
+    std::vector<BatchInsertRow> rows2;
+    for (int i = 30; i < 33; i++) {
+        rows2.emplace_back(std::to_string(i), i);
+    }
+    con->batchSave(rows2);
+    CHECK_EQ(rows2[0].id(), rows.back().id() + 1);
+    CHECK_EQ(rows2[2].id(), rows.back().id() + 3);
+
+    /** @arg 插入失败时回滚整批记录 */
+    con->batchInsertRows(500);
+    con->exec("create unique index batch_insert_name on batch_insert (name)");
+    std::vector<BatchInsertRow> rows3;
+    rows3.emplace_back("new", 100);
+    rows3.emplace_back("0", 101);
+    CHECK_THROWS(con->batchSave(rows3));
+    CHECK_EQ(con->queryNumber<int>("select count(1) from batch_insert"), 33);
+
+    con->exec("drop table batch_insert");
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_sqlite_batch_insert_benchmark") {
+    createDir("测试");
+    Parameter param;
+    param.set<std::string>("db", "测试/batch_insert_benchmark.db");
+    param.set<int>("flags", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    auto con = std::make_shared<SQLiteConnect>(param);
+
+    size_t total = 1000000;
+    std::vector<BatchInsertRow> rows;
+    rows.reserve(total);
+    for (size_t i = 0; i < total; i++) {
+        rows.emplace_back(std::to_string(i), i);
+    }
+
+    for (size_t batch_rows : {1, 50, 500}) {
+        if (con->tableExist("batch_insert")) {
+            con->exec("drop table batch_insert");
+        }
+        con->exec(
+          "create table batch_insert (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT, value "
+          "INTEGER)");
+        con->batchInsertRows(batch_rows);
+        BENCHMARK_TIME_MSG(test_sqlite_batch_insert_benchmark, 1,
+                           "sqlite batchSave {} rows, batch_insert_rows: {}", total, batch_rows);
+        con->batchSave(rows);
+    }
+    con->exec("drop table batch_insert");
+}
+#endif
+
+TEST_CASE("test_sqlite_row_cursor") {
+    createDir("测试");
+    Parameter param;
+    param.set<std::string>("db", "测试/row_cursor.db");
+    param.set<int>("flags", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    auto con = std::make_shared<SQLiteConnect>(param);
+    if (con->tableExist("batch_insert")) {
+        con->exec("drop table batch_insert");
+    }
+    con->exec(
+      "create table batch_insert (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT, value "
+      "INTEGER)");
+    std::vector<BatchInsertRow> rows;
+    for (int i = 0; i < 1000; i++) {
+        rows.emplace_back(std::to_string(i), i);
+    }
+    con->batchSave(rows);
+
+    /** @arg 游标逐行读取，可移出行对象 */
+    std::vector<BatchInsertRow> result;
+    for (auto& row : con->cursor<BatchInsertRow>("value < 10 order by id")) {
+        result.push_back(std::move(row));
+    }
+    REQUIRE_EQ(result.size(), 10);
+    for (size_t i = 0; i < result.size(); i++) {
+        CHECK_EQ(result[i].id(), rows[i].id());
+        CHECK_EQ(result[i].name, rows[i].name);
+        CHECK_EQ(result[i].value, rows[i].value);
+    }
+
+    /** @arg 复用同一行对象 */
+    auto cursor = con->cursorView<BatchInsertRow>(
+      "select id, name, value from batch_insert where value >= 990 order by id", true);
+    const BatchInsertRow* addr = nullptr;
+    int64_t expect = 990;
+    for (auto iter = cursor.begin(); iter != cursor.end(); ++iter) {
+        if (!addr) {
+            addr = &(*iter);
+        }
+        CHECK_EQ(&(*iter), addr);
+        CHECK_EQ(iter->value, expect++);
+    }
+    CHECK_EQ(cursor.count(), 10);
+
+    /** @arg 无结果 */
+    auto empty = con->cursor<BatchInsertRow>("value < 0");
+    CHECK_UNARY(empty.begin() == empty.end());
+
+    /** @arg 逐行处理 */
+    int64_t sum = 0;
+    size_t count = con->forEachRow<BatchInsertRow>(
+      "", [&sum](BatchInsertRow& row) { sum += row.value; }, true);
+    CHECK_EQ(count, 1000);
+    CHECK_EQ(sum, 999 * 1000 / 2);
+
+    /** @arg 并行处理，队列容量小于数据批数 */
+    std::atomic<int64_t> parallel_sum{0};
+    count = con->forEachRowParallel<BatchInsertRow>(
+      "value > 0", [&parallel_sum](BatchInsertRow& row) { parallel_sum += row.value; }, 3, 2,
+      16);
+    CHECK_EQ(count, 999);
+    CHECK_EQ(parallel_sum, 999 * 1000 / 2);
+
+    /** @arg 处理函数抛出异常时停止读取并传递异常 */
+    std::atomic<int> processed{0};
+    CHECK_THROWS_AS(con->forEachRowParallel<BatchInsertRow>(
+                      "",
+                      [&processed](BatchInsertRow& row) {
+                          processed++;
+                          HKU_CHECK_THROW(row.value != 100, std::runtime_error, "failed");
+                      },
+                      2, 2, 10),
+                    std::runtime_error);
+    CHECK_LT(processed, 1000);
+
+    con->exec("drop table batch_insert");
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_sqlite_row_cursor_benchmark") {
+    createDir("测试");
+    Parameter param;
+    param.set<std::string>("db", "测试/row_cursor_benchmark.db");
+    param.set<int>("flags", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    auto con = std::make_shared<SQLiteConnect>(param);
+    if (con->tableExist("batch_insert")) {
+        con->exec("drop table batch_insert");
+    }
+    con->exec(
+      "create table batch_insert (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT, value "
+      "INTEGER)");
+    size_t total = 1000000;
+    {
+        std::vector<BatchInsertRow> rows;
+        rows.reserve(total);
+        for (size_t i = 0; i < total; i++) {
+            rows.emplace_back(fmt::format("name-of-row-{:032}", i), i);
+        }
+        con->batchSave(rows);
+    }
+
+    // 峰值内存以同时持有的行对象数衡量：batchLoad 为全部行，游标为 1 行，并行为队列容量对应的行数
+    int64_t sum = 0;
+    {
+        BENCHMARK_TIME_MSG(test_sqlite_row_cursor_benchmark, 1,
+                           "batchLoad {} rows, rows held: {}", total, total);
+        std::vector<BatchInsertRow> rows;
+        con->batchLoad(rows);
+        for (const auto& row : rows) {
+            sum += row.value;
+        }
+    }
+    for (bool reuse : {false, true}) {
+        BENCHMARK_TIME_MSG(test_sqlite_row_cursor_benchmark, 1,
+                           "forEachRow {} rows, reuse: {}, rows held: 1", total, reuse);
+        con->forEachRow<BatchInsertRow>(
+          "", [&sum](BatchInsertRow& row) { sum += row.value; }, reuse);
+    }
+    {
+        BENCHMARK_TIME_MSG(test_sqlite_row_cursor_benchmark, 1,
+                           "forEachRowParallel {} rows, 4 workers, rows held: <= {}", total,
+                           (16 + 4 + 1) * 256);
+        std::atomic<int64_t> parallel_sum{0};
+        con->forEachRowParallel<BatchInsertRow>(
+          "", [&parallel_sum](BatchInsertRow& row) { parallel_sum += row.value; }, 4);
+    }
+    CHECK_UNARY(sum > 0);
+    con->exec("drop table batch_insert");
+}
+#endif
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <hikyuu/utilities/FlatLruCache.h>
+#include <hikyuu/utilities/LRUCache11.h>
+#include <hikyuu/utilities/SpendTimer.h>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_FlatLruCache test_hikyuu_FlatLruCache
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_FlatLruCache_basic") {
+    FlatLruCache<int, std::string> cache(100, 0);
+    CHECK_EQ(cache.capacity(), 100);
+    CHECK_EQ(cache.overflow(), 0);
+    CHECK_UNARY(cache.empty());
+    CHECK_UNARY_FALSE(cache.contains(1));
+
+    cache.insert(1, "one");
+    std::string two("two");
+    cache.insert(2, std::move(two));
+    CHECK_EQ(cache.size(), 2);
+    CHECK_EQ(cache.get(1), "one");
+    CHECK_EQ(cache.get(2), "two");
+    CHECK_EQ(cache.get(3), "");
+    CHECK_UNARY(cache.contains(1));
+
+    std::string value;
+    CHECK_UNARY(cache.tryGet(1, value));
+    CHECK_EQ(value, "one");
+    CHECK_UNARY_FALSE(cache.tryGet(4, value));
+
+    /** @arg 更新已存在的键 */
+    cache.insert(1, "ONE");
+    CHECK_EQ(cache.get(1), "ONE");
+    CHECK_EQ(cache.size(), 2);
+
+    CHECK_UNARY(cache.remove(1));
+    CHECK_UNARY_FALSE(cache.remove(1));
+    CHECK_UNARY_FALSE(cache.contains(1));
+    CHECK_EQ(cache.size(), 1);
+
+    cache.clear();
+    CHECK_UNARY(cache.empty());
+    cache.insert(3, "three");
+    CHECK_EQ(cache.get(3), "three");
+}
+
+/** @par 检测点 */
+TEST_CASE("test_FlatLruCache_eviction") {
+    /** @arg 超出容量时淘汰最久未使用的元素 */
+    FlatLruCache<int, int> cache(3, 0);
+    cache.insert(1, 1);
+    cache.insert(2, 2);
+    cache.insert(3, 3);
+    cache.insert(4, 4);
+    CHECK_EQ(cache.size(), 3);
+    CHECK_UNARY_FALSE(cache.contains(1));
+
+    /** @arg 被读取过的元素在淘汰时获得第二次机会 */
+    CHECK_EQ(cache.get(2), 2);
+    cache.insert(5, 5);
+    CHECK_UNARY(cache.contains(2));
+    CHECK_UNARY_FALSE(cache.contains(3));
+
+    /** @arg 溢出容量：超出容量+溢出容量时才淘汰，并淘汰至容量大小 */
+    FlatLruCache<int, int> overflow_cache(4, 2);
+    for (int i = 0; i < 6; i++) {
+        overflow_cache.insert(i, i);
+    }
+    CHECK_EQ(overflow_cache.size(), 6);
+    overflow_cache.insert(6, 6);
+    CHECK_EQ(overflow_cache.size(), 4);
+    CHECK_UNARY(overflow_cache.contains(6));
+    CHECK_UNARY_FALSE(overflow_cache.contains(0));
+
+    /** @arg 调整容量 */
+    overflow_cache.setOverflow(0);
+    overflow_cache.resize(2);
+    CHECK_EQ(overflow_cache.size(), 2);
+    CHECK_UNARY(overflow_cache.contains(6));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_FlatLruCache_random") {
+    /** @arg 随机插入删除，内容与 std::map 一致，节点复用后内存不再增长 */
+    FlatLruCache<int, int> cache(0);
+    std::map<int, int> expect;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> key_dist(0, 2000);
+    size_t memory = 0;
+    for (int i = 0; i < 200000; i++) {
+        int key = key_dist(rng);
+        if (rng() % 2 == 0) {
+            cache.insert(key, i);
+            expect[key] = i;
+        } else {
+            CHECK_EQ(cache.remove(key), expect.erase(key) == 1);
+        }
+        if (i == 100000) {
+            memory = cache.memoryUsage();
+        }
+    }
+    CHECK_EQ(cache.size(), expect.size());
+    for (int key = 0; key <= 2000; key++) {
+        auto iter = expect.find(key);
+        int value = -1;
+        CHECK_EQ(cache.tryGet(key, value), iter != expect.end());
+        if (iter != expect.end()) {
+            CHECK_EQ(value, iter->second);
+        }
+    }
+    CHECK_EQ(cache.memoryUsage(), memory);
+
+    /** @arg 预分配后插入不再增长内存 */
+    FlatLruCache<int, int> reserved(1000, 0);
+    reserved.reserve(1000);
+    memory = reserved.memoryUsage();
+    for (int i = 0; i < 10000; i++) {
+        reserved.insert(i, i);
+    }
+    CHECK_EQ(reserved.size(), 1000);
+    CHECK_EQ(reserved.memoryUsage(), memory);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_FlatLruCache_thread_safety") {
+    FlatLruCache<int, int, std::shared_mutex> cache(0);
+    const int num_threads = 8;
+    const int ops_per_thread = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([t, &cache]() {
+            for (int i = 0; i < ops_per_thread; i++) {
+                int key = t * ops_per_thread + i;
+                cache.insert(key, key * 2);
+                int value = 0;
+                cache.tryGet(key, value);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    CHECK_EQ(cache.size(), num_threads * ops_per_thread);
+    for (int key = 0; key < num_threads * ops_per_thread; key++) {
+        CHECK_EQ(cache.get(key), key * 2);
+    }
+}
+
+#if ENABLE_BENCHMARK_TEST
+/** @par 检测点 */
+TEST_CASE("test_FlatLruCache_benchmark") {
+    // LruCache 每次插入需遍历链表查找脏节点，百万级条目下构建耗时过长，此处仅与 LRUCache11 对比
+    const int num = 1000000;
+    std::vector<int> keys(num);
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> dist(0, num - 1);
+    for (auto& key : keys) {
+        key = dist(rng);
+    }
+
+    {
+        lru11::Cache<int, int> cache(num, 0);
+        {
+            BENCHMARK_TIME_MSG(flat_lru_insert, 1, "LRUCache11 insert {} entries", num);
+            for (int i = 0; i < num; i++) {
+                cache.insert(i, i);
+            }
+        }
+        int64_t sum = 0;
+        {
+            BENCHMARK_TIME_MSG(flat_lru_get, 1, "LRUCache11 lookup {} times", num);
+            int value = 0;
+            for (int key : keys) {
+                cache.tryGet(key, value);
+                sum += value;
+            }
+        }
+        // std::list 节点（两个指针 + 键值对）+ unordered_map 节点（next 指针 + 键 + 链表迭代器）
+        // + 桶数组，未计入分配器的额外开销
+        using Cache = lru11::Cache<int, int>;
+        size_t per_entry = 2 * sizeof(void*) + sizeof(Cache::node_type) + sizeof(void*) +
+                           sizeof(Cache::map_type::value_type);
+        HKU_INFO("LRUCache11 memory per entry: ~{} bytes (sum: {})", per_entry + sizeof(void*),
+                 sum);
+    }
+
+    {
+        FlatLruCache<int, int> cache(num, 0);
+        {
+            BENCHMARK_TIME_MSG(flat_lru_insert, 1, "FlatLruCache insert {} entries", num);
+            for (int i = 0; i < num; i++) {
+                cache.insert(i, i);
+            }
+        }
+        int64_t sum = 0;
+        {
+            BENCHMARK_TIME_MSG(flat_lru_get, 1, "FlatLruCache lookup {} times", num);
+            int value = 0;
+            for (int key : keys) {
+                cache.tryGet(key, value);
+                sum += value;
+            }
+        }
+        HKU_INFO("FlatLruCache memory per entry: {:.1f} bytes (sum: {})",
+                 double(cache.memoryUsage()) / num, sum);
+
+        FlatLruCache<int, int> reserved(num, 0);
+        reserved.reserve(num);
+        HKU_INFO("FlatLruCache memory per entry after reserve: {:.1f} bytes",
+                 double(reserved.memoryUsage()) / num);
+    }
+}
+#endif
+
+/** @} */
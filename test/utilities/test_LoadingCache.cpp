@@ -0,0 +1,262 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <hikyuu/utilities/LoadingCache.h>
+#include <hikyuu/utilities/thread/thread.h>
+
+using namespace hku;
+using namespace std::chrono_literals;
+
+/**
+ * @defgroup test_hikyuu_LoadingCache test_hikyuu_LoadingCache
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_LoadingCache_basic") {
+    LoadingCache<int, std::string> cache(10);
+    std::atomic<int> calls{0};
+    auto loader = [&calls](const int& key) {
+        calls++;
+        return std::to_string(key);
+    };
+
+    /** @arg 未命中时加载，之后命中缓存 */
+    CHECK_EQ(cache.get_or_load(1, loader), "1");
+    CHECK_EQ(cache.get_or_load(1, loader), "1");
+    CHECK_EQ(calls, 1);
+    CHECK_EQ(cache.loadCount(), 1);
+    CHECK_EQ(cache.size(), 1);
+
+    std::string value;
+    CHECK_UNARY(cache.tryGet(1, value));
+    CHECK_EQ(value, "1");
+    CHECK_UNARY_FALSE(cache.tryGet(2, value));
+
+    /** @arg 直接放入与失效 */
+    cache.insert(2, "two");
+    CHECK_EQ(cache.get_or_load(2, loader), "two");
+    CHECK_EQ(calls, 1);
+    cache.invalidate(2);
+    CHECK_EQ(cache.get_or_load(2, loader), "2");
+    CHECK_EQ(calls, 2);
+
+    /** @arg 未设置执行器时异步加载在当前线程完成 */
+    auto future = cache.get_or_load_async(3, loader);
+    CHECK_UNARY(future.ready());
+    CHECK_EQ(future.get(), "3");
+
+    /** @arg 加载失败时异常传递给调用者，未开启失败缓存时下次重新加载 */
+    auto failed_loader = [&calls](const int&) -> std::string {
+        calls++;
+        throw std::runtime_error("load failed");
+    };
+    calls = 0;
+    CHECK_THROWS_AS(cache.get_or_load(4, failed_loader), std::runtime_error);
+    CHECK_THROWS_AS(cache.get_or_load(4, failed_loader), std::runtime_error);
+    CHECK_EQ(calls, 2);
+    CHECK_UNARY_FALSE(cache.tryGet(4, value));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_LoadingCache_coalescing") {
+    /** @arg 多个线程并发未命中同一键时只加载一次 */
+    LoadingCache<int, int> cache(10);
+    std::atomic<int> calls{0};
+    auto loader = [&calls](const int& key) {
+        calls++;
+        std::this_thread::sleep_for(50ms);
+        return key * 10;
+    };
+
+    std::vector<std::thread> threads;
+    std::atomic<int> right{0};
+    for (int i = 0; i < 8; i++) {
+        threads.emplace_back([&]() {
+            if (cache.get_or_load(7, loader) == 70) {
+                right++;
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    CHECK_EQ(calls, 1);
+    CHECK_EQ(right, 8);
+    CHECK_EQ(cache.loadCount(), 1);
+
+    /** @arg 加载失败时所有等待者收到同一异常 */
+    calls = 0;
+    uint64_t coalesced = cache.coalescedCount();
+    auto failed_loader = [&calls](const int&) -> int {
+        calls++;
+        std::this_thread::sleep_for(50ms);
+        throw std::runtime_error("load failed");
+    };
+    threads.clear();
+    std::atomic<int> failed{0};
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&]() {
+            try {
+                cache.get_or_load(8, failed_loader);
+            } catch (const std::runtime_error&) {
+                failed++;
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    CHECK_EQ(failed, 4);
+    CHECK_LE(calls, 4);
+    CHECK_EQ(calls + cache.coalescedCount() - coalesced, 4);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_LoadingCache_negative") {
+    /** @arg 失败缓存期间直接抛出上次的异常，过期后重新加载 */
+    LoadingCache<int, int> cache(10);
+    cache.setNegativeTTL(50ms);
+    CHECK_EQ(cache.negativeTTL().count(), 50);
+
+    int calls = 0;
+    bool fail = true;
+    auto loader = [&calls, &fail](const int& key) {
+        calls++;
+        if (fail) {
+            throw std::runtime_error("load failed");
+        }
+        return key;
+    };
+    CHECK_THROWS_AS(cache.get_or_load(1, loader), std::runtime_error);
+    CHECK_THROWS_AS(cache.get_or_load(1, loader), std::runtime_error);
+    CHECK_THROWS_AS(cache.get_or_load_async(1, loader).get(), std::runtime_error);
+    CHECK_EQ(calls, 1);
+
+    fail = false;
+    std::this_thread::sleep_for(80ms);
+    CHECK_EQ(cache.get_or_load(1, loader), 1);
+    CHECK_EQ(calls, 2);
+
+    /** @arg 直接放入值时清除失败记录 */
+    fail = true;
+    CHECK_THROWS_AS(cache.get_or_load(2, loader), std::runtime_error);
+    cache.insert(2, 20);
+    CHECK_EQ(cache.get_or_load(2, loader), 20);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_LoadingCache_ttl_refresh") {
+    ThreadPool pool(2);
+    LoadingCache<int, int> cache(10);
+    cache.setExecutor([&pool](std::function<void()> task) { pool.submit(std::move(task)); });
+    cache.setTTL(300ms);
+    cache.setRefreshAhead(200ms);
+    CHECK_EQ(cache.ttl().count(), 300);
+    CHECK_EQ(cache.refreshAhead().count(), 200);
+
+    std::atomic<int> version{0};
+    auto loader = [&version](const int&) { return ++version; };
+
+    /** @arg 距过期不足提前量时返回旧值并在后台刷新 */
+    CHECK_EQ(cache.get_or_load(1, loader), 1);
+    CHECK_EQ(cache.get_or_load(1, loader), 1);
+    std::this_thread::sleep_for(150ms);
+    CHECK_EQ(cache.get_or_load(1, loader), 1);
+    for (int i = 0; i < 100 && cache.loadCount() < 2; i++) {
+        std::this_thread::sleep_for(5ms);
+    }
+    std::this_thread::sleep_for(20ms);
+    CHECK_EQ(cache.get_or_load(1, loader), 2);
+
+    /** @arg 过期后重新加载 */
+    cache.setRefreshAhead(0ms);
+    std::this_thread::sleep_for(350ms);
+    CHECK_EQ(cache.get_or_load(1, loader), 3);
+
+    /** @arg 通过执行器异步加载，并发请求合并为一次加载，各自得到结果 */
+    std::atomic<int> calls{0};
+    auto slow_loader = [&calls](const int& key) {
+        calls++;
+        std::this_thread::sleep_for(20ms);
+        return key * 100;
+    };
+    uint64_t coalesced = cache.coalescedCount();
+    auto future = cache.get_or_load_async(2, slow_loader);
+    auto other = cache.get_or_load_async(2, slow_loader);
+    std::promise<void> notified;
+    other.on_ready([&notified]() { notified.set_value(); });
+    CHECK_EQ(future.get(), 200);
+    notified.get_future().wait();
+    CHECK_EQ(other.get(), 200);
+    CHECK_EQ(calls, 1);
+    CHECK_EQ(cache.coalescedCount() - coalesced, 1);
+    pool.join();
+}
+
+/** @par 检测点 */
+TEST_CASE("test_LoadingCache_destroy_while_loading") {
+    ThreadPool pool(2);
+    std::atomic<int> finished{0};
+    auto loader = [&finished](const int& key) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(key));
+        finished++;
+        return key;
+    };
+
+    /** @arg 析构时等待进行中的加载完成 */
+    {
+        LoadingCache<int, int> cache(10);
+        cache.setExecutor([&pool](std::function<void()> task) { pool.submit(std::move(task)); });
+        cache.get_or_load_async(50, loader);
+        CHECK_EQ(finished, 0);
+    }
+    CHECK_EQ(finished, 1);
+
+    /** @arg 加载刚完成时立即析构 */
+    for (int i = 0; i < 100; i++) {
+        LoadingCache<int, int> cache(10);
+        cache.setExecutor([&pool](std::function<void()> task) { pool.submit(std::move(task)); });
+        cache.get_or_load_async(0, loader);
+    }
+    CHECK_EQ(finished, 101);
+    pool.join();
+}
+
+#if CPP_STANDARD >= CPP_STANDARD_20
+#if !(defined(__GNUC__) && (__GNUC__ <= 12))
+
+static asio::awaitable<void> test_LoadingCache_await_helper(LoadingCache<int, int>& cache) {
+    int result = co_await await_future(cache.get_or_load_async(5, [](const int& key) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return key + 1;
+    }));
+    CHECK_EQ(result, 6);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_LoadingCache_await_future") {
+    ThreadPool pool(2);
+    LoadingCache<int, int> cache(10);
+    cache.setExecutor([&pool](std::function<void()> task) { pool.submit(std::move(task)); });
+    asio::io_context ctx;
+    asio::co_spawn(ctx, test_LoadingCache_await_helper(cache), asio::detached);
+    ctx.run();
+    pool.join();
+}
+
+#endif
+#endif
+
+/** @} */
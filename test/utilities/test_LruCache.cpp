@@ -454,4 +454,106 @@ TEST_CASE("test_LruCache_overflow_functions") {
     CHECK_UNARY(cache2.contains(6));   // 6应该还存在
 }
 
-/** @} */
\ No newline at end of file
+/** @par 检测点: 权重函数测试 */
+TEST_CASE("test_LruCache_weigher") {
+    LruCache<int, std::string> cache(10, 0);  // 容量为10（按字节计），溢出容量为0
+    cache.setWeigher([](const int&, const std::string& value) { return value.size(); });
+
+    /** @arg 按权重之和淘汰 */
+    cache.insert(1, "aaaa");
+    cache.insert(2, "bbbb");
+    CHECK_EQ(cache.weight(), 8);
+    cache.insert(3, "cccc");  // 总权重12超过10，淘汰最久未使用的1
+    CHECK_EQ(cache.weight(), 8);
+    CHECK_EQ(cache.size(), 2);
+    CHECK_UNARY(!cache.contains(1));
+    CHECK_UNARY(cache.contains(2));
+    CHECK_UNARY(cache.contains(3));
+
+    /** @arg 更新已存在的键时重新计算权重 */
+    cache.insert(2, "b");
+    CHECK_EQ(cache.weight(), 5);
+    cache.insert(4, "dddd");
+    CHECK_EQ(cache.weight(), 9);
+    CHECK_EQ(cache.size(), 3);
+
+    /** @arg 权重超过容量的元素插入后被立即淘汰 */
+    cache.insert(5, "eeeeeeeeeeee");
+    CHECK_UNARY(!cache.contains(5));
+    CHECK_UNARY(cache.empty());
+    CHECK_EQ(cache.weight(), 0);
+
+    /** @arg 删除与清空时权重同步减少 */
+    cache.insert(6, "ff");
+    cache.insert(7, "ggg");
+    CHECK_UNARY(cache.remove(6));
+    CHECK_EQ(cache.weight(), 3);
+    cache.clear();
+    CHECK_EQ(cache.weight(), 0);
+
+    /** @arg 取消权重函数后恢复按元素个数计量 */
+    cache.insert(8, "hhhhhhhh");
+    cache.insert(9, "iiiiiiii");
+    CHECK_EQ(cache.size(), 1);
+    cache.setWeigher(nullptr);
+    CHECK_EQ(cache.weight(), 1);
+    cache.insert(10, "jjjjjjjj");
+    CHECK_EQ(cache.size(), 2);
+    CHECK_EQ(cache.weight(), 2);
+
+    /** @arg 设置权重函数时对已有元素重新计算并淘汰 */
+    cache.setWeigher([](const int&, const std::string& value) { return value.size(); });
+    CHECK_EQ(cache.size(), 1);
+    CHECK_EQ(cache.weight(), 8);
+    CHECK_UNARY(cache.contains(10));
+}
+
+/** @par 检测点: 存活时间测试 */
+TEST_CASE("test_LruCache_ttl") {
+    using namespace std::chrono_literals;
+    LruCache<int, int> cache(0);
+    CHECK_EQ(cache.defaultTTL().count(), 0);
+
+    /** @arg 单个元素的存活时间，过期后访问视为不存在 */
+    cache.insert(1, 1, 30ms);
+    cache.insert(2, 2);
+    int value = 0;
+    CHECK_UNARY(cache.tryGet(1, value));
+    CHECK_EQ(value, 1);
+    std::this_thread::sleep_for(50ms);
+    CHECK_UNARY(!cache.contains(1));
+    CHECK_UNARY(!cache.tryGet(1, value));
+    CHECK_EQ(cache.get(1), 0);
+    CHECK_EQ(cache.get(2), 2);
+
+    /** @arg 过期元素在插入时批量清理 */
+    CHECK_EQ(cache.size(), 2);
+    cache.insert(3, 3);
+    CHECK_EQ(cache.size(), 2);
+    CHECK_EQ(cache.weight(), 2);
+
+    /** @arg 默认存活时间 */
+    cache.setDefaultTTL(30ms);
+    CHECK_EQ(cache.defaultTTL().count(), 30);
+    cache.insert(4, 4);
+    cache.insert(5, 5, 0ms);  // 指定永不过期
+    std::this_thread::sleep_for(50ms);
+    CHECK_UNARY(!cache.contains(4));
+    CHECK_UNARY(cache.contains(5));
+    CHECK_EQ(cache.removeExpired(), 1);
+    CHECK_EQ(cache.size(), 3);
+
+    /** @arg 重新插入时刷新存活时间 */
+    cache.insert(6, 6, 30ms);
+    cache.insert(6, 60, 10s);
+    std::this_thread::sleep_for(50ms);
+    CHECK_EQ(cache.get(6), 60);
+    CHECK_EQ(cache.removeExpired(), 0);
+
+    /** @arg 删除带存活时间的元素 */
+    CHECK_UNARY(cache.remove(6));
+    CHECK_EQ(cache.removeExpired(), 0);
+    CHECK_EQ(cache.size(), 3);
+}
+
+/** @} */
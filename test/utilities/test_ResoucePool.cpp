@@ -9,6 +9,8 @@
 #include <hikyuu/utilities/ResourcePool.h>
 #include <hikyuu/utilities/thread/ThreadPool.h>
 #include <hikyuu/utilities/Log.h>
+#include <atomic>
+#include <vector>
 
 using namespace hku;
 
@@ -129,4 +131,120 @@ TEST_CASE("test_ResourceVersionPool") {
     x2.reset();
     CHECK_EQ(pool.count(), 2);
     CHECK_EQ(pool.idleCount(), 0);
-}
\ No newline at end of file
+}
+class PingResource {
+public:
+    PingResource(const Parameter& param) {
+        s_alive++;
+    }
+
+    ~PingResource() {
+        s_alive--;
+    }
+
+    bool ping() {
+        return alive;
+    }
+
+    bool alive = true;
+    static std::atomic<int> s_alive;
+};
+
+std::atomic<int> PingResource::s_alive{0};
+
+TEST_CASE("test_ResourcePool_maintain") {
+    Parameter param;
+    ResourcePool<PingResource> pool(param, 10, 10);
+
+    // 预热至最小空闲资源数
+    pool.minIdleSize(3);
+    pool.maintain();
+    CHECK_EQ(pool.count(), 3);
+    CHECK_EQ(pool.idleCount(), 3);
+    CHECK_EQ(pool.stats().created, 3);
+
+    // 空闲资源后进先出
+    auto x1 = pool.get();
+    auto x2 = pool.get();
+    PingResource* p2 = x2.get();
+    x2.reset();
+    x2 = pool.get();
+    CHECK_EQ(x2.get(), p2);
+
+    // 默认以 ping() 作为健康检查，检查失败的空闲资源被释放后补足最小空闲数
+    x2->alive = false;
+    x2.reset();
+    x1.reset();
+    pool.validateInterval(std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    pool.maintain();
+    auto stats = pool.stats();
+    CHECK_EQ(stats.validation_failed, 1);
+    CHECK_EQ(stats.count, 3);
+    CHECK_EQ(stats.idle, 3);
+    CHECK_EQ(PingResource::s_alive, 3);
+
+    // 超过最大空闲时间的资源被释放，保留最小空闲数
+    pool.validateInterval(std::chrono::milliseconds(0));
+    std::vector<ResourcePool<PingResource>::ResourcePtr> list;
+    for (int i = 0; i < 6; i++) {
+        list.push_back(pool.get());
+    }
+    list.clear();
+    CHECK_EQ(pool.idleCount(), 6);
+    pool.maxIdleTime(std::chrono::milliseconds(10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pool.maintain();
+    stats = pool.stats();
+    CHECK_EQ(stats.evicted, 3);
+    CHECK_EQ(stats.idle, 3);
+    CHECK_EQ(PingResource::s_alive, 3);
+
+    // 自定义健康检查函数
+    pool.setValidator([](PingResource&) { return false; });
+    pool.validateInterval(std::chrono::milliseconds(1));
+    pool.minIdleSize(0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    pool.maintain();
+    CHECK_EQ(pool.count(), 0);
+    CHECK_EQ(PingResource::s_alive, 0);
+
+    // 检查期间有资源归还至空闲列表时，放回的资源不超过最大空闲数
+    pool.maxIdleSize(2);
+    for (int i = 0; i < 4; i++) {
+        list.push_back(pool.get());
+    }
+    list.pop_back();
+    list.pop_back();
+    CHECK_EQ(pool.idleCount(), 2);
+    pool.setValidator([&list](PingResource&) {
+        list.clear();
+        return true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    pool.maintain();
+    CHECK_EQ(pool.idleCount(), 2);
+    CHECK_EQ(pool.count(), 2);
+    CHECK_EQ(PingResource::s_alive, 2);
+}
+
+TEST_CASE("test_ResourcePool_maintenance_task") {
+    Parameter param;
+    ResourcePool<PingResource> pool(param, 2, 10);
+    pool.minIdleSize(2);
+    pool.startMaintenance(std::chrono::milliseconds(10));
+    for (int i = 0; i < 100 && pool.idleCount() < 2; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    CHECK_EQ(pool.idleCount(), 2);
+
+    // 等待超时计入统计
+    auto x1 = pool.get();
+    auto x2 = pool.get();
+    CHECK_THROWS_AS(pool.getWaitFor(10), GetResourceTimeoutException);
+    auto stats = pool.stats();
+    CHECK_EQ(stats.timeouts, 1);
+    CHECK_EQ(stats.wait_time.count, 2);
+    CHECK_EQ(stats.created, 2);
+    pool.stopMaintenance();
+}
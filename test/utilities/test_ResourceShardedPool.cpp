@@ -0,0 +1,200 @@
+/**
+ *  Copyright (c) 2026 hikyuu
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <hikyuu/utilities/ResourcePool.h>
+#include <hikyuu/utilities/ResourceShardedPool.h>
+#include <hikyuu/utilities/Log.h>
+#include <hikyuu/utilities/SpendTimer.h>
+
+using namespace hku;
+
+class ShardedTestResource {
+public:
+    ShardedTestResource(const Parameter& param) {
+        HKU_CHECK_THROW(!param.have("fail"), std::runtime_error, "create failed");
+        s_alive++;
+    }
+
+    virtual ~ShardedTestResource() {
+        s_alive--;
+    }
+
+    int value = 0;
+    static std::atomic<int> s_alive;
+};
+
+std::atomic<int> ShardedTestResource::s_alive{0};
+
+/**
+ * @defgroup test_hikyuu_ResourceShardedPool test_hikyuu_ResourceShardedPool
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_ResourceShardedPool") {
+    Parameter param;
+    ResourceShardedPool<ShardedTestResource> pool(param, 0, 5, 3);
+    CHECK_EQ(pool.shardNum(), 4);
+    CHECK_EQ(pool.count(), 0);
+    CHECK_EQ(pool.idleCount(), 0);
+
+    /** @arg 归还后的资源被复用 */
+    auto x1 = pool.get();
+    x1->value = 1;
+    CHECK_EQ(pool.count(), 1);
+    x1.reset();
+    CHECK_EQ(pool.count(), 1);
+    CHECK_EQ(pool.idleCount(), 1);
+    x1 = pool.get();
+    CHECK_EQ(x1->value, 1);
+    CHECK_EQ(pool.count(), 1);
+    CHECK_EQ(pool.idleCount(), 0);
+
+    /** @arg 超出最大空闲数的资源在归还时释放 */
+    std::vector<ResourceShardedPool<ShardedTestResource>::ResourcePtr> list;
+    for (int i = 0; i < 8; i++) {
+        list.push_back(pool.get());
+    }
+    CHECK_EQ(pool.count(), 9);
+    list.clear();
+    CHECK_EQ(pool.count(), 6);
+    CHECK_EQ(pool.idleCount(), 5);
+    CHECK_EQ(ShardedTestResource::s_alive, 6);
+
+    pool.releaseIdleResource();
+    CHECK_EQ(pool.count(), 1);
+    CHECK_EQ(pool.idleCount(), 0);
+    CHECK_EQ(ShardedTestResource::s_alive, 1);
+
+    /** @arg 资源池先于资源析构 */
+    auto* pool_ptr = new ResourceShardedPool<ShardedTestResource>(param);
+    auto y1 = pool_ptr->get();
+    auto y2 = pool_ptr->get();
+    y2.reset();
+    CHECK_EQ(ShardedTestResource::s_alive, 3);
+    delete pool_ptr;
+    CHECK_EQ(ShardedTestResource::s_alive, 2);
+    y1.reset();
+    CHECK_EQ(ShardedTestResource::s_alive, 1);
+
+    /** @arg 创建资源失败时抛出异常并释放占用的名额 */
+    Parameter fail_param;
+    fail_param.set<bool>("fail", true);
+    ResourceShardedPool<ShardedTestResource> fail_pool(fail_param, 1);
+    CHECK_THROWS_AS(fail_pool.get(), CreateResourceException);
+    CHECK_EQ(fail_pool.count(), 0);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_ResourceShardedPool_max_size") {
+    Parameter param;
+    ResourceShardedPool<ShardedTestResource> pool(param, 2);
+
+    /** @arg 超出最大资源数时返回空指针 */
+    auto x1 = pool.get();
+    auto x2 = pool.get();
+    CHECK_UNARY(x1);
+    CHECK_UNARY(x2);
+    CHECK_UNARY(!pool.get());
+
+    /** @arg 等待超时抛出异常 */
+    CHECK_THROWS_AS(pool.getWaitFor(20), GetResourceTimeoutException);
+
+    /** @arg 等待中的线程在资源归还后获得资源 */
+    std::thread t([&x1]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        x1.reset();
+    });
+    auto x3 = pool.getAndWait();
+    CHECK_UNARY(x3);
+    CHECK_EQ(pool.count(), 2);
+    t.join();
+
+    /** @arg 调大最大资源数后等待中的线程可创建新资源 */
+    t = std::thread([&pool]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        pool.maxPoolSize(3);
+    });
+    auto x4 = pool.getWaitFor(1000);
+    CHECK_UNARY(x4);
+    CHECK_EQ(pool.count(), 3);
+    t.join();
+}
+
+/** @par 检测点 */
+TEST_CASE("test_ResourceShardedPool_multi_thread") {
+    Parameter param;
+    ResourceShardedPool<ShardedTestResource> pool(param, 4, 4);
+    std::atomic<int> in_use{0};
+    std::atomic<int> max_in_use{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 500; j++) {
+                auto x = pool.getAndWait();
+                int n = ++in_use;
+                int expected = max_in_use.load();
+                while (n > expected && !max_in_use.compare_exchange_weak(expected, n)) {
+                }
+                --in_use;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    CHECK_LE(max_in_use, 4);
+    CHECK_LE(pool.count(), 4);
+    CHECK_EQ(pool.idleCount(), pool.count());
+}
+
+#if ENABLE_BENCHMARK_TEST
+template <class Pool>
+static void test_ResourceShardedPool_benchmark_helper(Pool& pool, size_t thread_num,
+                                                       size_t loop) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; i++) {
+        threads.emplace_back([&pool, loop]() {
+            for (size_t j = 0; j < loop; j++) {
+                auto x = pool.get();
+                x->value++;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+TEST_CASE("test_ResourceShardedPool_benchmark") {
+    Parameter param;
+    size_t total = 1000000;
+    for (size_t thread_num : {1, 4, 16, 64}) {
+        size_t loop = total / thread_num;
+        {
+            ResourcePool<ShardedTestResource> pool(param, 0, 100);
+            BENCHMARK_TIME_MSG(test_ResourceShardedPool_benchmark, 1,
+                               "ResourcePool checkout/return, threads: {}", thread_num);
+            test_ResourceShardedPool_benchmark_helper(pool, thread_num, loop);
+        }
+        {
+            ResourceShardedPool<ShardedTestResource> pool(param, 0, 100);
+            BENCHMARK_TIME_MSG(test_ResourceShardedPool_benchmark, 1,
+                               "ResourceShardedPool checkout/return, threads: {}", thread_num);
+            test_ResourceShardedPool_benchmark_helper(pool, thread_num, loop);
+        }
+    }
+}
+#endif
+
+/** @} */
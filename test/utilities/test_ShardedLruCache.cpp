@@ -0,0 +1,206 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <hikyuu/utilities/ShardedLruCache.h>
+#include <hikyuu/utilities/LRUCache11.h>
+#include <hikyuu/utilities/SpendTimer.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <random>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_ShardedLruCache test_hikyuu_ShardedLruCache
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_ShardedLruCache_basic") {
+    ShardedLruCache<int, std::string, std::shared_mutex, 4> cache(100, 0, true);
+    CHECK_EQ(cache.shardCount(), 4);
+    CHECK_EQ(cache.capacity(), 100);
+    CHECK_EQ(cache.overflow(), 0);
+    CHECK_UNARY(cache.empty());
+
+    cache.insert(1, "one");
+    std::string two("two");
+    cache.insert(2, std::move(two));
+    CHECK_EQ(cache.size(), 2);
+    CHECK_EQ(cache.get(1), "one");
+    CHECK_EQ(cache.get(2), "two");
+    CHECK_EQ(cache.get(3), "");
+    CHECK_UNARY(cache.contains(1));
+
+    std::string value;
+    CHECK_UNARY(cache.tryGet(1, value));
+    CHECK_EQ(value, "one");
+    CHECK_UNARY_FALSE(cache.tryGet(4, value));
+
+    CHECK_UNARY(cache.remove(1));
+    CHECK_UNARY_FALSE(cache.remove(1));
+    CHECK_UNARY_FALSE(cache.contains(1));
+
+    /** @arg 统计信息 */
+    LruCacheStats stats = cache.stats();
+    CHECK_EQ(stats.size, 1);
+    CHECK_EQ(stats.capacity, 100);
+    CHECK_EQ(stats.inserts, 2);
+    CHECK_EQ(stats.hits, 3);
+    CHECK_EQ(stats.misses, 2);
+    CHECK_EQ(stats.hitRate(), 3.0 / 5.0);
+
+    auto shard_stats = cache.shardStats();
+    CHECK_EQ(shard_stats.size(), 4);
+    size_t total_capacity = 0;
+    uint64_t total_hits = 0;
+    for (const auto& one : shard_stats) {
+        total_capacity += one.capacity;
+        total_hits += one.hits;
+    }
+    CHECK_EQ(total_capacity, 100);
+    CHECK_EQ(total_hits, 3);
+
+    cache.resetStats();
+    CHECK_EQ(cache.stats().hits, 0);
+
+    cache.clear();
+    CHECK_UNARY(cache.empty());
+
+    /** @arg 未开启统计时不计数 */
+    ShardedLruCache<int, int> no_stats(16);
+    no_stats.insert(1, 1);
+    no_stats.get(1);
+    CHECK_UNARY_FALSE(no_stats.statsEnabled());
+    CHECK_EQ(no_stats.stats().hits, 0);
+    CHECK_EQ(no_stats.stats().inserts, 0);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_ShardedLruCache_capacity") {
+    /** @arg 总容量按分片均分，总大小不超过总容量 */
+    ShardedLruCache<int, int, std::shared_mutex, 8> cache(64, 0);
+    for (int i = 0; i < 1000; i++) {
+        cache.insert(i, i);
+    }
+    CHECK_LE(cache.size(), 64);
+    for (const auto& one : cache.shardStats()) {
+        CHECK_EQ(one.capacity, 8);
+        CHECK_LE(one.size, 8);
+    }
+
+    /** @arg 最近插入的元素仍在缓存中 */
+    CHECK_EQ(cache.get(999), 999);
+
+    /** @arg 调整总容量 */
+    cache.resize(16);
+    CHECK_EQ(cache.capacity(), 16);
+    CHECK_LE(cache.size(), 16);
+
+    /** @arg 总容量小于分片数时，每个分片至少保留一个元素 */
+    cache.resize(3);
+    for (const auto& one : cache.shardStats()) {
+        CHECK_EQ(one.capacity, 1);
+    }
+
+    /** @arg 0 表示无限制容量 */
+    cache.resize(0);
+    for (int i = 0; i < 1000; i++) {
+        cache.insert(i, i);
+    }
+    CHECK_EQ(cache.size(), 1000);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_ShardedLruCache_thread_safety") {
+    ShardedLruCache<int, int> cache(0, 0, true);
+    const int num_threads = 8;
+    const int ops_per_thread = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([t, &cache]() {
+            for (int i = 0; i < ops_per_thread; i++) {
+                int key = t * ops_per_thread + i;
+                cache.insert(key, key * 2);
+                int value = 0;
+                cache.tryGet(key, value);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    CHECK_EQ(cache.size(), num_threads * ops_per_thread);
+    LruCacheStats stats = cache.stats();
+    CHECK_EQ(stats.inserts, num_threads * ops_per_thread);
+    CHECK_EQ(stats.hits, num_threads * ops_per_thread);
+    for (int key = 0; key < num_threads * ops_per_thread; key++) {
+        CHECK_EQ(cache.get(key), key * 2);
+    }
+}
+
+#if ENABLE_BENCHMARK_TEST
+template <class Cache, class Get>
+static void bench_cache_mix(const char* name, Cache& cache, Get get, size_t num_threads,
+                            size_t write_percent) {
+    const size_t ops_per_thread = 50000;
+    const int key_range = 10000;
+    for (int i = 0; i < key_range; i++) {
+        cache.insert(i, i);
+    }
+
+    BENCHMARK_TIME_MSG(cache_mix, 1, "{} {} threads x {} ops, {}% writes", name, num_threads,
+                       ops_per_thread, write_percent);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; t++) {
+        threads.emplace_back([&cache, &get, t, write_percent, ops_per_thread, key_range]() {
+            std::mt19937 rng(static_cast<unsigned>(t));
+            std::uniform_int_distribution<int> key_dist(0, key_range * 2 - 1);
+            std::uniform_int_distribution<size_t> op_dist(0, 99);
+            int value = 0;
+            for (size_t i = 0; i < ops_per_thread; i++) {
+                int key = key_dist(rng);
+                if (op_dist(rng) < write_percent) {
+                    cache.insert(key, key);
+                } else {
+                    get(cache, key, value);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_ShardedLruCache_benchmark") {
+    const size_t capacity = 8192;
+    size_t num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 4);
+    auto get = [](auto& cache, int key, int& value) { return cache.tryGet(key, value); };
+    for (size_t write_percent : {10, 50}) {
+        {
+            LruCache<int, int, std::shared_mutex> cache(capacity, 64);
+            bench_cache_mix("LruCache", cache, get, num_threads, write_percent);
+        }
+        {
+            lru11::Cache<int, int, std::mutex> cache(capacity, 64);
+            bench_cache_mix("LRUCache11", cache, get, num_threads, write_percent);
+        }
+        {
+            ShardedLruCache<int, int> cache(capacity, 64);
+            bench_cache_mix("ShardedLruCache", cache, get, num_threads, write_percent);
+        }
+    }
+}
+#endif
+
+/** @} */
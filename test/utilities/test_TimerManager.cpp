@@ -10,6 +10,10 @@
 #if defined(HKU_SUPPORT_DATETIME)
 #include <hikyuu/utilities/TimerManager.h>
 #include <hikyuu/utilities/Log.h>
+#include <hikyuu/utilities/SpendTimer.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 using namespace hku;
 
@@ -56,6 +60,97 @@ TEST_CASE("test_TimerManager") {
       hku::exception);
 }
 
+TEST_CASE("test_TimerManager_ElasticThreadPool") {
+    ElasticThreadPool tg(0, 2, std::chrono::milliseconds(10));
+    std::atomic<int> count{0};
+    {
+        TimerManager tm(&tg);
+        tm.addDelayFunc(Milliseconds(1), [&count]() { count++; });
+        tm.addDelayFunc(Milliseconds(2), [&count]() { count++; });
+        for (int i = 0; i < 2000 && count < 2; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    tg.join();
+    CHECK_EQ(count.load(), 2);
+    CHECK_GE(tg.created_count(), 1);
+}
+
+TEST_CASE("test_TimerManager_timing_wheel") {
+    TimerManager tm(2, TimerManager::TIMING_WHEEL);
+    CHECK_EQ(tm.scheduler(), TimerManager::TIMING_WHEEL);
+
+    std::atomic<int> delay_count{0}, repeat_count{0}, removed_count{0};
+    tm.addDelayFunc(Milliseconds(5), [&delay_count]() { delay_count++; });
+    tm.addDurationFunc(3, Milliseconds(2), [&repeat_count]() { repeat_count++; });
+    int id = tm.addDelayFunc(Milliseconds(50), [&removed_count]() { removed_count++; });
+    tm.addDelayFunc(Seconds(3600), hello_test);
+    CHECK_EQ(tm.size(), 4);
+
+    /** @arg 取消的定时器立即删除，且不会再执行 */
+    tm.removeTimer(id);
+    CHECK_EQ(tm.size(), 3);
+
+    for (int i = 0; i < 2000 && (delay_count < 1 || repeat_count < 3); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    CHECK_EQ(delay_count.load(), 1);
+    CHECK_EQ(repeat_count.load(), 3);
+    CHECK_EQ(removed_count.load(), 0);
+    CHECK_EQ(tm.size(), 1);
+
+    /** @arg 停止后重新启动，剩余定时器重新加入时间轮 */
+    tm.stop();
+    tm.start();
+    CHECK_EQ(tm.size(), 1);
+    tm.addDelayFunc(Milliseconds(1), [&delay_count]() { delay_count++; });
+    for (int i = 0; i < 2000 && delay_count < 2; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK_EQ(delay_count.load(), 2);
+}
+
+#if ENABLE_BENCHMARK_TEST
+static void bench_timer_manager(TimerManager::SchedulerType scheduler, const char* name,
+                                size_t total) {
+    std::vector<int> ids(total);
+    TimerManager tm(1, scheduler);
+    {
+        // 延迟分布在 1 小时内，测试期间均不会触发
+        BENCHMARK_TIME_MSG(timer_insert, 1, "{} insert {} timers", name, total);
+        for (size_t i = 0; i < total; i++) {
+            ids[i] = tm.addDelayFunc(Seconds(60 + i % 3600), hello_test);
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(timer_cancel, 1, "{} cancel {} timers", name, total);
+        for (size_t i = 0; i < total; i++) {
+            tm.removeTimer(ids[i]);
+        }
+    }
+
+    /** @arg 大量定时器在 200 毫秒内陆续到期，统计全部执行完毕的耗时 */
+    std::atomic<size_t> count{0};
+    {
+        BENCHMARK_TIME_MSG(timer_expire, 1, "{} expire {} timers", name, total);
+        for (size_t i = 0; i < total; i++) {
+            tm.addDelayFunc(Milliseconds(1 + int64_t(i % 200)), [&count]() { count++; });
+        }
+        while (count < total) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+TEST_CASE("test_TimerManager_benchmark") {
+    for (size_t total : {1000, 10000, 100000, 1000000}) {
+        bench_timer_manager(TimerManager::PRIORITY_QUEUE, "priority queue", total);
+        bench_timer_manager(TimerManager::TIMING_WHEEL, "timing wheel", total);
+    }
+}
+#endif
+
 /** @} */
 
 #endif
\ No newline at end of file
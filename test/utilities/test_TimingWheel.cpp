@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <hikyuu/utilities/TimingWheel.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_TimingWheel test_hikyuu_TimingWheel
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_TimingWheel") {
+    TimingWheel<int> wheel;
+    CHECK_UNARY(wheel.empty());
+    CHECK_UNARY_FALSE(wheel.nextExpiration().has_value());
+
+    std::vector<int> fired;
+    auto on_expire = [&fired](int& v) { fired.push_back(v); };
+
+    /** @arg 各层级的条目按到期先后触发 */
+    wheel.insert(5, 5);
+    wheel.insert(70, 70);
+    wheel.insert(5000, 5000);
+    wheel.insert(300000, 300000);
+    wheel.insert(1, 1);
+    CHECK_EQ(wheel.size(), 5);
+    CHECK_EQ(*wheel.nextExpiration(), 1);
+
+    wheel.advance(4, on_expire);
+    std::vector<int> expect{1};
+    CHECK_EQ(fired, expect);
+    CHECK_EQ(wheel.elapsed(), 4);
+
+    wheel.advance(5000, on_expire);
+    expect = {1, 5, 70, 5000};
+    CHECK_EQ(fired, expect);
+    CHECK_EQ(wheel.size(), 1);
+
+    wheel.advance(299999, on_expire);
+    CHECK_EQ(fired.size(), 4);
+    wheel.advance(300000, on_expire);
+    CHECK_EQ(fired.back(), 300000);
+    CHECK_UNARY(wheel.empty());
+
+    /** @arg 已过期的条目在下次推进时立即触发 */
+    fired.clear();
+    wheel.insert(10, 10);
+    CHECK_EQ(*wheel.nextExpiration(), wheel.elapsed());
+    wheel.advance(wheel.elapsed(), on_expire);
+    expect = {10};
+    CHECK_EQ(fired, expect);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TimingWheel_cancel") {
+    TimingWheel<int> wheel(1000);
+    std::vector<int> fired;
+    auto on_expire = [&fired](int& v) { fired.push_back(v); };
+
+    wheel.insert(1010, 1);
+    auto h2 = wheel.insert(1010, 2);
+    auto h3 = wheel.insert(1010, 3);
+    auto h4 = wheel.insert(900000, 4);
+
+    /** @arg 取消链表头、中间、尾部的条目 */
+    wheel.cancel(h2);
+    wheel.cancel(h3);
+    wheel.cancel(h4);
+    CHECK_EQ(wheel.size(), 1);
+    CHECK_EQ(*wheel.nextExpiration(), 1010);
+
+    wheel.advance(1000000, on_expire);
+    std::vector<int> expect{1};
+    CHECK_EQ(fired, expect);
+
+    /** @arg 取消槽位中唯一的条目后，该槽位不再参与调度 */
+    auto h5 = wheel.insert(1000100, 5);
+    wheel.cancel(h5);
+    CHECK_UNARY_FALSE(wheel.nextExpiration().has_value());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TimingWheel_far_future") {
+    /** @arg 超出时间轮范围的条目不会提前触发 */
+    typedef TimingWheel<int>::tick_type tick_type;
+    TimingWheel<int> wheel(123);
+    tick_type far = 123 + TimingWheel<int>::MAX_RANGE * 3 + 77;
+    wheel.insert(far, 1);
+
+    int count = 0;
+    tick_type fired_at = 0;
+    size_t steps = 0;
+    while (!wheel.empty()) {
+        tick_type next = *wheel.nextExpiration();
+        wheel.advance(next, [&](int&) {
+            count++;
+            fired_at = next;
+        });
+        steps++;
+    }
+    CHECK_EQ(count, 1);
+    CHECK_EQ(fired_at, far);
+    CHECK_LT(steps, 100);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TimingWheel_random") {
+    /** @arg 随机到期时间，逐步推进时触发顺序与到期时间一致 */
+    typedef TimingWheel<uint64_t>::tick_type tick_type;
+    std::mt19937_64 rng(42);
+    TimingWheel<uint64_t> wheel(rng() % 1000000);
+    tick_type base = wheel.elapsed();
+
+    std::vector<tick_type> deadlines;
+    std::vector<TimingWheel<uint64_t>::handle_type> handles;
+    for (size_t i = 0; i < 2000; i++) {
+        tick_type d = base + 1 + rng() % (uint64_t(1) << (6 * (1 + i % 6)));
+        deadlines.push_back(d);
+        handles.push_back(wheel.insert(d, d));
+    }
+
+    // 取消一部分
+    std::vector<tick_type> expect;
+    for (size_t i = 0; i < deadlines.size(); i++) {
+        if (i % 7 == 0) {
+            wheel.cancel(handles[i]);
+        } else {
+            expect.push_back(deadlines[i]);
+        }
+    }
+    std::sort(expect.begin(), expect.end());
+
+    std::vector<tick_type> fired;
+    bool on_time = true;
+    while (!wheel.empty()) {
+        tick_type next = *wheel.nextExpiration();
+        wheel.advance(next, [&](tick_type& d) {
+            on_time = on_time && d == next;
+            fired.push_back(d);
+        });
+    }
+    CHECK_UNARY(on_time);
+    CHECK_EQ(fired, expect);
+}
+
+/** @} */
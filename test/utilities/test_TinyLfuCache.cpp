@@ -0,0 +1,242 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <hikyuu/utilities/TinyLfuCache.h>
+#include <hikyuu/utilities/LRUCache11.h>
+#include <hikyuu/utilities/SpendTimer.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_TinyLfuCache test_hikyuu_TinyLfuCache
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+// 生成 Zipf 分布的访问序列，键取值 [0, key_num)
+static std::vector<int> make_zipf_trace(size_t key_num, double s, size_t length, unsigned seed) {
+    std::vector<double> cdf(key_num);
+    double sum = 0.0;
+    for (size_t i = 0; i < key_num; i++) {
+        sum += 1.0 / std::pow(double(i + 1), s);
+        cdf[i] = sum;
+    }
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(0.0, sum);
+    std::vector<int> trace(length);
+    for (size_t i = 0; i < length; i++) {
+        trace[i] = int(std::lower_bound(cdf.begin(), cdf.end(), dist(rng)) - cdf.begin());
+    }
+    return trace;
+}
+
+// 在 Zipf 序列中周期性插入一次性的顺序扫描（模拟遍历历史K线数据），扫描键不与热点键重叠
+static std::vector<int> make_scan_mixed_trace(size_t key_num, double s, size_t length,
+                                              size_t scan_interval, size_t scan_length,
+                                              unsigned seed) {
+    std::vector<int> zipf = make_zipf_trace(key_num, s, length, seed);
+    std::vector<int> trace;
+    trace.reserve(length + length / scan_interval * scan_length);
+    int scan_key = int(key_num);
+    for (size_t i = 0; i < zipf.size(); i++) {
+        if (i > 0 && i % scan_interval == 0) {
+            for (size_t j = 0; j < scan_length; j++) {
+                trace.push_back(scan_key++);
+            }
+        }
+        trace.push_back(zipf[i]);
+    }
+    return trace;
+}
+
+// 按访问序列回放，未命中时插入，返回命中率
+template <class Cache>
+static double replay_hit_rate(Cache& cache, const std::vector<int>& trace) {
+    size_t hits = 0;
+    int value = 0;
+    for (int key : trace) {
+        if (cache.tryGet(key, value)) {
+            hits++;
+        } else {
+            cache.insert(key, key);
+        }
+    }
+    return trace.empty() ? 0.0 : double(hits) / double(trace.size());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TinyLfuCache_basic") {
+    TinyLfuCache<int, std::string> cache(100);
+    CHECK_EQ(cache.capacity(), 100);
+    CHECK_UNARY(cache.empty());
+
+    cache.insert(1, "one");
+    std::string two("two");
+    cache.insert(2, std::move(two));
+    CHECK_EQ(cache.size(), 2);
+    CHECK_EQ(cache.get(1), "one");
+    CHECK_EQ(cache.get(2), "two");
+    CHECK_EQ(cache.get(3), "");
+    CHECK_UNARY(cache.contains(1));
+
+    std::string value;
+    CHECK_UNARY(cache.tryGet(1, value));
+    CHECK_EQ(value, "one");
+    CHECK_UNARY_FALSE(cache.tryGet(4, value));
+
+    /** @arg 更新已存在的键 */
+    cache.insert(1, "ONE");
+    CHECK_EQ(cache.get(1), "ONE");
+    CHECK_EQ(cache.size(), 2);
+
+    CHECK_UNARY(cache.remove(1));
+    CHECK_UNARY_FALSE(cache.remove(1));
+    CHECK_UNARY_FALSE(cache.contains(1));
+    CHECK_EQ(cache.size(), 1);
+
+    cache.clear();
+    CHECK_UNARY(cache.empty());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TinyLfuCache_capacity") {
+    /** @arg 大小不超过容量 */
+    TinyLfuCache<int, int> cache(64);
+    for (int i = 0; i < 1000; i++) {
+        cache.insert(i, i);
+        CHECK_LE(cache.size(), 64);
+    }
+    CHECK_EQ(cache.size(), 64);
+
+    /** @arg 最近插入的元素位于窗口区，仍在缓存中 */
+    CHECK_EQ(cache.get(999), 999);
+
+    /** @arg 缩小容量 */
+    cache.resize(10);
+    CHECK_EQ(cache.capacity(), 10);
+    CHECK_EQ(cache.size(), 10);
+
+    /** @arg 容量为 1 */
+    cache.resize(1);
+    cache.insert(2000, 2000);
+    cache.insert(2001, 2001);
+    CHECK_EQ(cache.size(), 1);
+
+    /** @arg 0 表示无限制容量 */
+    cache.resize(0);
+    cache.clear();
+    for (int i = 0; i < 1000; i++) {
+        cache.insert(i, i);
+    }
+    CHECK_EQ(cache.size(), 1000);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TinyLfuCache_scan_resistance") {
+    /** @arg 已进入主区保护段的热点数据在一次顺序扫描后仍保留在缓存中 */
+    const int hot_num = 50;
+    TinyLfuCache<int, int> cache(100);
+    int value = 0;
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < hot_num; i++) {
+            if (!cache.tryGet(i, value)) {
+                cache.insert(i, i);
+            }
+        }
+        // 将最后一个热点键挤出窗口区，使其在下一轮访问时晋升至保护段
+        cache.insert(hot_num + round, 0);
+    }
+    for (int i = 1000; i < 11000; i++) {
+        if (!cache.tryGet(i, value)) {
+            cache.insert(i, i);
+        }
+    }
+    CHECK_EQ(cache.size(), 100);
+    int hot_left = 0;
+    for (int i = 0; i < hot_num; i++) {
+        hot_left += cache.contains(i) ? 1 : 0;
+    }
+    CHECK_EQ(hot_left, hot_num);
+
+    /** @arg 扫描混合访问序列下命中率高于纯 LRU */
+    std::vector<int> trace = make_scan_mixed_trace(10000, 0.99, 50000, 5000, 2000, 7);
+    TinyLfuCache<int, int> tiny(500);
+    lru11::Cache<int, int> lru(500, 0);
+    CHECK_GT(replay_hit_rate(tiny, trace), replay_hit_rate(lru, trace));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TinyLfuCache_thread_safety") {
+    TinyLfuCache<int, int, std::mutex> cache(0);
+    const int num_threads = 8;
+    const int ops_per_thread = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([t, &cache]() {
+            for (int i = 0; i < ops_per_thread; i++) {
+                int key = t * ops_per_thread + i;
+                cache.insert(key, key * 2);
+                int value = 0;
+                cache.tryGet(key, value);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    CHECK_EQ(cache.size(), num_threads * ops_per_thread);
+    for (int key = 0; key < num_threads * ops_per_thread; key++) {
+        CHECK_EQ(cache.get(key), key * 2);
+    }
+}
+
+#if ENABLE_BENCHMARK_TEST
+template <class Cache>
+static void bench_hit_rate(const char* name, const char* trace_name, Cache& cache,
+                           const std::vector<int>& trace) {
+    double hit_rate = 0.0;
+    {
+        BENCHMARK_TIME_MSG(hit_rate, 1, "{} {} trace, {} accesses", name, trace_name,
+                           trace.size());
+        hit_rate = replay_hit_rate(cache, trace);
+    }
+    HKU_INFO("{} {} trace hit rate: {:.2f}%", name, trace_name, hit_rate * 100.0);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TinyLfuCache_benchmark") {
+    const size_t key_num = 100000;
+    const size_t capacity = 2000;
+    std::vector<int> zipf = make_zipf_trace(key_num, 0.99, 1000000, 1);
+    std::vector<int> scan_mixed = make_scan_mixed_trace(key_num, 0.99, 1000000, 50000, 20000, 1);
+    for (auto* trace : {&zipf, &scan_mixed}) {
+        const char* trace_name = trace == &zipf ? "zipf" : "zipf+scan";
+        {
+            LruCache<int, int> cache(capacity, 0);
+            bench_hit_rate("LruCache", trace_name, cache, *trace);
+        }
+        {
+            lru11::Cache<int, int> cache(capacity, 0);
+            bench_hit_rate("LRUCache11", trace_name, cache, *trace);
+        }
+        {
+            TinyLfuCache<int, int> cache(capacity);
+            bench_hit_rate("TinyLfuCache", trace_name, cache, *trace);
+        }
+    }
+}
+#endif
+
+/** @} */
@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "test_config.h"
+#include <atomic>
+#include <thread>
+#include <hikyuu/utilities/thread/thread.h>
+#include <hikyuu/utilities/thread/AwaitableFuture.h>
+#include <hikyuu/utilities/SpendTimer.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_AwaitableFuture test_hikyuu_AwaitableFuture
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_AwaitableFuture") {
+    /** @arg 无共享状态 */
+    AwaitableFuture<int> empty;
+    CHECK_UNARY_FALSE(empty.valid());
+    CHECK_THROWS_AS(empty.get(), std::future_error);
+
+    /** @arg 先设置值后注册回调，回调在当前线程立即执行 */
+    AwaitablePromise<int> p1;
+    auto f1 = p1.get_future();
+    CHECK_THROWS_AS(p1.get_future(), std::future_error);
+    p1.set_value(1);
+    CHECK_UNARY(f1.ready());
+    int called = 0;
+    f1.on_ready([&called]() { called++; });
+    CHECK_EQ(called, 1);
+    CHECK_EQ(f1.get(), 1);
+    CHECK_UNARY_FALSE(f1.valid());
+
+    /** @arg 先注册回调后设置值，回调由设置值的线程执行 */
+    AwaitablePromise<std::string> p2;
+    auto f2 = p2.get_future();
+    std::thread::id callback_id;
+    f2.on_ready([&callback_id]() { callback_id = std::this_thread::get_id(); });
+    CHECK_UNARY_FALSE(f2.ready());
+    std::thread t([&p2]() { p2.set_value("test"); });
+    CHECK_EQ(f2.get(), "test");
+    // 回调在唤醒等待者之后执行，需等待设置值的线程结束
+    std::thread::id setter_id = t.get_id();
+    t.join();
+    CHECK_EQ(callback_id, setter_id);
+
+    /** @arg 异常传递 */
+    AwaitablePromise<void> p3;
+    auto f3 = p3.get_future();
+    p3.set_exception(std::make_exception_ptr(std::runtime_error("error")));
+    CHECK_THROWS_AS(f3.get(), std::runtime_error);
+
+    /** @arg promise 未设置值即析构 */
+    AwaitableFuture<int> f4;
+    {
+        AwaitablePromise<int> p4;
+        f4 = p4.get_future();
+    }
+    CHECK_UNARY(f4.ready());
+    CHECK_THROWS_AS(f4.get(), std::future_error);
+
+    /** @arg 回调抛出异常时不影响结果的设置 */
+    AwaitablePromise<int> p5;
+    auto f5 = p5.get_future();
+    f5.on_ready([]() { throw std::runtime_error("callback error"); });
+    CHECK_NOTHROW(p5.set_value(5));
+    CHECK_EQ(f5.get(), 5);
+
+    AwaitablePromise<int> p6;
+    auto f6 = p6.get_future();
+    p6.set_value(6);
+    CHECK_NOTHROW(f6.on_ready([]() { throw std::runtime_error("callback error"); }));
+    CHECK_EQ(f6.get(), 6);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_submit_awaitable") {
+    ThreadPool tg(2);
+    std::vector<AwaitableFuture<int>> futures;
+    for (int i = 0; i < 100; i++) {
+        futures.emplace_back(tg.submit_awaitable([i]() { return i; }));
+    }
+    for (int i = 0; i < 100; i++) {
+        CHECK_EQ(futures[i].get(), i);
+    }
+
+    auto void_fut = tg.submit_awaitable([]() {});
+    void_fut.get();
+
+    auto err_fut = tg.submit_awaitable([]() -> int { throw std::runtime_error("error"); });
+    CHECK_THROWS_AS(err_fut.get(), std::runtime_error);
+
+    // 回调抛出的异常不会传递至工作线程
+    auto cb_fut = tg.submit_awaitable([]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return 7;
+    });
+    cb_fut.on_ready([]() { throw std::runtime_error("callback error"); });
+    CHECK_EQ(cb_fut.get(), 7);
+    CHECK_EQ(tg.submit_awaitable([]() { return 8; }).get(), 8);
+
+    MQThreadPool mq(2);
+    CHECK_EQ(mq.submit_awaitable([]() { return 1; }).get(), 1);
+    StealThreadPool st(2);
+    CHECK_EQ(st.submit_awaitable([]() { return 2; }).get(), 2);
+    MQStealThreadPool mqst(2);
+    CHECK_EQ(mqst.submit_awaitable([]() { return 3; }).get(), 3);
+
+    tg.join();
+    mq.join();
+    st.join();
+    mqst.join();
+}
+
+#if CPP_STANDARD >= CPP_STANDARD_20
+#if !(defined(__GNUC__) && (__GNUC__ <= 12))
+
+static asio::awaitable<void> test_await_awaitable_future_helper(ThreadPool& pool) {
+    int result = co_await await_future(pool.submit_awaitable([]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return 42;
+    }));
+    CHECK_EQ(result, 42);
+
+    // 已完成的任务
+    auto fut = pool.submit_awaitable([]() { return 1; });
+    fut.wait();
+    CHECK_EQ(co_await await_future(std::move(fut)), 1);
+
+    bool executed = false;
+    co_await await_future(pool.submit_awaitable([&executed]() { executed = true; }));
+    CHECK_UNARY(executed);
+
+    bool caught = false;
+    try {
+        co_await await_future(
+          pool.submit_awaitable([]() -> int { throw std::runtime_error("error"); }));
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    CHECK_UNARY(caught);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_await_future_AwaitableFuture") {
+    ThreadPool pool(2);
+    asio::io_context ctx;
+    asio::co_spawn(ctx, test_await_awaitable_future_helper(pool), asio::detached);
+    ctx.run();
+    pool.join();
+}
+
+#if ENABLE_BENCHMARK_TEST
+static asio::awaitable<void> bench_await_std_future(ThreadPool& pool, int total) {
+    for (int i = 0; i < total; i++) {
+        co_await await_future(pool.submit([i]() { return i; }));
+    }
+}
+
+static asio::awaitable<void> bench_await_awaitable_future(ThreadPool& pool, int total) {
+    for (int i = 0; i < total; i++) {
+        co_await await_future(pool.submit_awaitable([i]() { return i; }));
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_await_future_benchmark") {
+    const int total = 10000;
+    ThreadPool pool(1);
+
+    {
+        asio::io_context ctx;
+        BENCHMARK_TIME_MSG(await_std_future, total, "await_future(std::future) polling");
+        asio::co_spawn(ctx, bench_await_std_future(pool, total), asio::detached);
+        ctx.run();
+    }
+
+    {
+        asio::io_context ctx;
+        BENCHMARK_TIME_MSG(await_awaitable_future, total, "await_future(AwaitableFuture)");
+        asio::co_spawn(ctx, bench_await_awaitable_future(pool, total), asio::detached);
+        ctx.run();
+    }
+
+    pool.join();
+}
+#endif
+
+#endif  // #if !(defined(__GNUC__) && (__GNUC__ <= 12))
+#endif  // CPP_STANDARD >= CPP_STANDARD_20
+
+/** @} */
@@ -0,0 +1,190 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "test_config.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <hikyuu/utilities/thread/thread.h>
+#include <hikyuu/utilities/SpendTimer.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_BulkFuture test_hikyuu_BulkFuture
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+template <class TaskGroup>
+static void check_submit_bulk(TaskGroup& tg) {
+    const size_t total = 1000;
+
+    /** @arg submit_n */
+    std::vector<int> flags(total, 0);
+    auto fut = tg.submit_n(total, [&flags](size_t i) { flags[i] = 1; });
+    fut.get();
+    CHECK_UNARY(fut.ready());
+    CHECK_EQ(fut.remaining(), 0);
+    for (size_t i = 0; i < total; i++) {
+        CHECK_EQ(flags[i], 1);
+    }
+
+    /** @arg submit_bulk */
+    std::atomic<int> count{0};
+    std::vector<std::function<void()>> funcs;
+    for (size_t i = 0; i < total; i++) {
+        funcs.emplace_back([&count]() { count++; });
+    }
+    tg.submit_bulk(funcs.begin(), funcs.end()).get();
+    CHECK_EQ(count.load(), total);
+
+    /** @arg 空任务集合立即就绪 */
+    auto empty_fut = tg.submit_n(0, [](size_t) {});
+    CHECK_UNARY(empty_fut.ready());
+    empty_fut.get();
+
+    /** @arg 任务异常不影响其他任务执行，get 时抛出 */
+    count = 0;
+    auto err_fut = tg.submit_n(100, [&count](size_t i) {
+        count++;
+        if (i == 50) {
+            throw std::runtime_error("error");
+        }
+    });
+    CHECK_THROWS_AS(err_fut.get(), std::runtime_error);
+    CHECK_EQ(count.load(), 100);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_BulkFuture") {
+    BulkFuture empty;
+    CHECK_UNARY_FALSE(empty.valid());
+    CHECK_THROWS_AS(empty.wait(), std::future_error);
+
+    /** @arg 任务未执行即销毁 */
+    std::vector<FuncWrapper> tasks;
+    BulkFuture fut = package_n_tasks(3, [](size_t) {}, tasks);
+    CHECK_EQ(fut.remaining(), 3);
+    tasks[0]();
+    CHECK_EQ(fut.remaining(), 2);
+    CHECK_EQ(fut.wait_for(std::chrono::milliseconds(1)), std::future_status::timeout);
+    tasks.clear();
+    CHECK_UNARY(fut.ready());
+    CHECK_THROWS_AS(fut.get(), std::future_error);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_submit_bulk") {
+    {
+        ThreadPool tg(4);
+        check_submit_bulk(tg);
+        tg.join();
+    }
+    {
+        MQThreadPool tg(4);
+        check_submit_bulk(tg);
+        tg.join();
+    }
+    {
+        StealThreadPool tg(4);
+        check_submit_bulk(tg);
+        tg.join();
+    }
+    {
+        MQStealThreadPool tg(4);
+        check_submit_bulk(tg);
+        tg.join();
+    }
+    {
+        GlobalThreadPool tg(4);
+        check_submit_bulk(tg);
+        tg.join();
+    }
+    {
+        GlobalMQThreadPool tg(4);
+        check_submit_bulk(tg);
+        tg.join();
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_global_parallel_for_index_void_bulk") {
+    init_global_task_group(4);
+
+    std::vector<int> values(1000, 0);
+    global_parallel_for_index_void(0, values.size(), [&values](size_t i) { values[i] = i; });
+    for (size_t i = 0; i < values.size(); i++) {
+        CHECK_EQ(values[i], i);
+    }
+
+    std::vector<int> single(100, 0);
+    global_parallel_for_index_void_single(0, single.size(),
+                                          [&single](size_t i) { single[i] = i + 1; });
+    for (size_t i = 0; i < single.size(); i++) {
+        CHECK_EQ(single[i], i + 1);
+    }
+
+    /** @arg 嵌套 */
+    std::atomic<int> count{0};
+    global_parallel_for_index_void(0, 10, [&count](size_t) {
+        global_parallel_for_index_void_single(0, 10, [&count](size_t) { count++; });
+    });
+    CHECK_EQ(count.load(), 100);
+
+    release_global_task_group();
+}
+
+#if ENABLE_BENCHMARK_TEST
+/** @par 检测点 */
+TEST_CASE("test_submit_bulk_benchmark") {
+    const size_t total = 1000000;
+    std::atomic<size_t> count{0};
+
+    {
+        ThreadPool tg;
+        BENCHMARK_TIME_MSG(ThreadPool_submit, total, "ThreadPool submit");
+        std::vector<std::future<void>> futures;
+        futures.reserve(total);
+        for (size_t i = 0; i < total; i++) {
+            futures.emplace_back(tg.submit([&count]() { count++; }));
+        }
+        for (auto& fut : futures) {
+            fut.get();
+        }
+    }
+
+    {
+        ThreadPool tg;
+        BENCHMARK_TIME_MSG(ThreadPool_submit_n, total, "ThreadPool submit_n");
+        tg.submit_n(total, [&count](size_t) { count++; }).get();
+    }
+
+    {
+        MQThreadPool tg;
+        BENCHMARK_TIME_MSG(MQThreadPool_submit, total, "MQThreadPool submit");
+        std::vector<std::future<void>> futures;
+        futures.reserve(total);
+        for (size_t i = 0; i < total; i++) {
+            futures.emplace_back(tg.submit([&count]() { count++; }));
+        }
+        for (auto& fut : futures) {
+            fut.get();
+        }
+    }
+
+    {
+        MQThreadPool tg;
+        BENCHMARK_TIME_MSG(MQThreadPool_submit_n, total, "MQThreadPool submit_n");
+        tg.submit_n(total, [&count](size_t) { count++; }).get();
+    }
+
+    CHECK_EQ(count.load(), total * 4);
+}
+#endif
+
+/** @} */
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "test_config.h"
+#include <atomic>
+#include <fstream>
+#include <hikyuu/utilities/osdef.h>
+#include <hikyuu/utilities/os.h>
+#include <hikyuu/utilities/thread/thread.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_CpuAffinity test_hikyuu_CpuAffinity
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+static void write_sysfs_file(const std::string& filename, const std::string& content) {
+    std::ofstream file(filename, std::ofstream::trunc);
+    file << content << "\n";
+}
+
+/** @par 检测点 */
+TEST_CASE("test_parse_cpu_list") {
+    std::vector<int> expect{0, 1, 2, 3, 8, 10, 11};
+    CHECK_EQ(parse_cpu_list("0-3,8,10-11"), expect);
+    expect = {5};
+    CHECK_EQ(parse_cpu_list("5"), expect);
+    CHECK_UNARY(parse_cpu_list("").empty());
+
+    /** @arg 格式错误的部分被忽略 */
+    expect = {2, 6, 7};
+    CHECK_EQ(parse_cpu_list("x,2,4-3,6-7"), expect);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_CpuTopology") {
+    CpuTopology topo({{0, 1, 2, 3}, {}, {4, 5, 6, 7}});
+    CHECK_EQ(topo.node_num(), 2);
+    CHECK_EQ(topo.cpu_num(), 8);
+    CHECK_EQ(topo.node_of(5), 1);
+    CHECK_EQ(topo.node_of(100), -1);
+
+    const auto& sys = CpuTopology::system();
+    CHECK_GE(sys.node_num(), 1);
+    CHECK_GE(sys.cpu_num(), 1);
+
+    /** @arg 从模拟的 sysfs 读取，离线 CPU 被排除 */
+    std::string root = "test_data/tmp/sysfs";
+    for (auto dir : {"", "/devices", "/devices/system", "/devices/system/cpu",
+                     "/devices/system/node", "/devices/system/node/node0",
+                     "/devices/system/node/node1"}) {
+        REQUIRE_UNARY(createDir(root + dir));
+    }
+    write_sysfs_file(root + "/devices/system/cpu/online", "0-5,7");
+    write_sysfs_file(root + "/devices/system/node/node0/cpulist", "0-3");
+    write_sysfs_file(root + "/devices/system/node/node1/cpulist", "4-7");
+    auto fake = CpuTopology::from_sysfs(root);
+#if HKU_OS_LINUX
+    CHECK_EQ(fake.node_num(), 2);
+    std::vector<int> expect{0, 1, 2, 3};
+    CHECK_EQ(fake.node_cpus(0), expect);
+    expect = {4, 5, 7};
+    CHECK_EQ(fake.node_cpus(1), expect);
+#endif
+
+    /** @arg sysfs 不存在时视为单节点 */
+    auto missing = CpuTopology::from_sysfs("test_data/tmp/not_exist_sysfs");
+    CHECK_EQ(missing.node_num(), 1);
+    removeDir(root);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_AffinityPolicy") {
+    CpuTopology topo({{0, 1, 2, 3}, {4, 5, 6, 7}});
+
+    auto none = AffinityPolicy::none().assign(3, topo);
+    CHECK_EQ(none.size(), 3);
+    CHECK_UNARY(none[0].empty());
+
+    auto compact = AffinityPolicy::compact().assign(5, topo);
+    std::vector<std::vector<int>> expect{{0}, {1}, {2}, {3}, {4}};
+    CHECK_EQ(compact, expect);
+
+    auto scatter = AffinityPolicy::scatter().assign(5, topo);
+    expect = {{0}, {4}, {1}, {5}, {2}};
+    CHECK_EQ(scatter, expect);
+
+    auto explicit_cpus = AffinityPolicy::explicit_cpus({6, 2}).assign(3, topo);
+    expect = {{6}, {2}, {6}};
+    CHECK_EQ(explicit_cpus, expect);
+
+    auto node = AffinityPolicy::numa_node(1).assign(2, topo);
+    expect = {{4, 5, 6, 7}, {4, 5, 6, 7}};
+    CHECK_EQ(node, expect);
+
+    /** @arg 节点不存在时不绑定 */
+    auto bad_node = AffinityPolicy::numa_node(2).assign(2, topo);
+    CHECK_UNARY(bad_node[0].empty());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_WorkerPlacement") {
+    CpuTopology topo({{0, 1, 2, 3}, {4, 5, 6, 7}});
+
+    /** @arg 未绑定时按环形顺序窃取 */
+    WorkerPlacement none(AffinityPolicy::none(), 4, topo);
+    CHECK_EQ(none.node(0), -1);
+    std::vector<int> expect{2, 3, 0};
+    CHECK_EQ(none.steal_order(1), expect);
+
+    /** @arg 同节点的工作线程优先 */
+    WorkerPlacement scatter(AffinityPolicy::scatter(), 4, topo);
+    CHECK_EQ(scatter.node(0), 0);
+    CHECK_EQ(scatter.node(1), 1);
+    expect = {2, 1, 3};
+    CHECK_EQ(scatter.steal_order(0), expect);
+    expect = {1, 0, 2};
+    CHECK_EQ(scatter.steal_order(3), expect);
+
+    /** @arg 显式绑定时按 CPU 所在节点确定工作线程所在节点 */
+    WorkerPlacement cross(AffinityPolicy::explicit_cpus({0, 4}), 2, topo);
+    CHECK_EQ(cross.node(1), 1);
+    WorkerPlacement single(AffinityPolicy::none(), 1, topo);
+    CHECK_UNARY(single.steal_order(0).empty());
+
+    /** @arg 工作线程序号越界 */
+    CHECK_THROWS_AS(single.steal_order(1), std::out_of_range);
+    CHECK_THROWS_AS(single.cpus(1), std::out_of_range);
+}
+
+template <class TaskGroup>
+static void check_affinity_pool(TaskGroup& tg) {
+    std::atomic<int> count{0};
+    tg.submit_n(100, [&count](size_t) { count++; }).get();
+    CHECK_EQ(count.load(), 100);
+    tg.join();
+}
+
+/** @par 检测点 */
+TEST_CASE("test_thread_pool_affinity") {
+    const auto& topo = CpuTopology::system();
+    int first_cpu = topo.cpus().front();
+
+    {
+        ThreadPool tg(2, AffinityPolicy::compact());
+        check_affinity_pool(tg);
+    }
+    {
+        MQThreadPool tg(2, AffinityPolicy::scatter());
+        check_affinity_pool(tg);
+    }
+    {
+        StealThreadPool tg(2, AffinityPolicy::explicit_cpus({first_cpu}));
+        check_affinity_pool(tg);
+    }
+    {
+        GlobalStealThreadPool tg(2, AffinityPolicy::numa_node(0));
+        check_affinity_pool(tg);
+    }
+
+    init_global_task_group(0, AffinityPolicy::numa_node(0));
+    CHECK_EQ(get_global_task_group()->worker_num(), topo.node_cpus(0).size());
+    auto result = global_parallel_for_index(0, 100, [](size_t i) { return i; });
+    CHECK_EQ(result.size(), 100);
+    release_global_task_group();
+}
+
+/** @} */
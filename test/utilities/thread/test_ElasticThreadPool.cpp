@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "test_config.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+#include <hikyuu/utilities/thread/thread.h>
+#include <hikyuu/utilities/SpendTimer.h>
+#include <hikyuu/utilities/Log.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_ElasticThreadPool test_hikyuu_ElasticThreadPool
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+template <class Predicate>
+static bool wait_until(Predicate pred, int timeout_ms = 2000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/** @par 检测点 */
+TEST_CASE("test_ElasticThreadPool") {
+    ElasticThreadPool tg(1, 4, std::chrono::milliseconds(20));
+    CHECK_EQ(tg.worker_num(), 1);
+    CHECK_EQ(tg.min_threads(), 1);
+    CHECK_EQ(tg.max_threads(), 4);
+
+    /** @arg 排队任务增多时扩容，但不超过上限 */
+    std::atomic<int> count{0};
+    auto res = tg.submit_n(16, [&count](size_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        count++;
+    });
+    CHECK_EQ(tg.worker_num(), 4);
+    res.get();
+    CHECK_EQ(count.load(), 16);
+    CHECK_EQ(tg.peak_worker_num(), 4);
+    CHECK_EQ(tg.created_count(), 4);
+
+    /** @arg 空闲超时后缩容至常驻线程数 */
+    CHECK_UNARY(wait_until([&tg]() { return tg.worker_num() == 1; }));
+    CHECK_EQ(tg.retired_count(), 3);
+
+    /** @arg 缩容后可再次扩容 */
+    auto f = tg.submit([]() { return 42; });
+    CHECK_EQ(f.get(), 42);
+    auto a = tg.submit_awaitable([]() { return 1; });
+    CHECK_EQ(a.get(), 1);
+
+    tg.join();
+    CHECK_UNARY(tg.done());
+    CHECK_EQ(tg.worker_num(), 0);
+    CHECK_THROWS_AS(tg.submit([]() {}), std::logic_error);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_ElasticThreadPool_min_zero") {
+    /** @arg 无常驻线程时，提交任务才创建线程 */
+    ElasticThreadPool tg(0, 2, std::chrono::milliseconds(10));
+    CHECK_EQ(tg.worker_num(), 0);
+    CHECK_EQ(tg.submit([]() { return 1; }).get(), 1);
+    CHECK_GE(tg.created_count(), 1);
+    CHECK_UNARY(wait_until([&tg]() { return tg.worker_num() == 0; }));
+    CHECK_EQ(tg.submit([]() { return 2; }).get(), 2);
+    tg.join();
+}
+
+/** @par 检测点 */
+TEST_CASE("test_ElasticThreadPool_blocking") {
+    /** @arg 阻塞区间内的线程不计入活动线程数，依赖任务可由新线程执行 */
+    ElasticThreadPool tg(1, 1);
+    std::promise<int> promise;
+    auto waiter = tg.submit([&tg, &promise]() {
+        ElasticThreadPool::BlockingScope blocking(tg);
+        return promise.get_future().get();
+    });
+    auto setter = tg.submit([&promise]() { promise.set_value(7); });
+    CHECK_EQ(waiter.get(), 7);
+    setter.get();
+    CHECK_EQ(tg.peak_worker_num(), 2);
+    tg.join();
+}
+
+/** @par 检测点 */
+TEST_CASE("test_ElasticThreadPool_stop") {
+    ElasticThreadPool tg(2, 2);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 100; i++) {
+        tg.submit([&count]() {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            count++;
+        });
+    }
+    tg.stop();
+    CHECK_LE(count.load(), 100);
+    CHECK_EQ(tg.remain_task_count(), 0);
+    CHECK_UNARY(tg.done());
+}
+
+#if ENABLE_BENCHMARK_TEST
+/** @par 检测点 */
+TEST_CASE("test_ElasticThreadPool_benchmark") {
+    const size_t burst_num = 20;
+    const size_t task_num = 1000;
+    size_t hw = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    /** @arg 突发负载，突发之间的空闲间隔长于 keep_alive，统计线程创建次数 */
+    {
+        ElasticThreadPool tg(1, hw, std::chrono::milliseconds(5));
+        {
+            BENCHMARK_TIME_MSG(elastic_bursts, burst_num, "bursty load on ElasticThreadPool");
+            for (size_t i = 0; i < burst_num; i++) {
+                tg.submit_n(task_num, [](size_t) {}).get();
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        HKU_INFO("elastic bursts: created {} threads, retired {}, peak {}", tg.created_count(),
+                 tg.retired_count(), tg.peak_worker_num());
+    }
+
+    /** @arg 稳态下逐个提交并等待任务的往返延迟 */
+    {
+        ThreadPool tg(hw);
+        BENCHMARK_TIME_MSG(fixed_round_trip, task_num, "round trip on ThreadPool");
+        for (size_t i = 0; i < task_num; i++) {
+            tg.submit([]() {}).get();
+        }
+    }
+    {
+        ElasticThreadPool tg(1, hw);
+        BENCHMARK_TIME_MSG(elastic_round_trip, task_num, "round trip on ElasticThreadPool");
+        for (size_t i = 0; i < task_num; i++) {
+            tg.submit([]() {}).get();
+        }
+    }
+}
+#endif
+
+/** @} */
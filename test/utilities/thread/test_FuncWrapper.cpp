@@ -0,0 +1,179 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "test_config.h"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <hikyuu/utilities/thread/thread.h>
+#include <hikyuu/utilities/thread/PackagedTask.h>
+#include <hikyuu/utilities/SpendTimer.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_FuncWrapper test_hikyuu_FuncWrapper
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_FuncWrapper") {
+    CHECK_EQ(sizeof(FuncWrapper), 64);
+
+    /** @arg 空任务 */
+    FuncWrapper null_task;
+    CHECK_UNARY(null_task.isNullTask());
+    CHECK_UNARY_FALSE(null_task.isInline());
+    null_task();
+
+    /** @arg 小函数对象内联保存 */
+    int x = 0;
+    FuncWrapper small([&x]() { x++; });
+    CHECK_UNARY(small.isInline());
+    small();
+    CHECK_EQ(x, 1);
+
+    /** @arg 大函数对象使用堆内存 */
+    std::array<char, 128> big_data{};
+    big_data[0] = 2;
+    FuncWrapper big([&x, big_data]() { x += big_data[0]; });
+    CHECK_UNARY_FALSE(big.isInline());
+    big();
+    CHECK_EQ(x, 3);
+
+    /** @arg 移动构造及移动赋值 */
+    std::string str("test");
+    FuncWrapper moved([&x, str]() { x += static_cast<int>(str.size()); });
+    FuncWrapper other(std::move(moved));
+    CHECK_UNARY(moved.isNullTask());
+    other();
+    CHECK_EQ(x, 7);
+
+    other = std::move(big);
+    CHECK_UNARY(big.isNullTask());
+    other();
+    CHECK_EQ(x, 9);
+
+    /** @arg 仅可移动的函数对象 */
+    auto ptr = std::make_unique<int>(10);
+    FuncWrapper move_only([&x, p = std::move(ptr)]() { x += *p; });
+    CHECK_UNARY(move_only.isInline());
+    move_only();
+    CHECK_EQ(x, 19);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_package_task") {
+    /** @arg 有返回值 */
+    FuncWrapper task;
+    auto fut = package_task([]() { return 42; }, task);
+    CHECK_UNARY(task.isInline());
+    task();
+    CHECK_EQ(fut.get(), 42);
+
+    /** @arg 无返回值 */
+    int x = 0;
+    auto void_fut = package_task([&x]() { x = 1; }, task);
+    task();
+    void_fut.get();
+    CHECK_EQ(x, 1);
+
+    /** @arg 异常传递 */
+    auto err_fut = package_task([]() -> int { throw std::runtime_error("error"); }, task);
+    task();
+    CHECK_THROWS_AS(err_fut.get(), std::runtime_error);
+
+    /** @arg 任务未执行即销毁 */
+    auto broken_fut = package_task([]() { return 1; }, task);
+    task = FuncWrapper();
+    CHECK_THROWS_AS(broken_fut.get(), std::future_error);
+
+    /** @arg 线程池中执行 */
+    ThreadPool tg(2);
+    std::vector<std::future<size_t>> futures;
+    for (size_t i = 0; i < 100; i++) {
+        futures.emplace_back(tg.submit([i]() { return i * 2; }));
+    }
+    for (size_t i = 0; i < 100; i++) {
+        CHECK_EQ(futures[i].get(), i * 2);
+    }
+    tg.join();
+}
+
+#if ENABLE_BENCHMARK_TEST
+static std::atomic<size_t> g_alloc_count{0};
+
+void* operator new(std::size_t n) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(n == 0 ? 1 : n);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_package_task_benchmark") {
+    const int total = 1000000;
+
+    {
+        // 原实现: std::packaged_task 包装后再由 FuncWrapper 堆分配
+        size_t start = g_alloc_count.load();
+        BENCHMARK_TIME_MSG(packaged_task, total, "std::packaged_task");
+        for (int i = 0; i < total; i++) {
+            std::packaged_task<int()> pt([i]() { return i; });
+            auto fut = pt.get_future();
+            auto* task = new std::packaged_task<int()>(std::move(pt));
+            (*task)();
+            delete task;
+            fut.get();
+        }
+        HKU_INFO("std::packaged_task allocations per task: {:.2f}",
+                 double(g_alloc_count.load() - start) / total);
+    }
+
+    {
+        size_t start = g_alloc_count.load();
+        BENCHMARK_TIME_MSG(package_task, total, "package_task");
+        FuncWrapper task;
+        for (int i = 0; i < total; i++) {
+            auto fut = package_task([i]() { return i; }, task);
+            task();
+            fut.get();
+        }
+        size_t count = g_alloc_count.load() - start;
+        HKU_INFO("package_task allocations per task: {:.2f}", double(count) / total);
+        CHECK_LT(count, total / 100);
+    }
+
+    {
+        ThreadPool tg(1);
+        // 预热
+        tg.submit([]() { return 0; }).get();
+        size_t start = g_alloc_count.load();
+        BENCHMARK_TIME_MSG(ThreadPool_submit, total, "ThreadPool submit");
+        for (int i = 0; i < total; i++) {
+            tg.submit([i]() { return i; }).get();
+        }
+        HKU_INFO("ThreadPool submit allocations per task: {:.2f}",
+                 double(g_alloc_count.load() - start) / total);
+        tg.join();
+    }
+}
+#endif
+
+/** @} */
@@ -0,0 +1,229 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "test_config.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <hikyuu/utilities/thread/WorkStealQueue.h>
+#include <hikyuu/utilities/thread/LockFreeStealQueue.h>
+#include <hikyuu/utilities/SpendTimer.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_LockFreeStealQueue test_hikyuu_LockFreeStealQueue
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_LockFreeStealQueue_single_thread") {
+    LockFreeStealQueue<FuncWrapper> queue(2);
+    CHECK_UNARY(queue.empty());
+
+    std::vector<int> order;
+    for (int i = 0; i < 10; i++) {
+        queue.push_front(FuncWrapper([i, &order]() { order.push_back(i); }));
+    }
+    CHECK_EQ(queue.size(), 10);
+
+    /** @arg 本地端后进先出 */
+    FuncWrapper task;
+    CHECK_UNARY(queue.try_pop(task));
+    task();
+    CHECK_EQ(order.back(), 9);
+
+    /** @arg 偷取端取最早加入的任务 */
+    CHECK_UNARY(queue.try_steal(task));
+    task();
+    CHECK_EQ(order.back(), 0);
+    CHECK_EQ(queue.size(), 8);
+
+    /** @arg 外部队列在本地任务之后取出，且空任务不会被偷取 */
+    queue.push_back(FuncWrapper());
+    while (queue.try_pop(task)) {
+        if (task.isNullTask()) {
+            break;
+        }
+        task();
+    }
+    CHECK_UNARY(task.isNullTask());
+    CHECK_EQ(order.size(), 10);
+    CHECK_UNARY(queue.empty());
+
+    queue.push_back(FuncWrapper());
+    CHECK_UNARY_FALSE(queue.try_steal(task));
+    queue.clear();
+    CHECK_UNARY(queue.empty());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_LockFreeStealQueue_concurrent") {
+    const int total = 100000;
+    const int thief_num = 4;
+    LockFreeStealQueue<FuncWrapper> queue(16);
+    std::atomic<int> executed{0};
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < thief_num; i++) {
+        thieves.emplace_back([&]() {
+            FuncWrapper task;
+            while (!done.load(std::memory_order_acquire)) {
+                if (queue.try_steal(task)) {
+                    task();
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    FuncWrapper task;
+    for (int i = 0; i < total; i++) {
+        queue.push_front(FuncWrapper([&executed]() { executed++; }));
+        if (i % 3 == 0 && queue.try_pop(task)) {
+            task();
+        }
+    }
+    while (queue.try_pop(task)) {
+        task();
+    }
+
+    // 等待偷取线程执行完已偷取的任务
+    while (executed.load() != total) {
+        std::this_thread::yield();
+    }
+    done = true;
+    for (auto& t : thieves) {
+        t.join();
+    }
+
+    CHECK_EQ(executed.load(), total);
+    CHECK_UNARY(queue.empty());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_LockFreeStealQueue_contended") {
+    // 所有者批量压入后再逐个弹出，偷取线程同时偷取，队列将空时与所有者争抢最后的任务
+    const int rounds = 2000;
+    const int batch = 64;
+    const int total = rounds * batch;
+    const int thief_num = 4;
+    LockFreeStealQueue<FuncWrapper> queue(16);
+    std::vector<std::atomic<int>> counts(total);
+    std::atomic<int> executed{0};
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < thief_num; i++) {
+        thieves.emplace_back([&]() {
+            FuncWrapper task;
+            while (!done.load(std::memory_order_acquire)) {
+                if (queue.try_steal(task)) {
+                    task();
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    FuncWrapper task;
+    for (int r = 0; r < rounds; r++) {
+        for (int i = r * batch; i < (r + 1) * batch; i++) {
+            queue.push_front(FuncWrapper([&counts, &executed, i]() {
+                counts[i]++;
+                executed++;
+            }));
+        }
+        while (queue.try_pop(task)) {
+            task();
+        }
+    }
+
+    while (executed.load() != total) {
+        std::this_thread::yield();
+    }
+    done = true;
+    for (auto& t : thieves) {
+        t.join();
+    }
+
+    int wrong = 0;
+    for (const auto& count : counts) {
+        wrong += count.load() == 1 ? 0 : 1;
+    }
+    CHECK_EQ(wrong, 0);
+    CHECK_EQ(executed.load(), total);
+    CHECK_UNARY(queue.empty());
+}
+
+#if ENABLE_BENCHMARK_TEST
+// 所有者每次压入 batch 个任务后弹出至队列为空，batch 为 1 时偷取线程几乎不与所有者争抢
+template <class QueueType>
+static void bench_steal_queue(QueueType& queue, int total, int thief_num, int batch) {
+    std::atomic<int> executed{0};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < thief_num; i++) {
+        thieves.emplace_back([&]() {
+            FuncWrapper task;
+            while (!done.load(std::memory_order_acquire)) {
+                if (queue.try_steal(task)) {
+                    task();
+                }
+            }
+        });
+    }
+
+    FuncWrapper task;
+    for (int i = 0; i < total; i += batch) {
+        for (int j = 0; j < batch; j++) {
+            queue.push_front(FuncWrapper([&executed]() { executed++; }));
+        }
+        while (queue.try_pop(task)) {
+            task();
+        }
+    }
+    while (executed.load() != total) {
+        if (queue.try_pop(task)) {
+            task();
+        }
+    }
+    done = true;
+    for (auto& t : thieves) {
+        t.join();
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_LockFreeStealQueue_benchmark") {
+    const int total = 1000000;
+    size_t cpu_num = std::thread::hardware_concurrency();
+    for (size_t thief_num = 1; thief_num <= std::max<size_t>(cpu_num, 2); thief_num *= 2) {
+        for (int batch : {1, 64}) {
+            {
+                WorkStealQueue queue;
+                BENCHMARK_TIME_MSG(WorkStealQueue, total, "WorkStealQueue, thieves: {}, batch: {}",
+                                   thief_num, batch);
+                bench_steal_queue(queue, total, thief_num, batch);
+            }
+            {
+                LockFreeStealQueue<FuncWrapper> queue;
+                BENCHMARK_TIME_MSG(LockFreeStealQueue, total,
+                                   "LockFreeStealQueue, thieves: {}, batch: {}", thief_num, batch);
+                bench_steal_queue(queue, total, thief_num, batch);
+            }
+        }
+    }
+}
+#endif
+
+/** @} */
@@ -0,0 +1,250 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "test_config.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <hikyuu/utilities/thread/thread.h>
+#include <hikyuu/utilities/SpendTimer.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_Partitioner test_hikyuu_Partitioner
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+static std::vector<Partitioner> all_partitioners() {
+    return {static_partitioner(), guided_partitioner(), guided_partitioner(7),
+            dynamic_partitioner(), dynamic_partitioner(13), auto_partitioner()};
+}
+
+/** @par 检测点 */
+TEST_CASE("test_PartitionRange") {
+    /** @arg 静态划分，余数分摊至前面的区间 */
+    PartitionRange pr(static_partitioner(), 10, 20, 4);
+    std::vector<range_t> ranges;
+    range_t range;
+    while (pr.next(range)) {
+        ranges.push_back(range);
+    }
+    std::vector<range_t> expect{{10, 13}, {13, 16}, {16, 18}, {18, 20}};
+    CHECK_EQ(ranges, expect);
+
+    /** @arg 静态划分，数量少于线程数 */
+    PartitionRange small(static_partitioner(), 0, 2, 4);
+    ranges.clear();
+    while (small.next(range)) {
+        ranges.push_back(range);
+    }
+    expect = {{0, 1}, {1, 2}};
+    CHECK_EQ(ranges, expect);
+
+    /** @arg 递减划分 */
+    PartitionRange guided(guided_partitioner(), 0, 100, 2);
+    ranges.clear();
+    while (guided.next(range)) {
+        ranges.push_back(range);
+    }
+    REQUIRE_GT(ranges.size(), 2);
+    CHECK_EQ(ranges[0], range_t(0, 25));
+    CHECK_EQ(ranges.back().second, 100);
+    for (size_t i = 1; i < ranges.size(); i++) {
+        CHECK_EQ(ranges[i].first, ranges[i - 1].second);
+        CHECK_LE(ranges[i].second - ranges[i].first, ranges[i - 1].second - ranges[i - 1].first);
+    }
+
+    /** @arg 动态划分 */
+    PartitionRange dynamic(dynamic_partitioner(30), 0, 100, 2);
+    ranges.clear();
+    while (dynamic.next(range)) {
+        ranges.push_back(range);
+    }
+    expect = {{0, 30}, {30, 60}, {60, 90}, {90, 100}};
+    CHECK_EQ(ranges, expect);
+
+    /** @arg 空区间 */
+    for (auto& p : all_partitioners()) {
+        PartitionRange empty(p, 5, 5, 4);
+        CHECK_UNARY_FALSE(empty.next(range));
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_PartitionRange_concurrent") {
+    const size_t total = 100000;
+    for (auto& p : all_partitioners()) {
+        PartitionRange pr(p, 0, total, 4);
+        std::vector<std::atomic<int>> visited(total);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&]() {
+                range_t range;
+                while (pr.next(range)) {
+                    auto start_time = std::chrono::steady_clock::now();
+                    for (size_t i = range.first; i < range.second; i++) {
+                        visited[i]++;
+                    }
+                    if (pr.need_timing()) {
+                        pr.report(range, std::chrono::steady_clock::now() - start_time);
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        for (size_t i = 0; i < total; i++) {
+            CHECK_EQ(visited[i].load(), 1);
+        }
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_parallel_for_partitioner") {
+    const size_t total = 1003;
+    std::vector<size_t> expect(total);
+    for (size_t i = 0; i < total; i++) {
+        expect[i] = i * 2;
+    }
+
+    for (auto& p : all_partitioners()) {
+        std::vector<size_t> values(total, 0);
+        parallel_for_index_void(0, total, [&values](size_t i) { values[i] = i * 2; }, p, 4);
+        CHECK_EQ(values, expect);
+
+        auto result = parallel_for_index(0, total, [](size_t i) { return i * 2; }, p, 4);
+        CHECK_EQ(result, expect);
+
+        auto range_result = parallel_for_range(
+          0, total,
+          [](const range_t& range) {
+              std::vector<size_t> ret;
+              for (size_t i = range.first; i < range.second; i++) {
+                  ret.push_back(i * 2);
+              }
+              return ret;
+          },
+          p, 4);
+        CHECK_EQ(range_result, expect);
+    }
+
+    /** @arg 异常传递 */
+    CHECK_THROWS_AS(parallel_for_index_void(
+                      0, 100,
+                      [](size_t i) {
+                          if (i == 50) {
+                              throw std::runtime_error("error");
+                          }
+                      },
+                      dynamic_partitioner(), 4),
+                    std::runtime_error);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_global_parallel_for_partitioner") {
+    init_global_task_group(4);
+
+    const size_t total = 1003;
+    std::vector<size_t> expect(total);
+    for (size_t i = 0; i < total; i++) {
+        expect[i] = i * 2;
+    }
+
+    for (auto& p : all_partitioners()) {
+        std::vector<size_t> values(total, 0);
+        global_parallel_for_index_void(0, total, [&values](size_t i) { values[i] = i * 2; }, p);
+        CHECK_EQ(values, expect);
+
+        auto result = global_parallel_for_index(0, total, [](size_t i) { return i * 2; }, p);
+        CHECK_EQ(result, expect);
+    }
+
+    /** @arg 嵌套 */
+    auto nested = global_parallel_for_index(
+      0, 10,
+      [](size_t i) {
+          auto one = global_parallel_for_index(0, 10, [i](size_t j) { return i * 10 + j; },
+                                               guided_partitioner());
+          size_t sum = 0;
+          for (auto v : one) {
+              sum += v;
+          }
+          return sum;
+      },
+      dynamic_partitioner());
+    for (size_t i = 0; i < 10; i++) {
+        CHECK_EQ(nested[i], i * 100 + 45);
+    }
+
+    release_global_task_group();
+}
+
+#if ENABLE_BENCHMARK_TEST
+static void spin_work(size_t n) {
+    volatile size_t x = 0;
+    for (size_t i = 0; i < n; i++) {
+        x = x + i;
+    }
+}
+
+template <class LoadFunc>
+static void bench_partitioners(const char* name, size_t total, LoadFunc load) {
+    auto f = [&load](size_t i) { spin_work(load(i)); };
+    {
+        BENCHMARK_TIME_MSG(parallelIndexRange, total, "{} parallelIndexRange", name);
+        parallel_for_index_void(0, total, f);
+    }
+    {
+        BENCHMARK_TIME_MSG(static_partitioner, total, "{} static", name);
+        parallel_for_index_void(0, total, f, static_partitioner());
+    }
+    {
+        BENCHMARK_TIME_MSG(guided_partitioner, total, "{} guided", name);
+        parallel_for_index_void(0, total, f, guided_partitioner());
+    }
+    {
+        BENCHMARK_TIME_MSG(dynamic_partitioner, total, "{} dynamic", name);
+        parallel_for_index_void(0, total, f, dynamic_partitioner(16));
+    }
+    {
+        BENCHMARK_TIME_MSG(auto_partitioner, total, "{} auto", name);
+        parallel_for_index_void(0, total, f, auto_partitioner());
+    }
+
+    init_global_task_group();
+    {
+        BENCHMARK_TIME_MSG(global_parallelIndexRange, total, "{} global parallelIndexRange", name);
+        global_parallel_for_index_void(0, total, f);
+    }
+    {
+        BENCHMARK_TIME_MSG(global_guided_partitioner, total, "{} global guided", name);
+        global_parallel_for_index_void(0, total, f, guided_partitioner());
+    }
+    {
+        BENCHMARK_TIME_MSG(global_auto_partitioner, total, "{} global auto", name);
+        global_parallel_for_index_void(0, total, f, auto_partitioner());
+    }
+    release_global_task_group();
+}
+
+/** @par 检测点 */
+TEST_CASE("test_partitioner_benchmark") {
+    const size_t total = 100003;
+
+    // 均匀负载
+    bench_partitioners("uniform", total, [](size_t) { return 2000; });
+
+    // 倾斜负载：前 1/16 的索引耗时是其他索引的 64 倍
+    bench_partitioners("skewed", total,
+                       [total](size_t i) { return i < total / 16 ? 64 * 200 : 200; });
+}
+#endif
+
+/** @} */
@@ -0,0 +1,218 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "test_config.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <hikyuu/utilities/thread/thread.h>
+#include <hikyuu/utilities/SpendTimer.h>
+#include <hikyuu/utilities/Log.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_PriorityMQThreadPool test_hikyuu_PriorityMQThreadPool
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** 阻塞唯一的工作线程，直至 release 被置位 */
+template <class ThreadPoolType>
+static void block_worker(ThreadPoolType& tg, std::atomic<bool>& release) {
+    tg.submit(0, [&release]() {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    while (tg.remain_task_count() != 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_PriorityTaskQueue") {
+    PriorityTaskQueue queue(3, std::chrono::steady_clock::duration::zero());
+    CHECK_EQ(queue.levels(), 3);
+
+    std::vector<int> order;
+    queue.push(2, [&order]() { order.push_back(2); });
+    queue.push(100, [&order]() { order.push_back(3); });
+    queue.push(0, FuncWrapper());
+    queue.push(1, [&order]() { order.push_back(1); });
+    queue.push(0, [&order]() { order.push_back(0); });
+    CHECK_EQ(queue.size(), 5);
+
+    /** @arg 空任务不可被偷取 */
+    FuncWrapper task;
+    while (queue.try_steal(task)) {
+        task();
+    }
+    std::vector<int> expect{0, 1, 2, 3};
+    CHECK_EQ(order, expect);
+    CHECK_EQ(queue.size(), 1);
+
+    /** @arg 空任务在队列中没有其他任务时才被取出 */
+    CHECK_UNARY(queue.try_pop(task));
+    CHECK_UNARY(task.isNullTask());
+    CHECK_UNARY(queue.empty());
+    CHECK_UNARY_FALSE(queue.try_pop(task));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_PriorityMQThreadPool") {
+    PriorityMQThreadPool tg(4);
+    CHECK_EQ(tg.worker_num(), 4);
+    CHECK_EQ(tg.priority_levels(), 3);
+    CHECK_EQ(tg.default_priority(), 1);
+
+    auto f1 = tg.submit([]() { return 1; });
+    auto f2 = tg.submit(0, []() { return 2; });
+    auto f3 = tg.submit_awaitable(2, []() { return 3; });
+    CHECK_EQ(f1.get() + f2.get() + f3.get(), 6);
+
+    std::atomic<int> count{0};
+    tg.submit_n(2, 100, [&count](size_t) { count++; }).get();
+    std::vector<std::function<void()>> tasks(50, [&count]() { count++; });
+    tg.submit_bulk(0, tasks.begin(), tasks.end()).get();
+    CHECK_EQ(count.load(), 150);
+
+    tg.join();
+    CHECK_THROWS_AS(tg.submit([]() {}), std::logic_error);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_PriorityMQThreadPool_order") {
+    /** @arg 不提升优先级时，严格按优先级执行，同一优先级先进先出 */
+    PriorityMQThreadPool tg(1, 3, std::chrono::milliseconds(0));
+    std::atomic<bool> release{false};
+    block_worker(tg, release);
+
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&mutex, &order](int i) {
+        return [&mutex, &order, i]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+        };
+    };
+    tg.submit(2, record(20));
+    tg.submit(1, record(10));
+    tg.submit(2, record(21));
+    tg.submit(0, record(0));
+    tg.submit(0, record(1));
+    release = true;
+    tg.join();
+
+    std::vector<int> expect{0, 1, 10, 20, 21};
+    CHECK_EQ(order, expect);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_PriorityMQThreadPool_aging") {
+    /** @arg 低优先级任务等待足够长时间后，先于新到达的高优先级任务执行 */
+    PriorityMQThreadPool tg(1, 3, std::chrono::milliseconds(1));
+    std::atomic<bool> release{false};
+    block_worker(tg, release);
+
+    std::mutex mutex;
+    std::vector<int> order;
+    tg.submit(2, [&mutex, &order]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(2);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    tg.submit(0, [&mutex, &order]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(0);
+    });
+    release = true;
+    tg.join();
+
+    std::vector<int> expect{2, 0};
+    CHECK_EQ(order, expect);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_PriorityMQThreadPool_stop") {
+    PriorityMQThreadPool tg(2);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 10; i++) {
+        tg.submit(i % 3, [&count]() { count++; });
+    }
+    tg.stop();
+    CHECK_LE(count.load(), 10);
+    CHECK_UNARY(tg.done());
+    CHECK_EQ(tg.remain_task_count(), 0);
+}
+
+#if ENABLE_BENCHMARK_TEST
+template <class ThreadPoolType, class Submit>
+static std::vector<int64_t> urgent_latency(ThreadPoolType& tg, Submit submit) {
+    using namespace std::chrono;
+    const size_t bulk_num = 5000 * tg.worker_num();
+    const size_t urgent_num = 200;
+
+    // 持续饱和的低优先级批量任务
+    std::atomic<bool> stop{false};
+    auto bulk = [&stop]() {
+        auto start = steady_clock::now();
+        while (!stop && steady_clock::now() - start < microseconds(50)) {
+        }
+    };
+
+    std::vector<int64_t> latency(urgent_num);
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < bulk_num; i++) {
+        submit(tg, 2, bulk);
+    }
+    for (size_t i = 0; i < urgent_num; i++) {
+        auto created = steady_clock::now();
+        futures.emplace_back(submit(tg, 0, [&latency, i, created]() {
+            latency[i] = duration_cast<microseconds>(steady_clock::now() - created).count();
+        }));
+        std::this_thread::sleep_for(microseconds(200));
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+    stop = true;
+    tg.join();
+
+    std::sort(latency.begin(), latency.end());
+    return latency;
+}
+
+/** @par 检测点 */
+TEST_CASE("test_PriorityMQThreadPool_benchmark") {
+    std::vector<int64_t> fifo, priority;
+    {
+        BENCHMARK_TIME_MSG(mq_fifo, 1, "urgent tasks behind bulk tasks in MQThreadPool");
+        MQThreadPool tg;
+        fifo = urgent_latency(
+          tg, [](MQThreadPool& tg, size_t, auto&& f) { return tg.submit(std::move(f)); });
+    }
+    {
+        BENCHMARK_TIME_MSG(mq_priority, 1, "urgent tasks with PriorityMQThreadPool");
+        PriorityMQThreadPool tg;
+        priority =
+          urgent_latency(tg, [](PriorityMQThreadPool& tg, size_t priority, auto&& f) {
+              return tg.submit(priority, std::move(f));
+          });
+    }
+
+    size_t p99 = fifo.size() * 99 / 100;
+    HKU_INFO("urgent task latency p99 (us): MQThreadPool {}, PriorityMQThreadPool {}", fifo[p99],
+             priority[p99]);
+    CHECK_LT(priority[p99], fifo[p99]);
+}
+#endif
+
+/** @} */
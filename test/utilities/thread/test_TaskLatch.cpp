@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "test_config.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <hikyuu/utilities/thread/thread.h>
+#include <hikyuu/utilities/SpendTimer.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_TaskLatch test_hikyuu_TaskLatch
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+static size_t fib(size_t n) {
+    if (n < 2) {
+        return n;
+    }
+    size_t a = 0, b = 0;
+    GlobalTaskGroup group;
+    group.run([&a, n]() { a = fib(n - 1); });
+    b = fib(n - 2);
+    group.wait();
+    return a + b;
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TaskLatch") {
+    TaskLatch latch;
+    CHECK_UNARY(latch.ready());
+    latch.wait();
+
+    latch.add(2);
+    CHECK_EQ(latch.count(), 2);
+    CHECK_UNARY_FALSE(latch.wait_for(std::chrono::milliseconds(1)));
+
+    std::thread t([&latch]() {
+        latch.count_down();
+        latch.count_down();
+    });
+    latch.wait();
+    CHECK_UNARY(latch.ready());
+    t.join();
+
+    /** @arg 异常仅保留第一个 */
+    latch.set_exception(std::make_exception_ptr(std::runtime_error("first")));
+    latch.set_exception(std::make_exception_ptr(std::logic_error("second")));
+    CHECK_THROWS_AS(latch.rethrow_if_exception(), std::runtime_error);
+    latch.rethrow_if_exception();
+}
+
+/** @par 检测点 */
+TEST_CASE("test_GlobalStealThreadPool_spawn") {
+    GlobalStealThreadPool tg(4);
+
+    /** @arg spawn_n */
+    std::vector<int> flags(1000, 0);
+    auto f = [&flags](size_t i) { flags[i] = 1; };
+    TaskLatch latch;
+    tg.spawn_n(latch, flags.size(), f);
+    tg.wait(latch);
+    for (auto flag : flags) {
+        CHECK_EQ(flag, 1);
+    }
+
+    /** @arg spawn，子任务异常在 wait 时抛出，且不影响其他子任务 */
+    std::atomic<int> count{0};
+    for (int i = 0; i < 100; i++) {
+        tg.spawn(latch, [&count, i]() {
+            count++;
+            if (i == 50) {
+                throw std::runtime_error("error");
+            }
+        });
+    }
+    CHECK_THROWS_AS(tg.wait(latch), std::runtime_error);
+    CHECK_EQ(count.load(), 100);
+
+    tg.join();
+
+    /** @arg 线程池已停止 */
+    CHECK_THROWS_AS(tg.spawn(latch, []() {}), std::logic_error);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_GlobalTaskGroup") {
+    init_global_task_group(4);
+
+    /** @arg 递归嵌套 */
+    CHECK_EQ(fib(20), 6765);
+
+    /** @arg 析构时等待未完成的子任务 */
+    std::atomic<int> count{0};
+    {
+        GlobalTaskGroup group;
+        for (int i = 0; i < 10; i++) {
+            group.run([&count]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                count++;
+            });
+        }
+    }
+    CHECK_EQ(count.load(), 10);
+
+    /** @arg 嵌套并行循环 */
+    std::vector<std::atomic<int>> visited(100 * 100);
+    global_parallel_for_index_void(0, 100, [&visited](size_t i) {
+        global_parallel_for_index_void_single(0, 100, [&visited, i](size_t j) {
+            visited[i * 100 + j]++;
+        });
+    });
+    for (auto& v : visited) {
+        CHECK_EQ(v.load(), 1);
+    }
+
+    release_global_task_group();
+}
+
+#if ENABLE_BENCHMARK_TEST
+/** @par 检测点 */
+TEST_CASE("test_GlobalTaskGroup_benchmark") {
+    init_global_task_group();
+    const size_t outer = 200;
+    std::atomic<size_t> count{0};
+
+    {
+        BENCHMARK_TIME_MSG(nested_futures, outer, "nested parallel loops with futures");
+        for (size_t n = 0; n < outer; n++) {
+            auto* tg = get_global_task_group();
+            std::vector<BulkFuture> tasks;
+            tasks.emplace_back(tg->submit_n(16, [&count](size_t) {
+                auto* tg = get_global_task_group();
+                std::vector<BulkFuture> inner;
+                inner.emplace_back(tg->submit_n(16, [&count](size_t) { count++; }));
+                wait_for_all_non_blocking(*tg, inner);
+                inner.front().get();
+            }));
+            wait_for_all_non_blocking(*tg, tasks);
+            tasks.front().get();
+        }
+    }
+
+    {
+        BENCHMARK_TIME_MSG(nested_task_group, outer, "nested parallel loops with GlobalTaskGroup");
+        for (size_t n = 0; n < outer; n++) {
+            global_parallel_for_index_void_single(0, 16, [&count](size_t) {
+                global_parallel_for_index_void_single(0, 16, [&count](size_t) { count++; });
+            });
+        }
+    }
+
+    CHECK_EQ(count.load(), outer * 16 * 16 * 2);
+    release_global_task_group();
+}
+#endif
+
+/** @} */
@@ -96,6 +96,35 @@ TEST_CASE("test_StealThreadPool") {
     }
 }
 
+/** @par 检测点 */
+TEST_CASE("test_StealThreadPool_stop") {
+    /** @arg stop 时等待正在执行的任务完成，队列中尚未执行的任务被丢弃 */
+    StealThreadPool tg(1);
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    std::atomic<int> executed{0};
+    tg.submit([&started, &release]() {
+        started = true;
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    while (!started) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (int i = 0; i < 10; i++) {
+        tg.submit([&executed]() { executed++; });
+    }
+
+    std::thread stopper([&tg]() { tg.stop(); });
+    while (!tg.done()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    release = true;
+    stopper.join();
+    CHECK_EQ(executed, 0);
+}
+
 // /** @par 检测点 */
 // TEST_CASE("test_MQStealThreadPool") {
 //     {
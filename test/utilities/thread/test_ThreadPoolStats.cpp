@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "test_config.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <hikyuu/utilities/thread/thread.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_ThreadPoolStats test_hikyuu_ThreadPoolStats
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_LatencyHistogram") {
+    LatencyHistogram h;
+    CHECK_EQ(h.percentile(0.5), 0);
+    CHECK_EQ(h.mean_ns(), 0.0);
+
+    CHECK_EQ(LatencyHistogram::bucket_of(0), 0);
+    CHECK_EQ(LatencyHistogram::bucket_of(1), 1);
+    CHECK_EQ(LatencyHistogram::bucket_of(1000), 10);
+    CHECK_EQ(LatencyHistogram::bucket_of(UINT64_MAX), LatencyHistogram::bucket_num - 1);
+
+    for (int i = 0; i < 99; i++) {
+        h.record(1000);
+    }
+    h.record(1000000);
+    CHECK_EQ(h.count, 100);
+    CHECK_EQ(h.max_ns, 1000000);
+    CHECK_EQ(h.percentile(0.5), 1023);
+    CHECK_EQ(h.percentile(0.99), 1000000);
+    CHECK_EQ(h.percentile(1.0), 1000000);
+
+    /** @arg 合并 */
+    LatencyHistogram other;
+    other.record(10);
+    h.merge(other);
+    CHECK_EQ(h.count, 101);
+    CHECK_EQ(h.total_ns, 99 * 1000 + 1000000 + 10);
+    CHECK_EQ(h.percentile(0.0), 15);
+}
+
+template <class ThreadPoolType>
+static void check_pool_stats(ThreadPoolType& tg) {
+    const size_t n = 200;
+    std::atomic<size_t> count{0};
+    tg.submit_n(n, [&count](size_t) {
+          std::this_thread::sleep_for(std::chrono::microseconds(10));
+          count++;
+      })
+      .get();
+    CHECK_EQ(count.load(), n);
+
+    // 停止后统计不再变化
+    tg.join();
+    auto stats = tg.stats();
+    CHECK_EQ(stats.remain_tasks, 0);
+#if HKU_ENABLE_THREAD_POOL_STATS
+    CHECK_UNARY(stats.enabled);
+    CHECK_EQ(stats.workers.size(), tg.worker_num());
+    auto total = stats.total();
+    CHECK_EQ(total.tasks_executed, n);
+    CHECK_EQ(total.tasks_stolen, total.tasks_stolen_from);
+    CHECK_EQ(total.run_time.count, n);
+    CHECK_EQ(total.queue_latency.count, n);
+    CHECK_GE(total.run_time.max_ns, 10000);
+#else
+    CHECK_UNARY_FALSE(stats.enabled);
+    CHECK_UNARY(stats.workers.empty());
+#endif
+}
+
+/** @par 检测点 */
+TEST_CASE("test_thread_pool_stats") {
+    {
+        ThreadPool tg(2);
+        check_pool_stats(tg);
+    }
+    {
+        MQThreadPool tg(2);
+        check_pool_stats(tg);
+    }
+    {
+        StealThreadPool tg(2);
+        check_pool_stats(tg);
+    }
+    {
+        MQStealThreadPool tg(2);
+        check_pool_stats(tg);
+    }
+    {
+        GlobalThreadPool tg(2);
+        check_pool_stats(tg);
+    }
+    {
+        GlobalMQThreadPool tg(2);
+        check_pool_stats(tg);
+    }
+    {
+        GlobalStealThreadPool tg(2);
+        check_pool_stats(tg);
+    }
+    {
+        GlobalMQStealThreadPool tg(2);
+        check_pool_stats(tg);
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_thread_pool_stats_remain_tasks") {
+    ThreadPool tg(1);
+    std::atomic<bool> release{false};
+    tg.submit([&release]() {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    // 等待唯一的工作线程取走阻塞任务
+    while (tg.remain_task_count() != 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (int i = 0; i < 10; i++) {
+        tg.submit([]() {});
+    }
+    CHECK_EQ(tg.stats().remain_tasks, 10);
+    release = true;
+    tg.join();
+}
+
+/** @} */
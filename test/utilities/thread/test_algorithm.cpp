@@ -5,7 +5,7 @@
  *      Author: fasiondog
  */
 
-#include "doctest/doctest.h"
+#include "test_config.h"
 #include <hikyuu/utilities/thread/thread.h>
 #include <hikyuu/utilities/cppdef.h>
 #include <hikyuu/utilities/thread/ThreadPool.h>
@@ -833,4 +833,154 @@ TEST_CASE("test_parallel_for_index_single") {
     }
 }
 
+TEST_CASE("test_parallel_for_with_task_group") {
+    std::vector<size_t> expect(100);
+    for (size_t i = 0, len = expect.size(); i < len; i++) {
+        expect[i] = i + 1;
+    }
+    auto f = [](size_t i) { return i + 1; };
+    auto range_f = [](range_t range) {
+        std::vector<size_t> ret;
+        for (size_t i = range.first; i < range.second; i++) {
+            ret.push_back(i + 1);
+        }
+        return ret;
+    };
+
+    /** @arg 同一线程池多次调用，结果与按调用创建线程池的版本一致 */
+    MQThreadPool tg(4);
+    for (int n = 0; n < 3; n++) {
+        CHECK_EQ(parallel_for_index(tg, 0, expect.size(), f), expect);
+        CHECK_EQ(parallel_for_range(tg, 0, expect.size(), range_f), expect);
+        CHECK_EQ(parallel_for_index_single(tg, 0, expect.size(), f), expect);
+        CHECK_EQ(parallel_for_index(tg, 0, expect.size(), f, guided_partitioner()), expect);
+        CHECK_EQ(parallel_for_range(tg, 0, expect.size(), range_f, dynamic_partitioner(8)),
+                 expect);
+
+        std::vector<size_t> values(expect.size());
+        parallel_for_index_void(tg, 0, values.size(), [&values](size_t i) { values[i] = i + 1; });
+        CHECK_EQ(values, expect);
+
+        std::fill(values.begin(), values.end(), 0);
+        parallel_for_index_void_single(tg, 0, values.size(),
+                                       [&values](size_t i) { values[i] = i + 1; });
+        CHECK_EQ(values, expect);
+
+        std::fill(values.begin(), values.end(), 0);
+        parallel_for_index_void(
+          tg, 0, values.size(), [&values](size_t i) { values[i] = i + 1; }, static_partitioner());
+        CHECK_EQ(values, expect);
+    }
+    CHECK_UNARY_FALSE(tg.done());
+    CHECK_EQ(tg.remain_task_count(), 0);
+
+    /** @arg 空区间 */
+    CHECK_UNARY(parallel_for_index(tg, 10, 10, f).empty());
+    CHECK_UNARY(parallel_for_range(tg, 10, 5, range_f).empty());
+
+    /** @arg 任务中的异常在调用处重新抛出，线程池仍可继续使用 */
+    CHECK_THROWS_AS(parallel_for_index_void(tg, 0, 10,
+                                            [](size_t i) {
+                                                if (i == 5) {
+                                                    throw std::runtime_error("error");
+                                                }
+                                            }),
+                    std::runtime_error);
+    CHECK_EQ(parallel_for_index(tg, 0, expect.size(), f), expect);
+
+    /** @arg 任务抛出异常时，返回前等待其余任务全部结束 */
+    std::atomic<int> running{0};
+    auto throw_f = [&running](size_t i) {
+        running++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        running--;
+        if (i == 0) {
+            throw std::runtime_error("error");
+        }
+        return i;
+    };
+    auto throw_range_f = [&throw_f](range_t range) {
+        std::vector<size_t> ret;
+        for (size_t i = range.first; i < range.second; i++) {
+            ret.push_back(throw_f(i));
+        }
+        return ret;
+    };
+    CHECK_THROWS_AS(parallel_for_index(tg, 0, 20, throw_f), std::runtime_error);
+    CHECK_EQ(running, 0);
+    CHECK_THROWS_AS(parallel_for_index_single(tg, 0, 20, throw_f), std::runtime_error);
+    CHECK_EQ(running, 0);
+    CHECK_THROWS_AS(parallel_for_range(tg, 0, 20, throw_range_f), std::runtime_error);
+    CHECK_EQ(running, 0);
+    CHECK_EQ(tg.remain_task_count(), 0);
+
+    /** @arg 其他类型的线程池 */
+    ThreadPool pool(2);
+    CHECK_EQ(parallel_for_index(pool, 0, expect.size(), f), expect);
+    ElasticThreadPool elastic(0, 4);
+    CHECK_EQ(parallel_for_index(elastic, 0, expect.size(), f), expect);
+    CHECK_EQ(parallel_for_index(elastic, 0, expect.size(), f, auto_partitioner()), expect);
+}
+
+TEST_CASE("test_default_parallel_task_group") {
+    auto* tg = get_default_parallel_task_group();
+    REQUIRE(tg != nullptr);
+    CHECK_EQ(get_default_parallel_task_group(), tg);
+    CHECK_EQ(tg->worker_num(), std::thread::hardware_concurrency());
+
+    std::vector<size_t> values(100);
+    parallel_for_index_void(*tg, 0, values.size(), [&values](size_t i) { values[i] = i; });
+    for (size_t i = 0, len = values.size(); i < len; i++) {
+        CHECK_EQ(values[i], i);
+    }
+
+    release_default_parallel_task_group();
+    CHECK_EQ(parallel_for_index(*get_default_parallel_task_group(), 0, 3,
+                                [](size_t i) { return i; })
+               .size(),
+             3);
+    release_default_parallel_task_group();
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_parallel_for_with_task_group_benchmark") {
+    /** @arg 小规模任务反复调用时的单次调用开销 */
+    const size_t call_num = 1000;
+    const size_t total = 64;
+    std::vector<size_t> values(total);
+    auto f = [&values](size_t i) { values[i] = i; };
+    {
+        BENCHMARK_TIME_MSG(parallel_for_new_pool, call_num, "new MQThreadPool per call, N={}",
+                           total);
+        for (size_t n = 0; n < call_num; n++) {
+            parallel_for_index_void(0, total, f);
+        }
+    }
+    {
+        auto* tg = get_default_parallel_task_group();
+        BENCHMARK_TIME_MSG(parallel_for_default_pool, call_num, "default task group, N={}",
+                           total);
+        for (size_t n = 0; n < call_num; n++) {
+            parallel_for_index_void(*tg, 0, total, f);
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(parallel_for_index_new_pool, call_num,
+                           "parallel_for_index new MQThreadPool per call, N={}", total);
+        for (size_t n = 0; n < call_num; n++) {
+            parallel_for_index(0, total, [](size_t i) { return i; });
+        }
+    }
+    {
+        auto* tg = get_default_parallel_task_group();
+        BENCHMARK_TIME_MSG(parallel_for_index_default_pool, call_num,
+                           "parallel_for_index default task group, N={}", total);
+        for (size_t n = 0; n < call_num; n++) {
+            parallel_for_index(*tg, 0, total, [](size_t i) { return i; });
+        }
+    }
+    release_default_parallel_task_group();
+}
+#endif
+
 /** @} */
@@ -0,0 +1,236 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "test_config.h"
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include <hikyuu/utilities/thread/thread.h>
+#include <hikyuu/utilities/SpendTimer.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_parallel_reduce test_hikyuu_parallel_reduce
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_global_parallel_reduce") {
+    init_global_task_group(4);
+
+    std::vector<int64_t> values(100003);
+    std::iota(values.begin(), values.end(), 1);
+    int64_t expect = int64_t(values.size()) * int64_t(values.size() + 1) / 2;
+
+    /** @arg 空区间返回初始值 */
+    CHECK_EQ(global_parallel_reduce(values.begin(), values.begin(), int64_t(5)), 5);
+
+    /** @arg 低于阈值串行执行 */
+    CHECK_EQ(global_parallel_reduce(values.begin(), values.begin() + 10, int64_t(0)), 55);
+
+    /** @arg 各划分策略 */
+    for (auto& p : {static_partitioner(), guided_partitioner(), dynamic_partitioner(100),
+                    auto_partitioner()}) {
+        CHECK_EQ(global_parallel_reduce(values.begin(), values.end(), int64_t(0), std::plus<>(), p),
+                 expect);
+        CHECK_EQ(global_parallel_reduce(values.data(), values.data() + values.size(), int64_t(10),
+                                        std::plus<>(), p, 1),
+                 expect + 10);
+    }
+
+    /** @arg transform_reduce */
+    auto square_sum = global_parallel_transform_reduce(
+      values.begin(), values.begin() + 1000, int64_t(0), std::plus<>(),
+      [](int64_t v) { return v * v; }, guided_partitioner(), 1);
+    CHECK_EQ(square_sum, int64_t(1000) * 1001 * 2001 / 6);
+
+    /** @arg 结果类型无默认构造函数 */
+    struct MaxValue {
+        explicit MaxValue(int64_t v) : value(v) {}
+        int64_t value;
+    };
+    auto max_value = global_parallel_transform_reduce(
+      values.begin(), values.end(), MaxValue(-1),
+      [](const MaxValue& a, const MaxValue& b) { return a.value >= b.value ? a : b; },
+      [](int64_t v) { return MaxValue(v); });
+    CHECK_EQ(max_value.value, int64_t(values.size()));
+
+    /** @arg 异常传递 */
+    CHECK_THROWS_AS(global_parallel_transform_reduce(values.begin(), values.end(), int64_t(0),
+                                                     std::plus<>(),
+                                                     [](int64_t v) -> int64_t {
+                                                         if (v == 5000) {
+                                                             throw std::runtime_error("error");
+                                                         }
+                                                         return v;
+                                                     }),
+                    std::runtime_error);
+
+    /** @arg 嵌套 */
+    auto nested = global_parallel_transform_reduce(
+      values.begin(), values.begin() + 100, int64_t(0), std::plus<>(),
+      [&values](int64_t) {
+          return global_parallel_reduce(values.begin(), values.begin() + 2000, int64_t(0),
+                                        std::plus<>(), guided_partitioner(), 1);
+      },
+      dynamic_partitioner(), 1);
+    CHECK_EQ(nested, int64_t(100) * 2000 * 2001 / 2);
+
+    release_global_task_group();
+}
+
+/** @par 检测点 */
+TEST_CASE("test_global_parallel_inclusive_scan") {
+    init_global_task_group(4);
+
+    for (size_t total : {0, 1, 3, 1000, 100003}) {
+        std::vector<int64_t> values(total);
+        std::iota(values.begin(), values.end(), 1);
+        std::vector<int64_t> expect(total);
+        std::inclusive_scan(values.begin(), values.end(), expect.begin());
+
+        std::vector<int64_t> out(total, 0);
+        auto it = global_parallel_inclusive_scan(values.begin(), values.end(), out.begin(),
+                                                 std::plus<>(), 1);
+        CHECK_UNARY(it == out.end());
+        CHECK_EQ(out, expect);
+
+        /** @arg 原地扫描 */
+        global_parallel_inclusive_scan(values.begin(), values.end(), values.begin());
+        CHECK_EQ(values, expect);
+    }
+
+    /** @arg 非交换操作 */
+    std::vector<std::string> strs(100);
+    for (size_t i = 0; i < strs.size(); i++) {
+        strs[i] = std::to_string(i % 10);
+    }
+    std::vector<std::string> expect(strs.size());
+    std::inclusive_scan(strs.begin(), strs.end(), expect.begin());
+    std::vector<std::string> out(strs.size());
+    global_parallel_inclusive_scan(strs.begin(), strs.end(), out.begin(), std::plus<>(), 1);
+    CHECK_EQ(out, expect);
+
+    release_global_task_group();
+}
+
+/** @par 检测点 */
+TEST_CASE("test_global_parallel_sort") {
+    init_global_task_group(3);
+
+    std::mt19937 gen(1);
+    for (size_t total : {0, 1, 2, 100, 100003}) {
+        std::vector<int> values(total);
+        for (auto& v : values) {
+            v = gen() % 1000;
+        }
+        auto expect = values;
+        std::sort(expect.begin(), expect.end());
+
+        auto desc = values;
+        global_parallel_sort(values.begin(), values.end(), std::less<>(), 1);
+        CHECK_EQ(values, expect);
+
+        /** @arg 自定义比较 */
+        global_parallel_sort(desc.begin(), desc.end(), std::greater<>(), 1);
+        std::reverse(expect.begin(), expect.end());
+        CHECK_EQ(desc, expect);
+    }
+
+    release_global_task_group();
+}
+
+/** @par 检测点 */
+TEST_CASE("test_global_parallel_for_index_in_place") {
+    init_global_task_group(4);
+
+    /** @arg 结果直接写入预分配的数组 */
+    auto result = global_parallel_for_index(10, 1010, [](size_t i) { return i * 2; });
+    REQUIRE_EQ(result.size(), 1000);
+    for (size_t i = 0; i < result.size(); i++) {
+        CHECK_EQ(result[i], (i + 10) * 2);
+    }
+
+    auto part_result =
+      global_parallel_for_index(10, 1010, [](size_t i) { return i * 2; }, dynamic_partitioner(7));
+    CHECK_EQ(part_result, result);
+
+    /** @arg vector<bool> 不可并发写入，仍按区间收集 */
+    auto flags = global_parallel_for_index(0, 1000, [](size_t i) { return i % 2 == 0; });
+    REQUIRE_EQ(flags.size(), 1000);
+    for (size_t i = 0; i < flags.size(); i++) {
+        CHECK_EQ(flags[i], i % 2 == 0);
+    }
+
+    release_global_task_group();
+}
+
+#if ENABLE_BENCHMARK_TEST
+/** @par 检测点 */
+TEST_CASE("test_global_parallel_reduce_benchmark") {
+    const size_t total = 20000000;
+    std::vector<double> values(total);
+    for (size_t i = 0; i < total; i++) {
+        values[i] = double(i % 1000) * 0.001;
+    }
+
+    init_global_task_group();
+
+    double expect = 0.0;
+    {
+        BENCHMARK_TIME_MSG(std_accumulate, total, "std::accumulate");
+        expect = std::accumulate(values.begin(), values.end(), 0.0);
+    }
+
+    double result = 0.0;
+    {
+        BENCHMARK_TIME_MSG(global_parallel_for_index_sum, total, "global_parallel_for_index + sum");
+        auto copied =
+          global_parallel_for_index(0, total, [&values](size_t i) { return values[i]; });
+        result = std::accumulate(copied.begin(), copied.end(), 0.0);
+    }
+    CHECK_LT(std::abs(result - expect), 1e-3 * expect);
+
+    {
+        BENCHMARK_TIME_MSG(global_parallel_reduce, total, "global_parallel_reduce");
+        result = global_parallel_reduce(values.begin(), values.end(), 0.0);
+    }
+    CHECK_LT(std::abs(result - expect), 1e-3 * expect);
+
+    std::vector<double> out(total);
+    {
+        BENCHMARK_TIME_MSG(std_inclusive_scan, total, "std::inclusive_scan");
+        std::inclusive_scan(values.begin(), values.end(), out.begin());
+    }
+    {
+        BENCHMARK_TIME_MSG(global_parallel_inclusive_scan, total, "global_parallel_inclusive_scan");
+        global_parallel_inclusive_scan(values.begin(), values.end(), out.begin());
+    }
+
+    std::mt19937 gen(1);
+    for (auto& v : values) {
+        v = double(gen());
+    }
+    auto copy = values;
+    {
+        BENCHMARK_TIME_MSG(std_sort, total, "std::sort");
+        std::sort(copy.begin(), copy.end());
+    }
+    {
+        BENCHMARK_TIME_MSG(global_parallel_sort, total, "global_parallel_sort");
+        global_parallel_sort(values.begin(), values.end());
+    }
+    CHECK_EQ(values, copy);
+
+    release_global_task_group();
+}
+#endif
+
+/** @} */
@@ -35,6 +35,8 @@ option("http_client", {description = "use http client", default = true})
 option("http_client_ssl", {description = "enable https support for http client", default = false})
 option("http_client_zip", {description = "enable http support gzip", default = false})
 option("node", {description = "enable node reqrep server/client", default = true})
+option("lockfree_steal_queue", {description = "Use lock-free work steal queue for steal thread pools.", default = false})
+option("thread_pool_stats", {description = "Collect per-worker runtime statistics in thread pools.", default = false})
 
 
 -- SPDLOG_ACTIVE_LEVEL 需要单独加
@@ -173,6 +175,8 @@ target("hku_utils")
     set_configvar("HKU_ENABLE_HTTP_CLIENT_SSL", has_config("http_client_ssl") and 1 or 0)
     set_configvar("HKU_ENABLE_HTTP_CLIENT_ZIP", has_config("http_client_zip") and 1 or 0)
     set_configvar("HKU_ENABLE_NODE", has_config("node") and 1 or 0)
+    set_configvar("HKU_USE_LOCKFREE_STEAL_QUEUE", has_config("lockfree_steal_queue") and 1 or 0)
+    set_configvar("HKU_ENABLE_THREAD_POOL_STATS", has_config("thread_pool_stats") and 1 or 0)
     
     set_configvar("HKU_USE_SPDLOG_ASYNC_LOGGER", has_config("async_log") and 1 or 0)
     set_configvar("HKU_LOG_ACTIVE_LEVEL", get_config("log_level"))